@@ -0,0 +1,111 @@
+/**
+ * @file bench_future.cpp
+ * @brief 请求扇出基准：比较 std::packaged_task 与 ThreadPool::submit 的单任务堆分配次数与耗时
+ * @details 每个请求扇出若干子任务并等待全部完成；通过替换全局 operator new 统计分配次数
+ */
+
+#include <new>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <future>
+#include <memory>
+#include <vector>
+
+#include "danejoe/concurrent/thread_pool/thread_pool.hpp"
+
+using DaneJoe::Concurrent::ThreadPool::Future;
+using DaneJoe::Concurrent::ThreadPool::ThreadPool;
+using DaneJoe::Concurrent::ThreadPool::when_all;
+
+static std::atomic<std::size_t> g_allocation_count = 0;
+
+void* operator new(std::size_t size)
+{
+    g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size == 0 ? 1 : size))
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory)noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t)noexcept
+{
+    std::free(memory);
+}
+
+static constexpr int REQUEST_COUNT = 2000;
+static constexpr int FANOUT = 16;
+
+static long long run_packaged_task(ThreadPool& pool)
+{
+    long long total = 0;
+    for (int request = 0; request < REQUEST_COUNT; ++request)
+    {
+        std::vector<std::future<int>> futures;
+        futures.reserve(FANOUT);
+        for (int i = 0; i < FANOUT; ++i)
+        {
+            auto task = std::make_shared<std::packaged_task<int()>>([i]() { return i; });
+            futures.push_back(task->get_future());
+            pool.post([task]() { (*task)(); });
+        }
+        for (auto& future : futures)
+        {
+            total += future.get();
+        }
+    }
+    return total;
+}
+
+static long long run_library_future(ThreadPool& pool)
+{
+    long long total = 0;
+    std::vector<Future<int>> futures;
+    futures.reserve(FANOUT);
+    for (int request = 0; request < REQUEST_COUNT; ++request)
+    {
+        for (int i = 0; i < FANOUT; ++i)
+        {
+            futures.push_back(pool.submit([i]() { return i; }));
+        }
+        for (auto& future : futures)
+        {
+            total += future.get();
+        }
+        futures.clear();
+    }
+    return total;
+}
+
+template<class F>
+static void measure(const char* name, ThreadPool& pool, F&& run)
+{
+    run(pool);
+    std::size_t before = g_allocation_count.load();
+    auto start = std::chrono::steady_clock::now();
+    long long total = run(pool);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    std::size_t allocations = g_allocation_count.load() - before;
+    double tasks = static_cast<double>(REQUEST_COUNT) * FANOUT;
+    std::printf("%-16s allocs/task=%7.3f  ns/task=%8.1f  (checksum %lld)\n",
+        name,
+        static_cast<double>(allocations) / tasks,
+        std::chrono::duration<double, std::nano>(elapsed).count() / tasks,
+        total);
+}
+
+int main()
+{
+    ThreadPool pool(4);
+    measure("packaged_task", pool, run_packaged_task);
+    measure("ThreadPool", pool, run_library_future);
+    return 0;
+}
@@ -0,0 +1,108 @@
+/**
+ * @file bench_locks.cpp
+ * @brief 锁争用基准：比较 std::mutex、SpinLock、TicketLock 与 McsLock 的吞吐
+ * @details 线程数从 1 倍增到上限（默认硬件并发数的 2 倍，可通过第一个参数指定），临界区长度分别为 0、50、500 次空操作；
+ *          每个组合运行固定时长（默认 200ms，可通过第二个参数指定），报告每秒完成的临界区数
+ */
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#include "danejoe/concurrent/sync/spin_lock.hpp"
+#include "danejoe/concurrent/sync/ticket_lock.hpp"
+#include "danejoe/concurrent/sync/mcs_lock.hpp"
+
+using DaneJoe::Concurrent::Sync::McsLock;
+using DaneJoe::Concurrent::Sync::SpinLock;
+using DaneJoe::Concurrent::Sync::TicketLock;
+
+static void spin_work(std::uint32_t length)
+{
+    for (std::uint32_t i = 0; i < length; ++i)
+    {
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+    }
+}
+
+template<class Lock>
+static double measure(std::size_t thread_count, std::uint32_t critical_length, std::chrono::milliseconds duration)
+{
+    Lock lock;
+    std::uint64_t shared_counter = 0;
+    std::atomic<bool> is_started = false;
+    std::atomic<bool> is_stopped = false;
+    std::vector<std::uint64_t> counts(thread_count, 0);
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < thread_count; ++t)
+    {
+        threads.emplace_back([&, t]()
+            {
+                while (!is_started.load(std::memory_order_acquire))
+                {
+                    std::this_thread::yield();
+                }
+                std::uint64_t count = 0;
+                while (!is_stopped.load(std::memory_order_relaxed))
+                {
+                    {
+                        std::lock_guard<Lock> guard(lock);
+                        ++shared_counter;
+                        spin_work(critical_length);
+                    }
+                    // 临界区外的少量工作，避免同一线程连续重入
+                    spin_work(critical_length / 2 + 10);
+                    ++count;
+                }
+                counts[t] = count;
+            });
+    }
+    auto start = std::chrono::steady_clock::now();
+    is_started.store(true, std::memory_order_release);
+    std::this_thread::sleep_for(duration);
+    is_stopped.store(true, std::memory_order_relaxed);
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::uint64_t total = 0;
+    for (std::uint64_t count : counts)
+    {
+        total += count;
+    }
+    if (total != shared_counter)
+    {
+        std::fprintf(stderr, "lost update\n");
+        std::exit(1);
+    }
+    return static_cast<double>(total) / seconds / 1e6;
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t hardware = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    std::size_t max_threads = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : hardware * 2;
+    std::chrono::milliseconds duration(argc > 2 ? std::strtoll(argv[2], nullptr, 10) : 200);
+    std::printf("hardware threads=%zu, Mops/s\n", hardware);
+    std::printf("%8s %8s %12s %12s %12s %12s\n", "threads", "critical", "std::mutex", "SpinLock", "TicketLock", "McsLock");
+    for (std::uint32_t critical_length : { 0u, 50u, 500u })
+    {
+        for (std::size_t thread_count = 1; thread_count <= max_threads; thread_count *= 2)
+        {
+            double mutex_rate = measure<std::mutex>(thread_count, critical_length, duration);
+            double spin_rate = measure<SpinLock>(thread_count, critical_length, duration);
+            double ticket_rate = measure<TicketLock>(thread_count, critical_length, duration);
+            double mcs_rate = measure<McsLock>(thread_count, critical_length, duration);
+            std::printf("%8zu %8u %12.2f %12.2f %12.2f %12.2f\n",
+                thread_count, critical_length, mutex_rate, spin_rate, ticket_rate, mcs_rate);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,68 @@
+/**
+ * @file bench_parallel_sort.cpp
+ * @brief 并行排序基准：比较 std::sort / std::stable_sort 与 parallel_sort / parallel_stable_sort
+ * @details 规模从 1M 递增到上限（默认 100M，可通过第一个参数指定），随机 uint64 数据；
+ *          第二个参数可指定线程数，默认为硬件并发数
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include <algorithm>
+
+#include "danejoe/concurrent/thread_pool/thread_pool.hpp"
+#include "danejoe/concurrent/algorithm/parallel_sort.hpp"
+
+using DaneJoe::Concurrent::Algorithm::parallel_sort;
+using DaneJoe::Concurrent::Algorithm::parallel_stable_sort;
+using DaneJoe::Concurrent::ThreadPool::ThreadPool;
+
+static std::vector<std::uint64_t> make_random(std::size_t size)
+{
+    std::mt19937_64 engine(size);
+    std::vector<std::uint64_t> values(size);
+    for (auto& value : values)
+    {
+        value = engine();
+    }
+    return values;
+}
+
+template<class F>
+static double measure(const std::vector<std::uint64_t>& source, F&& sort)
+{
+    std::vector<std::uint64_t> values = source;
+    auto start = std::chrono::steady_clock::now();
+    sort(values);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    if (!std::is_sorted(values.begin(), values.end()))
+    {
+        std::fprintf(stderr, "result not sorted\n");
+        std::exit(1);
+    }
+    return std::chrono::duration<double, std::milli>(elapsed).count();
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t max_size = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100'000'000;
+    std::size_t thread_count = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 0;
+    ThreadPool pool(thread_count);
+    std::printf("threads=%zu\n", pool.get_thread_count());
+    std::printf("%12s %12s %12s %8s %12s %12s %8s\n",
+        "size", "std::sort", "parallel", "speedup", "std::stable", "parallel", "speedup");
+    for (std::size_t size = 1'000'000; size <= max_size; size *= 10)
+    {
+        auto source = make_random(size);
+        double std_sort = measure(source, [](auto& values) { std::sort(values.begin(), values.end()); });
+        double par_sort = measure(source, [&](auto& values) { parallel_sort(pool, values.begin(), values.end()); });
+        double std_stable = measure(source, [](auto& values) { std::stable_sort(values.begin(), values.end()); });
+        double par_stable = measure(source, [&](auto& values) { parallel_stable_sort(pool, values.begin(), values.end()); });
+        std::printf("%12zu %10.1fms %10.1fms %7.2fx %10.1fms %10.1fms %7.2fx\n",
+            size, std_sort, par_sort, std_sort / par_sort, std_stable, par_stable, std_stable / par_stable);
+    }
+    return 0;
+}
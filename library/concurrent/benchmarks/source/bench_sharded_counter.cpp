@@ -0,0 +1,71 @@
+/**
+ * @file bench_sharded_counter.cpp
+ * @brief 计数器扩展性基准：比较单个 std::atomic 与 ShardedCounter 在多线程自增下的单次开销
+ * @details 线程数从 1 倍增到上限（默认 64，可通过第一个参数指定），每个线程自增固定次数（默认 1000000，可通过第二个参数指定）
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#include "danejoe/concurrent/metrics/sharded_counter.hpp"
+
+using DaneJoe::Concurrent::Metrics::ShardedCounter;
+
+template<class F>
+static double measure(std::size_t thread_count, std::uint64_t per_thread, F&& increment)
+{
+    std::atomic<bool> is_started = false;
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < thread_count; ++t)
+    {
+        threads.emplace_back([&]()
+            {
+                while (!is_started.load(std::memory_order_acquire))
+                {
+                    std::this_thread::yield();
+                }
+                for (std::uint64_t i = 0; i < per_thread; ++i)
+                {
+                    increment();
+                }
+            });
+    }
+    auto start = std::chrono::steady_clock::now();
+    is_started.store(true, std::memory_order_release);
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    double nanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    // 单次自增的平均开销：总耗时乘以并行度后均摊到全部操作
+    std::size_t parallelism = std::min<std::size_t>(thread_count, std::max(1u, std::thread::hardware_concurrency()));
+    return nanoseconds * static_cast<double>(parallelism) / static_cast<double>(thread_count * per_thread);
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t max_threads = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 64;
+    std::uint64_t per_thread = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1'000'000;
+    std::printf("hardware threads=%u, ns per increment\n", std::thread::hardware_concurrency());
+    std::printf("%8s %14s %14s\n", "threads", "std::atomic", "ShardedCounter");
+    for (std::size_t thread_count = 1; thread_count <= max_threads; thread_count *= 2)
+    {
+        std::atomic<std::int64_t> atomic_counter = 0;
+        ShardedCounter sharded_counter;
+        double atomic_cost = measure(thread_count, per_thread, [&]() { atomic_counter.fetch_add(1, std::memory_order_relaxed); });
+        double sharded_cost = measure(thread_count, per_thread, [&]() { sharded_counter.increment(); });
+        if (atomic_counter.load() != sharded_counter.get())
+        {
+            std::fprintf(stderr, "count mismatch\n");
+            return 1;
+        }
+        std::printf("%8zu %14.2f %14.2f\n", thread_count, atomic_cost, sharded_cost);
+    }
+    return 0;
+}
@@ -0,0 +1,483 @@
+#pragma once
+
+/**
+ * @file actor.hpp
+ * @author DaneJoe001
+ * @version 0.1.1
+ * @brief 轻量级 Actor 运行时
+ * @details 每个 Actor 拥有一个无锁 MPSC 邮箱，仅当邮箱由空变为非空时才被投递到执行器上，
+ *          每次激活最多处理 batch_size 条消息；空闲 Actor 不占用线程，也不持有任何待执行任务
+ * @date 2026-10-18
+ */
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <utility>
+#include <optional>
+#include <exception>
+#include <functional>
+#include <type_traits>
+
+#include "danejoe/concurrent/thread_pool/task.hpp"
+#include "danejoe/concurrent/thread_pool/executor.hpp"
+#include "danejoe/concurrent/lock_free/mpsc_queue.hpp"
+
+/**
+ * @namespace DaneJoe
+ * @brief DaneJoe命名空间
+ */
+namespace DaneJoe
+{
+    /**
+     * @namespace Concurrent
+     * @brief 并发命名空间
+     */
+    namespace Concurrent
+    {
+        /**
+         * @namespace Actor
+         * @brief Actor命名空间
+         */
+        namespace Actor
+        {
+            class ActorSystem;
+            template<class Message>
+            class Actor;
+            template<class Message>
+            class ActorRef;
+            /**
+             * @enum FailureAction
+             * @brief 消息处理抛出异常后的处置
+             */
+            enum class FailureAction
+            {
+                /// @brief 忽略异常，继续处理后续消息
+                Resume,
+                /// @brief 停止 Actor，丢弃后续消息
+                Stop
+            };
+            class ActorBase;
+            /**
+             * @namespace Detail
+             * @brief 实现细节
+             */
+            namespace Detail
+            {
+                /**
+                 * @struct ActorSystemState
+                 * @brief ActorSystem 与其创建的 Actor 共享的状态
+                 * @details Actor 持有共享所有权，ActorSystem 先于 Actor 销毁时激活、计数与失败处理仍然有效
+                 */
+                struct ActorSystemState
+                {
+                    /// @brief 失败处理函数类型
+                    using FailureHandler = std::function<FailureAction(ActorBase&, std::exception_ptr)>;
+                    /**
+                     * @brief 构造函数
+                     * @param executor 执行器
+                     * @param batch_size 单次激活最多处理的消息数
+                     */
+                    ActorSystemState(ThreadPool::IExecutor& executor, std::size_t batch_size) :
+                        executor(executor), batch_size(batch_size == 0 ? 1 : batch_size)
+                    {
+                    }
+                    /**
+                     * @brief 处理 Actor 失败
+                     * @param actor 失败的 Actor
+                     * @param exception 异常
+                     * @return FailureAction 处置
+                     */
+                    FailureAction handle_failure(ActorBase& actor, std::exception_ptr exception)
+                    {
+                        failure_count.fetch_add(1, std::memory_order_relaxed);
+                        FailureHandler handler;
+                        {
+                            std::lock_guard<std::mutex> lock(failure_mutex);
+                            handler = failure_handler;
+                        }
+                        if (!handler)
+                        {
+                            return FailureAction::Stop;
+                        }
+                        try
+                        {
+                            return handler(actor, exception);
+                        }
+                        catch (...)
+                        {
+                            return FailureAction::Stop;
+                        }
+                    }
+                    /// @brief 执行器
+                    ThreadPool::IExecutor& executor;
+                    /// @brief 单次激活最多处理的消息数
+                    std::size_t batch_size;
+                    /// @brief 存活的 Actor 数
+                    std::atomic<std::size_t> actor_count = 0;
+                    /// @brief 消息处理失败次数
+                    std::atomic<std::size_t> failure_count = 0;
+                    /// @brief 失败处理函数互斥锁
+                    std::mutex failure_mutex;
+                    /// @brief 失败处理函数
+                    FailureHandler failure_handler;
+                };
+            }
+            /**
+             * @class ActorBase
+             * @brief Actor 公共部分
+             */
+            class ActorBase
+            {
+            public:
+                /**
+                 * @brief 构造函数
+                 */
+                ActorBase() = default;
+                /**
+                 * @brief 析构函数
+                 */
+                virtual ~ActorBase();
+                /**
+                 * @brief 停止 Actor
+                 * @note 停止后不再接收消息，邮箱中剩余消息被丢弃
+                 */
+                void stop()noexcept
+                {
+                    m_is_stopped.store(true, std::memory_order_release);
+                }
+                /**
+                 * @brief 判断是否已停止
+                 * @return bool 是否已停止
+                 */
+                bool is_stopped()const noexcept
+                {
+                    return m_is_stopped.load(std::memory_order_acquire);
+                }
+            protected:
+                /**
+                 * @brief 消息处理抛出异常时调用
+                 * @note 默认交给 ActorSystem 的失败处理函数，未设置时停止 Actor
+                 * @param exception 异常
+                 * @return FailureAction 处置
+                 */
+                virtual FailureAction on_failure(std::exception_ptr exception);
+                /**
+                 * @brief 获取所属 ActorSystem
+                 * @note 仅在 ActorSystem 存活期间可用
+                 * @return ActorSystem& 所属系统
+                 */
+                ActorSystem& get_system()const noexcept
+                {
+                    return *m_system;
+                }
+            private:
+                friend class ActorSystem;
+                template<class Message>
+                friend class Actor;
+                /**
+                 * @brief 拷贝构造函数
+                 * @note 禁止拷贝构造
+                 */
+                ActorBase(const ActorBase&) = delete;
+                /**
+                 * @brief 拷贝赋值运算符
+                 * @note 禁止拷贝赋值
+                 */
+                ActorBase& operator=(const ActorBase&) = delete;
+            private:
+                /// @brief 所属系统
+                ActorSystem* m_system = nullptr;
+                /// @brief 与所属系统共享的状态，使 Actor 可以比 ActorSystem 存活更久
+                std::shared_ptr<Detail::ActorSystemState> m_state;
+                /// @brief 是否已停止
+                std::atomic<bool> m_is_stopped = false;
+            };
+            /**
+             * @class ActorSystem
+             * @brief Actor 运行时
+             * @note 可先于其创建的 Actor 销毁：Actor 共享运行所需的状态，但执行器仍需在全部 Actor 销毁之前保持有效
+             */
+            class ActorSystem
+            {
+            public:
+                /// @brief 失败处理函数类型
+                using FailureHandler = Detail::ActorSystemState::FailureHandler;
+                /// @brief 默认单次激活处理的消息数
+                static constexpr std::size_t DEFAULT_BATCH_SIZE = 32;
+            public:
+                /**
+                 * @brief 构造函数
+                 * @param executor 执行器，需在全部 Actor 销毁之前保持有效
+                 * @param batch_size 单次激活最多处理的消息数
+                 */
+                explicit ActorSystem(ThreadPool::IExecutor& executor, std::size_t batch_size = DEFAULT_BATCH_SIZE) :
+                    m_state(std::make_shared<Detail::ActorSystemState>(executor, batch_size))
+                {
+                }
+                /**
+                 * @brief 创建 Actor
+                 * @tparam A Actor 类型，需派生自 Actor<Message>
+                 * @tparam Args 构造参数类型
+                 * @param args 构造参数
+                 * @return ActorRef<typename A::MessageType> Actor 引用
+                 */
+                template<class A, class... Args>
+                ActorRef<typename A::MessageType> spawn(Args&&... args);
+                /**
+                 * @brief 设置失败处理函数
+                 * @param handler 失败处理函数
+                 */
+                void set_failure_handler(FailureHandler handler)
+                {
+                    std::lock_guard<std::mutex> lock(m_state->failure_mutex);
+                    m_state->failure_handler = std::move(handler);
+                }
+                /**
+                 * @brief 获取执行器
+                 * @return ThreadPool::IExecutor& 执行器
+                 */
+                ThreadPool::IExecutor& get_executor()const noexcept
+                {
+                    return m_state->executor;
+                }
+                /**
+                 * @brief 获取单次激活处理的消息数
+                 * @return std::size_t 消息数
+                 */
+                std::size_t get_batch_size()const noexcept
+                {
+                    return m_state->batch_size;
+                }
+                /**
+                 * @brief 获取存活的 Actor 数
+                 * @return std::size_t Actor 数
+                 */
+                std::size_t get_actor_count()const noexcept
+                {
+                    return m_state->actor_count.load(std::memory_order_relaxed);
+                }
+                /**
+                 * @brief 获取消息处理失败次数
+                 * @return std::size_t 失败次数
+                 */
+                std::size_t get_failure_count()const noexcept
+                {
+                    return m_state->failure_count.load(std::memory_order_relaxed);
+                }
+            private:
+                /**
+                 * @brief 拷贝构造函数
+                 * @note 禁止拷贝构造
+                 */
+                ActorSystem(const ActorSystem&) = delete;
+                /**
+                 * @brief 拷贝赋值运算符
+                 * @note 禁止拷贝赋值
+                 */
+                ActorSystem& operator=(const ActorSystem&) = delete;
+            private:
+                /// @brief 与 Actor 共享的状态
+                std::shared_ptr<Detail::ActorSystemState> m_state;
+            };
+            /**
+             * @class Actor
+             * @brief 处理单一消息类型的 Actor
+             * @details 未处理消息数由计数器维护：计数由 0 变为 1 的发送者负责投递激活任务，
+             *          激活结束时计数仍非零则由激活任务自行重新投递，因此同一时刻至多一个激活在运行
+             * @note 需通过 ActorSystem::spawn() 创建
+             * @tparam Message 消息类型
+             */
+            template<class Message>
+            class Actor : public ActorBase, public std::enable_shared_from_this<Actor<Message>>
+            {
+            public:
+                /// @brief 消息类型
+                using MessageType = Message;
+            public:
+                /**
+                 * @brief 发送消息
+                 * @param message 消息
+                 * @return bool 是否进入邮箱；Actor 已停止时返回 false
+                 */
+                bool tell(Message message)
+                {
+                    if (is_stopped())
+                    {
+                        return false;
+                    }
+                    std::size_t previous = m_pending_count.fetch_add(1, std::memory_order_acq_rel);
+                    m_mailbox.push(std::move(message));
+                    if (previous == 0)
+                    {
+                        schedule();
+                    }
+                    return true;
+                }
+                /**
+                 * @brief 获取邮箱中未处理的消息数
+                 * @return std::size_t 消息数
+                 */
+                std::size_t get_mailbox_size()const noexcept
+                {
+                    return m_pending_count.load(std::memory_order_relaxed);
+                }
+                /**
+                 * @brief 获取自身引用
+                 * @return ActorRef<Message> 自身引用
+                 */
+                ActorRef<Message> get_self()
+                {
+                    return ActorRef<Message>(this->shared_from_this());
+                }
+            protected:
+                /**
+                 * @brief 处理一条消息
+                 * @note 同一 Actor 的 receive() 不会并发执行
+                 * @param message 消息
+                 */
+                virtual void receive(Message& message) = 0;
+            private:
+                /**
+                 * @brief 向执行器投递激活任务
+                 */
+                void schedule()
+                {
+                    m_state->executor.execute(ThreadPool::Task([self = this->shared_from_this()]()
+                        {
+                            self->activate();
+                        }));
+                }
+                /**
+                 * @brief 处理至多 batch_size 条消息
+                 */
+                void activate()
+                {
+                    std::size_t batch_size = m_state->batch_size;
+                    std::size_t processed_count = 0;
+                    while (processed_count < batch_size)
+                    {
+                        std::optional<Message> message = m_mailbox.try_pop();
+                        if (!message)
+                        {
+                            break;
+                        }
+                        ++processed_count;
+                        if (is_stopped())
+                        {
+                            continue;
+                        }
+                        try
+                        {
+                            receive(*message);
+                        }
+                        catch (...)
+                        {
+                            if (on_failure(std::current_exception()) == FailureAction::Stop)
+                            {
+                                stop();
+                            }
+                        }
+                    }
+                    std::size_t previous = m_pending_count.fetch_sub(processed_count, std::memory_order_acq_rel);
+                    if (previous > processed_count)
+                    {
+                        schedule();
+                    }
+                }
+            private:
+                /// @brief 邮箱
+                LockFree::MpscQueue<Message> m_mailbox;
+                /// @brief 已发送但未处理的消息数
+                std::atomic<std::size_t> m_pending_count = 0;
+            };
+            /**
+             * @class ActorRef
+             * @brief Actor 引用
+             * @details 可拷贝；持有引用期间 Actor 保持存活
+             * @tparam Message 消息类型
+             */
+            template<class Message>
+            class ActorRef
+            {
+            public:
+                /**
+                 * @brief 构造空引用
+                 */
+                ActorRef() = default;
+                /**
+                 * @brief 构造函数
+                 * @param actor Actor
+                 */
+                explicit ActorRef(std::shared_ptr<Actor<Message>> actor)noexcept :m_actor(std::move(actor)) {}
+                /**
+                 * @brief 发送消息
+                 * @param message 消息
+                 * @return bool 是否进入邮箱
+                 */
+                bool tell(Message message)const
+                {
+                    return m_actor && m_actor->tell(std::move(message));
+                }
+                /**
+                 * @brief 停止 Actor
+                 */
+                void stop()const noexcept
+                {
+                    if (m_actor)
+                    {
+                        m_actor->stop();
+                    }
+                }
+                /**
+                 * @brief 判断是否已停止
+                 * @return bool 是否已停止；空引用视为已停止
+                 */
+                bool is_stopped()const noexcept
+                {
+                    return !m_actor || m_actor->is_stopped();
+                }
+                /**
+                 * @brief 获取邮箱中未处理的消息数
+                 * @return std::size_t 消息数
+                 */
+                std::size_t get_mailbox_size()const noexcept
+                {
+                    return m_actor ? m_actor->get_mailbox_size() : 0;
+                }
+                /**
+                 * @brief 判断是否为非空引用
+                 */
+                explicit operator bool()const noexcept
+                {
+                    return static_cast<bool>(m_actor);
+                }
+            private:
+                /// @brief Actor
+                std::shared_ptr<Actor<Message>> m_actor;
+            };
+            inline ActorBase::~ActorBase()
+            {
+                if (m_state)
+                {
+                    m_state->actor_count.fetch_sub(1, std::memory_order_relaxed);
+                }
+            }
+            inline FailureAction ActorBase::on_failure(std::exception_ptr exception)
+            {
+                return m_state->handle_failure(*this, exception);
+            }
+            template<class A, class... Args>
+            ActorRef<typename A::MessageType> ActorSystem::spawn(Args&&... args)
+            {
+                static_assert(std::is_base_of_v<Actor<typename A::MessageType>, A>, "A must derive from Actor<Message>");
+                auto actor = std::make_shared<A>(std::forward<Args>(args)...);
+                static_cast<ActorBase&>(*actor).m_system = this;
+                static_cast<ActorBase&>(*actor).m_state = m_state;
+                m_state->actor_count.fetch_add(1, std::memory_order_relaxed);
+                return ActorRef<typename A::MessageType>(std::move(actor));
+            }
+        }
+    }
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+/**
+ * @file fork_join.hpp
+ * @author DaneJoe001
+ * @version 0.1.1
+ * @brief 基于线程池的分治执行
+ * @details 一侧投递到线程池，另一侧在当前线程执行；等待期间当前线程协助执行池中任务，
+ *          因此在工作线程中递归调用也不会耗尽线程
+ * @date 2026-10-18
+ */
+
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <exception>
+
+#include "danejoe/concurrent/thread_pool/task.hpp"
+#include "danejoe/concurrent/thread_pool/thread_pool.hpp"
+
+/**
+ * @namespace DaneJoe
+ * @brief DaneJoe命名空间
+ */
+namespace DaneJoe
+{
+    /**
+     * @namespace Concurrent
+     * @brief 并发命名空间
+     */
+    namespace Concurrent
+    {
+        /**
+         * @namespace Algorithm
+         * @brief 并行算法命名空间
+         */
+        namespace Algorithm
+        {
+            /**
+             * @brief 并行执行两个可调用对象并等待二者完成
+             * @note 任一侧抛出的异常在二者均完成后重新抛出（左侧优先）
+             * @tparam Left 左侧可调用对象类型
+             * @tparam Right 右侧可调用对象类型
+             * @param pool 线程池
+             * @param left 投递到线程池的一侧
+             * @param right 在当前线程执行的一侧
+             */
+            template<class Left, class Right>
+            void fork_join(ThreadPool::ThreadPool& pool, Left&& left, Right&& right)
+            {
+                std::atomic<bool> is_left_done = false;
+                std::exception_ptr left_exception;
+                bool is_posted = pool.post(ThreadPool::Task([&left, &is_left_done, &left_exception]()
+                    {
+                        try
+                        {
+                            left();
+                        }
+                        catch (...)
+                        {
+                            left_exception = std::current_exception();
+                        }
+                        is_left_done.store(true, std::memory_order_release);
+                    }));
+                if (!is_posted)
+                {
+                    left();
+                    right();
+                    return;
+                }
+                std::exception_ptr right_exception;
+                try
+                {
+                    right();
+                }
+                catch (...)
+                {
+                    right_exception = std::current_exception();
+                }
+                while (!is_left_done.load(std::memory_order_acquire))
+                {
+                    if (!pool.run_pending_task())
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+                if (left_exception)
+                {
+                    std::rethrow_exception(left_exception);
+                }
+                if (right_exception)
+                {
+                    std::rethrow_exception(right_exception);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+/**
+ * @file parallel_merge.hpp
+ * @author DaneJoe001
+ * @version 0.1.1
+ * @brief 并行归并
+ * @details 取较长序列的中点，在另一序列中二分定位切分点，两半独立归并；
+ *          相等元素中第一个序列的元素在前，与 std::merge 一样稳定
+ * @date 2026-10-18
+ */
+
+#include <iterator>
+#include <algorithm>
+#include <functional>
+
+#include "danejoe/concurrent/thread_pool/thread_pool.hpp"
+#include "danejoe/concurrent/algorithm/fork_join.hpp"
+
+/**
+ * @namespace DaneJoe
+ * @brief DaneJoe命名空间
+ */
+namespace DaneJoe
+{
+    /**
+     * @namespace Concurrent
+     * @brief 并发命名空间
+     */
+    namespace Concurrent
+    {
+        /**
+         * @namespace Algorithm
+         * @brief 并行算法命名空间
+         */
+        namespace Algorithm
+        {
+            /// @brief 默认串行阈值：元素总数不超过该值时直接串行处理
+            inline constexpr std::size_t DEFAULT_SEQUENTIAL_CUTOFF = 8192;
+            /**
+             * @brief 并行归并两个有序序列
+             * @tparam InputIt1 第一个序列迭代器类型
+             * @tparam InputIt2 第二个序列迭代器类型
+             * @tparam OutputIt 输出迭代器类型
+             * @tparam Compare 比较函数类型
+             * @param pool 线程池
+             * @param first1 第一个序列起始
+             * @param last1 第一个序列结束
+             * @param first2 第二个序列起始
+             * @param last2 第二个序列结束
+             * @param out 输出起始，不得与输入重叠
+             * @param comp 比较函数
+             * @param cutoff 串行阈值
+             * @return OutputIt 输出结束
+             */
+            template<class InputIt1, class InputIt2, class OutputIt, class Compare = std::less<>>
+            OutputIt parallel_merge(ThreadPool::ThreadPool& pool,
+                InputIt1 first1, InputIt1 last1,
+                InputIt2 first2, InputIt2 last2,
+                OutputIt out,
+                Compare comp = Compare(),
+                std::size_t cutoff = DEFAULT_SEQUENTIAL_CUTOFF)
+            {
+                auto size1 = std::distance(first1, last1);
+                auto size2 = std::distance(first2, last2);
+                if (static_cast<std::size_t>(size1 + size2) <= cutoff || size1 == 0 || size2 == 0)
+                {
+                    return std::merge(first1, last1, first2, last2, out, comp);
+                }
+                InputIt1 middle1;
+                InputIt2 middle2;
+                if (size1 >= size2)
+                {
+                    middle1 = std::next(first1, size1 / 2);
+                    middle2 = std::lower_bound(first2, last2, *middle1, comp);
+                }
+                else
+                {
+                    middle2 = std::next(first2, size2 / 2);
+                    middle1 = std::upper_bound(first1, last1, *middle2, comp);
+                }
+                OutputIt middle_out = std::next(out, std::distance(first1, middle1) + std::distance(first2, middle2));
+                fork_join(pool,
+                    [&]()
+                    {
+                        parallel_merge(pool, first1, middle1, first2, middle2, out, comp, cutoff);
+                    },
+                    [&]()
+                    {
+                        parallel_merge(pool, middle1, last1, middle2, last2, middle_out, comp, cutoff);
+                    });
+                return std::next(middle_out, std::distance(middle1, last1) + std::distance(middle2, last2));
+            }
+        }
+    }
+}
@@ -0,0 +1,281 @@
+#pragma once
+
+/**
+ * @file parallel_sort.hpp
+ * @author DaneJoe001
+ * @version 0.1.1
+ * @brief 并行排序
+ * @details parallel_sort 为三路划分快速排序，两侧子区间 fork-join 并行递归，
+ *          递归深度超过 2·log2(n) 时改用 std::sort（内省排序），最坏情况仍为 O(n log n)；
+ *          parallel_stable_sort 为归并排序，借助等长缓冲区往返归并，归并本身也并行执行；
+ *          区间不超过串行阈值时退化为 std::sort / std::stable_sort
+ * @date 2026-10-18
+ */
+
+#include <memory>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <functional>
+
+#include "danejoe/concurrent/thread_pool/thread_pool.hpp"
+#include "danejoe/concurrent/algorithm/fork_join.hpp"
+#include "danejoe/concurrent/algorithm/parallel_merge.hpp"
+
+/**
+ * @namespace DaneJoe
+ * @brief DaneJoe命名空间
+ */
+namespace DaneJoe
+{
+    /**
+     * @namespace Concurrent
+     * @brief 并发命名空间
+     */
+    namespace Concurrent
+    {
+        /**
+         * @namespace Algorithm
+         * @brief 并行算法命名空间
+         */
+        namespace Algorithm
+        {
+            /**
+             * @namespace Detail
+             * @brief 实现细节命名空间
+             */
+            namespace Detail
+            {
+                /**
+                 * @class MoveBuffer
+                 * @brief 由区间元素移动构造的临时缓冲区
+                 * @details 元素在未初始化存储上就地构造，元素类型无需可默认构造；之后的写入均为对已构造元素的赋值
+                 * @tparam T 元素类型
+                 */
+                template<class T>
+                class MoveBuffer
+                {
+                public:
+                    /**
+                     * @brief 构造函数
+                     * @tparam It 迭代器类型
+                     * @param first 区间起始，元素被移走
+                     * @param last 区间结束
+                     */
+                    template<class It>
+                    MoveBuffer(It first, It last) :
+                        m_size(static_cast<std::size_t>(last - first)),
+                        m_data(m_allocator.allocate(m_size))
+                    {
+                        try
+                        {
+                            std::uninitialized_move(first, last, m_data);
+                        }
+                        catch (...)
+                        {
+                            m_allocator.deallocate(m_data, m_size);
+                            throw;
+                        }
+                    }
+                    /**
+                     * @brief 析构函数
+                     */
+                    ~MoveBuffer()
+                    {
+                        std::destroy_n(m_data, m_size);
+                        m_allocator.deallocate(m_data, m_size);
+                    }
+                    /**
+                     * @brief 获取起始位置
+                     * @return T* 起始位置
+                     */
+                    T* begin()noexcept
+                    {
+                        return m_data;
+                    }
+                private:
+                    /**
+                     * @brief 拷贝构造函数
+                     * @note 禁止拷贝构造
+                     */
+                    MoveBuffer(const MoveBuffer&) = delete;
+                    /**
+                     * @brief 拷贝赋值运算符
+                     * @note 禁止拷贝赋值
+                     */
+                    MoveBuffer& operator=(const MoveBuffer&) = delete;
+                private:
+                    /// @brief 分配器
+                    std::allocator<T> m_allocator;
+                    /// @brief 元素数
+                    std::size_t m_size;
+                    /// @brief 存储
+                    T* m_data;
+                };
+                /**
+                 * @brief 并行快速排序的递归实现
+                 * @tparam RandomIt 随机访问迭代器类型
+                 * @tparam Compare 比较函数类型
+                 * @param pool 线程池
+                 * @param first 区间起始
+                 * @param last 区间结束
+                 * @param comp 比较函数
+                 * @param cutoff 串行阈值
+                 * @param depth_limit 剩余递归深度，耗尽时改用 std::sort
+                 */
+                template<class RandomIt, class Compare>
+                void parallel_sort(ThreadPool::ThreadPool& pool,
+                    RandomIt first, RandomIt last,
+                    Compare& comp, std::size_t cutoff, std::size_t depth_limit)
+                {
+                    auto size = last - first;
+                    // 深度耗尽说明枢轴持续失衡（如针对三数取中构造的输入），std::sort 保证 O(n log n)
+                    if (size < 2 || static_cast<std::size_t>(size) <= cutoff || depth_limit == 0)
+                    {
+                        std::sort(first, last, comp);
+                        return;
+                    }
+                    // 三数取中后把枢轴放到末尾
+                    RandomIt middle = first + size / 2;
+                    RandomIt back = last - 1;
+                    if (comp(*middle, *first))
+                    {
+                        std::iter_swap(middle, first);
+                    }
+                    if (comp(*back, *middle))
+                    {
+                        std::iter_swap(back, middle);
+                    }
+                    if (comp(*middle, *first))
+                    {
+                        std::iter_swap(middle, first);
+                    }
+                    std::iter_swap(middle, back);
+                    const auto& pivot = *back;
+                    // 三路划分：[first, less_end) < pivot，[less_end, equal_end) == pivot
+                    RandomIt less_end = std::partition(first, back,
+                        [&](const auto& value) { return comp(value, pivot); });
+                    RandomIt equal_end = std::partition(less_end, back,
+                        [&](const auto& value) { return !comp(pivot, value); });
+                    std::iter_swap(equal_end, back);
+                    ++equal_end;
+                    fork_join(pool,
+                        [&]()
+                        {
+                            parallel_sort(pool, first, less_end, comp, cutoff, depth_limit - 1);
+                        },
+                        [&]()
+                        {
+                            parallel_sort(pool, equal_end, last, comp, cutoff, depth_limit - 1);
+                        });
+                }
+                /**
+                 * @brief 并行归并排序的递归实现
+                 * @details 两半各自排序到另一侧存储后归并回目标侧，每层只移动一次元素
+                 * @tparam RandomIt 随机访问迭代器类型
+                 * @tparam BufferIt 缓冲区迭代器类型
+                 * @tparam Compare 比较函数类型
+                 * @param pool 线程池
+                 * @param first 区间起始
+                 * @param last 区间结束
+                 * @param buffer 与区间等长的缓冲区起始
+                 * @param comp 比较函数
+                 * @param cutoff 串行阈值
+                 * @param is_to_buffer 结果写入缓冲区（true）还是原区间（false）
+                 */
+                template<class RandomIt, class BufferIt, class Compare>
+                void parallel_stable_sort(ThreadPool::ThreadPool& pool,
+                    RandomIt first, RandomIt last, BufferIt buffer,
+                    Compare& comp, std::size_t cutoff, bool is_to_buffer)
+                {
+                    auto size = last - first;
+                    if (size < 2 || static_cast<std::size_t>(size) <= cutoff)
+                    {
+                        std::stable_sort(first, last, comp);
+                        if (is_to_buffer)
+                        {
+                            std::move(first, last, buffer);
+                        }
+                        return;
+                    }
+                    RandomIt middle = first + size / 2;
+                    BufferIt buffer_middle = buffer + size / 2;
+                    BufferIt buffer_last = buffer + size;
+                    fork_join(pool,
+                        [&]()
+                        {
+                            parallel_stable_sort(pool, first, middle, buffer, comp, cutoff, !is_to_buffer);
+                        },
+                        [&]()
+                        {
+                            parallel_stable_sort(pool, middle, last, buffer_middle, comp, cutoff, !is_to_buffer);
+                        });
+                    if (is_to_buffer)
+                    {
+                        parallel_merge(pool,
+                            std::make_move_iterator(first), std::make_move_iterator(middle),
+                            std::make_move_iterator(middle), std::make_move_iterator(last),
+                            buffer, comp, cutoff);
+                    }
+                    else
+                    {
+                        parallel_merge(pool,
+                            std::make_move_iterator(buffer), std::make_move_iterator(buffer_middle),
+                            std::make_move_iterator(buffer_middle), std::make_move_iterator(buffer_last),
+                            first, comp, cutoff);
+                    }
+                }
+            }
+            /**
+             * @brief 并行排序（不稳定）
+             * @tparam RandomIt 随机访问迭代器类型
+             * @tparam Compare 比较函数类型
+             * @param pool 线程池
+             * @param first 区间起始
+             * @param last 区间结束
+             * @param comp 比较函数
+             * @param cutoff 串行阈值
+             */
+            template<class RandomIt, class Compare = std::less<>>
+            void parallel_sort(ThreadPool::ThreadPool& pool,
+                RandomIt first, RandomIt last,
+                Compare comp = Compare(),
+                std::size_t cutoff = DEFAULT_SEQUENTIAL_CUTOFF)
+            {
+                std::size_t depth_limit = 0;
+                for (auto size = last - first; size > 1; size /= 2)
+                {
+                    depth_limit += 2;
+                }
+                Detail::parallel_sort(pool, first, last, comp, cutoff, depth_limit);
+            }
+            /**
+             * @brief 并行稳定排序
+             * @note 需要与区间等长的临时缓冲区，由区间元素移动构造，元素类型无需可默认构造
+             * @tparam RandomIt 随机访问迭代器类型
+             * @tparam Compare 比较函数类型
+             * @param pool 线程池
+             * @param first 区间起始
+             * @param last 区间结束
+             * @param comp 比较函数
+             * @param cutoff 串行阈值
+             */
+            template<class RandomIt, class Compare = std::less<>>
+            void parallel_stable_sort(ThreadPool::ThreadPool& pool,
+                RandomIt first, RandomIt last,
+                Compare comp = Compare(),
+                std::size_t cutoff = DEFAULT_SEQUENTIAL_CUTOFF)
+            {
+                auto size = last - first;
+                if (size < 2 || static_cast<std::size_t>(size) <= cutoff)
+                {
+                    std::stable_sort(first, last, comp);
+                    return;
+                }
+                Detail::MoveBuffer<typename std::iterator_traits<RandomIt>::value_type> buffer(first, last);
+                // 缓冲区持有元素本身，把它作为源排序回原区间（原区间中为已移走的元素，只被赋值）
+                Detail::parallel_stable_sort(pool, buffer.begin(), buffer.begin() + size, first, comp, cutoff, true);
+            }
+        }
+    }
+}
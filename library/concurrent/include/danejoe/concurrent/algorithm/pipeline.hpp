@@ -0,0 +1,832 @@
+#pragma once
+
+/**
+ * @file pipeline.hpp
+ * @author DaneJoe001
+ * @version 0.1.1
+ * @brief 多级流水线
+ * @details 参照 TBB parallel_pipeline：源、若干中间级与汇组成一条链，每级为串行或并行（多个工作线程）。
+ *          相邻两级之间是 生产者数 × 消费者数 个 SpscRingQueue，序号为 s 的令牌由上一级第 s % a 个工作线程
+ *          交给下一级第 s % b 个工作线程，每个工作线程按序号递增处理自己那一份，因此各级输出顺序与输入一致。
+ *          在途令牌数不超过 max_tokens，环形队列容量据此确定，推入永不失败。
+ *          等待输入或令牌的工作线程先有界自旋，之后在唤醒序号上休眠，推入令牌、归还令牌或中止时唤醒。
+ *          每级统计处理耗时（忙）与等待输入、令牌的耗时（闲），利用率最高的一级即瓶颈
+ * @note 令牌按序号静态分配给并行级的工作线程，不会被空闲的工作线程接手：某个令牌处理较慢时，
+ *       同一工作线程其后的令牌（每第 concurrency 个）随之等待，在途令牌用尽后其余工作线程也会停顿。
+ *       各令牌处理耗时差异大时应增大 max_tokens
+ * @date 2026-10-18
+ */
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <optional>
+#include <exception>
+#include <stdexcept>
+#include <functional>
+#include <type_traits>
+
+#include "danejoe/concurrent/sync/backoff.hpp"
+#include "danejoe/concurrent/lock_free/spsc_ring_queue.hpp"
+
+/**
+ * @namespace DaneJoe
+ * @brief DaneJoe命名空间
+ */
+namespace DaneJoe
+{
+    /**
+     * @namespace Concurrent
+     * @brief 并发命名空间
+     */
+    namespace Concurrent
+    {
+        /**
+         * @namespace Algorithm
+         * @brief 并行算法命名空间
+         */
+        namespace Algorithm
+        {
+            /**
+             * @enum StageMode
+             * @brief 流水线级的执行方式
+             */
+            enum class StageMode
+            {
+                /// @brief 单个工作线程按顺序处理
+                SerialInOrder,
+                /// @brief 多个工作线程并行处理，输出顺序仍与输入一致；令牌按序号轮流分配给各工作线程
+                Parallel,
+            };
+            /**
+             * @struct StageStats
+             * @brief 流水线级统计
+             */
+            struct StageStats
+            {
+                /// @brief 名称
+                std::string name;
+                /// @brief 执行方式
+                StageMode mode = StageMode::SerialInOrder;
+                /// @brief 工作线程数
+                std::size_t concurrency = 1;
+                /// @brief 已处理的令牌数
+                std::uint64_t item_count = 0;
+                /// @brief 各工作线程处理耗时之和
+                std::chrono::nanoseconds busy_time{ 0 };
+                /// @brief 各工作线程等待输入或令牌的耗时之和
+                std::chrono::nanoseconds idle_time{ 0 };
+                /**
+                 * @brief 获取利用率
+                 * @return double 忙时占比，无记录时为 0
+                 */
+                double get_utilization()const noexcept
+                {
+                    auto total = busy_time + idle_time;
+                    return total.count() == 0 ? 0.0 : static_cast<double>(busy_time.count()) / static_cast<double>(total.count());
+                }
+            };
+            class Pipeline;
+            class PipelineBuilder;
+            template<class T>
+            class PipelineChain;
+            /**
+             * @namespace Detail
+             * @brief 实现细节
+             */
+            namespace Detail
+            {
+                /// @brief 统计使用的时钟
+                using PipelineClock = std::chrono::steady_clock;
+                /**
+                 * @brief 一次运行的共享状态
+                 */
+                struct PipelineContext
+                {
+                    /// @brief 在途令牌上限
+                    std::size_t max_tokens = 0;
+                    /// @brief 在途令牌数
+                    std::atomic<std::size_t> in_flight_count = 0;
+                    /// @brief 是否因异常中止
+                    std::atomic<bool> is_aborted = false;
+                    /// @brief 保护首个异常
+                    std::mutex exception_mutex;
+                    /// @brief 首个异常
+                    std::exception_ptr exception;
+                    /// @brief 唤醒序号，有工作线程休眠时每次推入或归还令牌后递增
+                    std::atomic<std::uint32_t> wake_sequence = 0;
+                    /// @brief 休眠中的工作线程数
+                    std::atomic<std::uint32_t> sleeper_count = 0;
+                    /**
+                     * @brief 记录异常并中止所有工作线程
+                     * @param error 异常
+                     */
+                    void fail(std::exception_ptr error)
+                    {
+                        {
+                            std::lock_guard<std::mutex> lock(exception_mutex);
+                            if (!exception)
+                            {
+                                exception = std::move(error);
+                            }
+                        }
+                        is_aborted.store(true, std::memory_order_release);
+                        wake_sequence.fetch_add(1);
+                        wake_sequence.notify_all();
+                    }
+                    /**
+                     * @brief 推入或归还令牌后唤醒休眠的工作线程
+                     * @note 无休眠线程时只多一次内存屏障；有休眠线程时全部唤醒，各自重新检查等待条件
+                     */
+                    void notify()noexcept
+                    {
+                        // 与 park() 中的屏障配对：要么休眠方看到本次推入，要么这里看到休眠方
+                        std::atomic_thread_fence(std::memory_order_seq_cst);
+                        if (sleeper_count.load(std::memory_order_relaxed) > 0)
+                        {
+                            wake_sequence.fetch_add(1);
+                            wake_sequence.notify_all();
+                        }
+                    }
+                    /**
+                     * @brief 条件不成立时休眠到下一次唤醒
+                     * @note 可能虚假返回，调用方需重新检查条件
+                     * @tparam Predicate 条件类型
+                     * @param ready 条件
+                     */
+                    template<class Predicate>
+                    void park(Predicate& ready)
+                    {
+                        std::uint32_t sequence = wake_sequence.load();
+                        sleeper_count.fetch_add(1);
+                        std::atomic_thread_fence(std::memory_order_seq_cst);
+                        if (!ready() && !is_aborted.load(std::memory_order_acquire))
+                        {
+                            wake_sequence.wait(sequence);
+                        }
+                        sleeper_count.fetch_sub(1, std::memory_order_relaxed);
+                    }
+                };
+                /**
+                 * @brief 相邻两级之间的环形队列矩阵
+                 * @details 元素为空值表示该生产者已结束
+                 * @tparam T 令牌类型
+                 */
+                template<class T>
+                class PipelineLink
+                {
+                public:
+                    /// @brief 环形队列类型
+                    using Ring = LockFree::SpscRingQueue<std::optional<T>>;
+                    /**
+                     * @brief 构造函数
+                     * @param producer_count 生产者数
+                     * @param capacity 每个环形队列的容量
+                     */
+                    PipelineLink(std::size_t producer_count, std::size_t capacity) :
+                        m_producer_count(producer_count), m_capacity(capacity)
+                    {
+                    }
+                    /**
+                     * @brief 按消费者数分配环形队列
+                     * @param consumer_count 消费者数
+                     */
+                    void connect(std::size_t consumer_count)
+                    {
+                        m_consumer_count = consumer_count;
+                        m_rings.clear();
+                        for (std::size_t i = 0; i < m_producer_count * m_consumer_count; ++i)
+                        {
+                            m_rings.push_back(std::make_unique<Ring>(m_capacity));
+                        }
+                    }
+                    /**
+                     * @brief 获取环形队列
+                     * @param producer 生产者下标
+                     * @param consumer 消费者下标
+                     * @return Ring& 环形队列
+                     */
+                    Ring& get_ring(std::size_t producer, std::size_t consumer)noexcept
+                    {
+                        return *m_rings[producer * m_consumer_count + consumer];
+                    }
+                    /**
+                     * @brief 清空所有环形队列
+                     * @note 中止后的残留元素在下次运行前丢弃
+                     */
+                    void clear()
+                    {
+                        for (auto& ring : m_rings)
+                        {
+                            while (!ring->is_empty())
+                            {
+                                ring->pop();
+                            }
+                        }
+                    }
+                    /**
+                     * @brief 获取生产者数
+                     * @return std::size_t 生产者数
+                     */
+                    std::size_t get_producer_count()const noexcept
+                    {
+                        return m_producer_count;
+                    }
+                    /**
+                     * @brief 获取消费者数
+                     * @return std::size_t 消费者数
+                     */
+                    std::size_t get_consumer_count()const noexcept
+                    {
+                        return m_consumer_count;
+                    }
+                private:
+                    /// @brief 生产者数
+                    std::size_t m_producer_count;
+                    /// @brief 消费者数
+                    std::size_t m_consumer_count = 0;
+                    /// @brief 每个环形队列的容量
+                    std::size_t m_capacity;
+                    /// @brief 环形队列，按生产者为行排列
+                    std::vector<std::unique_ptr<Ring>> m_rings;
+                };
+                /**
+                 * @brief 流水线级基类
+                 */
+                class PipelineStageBase
+                {
+                public:
+                    /**
+                     * @brief 构造函数
+                     * @param name 名称
+                     * @param mode 执行方式
+                     * @param concurrency 工作线程数
+                     */
+                    PipelineStageBase(std::string name, StageMode mode, std::size_t concurrency) :
+                        m_name(std::move(name)), m_mode(mode), m_concurrency(concurrency)
+                    {
+                    }
+                    /**
+                     * @brief 析构函数
+                     */
+                    virtual ~PipelineStageBase() = default;
+                    /**
+                     * @brief 运行一个工作线程直到输入结束或中止
+                     * @param worker 工作线程下标
+                     * @param context 运行状态
+                     */
+                    virtual void run_worker(std::size_t worker, PipelineContext& context) = 0;
+                    /**
+                     * @brief 运行前丢弃输入队列中的残留元素
+                     */
+                    virtual void reset() = 0;
+                    /**
+                     * @brief 获取工作线程数
+                     * @return std::size_t 工作线程数
+                     */
+                    std::size_t get_concurrency()const noexcept
+                    {
+                        return m_concurrency;
+                    }
+                    /**
+                     * @brief 获取统计信息
+                     * @return StageStats 统计信息
+                     */
+                    StageStats get_stats()const
+                    {
+                        StageStats stats;
+                        stats.name = m_name;
+                        stats.mode = m_mode;
+                        stats.concurrency = m_concurrency;
+                        stats.item_count = m_item_count.load(std::memory_order_relaxed);
+                        stats.busy_time = std::chrono::nanoseconds(m_busy_nanoseconds.load(std::memory_order_relaxed));
+                        stats.idle_time = std::chrono::nanoseconds(m_idle_nanoseconds.load(std::memory_order_relaxed));
+                        return stats;
+                    }
+                protected:
+                    /**
+                     * @brief 等待条件成立，等待时长计入闲时
+                     * @details 先按 Backoff 有界自旋，自旋阶段结束后在 context 上休眠
+                     * @tparam Predicate 条件类型
+                     * @param ready 条件
+                     * @param context 运行状态
+                     * @return bool 条件是否成立，中止时返回 false
+                     */
+                    template<class Predicate>
+                    bool wait(Predicate&& ready, PipelineContext& context)
+                    {
+                        if (context.is_aborted.load(std::memory_order_relaxed))
+                        {
+                            return false;
+                        }
+                        if (ready())
+                        {
+                            return true;
+                        }
+                        auto start_time = PipelineClock::now();
+                        Sync::Backoff backoff;
+                        bool is_ready = true;
+                        while (!ready())
+                        {
+                            if (context.is_aborted.load(std::memory_order_acquire))
+                            {
+                                is_ready = false;
+                                break;
+                            }
+                            if (backoff.is_exhausted())
+                            {
+                                context.park(ready);
+                            }
+                            else
+                            {
+                                backoff.pause();
+                            }
+                        }
+                        add_time(m_idle_nanoseconds, start_time);
+                        return is_ready;
+                    }
+                    /**
+                     * @brief 执行处理函数，耗时计入忙时
+                     * @tparam F 处理函数类型
+                     * @param function 处理函数
+                     * @return 处理函数的返回值
+                     */
+                    template<class F>
+                    decltype(auto) measure(F&& function)
+                    {
+                        struct Recorder
+                        {
+                            std::atomic<std::int64_t>& total;
+                            PipelineClock::time_point start_time;
+                            ~Recorder()
+                            {
+                                add_time(total, start_time);
+                            }
+                        } recorder{ m_busy_nanoseconds, PipelineClock::now() };
+                        return function();
+                    }
+                    /**
+                     * @brief 计入一个已处理的令牌
+                     */
+                    void add_item()noexcept
+                    {
+                        m_item_count.fetch_add(1, std::memory_order_relaxed);
+                    }
+                private:
+                    /**
+                     * @brief 累加自 start_time 起的耗时
+                     * @param total 累计值
+                     * @param start_time 起始时间
+                     */
+                    static void add_time(std::atomic<std::int64_t>& total, PipelineClock::time_point start_time)noexcept
+                    {
+                        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(PipelineClock::now() - start_time);
+                        total.fetch_add(elapsed.count(), std::memory_order_relaxed);
+                    }
+                private:
+                    /// @brief 名称
+                    std::string m_name;
+                    /// @brief 执行方式
+                    StageMode m_mode;
+                    /// @brief 工作线程数
+                    std::size_t m_concurrency;
+                    /// @brief 已处理的令牌数
+                    std::atomic<std::uint64_t> m_item_count = 0;
+                    /// @brief 忙时（纳秒）
+                    std::atomic<std::int64_t> m_busy_nanoseconds = 0;
+                    /// @brief 闲时（纳秒）
+                    std::atomic<std::int64_t> m_idle_nanoseconds = 0;
+                };
+                /**
+                 * @brief 流水线级
+                 * @details In 为 void 时是源，Out 为 void 时是汇
+                 * @tparam In 输入类型
+                 * @tparam Out 输出类型
+                 * @tparam F 处理函数类型
+                 */
+                template<class In, class Out, class F>
+                class PipelineStage : public PipelineStageBase
+                {
+                public:
+                    /**
+                     * @brief 构造函数
+                     * @param name 名称
+                     * @param mode 执行方式
+                     * @param concurrency 工作线程数
+                     * @param function 处理函数
+                     * @param input 输入连接，源为空
+                     * @param output 输出连接，汇为空
+                     */
+                    PipelineStage(std::string name, StageMode mode, std::size_t concurrency, F function,
+                        std::shared_ptr<PipelineLink<In>> input, std::shared_ptr<PipelineLink<Out>> output) :
+                        PipelineStageBase(std::move(name), mode, concurrency),
+                        m_function(std::move(function)), m_input(std::move(input)), m_output(std::move(output))
+                    {
+                    }
+                    /**
+                     * @brief 运行一个工作线程直到输入结束或中止
+                     * @param worker 工作线程下标
+                     * @param context 运行状态
+                     */
+                    void run_worker(std::size_t worker, PipelineContext& context)override
+                    {
+                        if constexpr (std::is_void_v<In>)
+                        {
+                            run_source(context);
+                        }
+                        else
+                        {
+                            std::size_t sequence = worker;
+                            while (true)
+                            {
+                                std::optional<In> value = receive(worker, sequence, context);
+                                if (!value)
+                                {
+                                    break;
+                                }
+                                if constexpr (std::is_void_v<Out>)
+                                {
+                                    measure([this, &value]() { std::invoke(m_function, std::move(*value)); });
+                                    add_item();
+                                    context.in_flight_count.fetch_sub(1, std::memory_order_release);
+                                    context.notify();
+                                }
+                                else
+                                {
+                                    send(worker, sequence, measure([this, &value]() -> Out { return std::invoke(m_function, std::move(*value)); }), context);
+                                    add_item();
+                                }
+                                sequence += get_concurrency();
+                            }
+                            if (context.is_aborted.load(std::memory_order_acquire))
+                            {
+                                return;
+                            }
+                            if constexpr (!std::is_void_v<Out>)
+                            {
+                                send_end(worker, context);
+                            }
+                        }
+                    }
+                    /**
+                     * @brief 运行前丢弃输入队列中的残留元素
+                     */
+                    void reset()override
+                    {
+                        if constexpr (!std::is_void_v<In>)
+                        {
+                            m_input->clear();
+                        }
+                    }
+                private:
+                    /**
+                     * @brief 源的工作循环
+                     * @param context 运行状态
+                     */
+                    void run_source(PipelineContext& context)
+                    {
+                        std::size_t sequence = 0;
+                        while (true)
+                        {
+                            bool has_token = wait([&context]()
+                                {
+                                    return context.in_flight_count.load(std::memory_order_acquire) < context.max_tokens;
+                                }, context);
+                            if (!has_token)
+                            {
+                                return;
+                            }
+                            std::optional<Out> value = measure([this]() -> std::optional<Out> { return std::invoke(m_function); });
+                            if (!value)
+                            {
+                                break;
+                            }
+                            add_item();
+                            context.in_flight_count.fetch_add(1, std::memory_order_relaxed);
+                            send(0, sequence, std::move(*value), context);
+                            ++sequence;
+                        }
+                        send_end(0, context);
+                    }
+                    /**
+                     * @brief 接收下一个令牌
+                     * @details 收到结束标记后再取走其余生产者的结束标记，使队列在运行结束时为空
+                     * @tparam U 输入类型
+                     * @param worker 工作线程下标
+                     * @param sequence 期望的令牌序号
+                     * @param context 运行状态
+                     * @return std::optional<U> 令牌，输入结束或中止时为空
+                     */
+                    template<class U = In>
+                    std::optional<U> receive(std::size_t worker, std::size_t sequence, PipelineContext& context)
+                    {
+                        std::size_t producer_count = m_input->get_producer_count();
+                        std::size_t producer = sequence % producer_count;
+                        auto& ring = m_input->get_ring(producer, worker);
+                        if (!wait([&ring]() { return !ring.is_empty(); }, context))
+                        {
+                            return std::nullopt;
+                        }
+                        std::optional<U> value = std::move(*ring.pop());
+                        if (value)
+                        {
+                            return value;
+                        }
+                        for (std::size_t other = 0; other < producer_count; ++other)
+                        {
+                            if (other == producer)
+                            {
+                                continue;
+                            }
+                            auto& other_ring = m_input->get_ring(other, worker);
+                            if (!wait([&other_ring]() { return !other_ring.is_empty(); }, context))
+                            {
+                                break;
+                            }
+                            other_ring.pop();
+                        }
+                        return std::nullopt;
+                    }
+                    /**
+                     * @brief 把令牌交给下一级
+                     * @tparam U 输出类型
+                     * @param worker 工作线程下标
+                     * @param sequence 令牌序号
+                     * @param value 令牌
+                     * @param context 运行状态
+                     */
+                    template<class U = Out>
+                    void send(std::size_t worker, std::size_t sequence, U value, PipelineContext& context)
+                    {
+                        std::size_t consumer = sequence % m_output->get_consumer_count();
+                        m_output->get_ring(worker, consumer).push(std::optional<U>(std::move(value)));
+                        context.notify();
+                    }
+                    /**
+                     * @brief 向下一级的每个工作线程发送结束标记
+                     * @param worker 工作线程下标
+                     * @param context 运行状态
+                     */
+                    void send_end(std::size_t worker, PipelineContext& context)
+                    {
+                        for (std::size_t consumer = 0; consumer < m_output->get_consumer_count(); ++consumer)
+                        {
+                            m_output->get_ring(worker, consumer).push(std::optional<Out>());
+                        }
+                        context.notify();
+                    }
+                private:
+                    /// @brief 处理函数
+                    F m_function;
+                    /// @brief 输入连接
+                    std::shared_ptr<PipelineLink<In>> m_input;
+                    /// @brief 输出连接
+                    std::shared_ptr<PipelineLink<Out>> m_output;
+                };
+                /**
+                 * @brief 按执行方式确定工作线程数
+                 * @param mode 执行方式
+                 * @param concurrency 期望的工作线程数，为0时取硬件并发数
+                 * @return std::size_t 工作线程数
+                 */
+                inline std::size_t get_stage_concurrency(StageMode mode, std::size_t concurrency)noexcept
+                {
+                    if (mode == StageMode::SerialInOrder)
+                    {
+                        return 1;
+                    }
+                    if (concurrency == 0)
+                    {
+                        concurrency = std::thread::hardware_concurrency();
+                    }
+                    return concurrency == 0 ? 1 : concurrency;
+                }
+            }
+            /**
+             * @class Pipeline
+             * @brief 已组装的流水线
+             * @details 由 PipelineBuilder 构建。run() 为每级的每个工作线程创建线程，源返回空值且所有令牌流出汇后返回
+             */
+            class Pipeline
+            {
+            public:
+                /**
+                 * @brief 运行直到源结束
+                 * @note 任一级抛出异常时中止所有工作线程，在全部线程结束后重新抛出首个异常
+                 */
+                void run()
+                {
+                    m_context->in_flight_count.store(0, std::memory_order_relaxed);
+                    m_context->is_aborted.store(false, std::memory_order_relaxed);
+                    m_context->exception = nullptr;
+                    for (auto& stage : m_stages)
+                    {
+                        stage->reset();
+                    }
+                    std::vector<std::thread> threads;
+                    for (auto& stage : m_stages)
+                    {
+                        for (std::size_t worker = 0; worker < stage->get_concurrency(); ++worker)
+                        {
+                            Detail::PipelineStageBase* stage_pointer = stage.get();
+                            Detail::PipelineContext* context = m_context.get();
+                            threads.emplace_back([stage_pointer, worker, context]()
+                                {
+                                    try
+                                    {
+                                        stage_pointer->run_worker(worker, *context);
+                                    }
+                                    catch (...)
+                                    {
+                                        context->fail(std::current_exception());
+                                    }
+                                });
+                        }
+                    }
+                    for (auto& thread : threads)
+                    {
+                        thread.join();
+                    }
+                    if (m_context->exception)
+                    {
+                        std::rethrow_exception(m_context->exception);
+                    }
+                }
+                /**
+                 * @brief 获取各级统计信息
+                 * @details 统计在多次 run() 之间累计
+                 * @return std::vector<StageStats> 按级顺序排列的统计信息
+                 */
+                std::vector<StageStats> get_stats()const
+                {
+                    std::vector<StageStats> stats;
+                    stats.reserve(m_stages.size());
+                    for (const auto& stage : m_stages)
+                    {
+                        stats.push_back(stage->get_stats());
+                    }
+                    return stats;
+                }
+                /**
+                 * @brief 获取在途令牌上限
+                 * @return std::size_t 在途令牌上限
+                 */
+                std::size_t get_max_tokens()const noexcept
+                {
+                    return m_context->max_tokens;
+                }
+                /**
+                 * @brief 获取级数
+                 * @return std::size_t 级数（含源与汇）
+                 */
+                std::size_t get_stage_count()const noexcept
+                {
+                    return m_stages.size();
+                }
+            private:
+                friend class PipelineBuilder;
+                template<class T>
+                friend class PipelineChain;
+                /**
+                 * @brief 构造函数
+                 * @param max_tokens 在途令牌上限
+                 */
+                explicit Pipeline(std::size_t max_tokens) :
+                    m_context(std::make_unique<Detail::PipelineContext>())
+                {
+                    m_context->max_tokens = max_tokens;
+                }
+            private:
+                /// @brief 各级
+                std::vector<std::unique_ptr<Detail::PipelineStageBase>> m_stages;
+                /// @brief 运行状态
+                std::unique_ptr<Detail::PipelineContext> m_context;
+            };
+            /**
+             * @class PipelineChain
+             * @brief 组装中的流水线，当前末级输出 T
+             * @tparam T 当前末级的输出类型
+             */
+            template<class T>
+            class PipelineChain
+            {
+            public:
+                /**
+                 * @brief 追加中间级
+                 * @tparam F 处理函数类型，签名为 U(T)
+                 * @param name 名称
+                 * @param mode 执行方式
+                 * @param function 处理函数，并行级会被多个线程同时调用
+                 * @param concurrency 并行级的工作线程数，为0时取硬件并发数；串行级忽略
+                 * @return PipelineChain<U> 末级输出 U 的流水线
+                 */
+                template<class F>
+                auto add_stage(std::string name, StageMode mode, F function, std::size_t concurrency = 0) &&
+                {
+                    using Out = std::invoke_result_t<F&, T>;
+                    static_assert(!std::is_void_v<Out>, "use add_sink for a stage without output");
+                    std::size_t stage_concurrency = Detail::get_stage_concurrency(mode, concurrency);
+                    m_link->connect(stage_concurrency);
+                    auto output = std::make_shared<Detail::PipelineLink<Out>>(stage_concurrency, get_ring_capacity());
+                    m_pipeline.m_stages.push_back(std::make_unique<Detail::PipelineStage<T, Out, F>>(
+                        std::move(name), mode, stage_concurrency, std::move(function), std::move(m_link), output));
+                    return PipelineChain<Out>(std::move(m_pipeline), std::move(output));
+                }
+                /**
+                 * @brief 追加汇并完成组装
+                 * @tparam F 处理函数类型，签名为 void(T)
+                 * @param name 名称
+                 * @param mode 执行方式
+                 * @param function 处理函数
+                 * @param concurrency 并行级的工作线程数，为0时取硬件并发数；串行级忽略
+                 * @return Pipeline 流水线
+                 */
+                template<class F>
+                Pipeline add_sink(std::string name, StageMode mode, F function, std::size_t concurrency = 0) &&
+                {
+                    std::size_t stage_concurrency = Detail::get_stage_concurrency(mode, concurrency);
+                    m_link->connect(stage_concurrency);
+                    m_pipeline.m_stages.push_back(std::make_unique<Detail::PipelineStage<T, void, F>>(
+                        std::move(name), mode, stage_concurrency, std::move(function), std::move(m_link), nullptr));
+                    return std::move(m_pipeline);
+                }
+            private:
+                friend class PipelineBuilder;
+                template<class U>
+                friend class PipelineChain;
+                /**
+                 * @brief 构造函数
+                 * @param pipeline 组装中的流水线
+                 * @param link 末级的输出连接
+                 */
+                PipelineChain(Pipeline pipeline, std::shared_ptr<Detail::PipelineLink<T>> link) :
+                    m_pipeline(std::move(pipeline)), m_link(std::move(link))
+                {
+                }
+                /**
+                 * @brief 获取环形队列容量
+                 * @return std::size_t 在途令牌上限加结束标记
+                 */
+                std::size_t get_ring_capacity()const noexcept
+                {
+                    return m_pipeline.get_max_tokens() + 1;
+                }
+            private:
+                /// @brief 组装中的流水线
+                Pipeline m_pipeline;
+                /// @brief 末级的输出连接
+                std::shared_ptr<Detail::PipelineLink<T>> m_link;
+            };
+            /**
+             * @class PipelineBuilder
+             * @brief 流水线构建器
+             * @details 用法：PipelineBuilder(max_tokens).add_source(...).add_stage(...).add_sink(...) 得到 Pipeline
+             */
+            class PipelineBuilder
+            {
+            public:
+                /**
+                 * @brief 构造函数
+                 * @param max_tokens 在途令牌上限，决定内存占用上限
+                 * @throws std::invalid_argument max_tokens 为0
+                 */
+                explicit PipelineBuilder(std::size_t max_tokens) :
+                    m_max_tokens(max_tokens)
+                {
+                    if (max_tokens == 0)
+                    {
+                        throw std::invalid_argument("max_tokens must be positive");
+                    }
+                }
+                /**
+                 * @brief 添加源
+                 * @details 源总是串行执行，只在持有令牌时调用
+                 * @tparam F 源函数类型，签名为 std::optional<T>()，返回空值表示结束
+                 * @param name 名称
+                 * @param source 源函数
+                 * @return PipelineChain<T> 末级输出 T 的流水线
+                 */
+                template<class F>
+                auto add_source(std::string name, F source)const
+                {
+                    using Out = typename std::invoke_result_t<F&>::value_type;
+                    Pipeline pipeline(m_max_tokens);
+                    auto output = std::make_shared<Detail::PipelineLink<Out>>(1, m_max_tokens + 1);
+                    pipeline.m_stages.push_back(std::make_unique<Detail::PipelineStage<void, Out, F>>(
+                        std::move(name), StageMode::SerialInOrder, 1, std::move(source), nullptr, output));
+                    return PipelineChain<Out>(std::move(pipeline), std::move(output));
+                }
+            private:
+                /// @brief 在途令牌上限
+                std::size_t m_max_tokens;
+            };
+        }
+    }
+}
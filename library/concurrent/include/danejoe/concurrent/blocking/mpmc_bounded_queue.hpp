@@ -14,11 +14,15 @@
 #include <chrono>
 #include <vector>
 #include <thread>
+#include <algorithm>
 #include <optional>
 #include <iterator>
 #include <stdexcept>
 #include <condition_variable>
 
+#include "danejoe/concurrent/cancellation/cancellation_token.hpp"
+#include "danejoe/concurrent/blocking/select_notifier.hpp"
+
 /**
  * @namespace DaneJoe
  */
@@ -186,6 +190,78 @@ namespace DaneJoe
                     m_full_cv.notify_one();
                     return item;
                 }
+                /**
+                 * @brief 可取消地弹出队首元素
+                 * @note 令牌带截止时间时最多等待到截止时间
+                 * @param token 取消令牌
+                 * @return std::optional<T> 弹出的元素，若已取消、超时或队列已关闭且为空则返回std::nullopt
+                 */
+                std::optional<T> pop(const Cancellation::CancellationToken& token)
+                {
+                    Cancellation::CancellationCallback callback(token, [this]()
+                        {
+                            wake_all();
+                        });
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    auto is_ready = [this, &token]()
+                        {
+                            return !m_queue.empty() || !m_is_running || token.is_cancellation_requested();
+                        };
+                    if (token.has_deadline())
+                    {
+                        m_empty_cv.wait_until(lock, token.get_deadline(), is_ready);
+                    }
+                    else
+                    {
+                        m_empty_cv.wait(lock, is_ready);
+                    }
+                    if (m_queue.empty() || token.is_cancellation_requested())
+                    {
+                        return std::nullopt;
+                    }
+                    T item = std::move(m_queue.front());
+                    m_queue.pop();
+                    lock.unlock();
+                    m_full_cv.notify_one();
+                    return item;
+                }
+                /**
+                 * @brief 可取消地添加元素到队列
+                 * @note 令牌带截止时间时最多等待到截止时间
+                 * @param item 元素
+                 * @param token 取消令牌
+                 * @return bool 是否成功添加，若已取消、超时或队列已关闭则返回false
+                 */
+                bool push(T item, const Cancellation::CancellationToken& token)
+                {
+                    Cancellation::CancellationCallback callback(token, [this]()
+                        {
+                            wake_all();
+                        });
+                    {
+                        std::unique_lock<std::mutex> lock(m_mutex);
+                        auto is_ready = [this, &token]()
+                            {
+                                return m_queue.size() < m_max_size || !m_is_running || token.is_cancellation_requested();
+                            };
+                        if (token.has_deadline())
+                        {
+                            m_full_cv.wait_until(lock, token.get_deadline(), is_ready);
+                        }
+                        else
+                        {
+                            m_full_cv.wait(lock, is_ready);
+                        }
+                        if (!m_is_running || token.is_cancellation_requested() || m_queue.size() >= m_max_size)
+                        {
+                            return false;
+                        }
+                        m_queue.push(std::move(item));
+                        notify_selectors_locked();
+                    }
+                    m_empty_cv.notify_one();
+                    return true;
+                }
                 /**
                  * @brief 判断队列是否为空
                  * @return bool 队列是否为空
@@ -262,6 +338,7 @@ namespace DaneJoe
                                 return false;
                             }
                             m_queue.push(std::move(item));
+                            notify_selectors_locked();
                             is_pushed = true;
                         }
                     }
@@ -307,6 +384,7 @@ namespace DaneJoe
                                 ++begin;
                             }
                             nums -= to_insert;
+                            notify_selectors_locked();
                             is_pushed = true;
                         }
                         if (is_pushed)
@@ -360,6 +438,7 @@ namespace DaneJoe
                     {
                         std::lock_guard<std::mutex> lock(m_mutex);
                         m_is_running = false;
+                        notify_selectors_locked();
                     }
                     m_empty_cv.notify_all();
                     m_full_cv.notify_all();
@@ -386,6 +465,26 @@ namespace DaneJoe
                 {
                     return m_max_size;
                 }
+                /**
+                 * @brief 登记多队列等待的通知对象
+                 * @details 入队与关闭时通知该对象，供 QueueSelector 同时等待多个队列
+                 * @note 通知对象须在移除前保持有效
+                 * @param notifier 通知对象
+                 */
+                void add_notifier(SelectNotifier* notifier)
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_notifiers.push_back(notifier);
+                }
+                /**
+                 * @brief 移除多队列等待的通知对象
+                 * @param notifier 通知对象
+                 */
+                void remove_notifier(SelectNotifier* notifier)
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_notifiers.erase(std::remove(m_notifiers.begin(), m_notifiers.end(), notifier), m_notifiers.end());
+                }
             private:
                 /**
                  * @brief 拷贝构造函数
@@ -397,6 +496,27 @@ namespace DaneJoe
                  * @note 禁止拷贝赋值
                  */
                 MpmcBoundedQueue& operator=(const MpmcBoundedQueue&) = delete;
+                /**
+                 * @brief 通知登记的多队列等待者（需持有锁）
+                 */
+                void notify_selectors_locked()
+                {
+                    for (SelectNotifier* notifier : m_notifiers)
+                    {
+                        notifier->notify();
+                    }
+                }
+                /**
+                 * @brief 唤醒全部等待者，供取消回调使用
+                 */
+                void wake_all()
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(m_mutex);
+                    }
+                    m_empty_cv.notify_all();
+                    m_full_cv.notify_all();
+                }
             private:
                 /// @brief 队列最大容量
                 std::size_t m_max_size = 0;
@@ -410,6 +530,8 @@ namespace DaneJoe
                 std::queue<T> m_queue;
                 /// @brief 是否正在运行
                 bool m_is_running = true;
+                /// @brief 多队列等待的通知对象
+                std::vector<SelectNotifier*> m_notifiers;
             };
         }
     }
@@ -0,0 +1,397 @@
+#pragma once
+
+/**
+ * @file queue_selector.hpp
+ * @author DaneJoe001
+ * @version 0.1.1
+ * @brief 同时等待多个有界阻塞队列
+ * @details 各队列入队或关闭时通知同一个 SelectNotifier，等待方只在一个条件变量上阻塞，不再轮询各队列的 pop_for。
+ *          QueueSelector 长期登记队列及其处理函数，按优先级从高到低取元素，同优先级之间轮转以免饥饿；
+ *          wait_any() 临时登记若干队列，返回第一个有数据的队列下标，由调用方自行出队
+ * @date 2026-10-18
+ */
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include <optional>
+#include <algorithm>
+
+#include "danejoe/concurrent/blocking/select_notifier.hpp"
+#include "danejoe/concurrent/blocking/mpmc_bounded_queue.hpp"
+#include "danejoe/concurrent/cancellation/cancellation_token.hpp"
+
+/**
+ * @namespace DaneJoe
+ * @brief DaneJoe命名空间
+ */
+namespace DaneJoe
+{
+    /**
+     * @namespace Concurrent
+     * @brief 并发命名空间
+     */
+    namespace Concurrent
+    {
+        /**
+         * @namespace Blocking
+         * @brief 阻塞命名空间
+         */
+        namespace Blocking
+        {
+            /**
+             * @namespace Detail
+             * @brief 实现细节
+             */
+            namespace Detail
+            {
+                /**
+                 * @brief 选择器中登记的队列
+                 */
+                class SelectSource
+                {
+                public:
+                    /**
+                     * @brief 构造函数
+                     * @param index 登记下标
+                     * @param priority 优先级
+                     */
+                    SelectSource(std::size_t index, int priority) :m_index(index), m_priority(priority) {}
+                    /**
+                     * @brief 析构函数
+                     */
+                    virtual ~SelectSource() = default;
+                    /**
+                     * @brief 尝试取出一个元素并交给处理函数
+                     * @return bool 是否取到元素
+                     */
+                    virtual bool try_dispatch() = 0;
+                    /**
+                     * @brief 判断队列是否已关闭且为空
+                     * @return bool 是否不会再有元素
+                     */
+                    virtual bool is_finished()const = 0;
+                    /**
+                     * @brief 从队列上移除通知对象
+                     * @param notifier 通知对象
+                     */
+                    virtual void detach(SelectNotifier* notifier) = 0;
+                    /**
+                     * @brief 获取登记下标
+                     * @return std::size_t 登记下标
+                     */
+                    std::size_t get_index()const noexcept
+                    {
+                        return m_index;
+                    }
+                    /**
+                     * @brief 获取优先级
+                     * @return int 优先级
+                     */
+                    int get_priority()const noexcept
+                    {
+                        return m_priority;
+                    }
+                private:
+                    /// @brief 登记下标
+                    std::size_t m_index;
+                    /// @brief 优先级
+                    int m_priority;
+                };
+                /**
+                 * @brief 带处理函数的队列
+                 * @tparam T 元素类型
+                 * @tparam F 处理函数类型
+                 */
+                template<class T, class F>
+                class QueueSource : public SelectSource
+                {
+                public:
+                    /**
+                     * @brief 构造函数
+                     * @param index 登记下标
+                     * @param priority 优先级
+                     * @param queue 队列
+                     * @param handler 处理函数
+                     */
+                    QueueSource(std::size_t index, int priority, MpmcBoundedQueue<T>& queue, F handler) :
+                        SelectSource(index, priority), m_queue(queue), m_handler(std::move(handler))
+                    {
+                    }
+                    /**
+                     * @brief 尝试取出一个元素并交给处理函数
+                     * @return bool 是否取到元素
+                     */
+                    bool try_dispatch()override
+                    {
+                        std::optional<T> item = m_queue.try_pop();
+                        if (!item)
+                        {
+                            return false;
+                        }
+                        m_handler(std::move(*item));
+                        return true;
+                    }
+                    /**
+                     * @brief 判断队列是否已关闭且为空
+                     * @return bool 是否不会再有元素
+                     */
+                    bool is_finished()const override
+                    {
+                        return !m_queue.is_running() && m_queue.empty();
+                    }
+                    /**
+                     * @brief 从队列上移除通知对象
+                     * @param notifier 通知对象
+                     */
+                    void detach(SelectNotifier* notifier)override
+                    {
+                        m_queue.remove_notifier(notifier);
+                    }
+                private:
+                    /// @brief 队列
+                    MpmcBoundedQueue<T>& m_queue;
+                    /// @brief 处理函数
+                    F m_handler;
+                };
+            }
+            /**
+             * @class QueueSelector
+             * @brief 多队列选择器
+             * @details 每次 select() 从优先级最高且有数据的队列取出一个元素，在调用线程上交给其处理函数
+             * @note 队列须比选择器存活更久；登记须在开始选择前完成
+             */
+            class QueueSelector
+            {
+            public:
+                /// @brief 超时使用的时钟
+                using Clock = SelectNotifier::Clock;
+                /**
+                 * @brief 构造函数
+                 */
+                QueueSelector() = default;
+                /**
+                 * @brief 析构函数
+                 */
+                ~QueueSelector()
+                {
+                    for (auto& source : m_sources)
+                    {
+                        source->detach(&m_notifier);
+                    }
+                }
+                /**
+                 * @brief 登记队列
+                 * @tparam T 元素类型
+                 * @tparam F 处理函数类型，签名为 void(T)
+                 * @param queue 队列
+                 * @param handler 处理函数
+                 * @param priority 优先级，数值大者优先；相同优先级之间轮转
+                 * @return std::size_t 登记下标，select() 以此指明取自哪个队列
+                 */
+                template<class T, class F>
+                std::size_t add(MpmcBoundedQueue<T>& queue, F handler, int priority = 0)
+                {
+                    std::size_t index = m_source_count++;
+                    auto source = std::make_unique<Detail::QueueSource<T, F>>(index, priority, queue, std::move(handler));
+                    auto position = std::find_if(m_sources.begin(), m_sources.end(), [priority](const auto& other)
+                        {
+                            return other->get_priority() < priority;
+                        });
+                    m_sources.insert(position, std::move(source));
+                    queue.add_notifier(&m_notifier);
+                    return index;
+                }
+                /**
+                 * @brief 取出并处理一个元素，无数据时阻塞
+                 * @return std::optional<std::size_t> 元素所在队列的登记下标，全部队列已关闭且为空时返回std::nullopt
+                 */
+                std::optional<std::size_t> select()
+                {
+                    return select_until(Clock::time_point::max(), nullptr);
+                }
+                /**
+                 * @brief 取出并处理一个元素，最多等待 timeout
+                 * @tparam Rep 时长计数类型
+                 * @tparam Period 时长单位
+                 * @param timeout 超时时长
+                 * @return std::optional<std::size_t> 元素所在队列的登记下标，超时或全部队列已关闭且为空时返回std::nullopt
+                 */
+                template<class Rep, class Period>
+                std::optional<std::size_t> select_for(const std::chrono::duration<Rep, Period>& timeout)
+                {
+                    return select_until(Clock::now() + timeout, nullptr);
+                }
+                /**
+                 * @brief 可取消地取出并处理一个元素
+                 * @note 令牌带截止时间时最多等待到截止时间
+                 * @param token 取消令牌
+                 * @return std::optional<std::size_t> 元素所在队列的登记下标，已取消、超时或全部队列已关闭且为空时返回std::nullopt
+                 */
+                std::optional<std::size_t> select(const Cancellation::CancellationToken& token)
+                {
+                    Cancellation::CancellationCallback callback(token, [this]()
+                        {
+                            m_notifier.notify();
+                        });
+                    return select_until(token.get_deadline(), &token);
+                }
+                /**
+                 * @brief 不等待地取出并处理一个元素
+                 * @return std::optional<std::size_t> 元素所在队列的登记下标，均无数据时返回std::nullopt
+                 */
+                std::optional<std::size_t> try_select()
+                {
+                    bool is_all_finished = true;
+                    return try_select_once(is_all_finished);
+                }
+                /**
+                 * @brief 获取登记的队列数
+                 * @return std::size_t 队列数
+                 */
+                std::size_t get_source_count()const noexcept
+                {
+                    return m_sources.size();
+                }
+            private:
+                /**
+                 * @brief 拷贝构造函数
+                 * @note 禁止拷贝构造
+                 */
+                QueueSelector(const QueueSelector&) = delete;
+                /**
+                 * @brief 拷贝赋值运算符
+                 * @note 禁止拷贝赋值
+                 */
+                QueueSelector& operator=(const QueueSelector&) = delete;
+                /**
+                 * @brief 按优先级扫描一遍
+                 * @param is_all_finished 输出全部队列是否已关闭且为空
+                 * @return std::optional<std::size_t> 取到元素的队列登记下标
+                 */
+                std::optional<std::size_t> try_select_once(bool& is_all_finished)
+                {
+                    is_all_finished = true;
+                    std::size_t rotation = m_rotation.load(std::memory_order_relaxed);
+                    std::size_t group_begin = 0;
+                    while (group_begin < m_sources.size())
+                    {
+                        std::size_t group_end = group_begin + 1;
+                        while (group_end < m_sources.size() && m_sources[group_end]->get_priority() == m_sources[group_begin]->get_priority())
+                        {
+                            ++group_end;
+                        }
+                        std::size_t group_size = group_end - group_begin;
+                        for (std::size_t i = 0; i < group_size; ++i)
+                        {
+                            auto& source = m_sources[group_begin + (rotation + i) % group_size];
+                            if (source->try_dispatch())
+                            {
+                                m_rotation.fetch_add(1, std::memory_order_relaxed);
+                                is_all_finished = false;
+                                return source->get_index();
+                            }
+                            if (!source->is_finished())
+                            {
+                                is_all_finished = false;
+                            }
+                        }
+                        group_begin = group_end;
+                    }
+                    return std::nullopt;
+                }
+                /**
+                 * @brief 等待直到取到元素、全部队列结束、取消或超时
+                 * @param deadline 截止时间
+                 * @param token 取消令牌，可为空
+                 * @return std::optional<std::size_t> 取到元素的队列登记下标
+                 */
+                std::optional<std::size_t> select_until(Clock::time_point deadline, const Cancellation::CancellationToken* token)
+                {
+                    while (true)
+                    {
+                        std::uint64_t epoch = m_notifier.get_epoch();
+                        bool is_all_finished = true;
+                        std::optional<std::size_t> index = try_select_once(is_all_finished);
+                        if (index || is_all_finished)
+                        {
+                            return index;
+                        }
+                        if (token && token->is_cancellation_requested())
+                        {
+                            return std::nullopt;
+                        }
+                        if (!m_notifier.wait_until(epoch, deadline))
+                        {
+                            return try_select();
+                        }
+                    }
+                }
+            private:
+                /// @brief 通知对象
+                SelectNotifier m_notifier;
+                /// @brief 登记的队列，按优先级从高到低排列
+                std::vector<std::unique_ptr<Detail::SelectSource>> m_sources;
+                /// @brief 已登记的队列数
+                std::size_t m_source_count = 0;
+                /// @brief 同优先级轮转起点
+                std::atomic<std::size_t> m_rotation = 0;
+            };
+            /**
+             * @brief 等待若干队列中任意一个有数据，最多等到 deadline
+             * @details 临时在各队列上登记通知对象；不出队，返回后其他消费者仍可能先取走元素
+             * @tparam Queues 队列类型
+             * @param deadline 截止时间
+             * @param queues 队列，靠前者优先
+             * @return std::optional<std::size_t> 第一个有数据的队列在参数中的下标，超时或全部队列已关闭且为空时返回std::nullopt
+             */
+            template<class... Queues>
+            std::optional<std::size_t> wait_any_until(SelectNotifier::Clock::time_point deadline, Queues&... queues)
+            {
+                SelectNotifier notifier;
+                (queues.add_notifier(&notifier), ...);
+                std::optional<std::size_t> result;
+                while (true)
+                {
+                    std::uint64_t epoch = notifier.get_epoch();
+                    std::size_t index = 0;
+                    bool is_all_finished = true;
+                    auto check = [&result, &index, &is_all_finished](auto& queue)
+                        {
+                            // 先读关闭状态：关闭后不再入队，此后为空即不会再有数据
+                            bool is_closed = !queue.is_running();
+                            if (!queue.empty())
+                            {
+                                result = index;
+                                return true;
+                            }
+                            is_all_finished = is_all_finished && is_closed;
+                            ++index;
+                            return false;
+                        };
+                    bool is_found = (check(queues) || ...);
+                    if (is_found || is_all_finished || !notifier.wait_until(epoch, deadline))
+                    {
+                        break;
+                    }
+                }
+                (queues.remove_notifier(&notifier), ...);
+                return result;
+            }
+            /**
+             * @brief 等待若干队列中任意一个有数据
+             * @tparam Queues 队列类型
+             * @param queues 队列，靠前者优先
+             * @return std::optional<std::size_t> 第一个有数据的队列在参数中的下标，全部队列已关闭且为空时返回std::nullopt
+             */
+            template<class... Queues>
+            std::optional<std::size_t> wait_any(Queues&... queues)
+            {
+                return wait_any_until(SelectNotifier::Clock::time_point::max(), queues...);
+            }
+        }
+    }
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+/**
+ * @file select_notifier.hpp
+ * @author DaneJoe001
+ * @version 0.1.1
+ * @brief 多队列等待的共享通知对象
+ * @details 队列在入队或关闭时递增纪元号，等待方先记下纪元号、再检查各队列，无数据时等待纪元号变化，
+ *          因此不会丢失检查与等待之间发生的通知。没有等待者时 notify() 只做一次原子加法
+ * @date 2026-10-18
+ */
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <condition_variable>
+
+/**
+ * @namespace DaneJoe
+ * @brief DaneJoe命名空间
+ */
+namespace DaneJoe
+{
+    /**
+     * @namespace Concurrent
+     * @brief 并发命名空间
+     */
+    namespace Concurrent
+    {
+        /**
+         * @namespace Blocking
+         * @brief 阻塞命名空间
+         */
+        namespace Blocking
+        {
+            /**
+             * @class SelectNotifier
+             * @brief 多队列等待的共享通知对象
+             * @note 被通知方持有队列的锁时也可调用 notify()，等待方检查队列时不持有本对象的锁
+             */
+            class SelectNotifier
+            {
+            public:
+                /// @brief 超时使用的时钟
+                using Clock = std::chrono::steady_clock;
+                /**
+                 * @brief 构造函数
+                 */
+                SelectNotifier() = default;
+                /**
+                 * @brief 通知等待者有队列状态变化
+                 */
+                void notify()
+                {
+                    m_epoch.fetch_add(1, std::memory_order_seq_cst);
+                    if (m_waiter_count.load(std::memory_order_seq_cst) == 0)
+                    {
+                        return;
+                    }
+                    {
+                        std::lock_guard<std::mutex> lock(m_mutex);
+                    }
+                    m_cv.notify_all();
+                }
+                /**
+                 * @brief 获取纪元号
+                 * @return std::uint64_t 纪元号
+                 */
+                std::uint64_t get_epoch()const noexcept
+                {
+                    return m_epoch.load(std::memory_order_seq_cst);
+                }
+                /**
+                 * @brief 等待纪元号离开 epoch
+                 * @param epoch 检查队列前记下的纪元号
+                 * @param deadline 截止时间
+                 * @return bool 纪元号是否已变化，超时返回 false
+                 */
+                bool wait_until(std::uint64_t epoch, Clock::time_point deadline)
+                {
+                    m_waiter_count.fetch_add(1, std::memory_order_seq_cst);
+                    bool is_changed = false;
+                    {
+                        std::unique_lock<std::mutex> lock(m_mutex);
+                        auto is_ready = [this, epoch]()
+                            {
+                                return m_epoch.load(std::memory_order_seq_cst) != epoch;
+                            };
+                        if (deadline == Clock::time_point::max())
+                        {
+                            m_cv.wait(lock, is_ready);
+                            is_changed = true;
+                        }
+                        else
+                        {
+                            is_changed = m_cv.wait_until(lock, deadline, is_ready);
+                        }
+                    }
+                    m_waiter_count.fetch_sub(1, std::memory_order_seq_cst);
+                    return is_changed;
+                }
+            private:
+                /**
+                 * @brief 拷贝构造函数
+                 * @note 禁止拷贝构造
+                 */
+                SelectNotifier(const SelectNotifier&) = delete;
+                /**
+                 * @brief 拷贝赋值运算符
+                 * @note 禁止拷贝赋值
+                 */
+                SelectNotifier& operator=(const SelectNotifier&) = delete;
+            private:
+                /// @brief 纪元号
+                std::atomic<std::uint64_t> m_epoch = 0;
+                /// @brief 等待者数
+                std::atomic<std::size_t> m_waiter_count = 0;
+                /// @brief 互斥锁
+                std::mutex m_mutex;
+                /// @brief 条件变量
+                std::condition_variable m_cv;
+            };
+        }
+    }
+}
@@ -0,0 +1,536 @@
+#pragma once
+
+/**
+ * @file spill_queue.hpp
+ * @author DaneJoe001
+ * @version 0.1.1
+ * @brief 溢写到磁盘的无界队列
+ * @details 内存中保留有界队列，超出部分以 [uint32 长度][数据] 记录追加写入内存映射的分段文件；
+ *          消费者追上后按 FIFO 顺序读回。只要磁盘上仍有记录，新元素一律写入磁盘以保持顺序。
+ *          常驻内存约为内存队列加上当前写入、读取两个分段，生产者不会因容量阻塞
+ * @note 仅支持 POSIX 平台；分段文件创建后立即 unlink，进程退出后不留残余
+ * @date 2026-10-18
+ */
+
+#if !defined(_WIN32)
+
+#include <mutex>
+#include <deque>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <utility>
+#include <optional>
+#include <stdexcept>
+#include <filesystem>
+#include <type_traits>
+#include <system_error>
+#include <condition_variable>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+/**
+ * @namespace DaneJoe
+ * @brief DaneJoe命名空间
+ */
+namespace DaneJoe
+{
+    /**
+     * @namespace Concurrent
+     * @brief 并发命名空间
+     */
+    namespace Concurrent
+    {
+        /**
+         * @namespace Blocking
+         * @brief 阻塞命名空间
+         */
+        namespace Blocking
+        {
+            /**
+             * @struct SpillSerializer
+             * @brief 溢写序列化特征
+             * @details 用户为自定义类型特化本模板，提供：
+             *          - static std::size_t size(const T&)：序列化后的字节数
+             *          - static void serialize(const T&, std::byte* out)：写入恰好 size() 字节
+             *          - static T deserialize(const std::byte* data, std::size_t size)：还原元素
+             *          可平凡拷贝的类型与 std::string 已提供默认实现
+             * @tparam T 元素类型
+             */
+            template<class T, class Enable = void>
+            struct SpillSerializer;
+            /**
+             * @brief 可平凡拷贝类型的序列化
+             * @tparam T 元素类型
+             */
+            template<class T>
+            struct SpillSerializer<T, std::enable_if_t<std::is_trivially_copyable_v<T>>>
+            {
+                /**
+                 * @brief 获取序列化字节数
+                 * @return std::size_t 字节数
+                 */
+                static std::size_t size(const T&)noexcept
+                {
+                    return sizeof(T);
+                }
+                /**
+                 * @brief 序列化
+                 * @param value 元素
+                 * @param out 输出缓冲区
+                 */
+                static void serialize(const T& value, std::byte* out)noexcept
+                {
+                    std::memcpy(out, &value, sizeof(T));
+                }
+                /**
+                 * @brief 反序列化
+                 * @param data 数据
+                 * @return T 元素
+                 */
+                static T deserialize(const std::byte* data, std::size_t)noexcept
+                {
+                    T value;
+                    std::memcpy(&value, data, sizeof(T));
+                    return value;
+                }
+            };
+            /**
+             * @brief std::string 的序列化
+             */
+            template<>
+            struct SpillSerializer<std::string>
+            {
+                /**
+                 * @brief 获取序列化字节数
+                 * @param value 字符串
+                 * @return std::size_t 字节数
+                 */
+                static std::size_t size(const std::string& value)noexcept
+                {
+                    return value.size();
+                }
+                /**
+                 * @brief 序列化
+                 * @param value 字符串
+                 * @param out 输出缓冲区
+                 */
+                static void serialize(const std::string& value, std::byte* out)noexcept
+                {
+                    std::memcpy(out, value.data(), value.size());
+                }
+                /**
+                 * @brief 反序列化
+                 * @param data 数据
+                 * @param size 字节数
+                 * @return std::string 字符串
+                 */
+                static std::string deserialize(const std::byte* data, std::size_t size)
+                {
+                    return std::string(reinterpret_cast<const char*>(data), size);
+                }
+            };
+            /**
+             * @struct SpillQueueOptions
+             * @brief 溢写队列配置
+             */
+            struct SpillQueueOptions
+            {
+                /// @brief 内存队列容量
+                std::size_t memory_capacity = 1024;
+                /// @brief 分段文件所在目录
+                std::filesystem::path directory = std::filesystem::temp_directory_path();
+                /// @brief 单个分段文件大小
+                std::size_t segment_size = std::size_t(64) << 20;
+            };
+            /**
+             * @class SpillQueue
+             * @brief 溢写到磁盘的多生产者多消费者队列
+             * @tparam T 元素类型
+             * @tparam Serializer 序列化特征
+             */
+            template<class T, class Serializer = SpillSerializer<T>>
+            class SpillQueue
+            {
+            public:
+                /**
+                 * @brief 构造函数
+                 * @param options 配置
+                 * @throws std::system_error 目录无法创建
+                 */
+                explicit SpillQueue(SpillQueueOptions options = SpillQueueOptions()) :
+                    m_options(std::move(options))
+                {
+                    if (m_options.memory_capacity == 0)
+                    {
+                        m_options.memory_capacity = 1;
+                    }
+                    std::filesystem::create_directories(m_options.directory);
+                }
+                /**
+                 * @brief 析构函数
+                 */
+                ~SpillQueue()
+                {
+                    for (auto& segment : m_segments)
+                    {
+                        release_segment(*segment);
+                    }
+                }
+                /**
+                 * @brief 添加元素，不因容量阻塞
+                 * @param item 元素
+                 * @return bool 是否成功添加，队列已关闭时返回 false
+                 * @throws std::system_error 分段文件创建或映射失败
+                 * @throws std::length_error 序列化结果超过 4 GiB
+                 */
+                bool push(T item)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(m_mutex);
+                        if (!m_is_running)
+                        {
+                            return false;
+                        }
+                        if (m_spilled_count == 0 && m_memory.size() < m_options.memory_capacity)
+                        {
+                            m_memory.push_back(std::move(item));
+                        }
+                        else
+                        {
+                            spill(item);
+                        }
+                    }
+                    m_empty_cv.notify_one();
+                    return true;
+                }
+                /**
+                 * @brief 弹出队首元素，队列为空时阻塞
+                 * @return std::optional<T> 弹出的元素，队列关闭且为空时返回 std::nullopt
+                 */
+                std::optional<T> pop()
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_empty_cv.wait(lock, [this]()
+                        {
+                            return !is_empty_locked() || !m_is_running;
+                        });
+                    return take_locked();
+                }
+                /**
+                 * @brief 尝试弹出队首元素
+                 * @return std::optional<T> 弹出的元素，队列为空时返回 std::nullopt
+                 */
+                std::optional<T> try_pop()
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    return take_locked();
+                }
+                /**
+                 * @brief 等待弹出队首元素
+                 * @tparam Rep 时长计数类型
+                 * @tparam Period 时长单位
+                 * @param timeout 等待时间
+                 * @return std::optional<T> 弹出的元素，超时或队列关闭且为空时返回 std::nullopt
+                 */
+                template<class Rep, class Period>
+                std::optional<T> pop_for(const std::chrono::duration<Rep, Period>& timeout)
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_empty_cv.wait_for(lock, timeout, [this]()
+                        {
+                            return !is_empty_locked() || !m_is_running;
+                        });
+                    return take_locked();
+                }
+                /**
+                 * @brief 关闭队列
+                 * @note 关闭后不再接受新元素，已有元素仍可弹出
+                 */
+                void close()
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(m_mutex);
+                        m_is_running = false;
+                    }
+                    m_empty_cv.notify_all();
+                }
+                /**
+                 * @brief 判断队列是否正在运行
+                 * @return bool 是否正在运行
+                 */
+                bool is_running()const
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    return m_is_running;
+                }
+                /**
+                 * @brief 获取元素总数
+                 * @return std::size_t 元素总数
+                 */
+                std::size_t size()const
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    return m_memory.size() + m_spilled_count;
+                }
+                /**
+                 * @brief 判断是否为空
+                 * @return bool 是否为空
+                 */
+                bool empty()const
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    return is_empty_locked();
+                }
+                /**
+                 * @brief 获取内存中的元素数
+                 * @return std::size_t 元素数
+                 */
+                std::size_t get_memory_size()const
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    return m_memory.size();
+                }
+                /**
+                 * @brief 获取溢写在磁盘上的元素数
+                 * @return std::size_t 元素数
+                 */
+                std::size_t get_spilled_count()const
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    return m_spilled_count;
+                }
+                /**
+                 * @brief 获取分段文件数
+                 * @return std::size_t 分段数
+                 */
+                std::size_t get_segment_count()const
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    return m_segments.size();
+                }
+            private:
+                /// @brief 记录长度字段类型
+                using RecordLength = std::uint32_t;
+                /**
+                 * @brief 分段文件
+                 */
+                struct Segment
+                {
+                    /// @brief 文件描述符
+                    int fd = -1;
+                    /// @brief 映射地址，未映射时为 nullptr
+                    std::byte* data = nullptr;
+                    /// @brief 文件大小
+                    std::size_t capacity = 0;
+                    /// @brief 写入偏移
+                    std::size_t write_offset = 0;
+                    /// @brief 读取偏移
+                    std::size_t read_offset = 0;
+                };
+            private:
+                /**
+                 * @brief 拷贝构造函数
+                 * @note 禁止拷贝构造
+                 */
+                SpillQueue(const SpillQueue&) = delete;
+                /**
+                 * @brief 拷贝赋值运算符
+                 * @note 禁止拷贝赋值
+                 */
+                SpillQueue& operator=(const SpillQueue&) = delete;
+                /**
+                 * @brief 判断是否为空（需持锁）
+                 * @return bool 是否为空
+                 */
+                bool is_empty_locked()const noexcept
+                {
+                    return m_memory.empty() && m_spilled_count == 0;
+                }
+                /**
+                 * @brief 取出队首元素（需持锁）
+                 * @details 内存中的元素总是早于磁盘上的元素
+                 * @return std::optional<T> 队首元素
+                 */
+                std::optional<T> take_locked()
+                {
+                    if (!m_memory.empty())
+                    {
+                        std::optional<T> item(std::move(m_memory.front()));
+                        m_memory.pop_front();
+                        return item;
+                    }
+                    if (m_spilled_count == 0)
+                    {
+                        return std::nullopt;
+                    }
+                    return read_record();
+                }
+                /**
+                 * @brief 追加一条记录到磁盘
+                 * @param item 元素
+                 */
+                void spill(const T& item)
+                {
+                    std::size_t payload_size = Serializer::size(item);
+                    if (payload_size > std::numeric_limits<RecordLength>::max())
+                    {
+                        throw std::length_error("SpillQueue record too large");
+                    }
+                    std::size_t record_size = sizeof(RecordLength) + payload_size;
+                    if (m_segments.empty() || m_segments.back()->capacity - m_segments.back()->write_offset < record_size)
+                    {
+                        open_segment(record_size);
+                    }
+                    Segment& segment = *m_segments.back();
+                    RecordLength length = static_cast<RecordLength>(payload_size);
+                    std::memcpy(segment.data + segment.write_offset, &length, sizeof(length));
+                    Serializer::serialize(item, segment.data + segment.write_offset + sizeof(length));
+                    segment.write_offset += record_size;
+                    ++m_spilled_count;
+                }
+                /**
+                 * @brief 从最旧的分段读出一条记录
+                 * @return std::optional<T> 元素
+                 */
+                std::optional<T> read_record()
+                {
+                    Segment* segment = m_segments.front().get();
+                    while (segment->read_offset == segment->write_offset)
+                    {
+                        // 空分段容纳不下超长记录时写入端已转到后续分段
+                        release_segment(*segment);
+                        m_segments.pop_front();
+                        segment = m_segments.front().get();
+                    }
+                    map_segment(*segment);
+                    RecordLength length = 0;
+                    std::memcpy(&length, segment->data + segment->read_offset, sizeof(length));
+                    const std::byte* payload = segment->data + segment->read_offset + sizeof(length);
+                    std::optional<T> item(Serializer::deserialize(payload, length));
+                    segment->read_offset += sizeof(length) + length;
+                    --m_spilled_count;
+                    if (segment->read_offset == segment->write_offset)
+                    {
+                        if (m_segments.size() == 1)
+                        {
+                            // 唯一的分段已读空：复用并归还物理页
+                            segment->read_offset = 0;
+                            segment->write_offset = 0;
+                            ::madvise(segment->data, segment->capacity, MADV_DONTNEED);
+                        }
+                        else
+                        {
+                            release_segment(*segment);
+                            m_segments.pop_front();
+                        }
+                    }
+                    return item;
+                }
+                /**
+                 * @brief 打开新的写入分段
+                 * @param record_size 待写入记录大小，超过分段大小时按记录大小创建
+                 */
+                void open_segment(std::size_t record_size)
+                {
+                    auto segment = std::make_unique<Segment>();
+                    segment->capacity = record_size > m_options.segment_size ? record_size : m_options.segment_size;
+                    std::string path = (m_options.directory / ("spill-XXXXXX")).string();
+                    segment->fd = ::mkostemp(path.data(), O_CLOEXEC);
+                    if (segment->fd < 0)
+                    {
+                        throw std::system_error(errno, std::generic_category(), "SpillQueue create segment");
+                    }
+                    ::unlink(path.c_str());
+                    if (::ftruncate(segment->fd, static_cast<off_t>(segment->capacity)) != 0)
+                    {
+                        int error = errno;
+                        ::close(segment->fd);
+                        throw std::system_error(error, std::generic_category(), "SpillQueue resize segment");
+                    }
+                    try
+                    {
+                        map_segment(*segment);
+                    }
+                    catch (...)
+                    {
+                        ::close(segment->fd);
+                        throw;
+                    }
+                    if (m_segments.size() > 1)
+                    {
+                        // 已写满且不在读取的分段解除映射，释放常驻内存
+                        unmap_segment(*m_segments.back());
+                    }
+                    m_segments.push_back(std::move(segment));
+                }
+                /**
+                 * @brief 映射分段
+                 * @param segment 分段
+                 */
+                static void map_segment(Segment& segment)
+                {
+                    if (segment.data)
+                    {
+                        return;
+                    }
+                    void* data = ::mmap(nullptr, segment.capacity, PROT_READ | PROT_WRITE, MAP_SHARED, segment.fd, 0);
+                    if (data == MAP_FAILED)
+                    {
+                        throw std::system_error(errno, std::generic_category(), "SpillQueue map segment");
+                    }
+                    segment.data = static_cast<std::byte*>(data);
+                }
+                /**
+                 * @brief 解除分段映射
+                 * @param segment 分段
+                 */
+                static void unmap_segment(Segment& segment)noexcept
+                {
+                    if (segment.data)
+                    {
+                        ::munmap(segment.data, segment.capacity);
+                        segment.data = nullptr;
+                    }
+                }
+                /**
+                 * @brief 释放分段
+                 * @param segment 分段
+                 */
+                static void release_segment(Segment& segment)noexcept
+                {
+                    unmap_segment(segment);
+                    if (segment.fd >= 0)
+                    {
+                        ::close(segment.fd);
+                        segment.fd = -1;
+                    }
+                }
+            private:
+                /// @brief 配置
+                SpillQueueOptions m_options;
+                /// @brief 互斥锁
+                mutable std::mutex m_mutex;
+                /// @brief 非空条件变量
+                std::condition_variable m_empty_cv;
+                /// @brief 内存队列
+                std::deque<T> m_memory;
+                /// @brief 分段，队首为读取分段，队尾为写入分段
+                std::deque<std::unique_ptr<Segment>> m_segments;
+                /// @brief 磁盘上未读的记录数
+                std::size_t m_spilled_count = 0;
+                /// @brief 是否正在运行
+                bool m_is_running = true;
+            };
+        }
+    }
+}
+
+#endif
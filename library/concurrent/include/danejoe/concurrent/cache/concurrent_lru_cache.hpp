@@ -0,0 +1,462 @@
+#pragma once
+
+/**
+ * @file concurrent_lru_cache.hpp
+ * @author DaneJoe001
+ * @version 0.1.1
+ * @brief 分片并发缓存
+ * @details 按键哈希分片，每个分片一把读写锁。命中只取共享锁并置位访问标记，不修改任何链表；
+ *          插入时在独占锁下用 CLOCK 算法（二次机会）近似 LRU 淘汰，直到分片字节数回到容量以内。
+ *          值以 std::shared_ptr<const V> 保存，读取方持有的值不受随后淘汰影响
+ * @date 2026-10-18
+ */
+
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <functional>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include "danejoe/concurrent/metrics/sharded_counter.hpp"
+
+/**
+ * @namespace DaneJoe
+ * @brief DaneJoe命名空间
+ */
+namespace DaneJoe
+{
+    /**
+     * @namespace Concurrent
+     * @brief 并发命名空间
+     */
+    namespace Concurrent
+    {
+        /**
+         * @namespace Cache
+         * @brief 缓存命名空间
+         */
+        namespace Cache
+        {
+            /**
+             * @struct CacheSizer
+             * @brief 默认的条目字节数估算
+             * @details sizeof(K) + sizeof(V)，键或值为连续容器（如 std::string、std::vector）时加上元素所占字节
+             * @tparam K 键类型
+             * @tparam V 值类型
+             */
+            template<class K, class V>
+            struct CacheSizer
+            {
+                /**
+                 * @brief 估算条目字节数
+                 * @param key 键
+                 * @param value 值
+                 * @return std::size_t 字节数
+                 */
+                std::size_t operator()(const K& key, const V& value)const noexcept
+                {
+                    return sizeof(K) + sizeof(V) + get_dynamic_size(key) + get_dynamic_size(value);
+                }
+            private:
+                /**
+                 * @brief 获取连续容器的元素字节数
+                 * @tparam U 类型
+                 * @param object 对象
+                 * @return std::size_t 字节数，非连续容器为 0
+                 */
+                template<class U>
+                static std::size_t get_dynamic_size(const U& object)noexcept
+                {
+                    if constexpr (requires { object.size(); object.data(); })
+                    {
+                        return object.size() * sizeof(*object.data());
+                    }
+                    else
+                    {
+                        return 0;
+                    }
+                }
+            };
+            /**
+             * @struct CacheStats
+             * @brief 缓存统计
+             */
+            struct CacheStats
+            {
+                /// @brief 命中次数
+                std::int64_t hit_count = 0;
+                /// @brief 未命中次数
+                std::int64_t miss_count = 0;
+                /// @brief 插入次数（含覆盖）
+                std::uint64_t insert_count = 0;
+                /// @brief 淘汰次数
+                std::uint64_t eviction_count = 0;
+                /// @brief 条目数
+                std::size_t entry_count = 0;
+                /// @brief 字节数
+                std::size_t bytes = 0;
+                /**
+                 * @brief 获取命中率
+                 * @return double 命中率，无访问时为 0
+                 */
+                double get_hit_rate()const noexcept
+                {
+                    std::int64_t total = hit_count + miss_count;
+                    return total == 0 ? 0.0 : static_cast<double>(hit_count) / static_cast<double>(total);
+                }
+            };
+            /**
+             * @class ConcurrentLruCache
+             * @brief 分片并发缓存，CLOCK 近似 LRU 淘汰，按字节计容量
+             * @tparam K 键类型
+             * @tparam V 值类型
+             * @tparam Hash 哈希函数
+             * @tparam KeyEqual 键比较函数
+             * @tparam Sizer 条目字节数估算函数
+             */
+            template<class K, class V, class Hash = std::hash<K>, class KeyEqual = std::equal_to<K>, class Sizer = CacheSizer<K, V>>
+            class ConcurrentLruCache
+            {
+            public:
+                /// @brief 值指针类型
+                using ValuePointer = std::shared_ptr<const V>;
+                /**
+                 * @brief 构造函数
+                 * @param capacity_bytes 总字节容量，平均分给各分片
+                 * @param shard_count 分片数，向上取整为 2 的幂；为0时按硬件并发数确定
+                 * @param sizer 条目字节数估算函数
+                 * @param hash 哈希函数
+                 */
+                explicit ConcurrentLruCache(std::size_t capacity_bytes, std::size_t shard_count = 0, Sizer sizer = Sizer(), Hash hash = Hash()) :
+                    m_shard_mask(Metrics::Detail::round_shard_count(shard_count) - 1),
+                    m_shards(std::make_unique<Shard[]>(m_shard_mask + 1)),
+                    m_sizer(std::move(sizer)),
+                    m_hash(std::move(hash))
+                {
+                    std::size_t shard_capacity = capacity_bytes / (m_shard_mask + 1);
+                    for (std::size_t i = 0; i <= m_shard_mask; ++i)
+                    {
+                        m_shards[i].capacity_bytes = shard_capacity;
+                    }
+                }
+                /**
+                 * @brief 查找
+                 * @details 命中时只持有共享锁
+                 * @param key 键
+                 * @return ValuePointer 值，未命中时为空
+                 */
+                ValuePointer get(const K& key)const
+                {
+                    std::size_t hash = m_hash(key);
+                    const Shard& shard = get_shard(hash);
+                    {
+                        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+                        auto iterator = shard.index.find(key);
+                        if (iterator != shard.index.end())
+                        {
+                            const Slot& slot = shard.slots[iterator->second];
+                            slot.is_referenced.store(true, std::memory_order_relaxed);
+                            ValuePointer value = slot.value;
+                            lock.unlock();
+                            m_hit_count.increment();
+                            return value;
+                        }
+                    }
+                    m_miss_count.increment();
+                    return nullptr;
+                }
+                /**
+                 * @brief 判断键是否存在，不计入统计也不影响淘汰
+                 * @param key 键
+                 * @return bool 是否存在
+                 */
+                bool contains(const K& key)const
+                {
+                    const Shard& shard = get_shard(m_hash(key));
+                    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+                    return shard.index.find(key) != shard.index.end();
+                }
+                /**
+                 * @brief 插入或覆盖
+                 * @param key 键
+                 * @param value 值
+                 * @return bool 是否缓存；条目大于分片容量时不缓存
+                 */
+                bool put(K key, V value)
+                {
+                    return put(std::move(key), std::make_shared<const V>(std::move(value)));
+                }
+                /**
+                 * @brief 插入或覆盖共享值
+                 * @param key 键
+                 * @param value 值，不能为空
+                 * @return bool 是否缓存；条目大于分片容量时不缓存
+                 */
+                bool put(K key, ValuePointer value)
+                {
+                    std::size_t bytes = m_sizer(key, *value);
+                    Shard& shard = get_shard(m_hash(key));
+                    if (bytes > shard.capacity_bytes)
+                    {
+                        return false;
+                    }
+                    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+                    auto iterator = shard.index.find(key);
+                    if (iterator != shard.index.end())
+                    {
+                        // 覆盖：先移除旧条目，再按新大小插入
+                        remove_locked(shard, iterator->second);
+                        shard.index.erase(iterator);
+                    }
+                    while (shard.bytes + bytes > shard.capacity_bytes && !shard.index.empty())
+                    {
+                        evict_locked(shard);
+                    }
+                    std::size_t slot_index = 0;
+                    if (!shard.free_slots.empty())
+                    {
+                        slot_index = shard.free_slots.back();
+                        shard.free_slots.pop_back();
+                    }
+                    else
+                    {
+                        slot_index = shard.slots.size();
+                        shard.slots.emplace_back();
+                    }
+                    Slot& slot = shard.slots[slot_index];
+                    slot.key = key;
+                    slot.value = std::move(value);
+                    slot.bytes = bytes;
+                    slot.is_occupied = true;
+                    slot.is_referenced.store(false, std::memory_order_relaxed);
+                    shard.index.emplace(std::move(key), slot_index);
+                    shard.bytes += bytes;
+                    ++shard.insert_count;
+                    return true;
+                }
+                /**
+                 * @brief 查找，未命中时加载并缓存
+                 * @note 加载在锁外执行，并发未命中同一键时可能重复加载，后写入者覆盖
+                 * @tparam F 加载函数类型，签名为 V(const K&)
+                 * @param key 键
+                 * @param loader 加载函数
+                 * @return ValuePointer 值
+                 */
+                template<class F>
+                ValuePointer get_or_load(const K& key, F&& loader)
+                {
+                    ValuePointer value = get(key);
+                    if (value)
+                    {
+                        return value;
+                    }
+                    value = std::make_shared<const V>(std::invoke(std::forward<F>(loader), key));
+                    put(key, value);
+                    return value;
+                }
+                /**
+                 * @brief 删除
+                 * @param key 键
+                 * @return bool 是否存在
+                 */
+                bool erase(const K& key)
+                {
+                    Shard& shard = get_shard(m_hash(key));
+                    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+                    auto iterator = shard.index.find(key);
+                    if (iterator == shard.index.end())
+                    {
+                        return false;
+                    }
+                    remove_locked(shard, iterator->second);
+                    shard.index.erase(iterator);
+                    return true;
+                }
+                /**
+                 * @brief 清空
+                 */
+                void clear()
+                {
+                    for (std::size_t i = 0; i <= m_shard_mask; ++i)
+                    {
+                        Shard& shard = m_shards[i];
+                        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+                        shard.index.clear();
+                        shard.slots.clear();
+                        shard.free_slots.clear();
+                        shard.bytes = 0;
+                        shard.hand = 0;
+                    }
+                }
+                /**
+                 * @brief 获取条目数
+                 * @return std::size_t 条目数
+                 */
+                std::size_t size()const
+                {
+                    std::size_t count = 0;
+                    for (std::size_t i = 0; i <= m_shard_mask; ++i)
+                    {
+                        std::shared_lock<std::shared_mutex> lock(m_shards[i].mutex);
+                        count += m_shards[i].index.size();
+                    }
+                    return count;
+                }
+                /**
+                 * @brief 获取统计信息
+                 * @return CacheStats 统计信息
+                 */
+                CacheStats get_stats()const
+                {
+                    CacheStats stats;
+                    stats.hit_count = m_hit_count.get();
+                    stats.miss_count = m_miss_count.get();
+                    for (std::size_t i = 0; i <= m_shard_mask; ++i)
+                    {
+                        const Shard& shard = m_shards[i];
+                        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+                        stats.insert_count += shard.insert_count;
+                        stats.eviction_count += shard.eviction_count;
+                        stats.entry_count += shard.index.size();
+                        stats.bytes += shard.bytes;
+                    }
+                    return stats;
+                }
+                /**
+                 * @brief 获取分片数
+                 * @return std::size_t 分片数
+                 */
+                std::size_t get_shard_count()const noexcept
+                {
+                    return m_shard_mask + 1;
+                }
+            private:
+                /**
+                 * @brief 条目槽位
+                 */
+                struct Slot
+                {
+                    /// @brief 键
+                    K key{};
+                    /// @brief 值
+                    ValuePointer value;
+                    /// @brief 字节数
+                    std::size_t bytes = 0;
+                    /// @brief 是否被占用
+                    bool is_occupied = false;
+                    /// @brief 访问标记，命中时在共享锁下置位
+                    mutable std::atomic<bool> is_referenced = false;
+                };
+                /**
+                 * @brief 分片
+                 */
+                struct alignas(64) Shard
+                {
+                    /// @brief 读写锁
+                    mutable std::shared_mutex mutex;
+                    /// @brief 键到槽位下标
+                    std::unordered_map<K, std::size_t, Hash, KeyEqual> index;
+                    /// @brief 槽位，CLOCK 指针在其上循环
+                    std::deque<Slot> slots;
+                    /// @brief 空闲槽位下标
+                    std::vector<std::size_t> free_slots;
+                    /// @brief CLOCK 指针
+                    std::size_t hand = 0;
+                    /// @brief 字节数
+                    std::size_t bytes = 0;
+                    /// @brief 字节容量
+                    std::size_t capacity_bytes = 0;
+                    /// @brief 插入次数
+                    std::uint64_t insert_count = 0;
+                    /// @brief 淘汰次数
+                    std::uint64_t eviction_count = 0;
+                };
+            private:
+                /**
+                 * @brief 拷贝构造函数
+                 * @note 禁止拷贝构造
+                 */
+                ConcurrentLruCache(const ConcurrentLruCache&) = delete;
+                /**
+                 * @brief 拷贝赋值运算符
+                 * @note 禁止拷贝赋值
+                 */
+                ConcurrentLruCache& operator=(const ConcurrentLruCache&) = delete;
+                /**
+                 * @brief 获取键所在分片
+                 * @param hash 键的哈希值
+                 * @return Shard& 分片
+                 */
+                Shard& get_shard(std::size_t hash)const noexcept
+                {
+                    // 取混合后的高位，避免与分片内哈希表的低位相关
+                    std::uint64_t mixed = static_cast<std::uint64_t>(hash) * 0x9E3779B97F4A7C15ULL;
+                    return m_shards[static_cast<std::size_t>(mixed >> 40) & m_shard_mask];
+                }
+                /**
+                 * @brief 释放槽位（需持独占锁，不修改索引）
+                 * @param shard 分片
+                 * @param slot_index 槽位下标
+                 */
+                static void remove_locked(Shard& shard, std::size_t slot_index)
+                {
+                    Slot& slot = shard.slots[slot_index];
+                    shard.bytes -= slot.bytes;
+                    slot.value.reset();
+                    slot.key = K{};
+                    slot.bytes = 0;
+                    slot.is_occupied = false;
+                    shard.free_slots.push_back(slot_index);
+                }
+                /**
+                 * @brief 按 CLOCK 淘汰一个条目（需持独占锁，分片非空）
+                 * @details 指针扫过带访问标记的条目时清除标记，遇到无标记的条目即淘汰
+                 * @param shard 分片
+                 */
+                static void evict_locked(Shard& shard)
+                {
+                    while (true)
+                    {
+                        if (shard.hand >= shard.slots.size())
+                        {
+                            shard.hand = 0;
+                        }
+                        std::size_t slot_index = shard.hand++;
+                        Slot& slot = shard.slots[slot_index];
+                        if (!slot.is_occupied)
+                        {
+                            continue;
+                        }
+                        if (slot.is_referenced.exchange(false, std::memory_order_relaxed))
+                        {
+                            continue;
+                        }
+                        shard.index.erase(slot.key);
+                        remove_locked(shard, slot_index);
+                        ++shard.eviction_count;
+                        return;
+                    }
+                }
+            private:
+                /// @brief 分片掩码
+                std::size_t m_shard_mask;
+                /// @brief 分片
+                std::unique_ptr<Shard[]> m_shards;
+                /// @brief 条目字节数估算函数
+                Sizer m_sizer;
+                /// @brief 哈希函数
+                Hash m_hash;
+                /// @brief 命中次数
+                mutable Metrics::ShardedCounter m_hit_count;
+                /// @brief 未命中次数
+                mutable Metrics::ShardedCounter m_miss_count;
+            };
+        }
+    }
+}
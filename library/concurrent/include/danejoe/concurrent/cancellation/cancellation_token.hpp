@@ -0,0 +1,314 @@
+#pragma once
+
+/**
+ * @file cancellation_token.hpp
+ * @author DaneJoe001
+ * @version 0.1.1
+ * @brief 取消令牌与截止时间
+ * @details CancellationSource 发出取消，CancellationToken 只读观察；
+ *          令牌可携带截止时间，可由父令牌派生子源使取消沿调用链向下传播。
+ *          底层基于 std::stop_source / std::stop_callback，注册回调不产生堆分配
+ * @date 2026-10-18
+ */
+
+#include <mutex>
+#include <chrono>
+#include <memory>
+#include <utility>
+#include <optional>
+#include <stdexcept>
+#include <stop_token>
+#include <condition_variable>
+
+/**
+ * @namespace DaneJoe
+ * @brief DaneJoe命名空间
+ */
+namespace DaneJoe
+{
+    /**
+     * @namespace Concurrent
+     * @brief 并发命名空间
+     */
+    namespace Concurrent
+    {
+        /**
+         * @namespace Cancellation
+         * @brief 取消命名空间
+         */
+        namespace Cancellation
+        {
+            /// @brief 截止时间使用的时钟
+            using Clock = std::chrono::steady_clock;
+            /**
+             * @class OperationCancelled
+             * @brief 操作被取消时抛出的异常
+             */
+            class OperationCancelled : public std::runtime_error
+            {
+            public:
+                /**
+                 * @brief 构造函数
+                 */
+                OperationCancelled() :std::runtime_error("operation cancelled") {}
+            };
+            /**
+             * @namespace Detail
+             * @brief 实现细节
+             */
+            namespace Detail
+            {
+                /**
+                 * @brief 父令牌到子源的取消转发
+                 */
+                struct ForwardCancel
+                {
+                    /// @brief 子源
+                    std::stop_source source;
+                    /**
+                     * @brief 转发取消
+                     */
+                    void operator()()noexcept
+                    {
+                        source.request_stop();
+                    }
+                };
+                /**
+                 * @brief 派生源与父令牌之间的链接
+                 */
+                struct Link
+                {
+                    /**
+                     * @brief 构造函数
+                     * @param parent 父令牌
+                     * @param source 子源
+                     */
+                    Link(const std::stop_token& parent, std::stop_source source) :
+                        callback(parent, ForwardCancel{ std::move(source) })
+                    {
+                    }
+                    /// @brief 登记在父令牌上的转发回调
+                    std::stop_callback<ForwardCancel> callback;
+                };
+            }
+            /**
+             * @class CancellationToken
+             * @brief 取消令牌
+             * @details 默认构造的令牌永远不会被取消；截止时间到达后 is_cancellation_requested() 返回 true，
+             *          但不会触发已注册的回调，等待方应以 get_deadline() 作为超时上限
+             */
+            class CancellationToken
+            {
+            public:
+                /**
+                 * @brief 构造永不取消的令牌
+                 */
+                CancellationToken() = default;
+                /**
+                 * @brief 判断是否已请求取消或已过截止时间
+                 * @return bool 是否应取消
+                 */
+                bool is_cancellation_requested()const noexcept
+                {
+                    return m_token.stop_requested() || (has_deadline() && Clock::now() >= m_deadline);
+                }
+                /**
+                 * @brief 判断令牌是否可能被取消
+                 * @return bool 是否可能被取消
+                 */
+                bool can_be_cancelled()const noexcept
+                {
+                    return m_token.stop_possible() || has_deadline();
+                }
+                /**
+                 * @brief 判断是否设置了截止时间
+                 * @return bool 是否有截止时间
+                 */
+                bool has_deadline()const noexcept
+                {
+                    return m_deadline != Clock::time_point::max();
+                }
+                /**
+                 * @brief 获取截止时间
+                 * @return Clock::time_point 截止时间，未设置时为 time_point::max()
+                 */
+                Clock::time_point get_deadline()const noexcept
+                {
+                    return m_deadline;
+                }
+                /**
+                 * @brief 已取消时抛出 OperationCancelled
+                 * @throws OperationCancelled 已请求取消或已过截止时间
+                 */
+                void throw_if_cancellation_requested()const
+                {
+                    if (is_cancellation_requested())
+                    {
+                        throw OperationCancelled();
+                    }
+                }
+                /**
+                 * @brief 可取消的休眠，可用作定时器
+                 * @tparam Rep 时长计数类型
+                 * @tparam Period 时长单位
+                 * @param duration 休眠时长
+                 * @return bool 是否因取消而提前返回
+                 */
+                template<class Rep, class Period>
+                bool sleep_for(const std::chrono::duration<Rep, Period>& duration)const
+                {
+                    return sleep_until(Clock::now() + duration);
+                }
+                /**
+                 * @brief 可取消的休眠，可用作定时器
+                 * @note 截止时间早于 time_point 时在截止时间返回 true
+                 * @param time_point 唤醒时间
+                 * @return bool 是否因取消而提前返回
+                 */
+                bool sleep_until(Clock::time_point time_point)const
+                {
+                    std::mutex mutex;
+                    std::condition_variable_any cv;
+                    std::unique_lock<std::mutex> lock(mutex);
+                    Clock::time_point wake_time = time_point < m_deadline ? time_point : m_deadline;
+                    cv.wait_until(lock, m_token, wake_time, []() { return false; });
+                    return is_cancellation_requested();
+                }
+                /**
+                 * @brief 获取底层 std::stop_token
+                 * @return const std::stop_token& 底层令牌
+                 */
+                const std::stop_token& get_stop_token()const noexcept
+                {
+                    return m_token;
+                }
+            private:
+                friend class CancellationSource;
+                /**
+                 * @brief 构造函数
+                 * @param token 底层令牌
+                 * @param deadline 截止时间
+                 * @param link 派生链接，保持父令牌到本令牌的转发存活
+                 */
+                CancellationToken(std::stop_token token, Clock::time_point deadline, std::shared_ptr<Detail::Link> link)noexcept :
+                    m_token(std::move(token)), m_deadline(deadline), m_link(std::move(link))
+                {
+                }
+            private:
+                /// @brief 底层令牌
+                std::stop_token m_token;
+                /// @brief 截止时间
+                Clock::time_point m_deadline = Clock::time_point::max();
+                /// @brief 派生链接
+                std::shared_ptr<Detail::Link> m_link;
+            };
+            /**
+             * @class CancellationSource
+             * @brief 取消源
+             * @note 可拷贝，拷贝共享同一取消状态
+             */
+            class CancellationSource
+            {
+            public:
+                /**
+                 * @brief 构造函数
+                 */
+                CancellationSource() = default;
+                /**
+                 * @brief 构造带截止时间的取消源
+                 * @param deadline 截止时间
+                 */
+                explicit CancellationSource(Clock::time_point deadline) :m_deadline(deadline) {}
+                /**
+                 * @brief 由父令牌派生取消源
+                 * @details 父令牌被取消时本源随之取消；截止时间取二者中较早者
+                 * @param parent 父令牌
+                 * @param deadline 本源自身的截止时间
+                 * @return CancellationSource 派生的取消源
+                 */
+                static CancellationSource create_linked(const CancellationToken& parent, Clock::time_point deadline = Clock::time_point::max())
+                {
+                    CancellationSource source(deadline < parent.get_deadline() ? deadline : parent.get_deadline());
+                    if (parent.get_stop_token().stop_possible())
+                    {
+                        source.m_link = std::make_shared<Detail::Link>(parent.get_stop_token(), source.m_source);
+                    }
+                    return source;
+                }
+                /**
+                 * @brief 获取令牌
+                 * @return CancellationToken 令牌
+                 */
+                CancellationToken get_token()const noexcept
+                {
+                    return CancellationToken(m_source.get_token(), m_deadline, m_link);
+                }
+                /**
+                 * @brief 请求取消
+                 * @note 已注册的回调在当前线程上同步执行
+                 * @return bool 是否为首次请求
+                 */
+                bool cancel()noexcept
+                {
+                    return m_source.request_stop();
+                }
+                /**
+                 * @brief 判断是否已请求取消或已过截止时间
+                 * @return bool 是否应取消
+                 */
+                bool is_cancellation_requested()const noexcept
+                {
+                    return get_token().is_cancellation_requested();
+                }
+            private:
+                /// @brief 底层取消源
+                std::stop_source m_source;
+                /// @brief 截止时间
+                Clock::time_point m_deadline = Clock::time_point::max();
+                /// @brief 派生链接
+                std::shared_ptr<Detail::Link> m_link;
+            };
+            /**
+             * @class CancellationCallback
+             * @brief 取消回调注册
+             * @details 构造时注册，析构时注销；令牌已取消时在构造函数中立即执行。
+             *          析构时若回调正在其他线程执行，等待其结束
+             * @note 截止时间到达不会触发回调
+             * @tparam F 回调类型
+             */
+            template<class F>
+            class CancellationCallback
+            {
+            public:
+                /**
+                 * @brief 构造函数
+                 * @param token 令牌
+                 * @param callback 回调
+                 */
+                CancellationCallback(const CancellationToken& token, F callback) :
+                    m_callback(token.get_stop_token(), std::move(callback))
+                {
+                }
+            private:
+                /**
+                 * @brief 拷贝构造函数
+                 * @note 禁止拷贝构造
+                 */
+                CancellationCallback(const CancellationCallback&) = delete;
+                /**
+                 * @brief 拷贝赋值运算符
+                 * @note 禁止拷贝赋值
+                 */
+                CancellationCallback& operator=(const CancellationCallback&) = delete;
+            private:
+                /// @brief 底层回调
+                std::stop_callback<F> m_callback;
+            };
+            /**
+             * @brief CancellationCallback 推导指引
+             */
+            template<class F>
+            CancellationCallback(const CancellationToken&, F) -> CancellationCallback<F>;
+        }
+    }
+}
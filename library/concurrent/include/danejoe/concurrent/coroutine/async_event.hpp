@@ -0,0 +1,183 @@
+#pragma once
+
+/**
+ * @file async_event.hpp
+ * @author DaneJoe001
+ * @version 0.1.1
+ * @brief 协程事件
+ * @details 手动复位事件；等待者以侵入式无锁栈登记，awaiter 位于协程帧内，不产生堆分配
+ * @date 2026-10-18
+ */
+
+#include <atomic>
+#include <coroutine>
+
+#include "danejoe/concurrent/thread_pool/task.hpp"
+#include "danejoe/concurrent/thread_pool/executor.hpp"
+#include "danejoe/concurrent/coroutine/co_task.hpp"
+
+/**
+ * @namespace DaneJoe
+ * @brief DaneJoe命名空间
+ */
+namespace DaneJoe
+{
+    /**
+     * @namespace Concurrent
+     * @brief 并发命名空间
+     */
+    namespace Concurrent
+    {
+        /**
+         * @namespace Coroutine
+         * @brief 协程命名空间
+         */
+        namespace Coroutine
+        {
+            /**
+             * @class AsyncEvent
+             * @brief 协程事件
+             * @note set() 在执行器上恢复全部等待者
+             */
+            class AsyncEvent
+            {
+            public:
+                /**
+                 * @brief 等待事件的 awaiter
+                 */
+                class Awaiter
+                {
+                public:
+                    /**
+                     * @brief 构造函数
+                     * @param event 事件
+                     */
+                    explicit Awaiter(AsyncEvent& event)noexcept :m_event(event) {}
+                    /**
+                     * @brief 判断事件是否已触发
+                     * @return bool 是否已触发
+                     */
+                    bool await_ready()const noexcept
+                    {
+                        return m_event.is_set();
+                    }
+                    /**
+                     * @brief 登记等待者
+                     * @param handle 当前协程
+                     * @return bool 是否挂起；登记前事件已触发时不挂起
+                     */
+                    bool await_suspend(std::coroutine_handle<> handle)noexcept
+                    {
+                        m_handle = handle;
+                        return m_event.push(this);
+                    }
+                    /**
+                     * @brief 恢复
+                     */
+                    void await_resume()const noexcept {}
+                private:
+                    friend class AsyncEvent;
+                    /// @brief 事件
+                    AsyncEvent& m_event;
+                    /// @brief 等待的协程
+                    std::coroutine_handle<> m_handle;
+                    /// @brief 下一个等待者
+                    Awaiter* m_next = nullptr;
+                };
+            public:
+                /**
+                 * @brief 构造函数
+                 * @param executor 恢复等待者的执行器
+                 * @param is_set 初始是否已触发
+                 */
+                explicit AsyncEvent(ThreadPool::IExecutor& executor, bool is_set = false) :
+                    m_executor(executor), m_state(is_set ? static_cast<void*>(this) : nullptr)
+                {
+                }
+                /**
+                 * @brief 等待事件触发
+                 * @return Awaiter
+                 */
+                Awaiter wait()noexcept
+                {
+                    return Awaiter(*this);
+                }
+                /**
+                 * @brief 判断事件是否已触发
+                 * @return bool 是否已触发
+                 */
+                bool is_set()const noexcept
+                {
+                    return m_state.load(std::memory_order_acquire) == this;
+                }
+                /**
+                 * @brief 触发事件并恢复全部等待者
+                 */
+                void set()
+                {
+                    void* previous = m_state.exchange(this, std::memory_order_acq_rel);
+                    if (previous == this)
+                    {
+                        return;
+                    }
+                    Awaiter* reversed = nullptr;
+                    for (Awaiter* waiter = static_cast<Awaiter*>(previous); waiter;)
+                    {
+                        Awaiter* next = waiter->m_next;
+                        waiter->m_next = reversed;
+                        reversed = waiter;
+                        waiter = next;
+                    }
+                    while (reversed)
+                    {
+                        Awaiter* next = reversed->m_next;
+                        m_executor.execute(ThreadPool::Task(ResumeOnExecutor{ reversed->m_handle }));
+                        reversed = next;
+                    }
+                }
+                /**
+                 * @brief 复位事件
+                 */
+                void reset()noexcept
+                {
+                    void* expected = this;
+                    m_state.compare_exchange_strong(expected, nullptr, std::memory_order_relaxed);
+                }
+            private:
+                /**
+                 * @brief 拷贝构造函数
+                 * @note 禁止拷贝构造
+                 */
+                AsyncEvent(const AsyncEvent&) = delete;
+                /**
+                 * @brief 拷贝赋值运算符
+                 * @note 禁止拷贝赋值
+                 */
+                AsyncEvent& operator=(const AsyncEvent&) = delete;
+                /**
+                 * @brief 登记等待者
+                 * @param waiter 等待者
+                 * @return bool 是否登记成功；事件已触发时返回 false
+                 */
+                bool push(Awaiter* waiter)noexcept
+                {
+                    void* state = m_state.load(std::memory_order_acquire);
+                    do
+                    {
+                        if (state == this)
+                        {
+                            return false;
+                        }
+                        waiter->m_next = static_cast<Awaiter*>(state);
+                    } while (!m_state.compare_exchange_weak(state, waiter, std::memory_order_release, std::memory_order_acquire));
+                    return true;
+                }
+            private:
+                /// @brief 恢复等待者的执行器
+                ThreadPool::IExecutor& m_executor;
+                /// @brief 状态：this 表示已触发，否则为等待者栈顶
+                std::atomic<void*> m_state;
+            };
+        }
+    }
+}
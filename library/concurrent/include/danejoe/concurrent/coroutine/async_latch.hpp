@@ -0,0 +1,100 @@
+#pragma once
+
+/**
+ * @file async_latch.hpp
+ * @author DaneJoe001
+ * @version 0.1.1
+ * @brief 协程闩锁
+ * @details 计数归零时触发内部事件；计数与等待均为无锁操作
+ * @date 2026-10-18
+ */
+
+#include <atomic>
+#include <cstddef>
+
+#include "danejoe/concurrent/thread_pool/executor.hpp"
+#include "danejoe/concurrent/coroutine/async_event.hpp"
+
+/**
+ * @namespace DaneJoe
+ * @brief DaneJoe命名空间
+ */
+namespace DaneJoe
+{
+    /**
+     * @namespace Concurrent
+     * @brief 并发命名空间
+     */
+    namespace Concurrent
+    {
+        /**
+         * @namespace Coroutine
+         * @brief 协程命名空间
+         */
+        namespace Coroutine
+        {
+            /**
+             * @class AsyncLatch
+             * @brief 协程闩锁
+             */
+            class AsyncLatch
+            {
+            public:
+                /**
+                 * @brief 构造函数
+                 * @param executor 恢复等待者的执行器
+                 * @param count 初始计数
+                 */
+                AsyncLatch(ThreadPool::IExecutor& executor, std::ptrdiff_t count) :
+                    m_count(count), m_event(executor, count <= 0)
+                {
+                }
+                /**
+                 * @brief 递减计数
+                 * @note 计数归零时恢复全部等待者
+                 * @param count 递减量
+                 */
+                void count_down(std::ptrdiff_t count = 1)
+                {
+                    std::ptrdiff_t previous = m_count.fetch_sub(count, std::memory_order_acq_rel);
+                    if (previous > 0 && previous <= count)
+                    {
+                        m_event.set();
+                    }
+                }
+                /**
+                 * @brief 判断计数是否已归零
+                 * @return bool 是否已归零
+                 */
+                bool is_ready()const noexcept
+                {
+                    return m_event.is_set();
+                }
+                /**
+                 * @brief 等待计数归零
+                 * @return AsyncEvent::Awaiter
+                 */
+                AsyncEvent::Awaiter wait()noexcept
+                {
+                    return m_event.wait();
+                }
+            private:
+                /**
+                 * @brief 拷贝构造函数
+                 * @note 禁止拷贝构造
+                 */
+                AsyncLatch(const AsyncLatch&) = delete;
+                /**
+                 * @brief 拷贝赋值运算符
+                 * @note 禁止拷贝赋值
+                 */
+                AsyncLatch& operator=(const AsyncLatch&) = delete;
+            private:
+                /// @brief 剩余计数
+                std::atomic<std::ptrdiff_t> m_count;
+                /// @brief 归零事件
+                AsyncEvent m_event;
+            };
+        }
+    }
+}
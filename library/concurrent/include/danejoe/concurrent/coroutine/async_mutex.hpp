@@ -0,0 +1,218 @@
+#pragma once
+
+/**
+ * @file async_mutex.hpp
+ * @author DaneJoe001
+ * @version 0.1.1
+ * @brief 协程互斥锁
+ * @details 基于单许可 AsyncSemaphore；持锁期间可以 co_await 而不占用线程
+ * @date 2026-10-18
+ */
+
+#include <utility>
+#include <coroutine>
+
+#include "danejoe/concurrent/thread_pool/executor.hpp"
+#include "danejoe/concurrent/coroutine/async_semaphore.hpp"
+#include "danejoe/concurrent/cancellation/cancellation_token.hpp"
+
+/**
+ * @namespace DaneJoe
+ * @brief DaneJoe命名空间
+ */
+namespace DaneJoe
+{
+    /**
+     * @namespace Concurrent
+     * @brief 并发命名空间
+     */
+    namespace Concurrent
+    {
+        /**
+         * @namespace Coroutine
+         * @brief 协程命名空间
+         */
+        namespace Coroutine
+        {
+            class AsyncMutex;
+            /**
+             * @class AsyncLockGuard
+             * @brief 协程互斥锁守卫
+             */
+            class AsyncLockGuard
+            {
+            public:
+                /**
+                 * @brief 构造函数
+                 * @param mutex 已加锁的互斥锁
+                 */
+                explicit AsyncLockGuard(AsyncMutex& mutex)noexcept :m_mutex(&mutex) {}
+                /**
+                 * @brief 移动构造函数
+                 * @param other 其他守卫
+                 */
+                AsyncLockGuard(AsyncLockGuard&& other)noexcept :m_mutex(std::exchange(other.m_mutex, nullptr)) {}
+                /**
+                 * @brief 析构函数
+                 */
+                ~AsyncLockGuard();
+                /**
+                 * @brief 提前解锁
+                 */
+                void unlock();
+            private:
+                /**
+                 * @brief 拷贝构造函数
+                 * @note 禁止拷贝构造
+                 */
+                AsyncLockGuard(const AsyncLockGuard&) = delete;
+                /**
+                 * @brief 赋值运算符
+                 * @note 禁止赋值
+                 */
+                AsyncLockGuard& operator=(const AsyncLockGuard&) = delete;
+            private:
+                /// @brief 互斥锁
+                AsyncMutex* m_mutex;
+            };
+            /**
+             * @class AsyncMutex
+             * @brief 协程互斥锁
+             * @note 等待者按 FIFO 顺序在执行器上恢复
+             */
+            class AsyncMutex
+            {
+            public:
+                /**
+                 * @brief 加锁并返回守卫的 awaiter
+                 */
+                class ScopedLockAwaiter
+                {
+                public:
+                    /**
+                     * @brief 构造函数
+                     * @param mutex 互斥锁
+                     */
+                    explicit ScopedLockAwaiter(AsyncMutex& mutex, Cancellation::CancellationToken token = {})noexcept :
+                        m_mutex(mutex), m_awaiter(mutex.m_semaphore, std::move(token))
+                    {
+                    }
+                    /**
+                     * @brief 尝试直接加锁
+                     * @return bool 是否加锁成功
+                     */
+                    bool await_ready()noexcept
+                    {
+                        return m_awaiter.await_ready();
+                    }
+                    /**
+                     * @brief 挂起等待加锁
+                     * @param handle 当前协程
+                     * @return bool 是否挂起
+                     */
+                    bool await_suspend(std::coroutine_handle<> handle)
+                    {
+                        return m_awaiter.await_suspend(handle);
+                    }
+                    /**
+                     * @brief 恢复，此时已持有锁
+                     * @return AsyncLockGuard 守卫
+                     * @throws Cancellation::OperationCancelled 等待被取消
+                     */
+                    AsyncLockGuard await_resume()
+                    {
+                        m_awaiter.await_resume();
+                        return AsyncLockGuard(m_mutex);
+                    }
+                private:
+                    /// @brief 互斥锁
+                    AsyncMutex& m_mutex;
+                    /// @brief 信号量 awaiter
+                    AsyncSemaphore::AcquireAwaiter m_awaiter;
+                };
+            public:
+                /**
+                 * @brief 构造函数
+                 * @param executor 恢复等待者的执行器
+                 */
+                explicit AsyncMutex(ThreadPool::IExecutor& executor) :m_semaphore(executor, 1) {}
+                /**
+                 * @brief 加锁
+                 * @note 需配对调用 unlock()
+                 * @return AsyncSemaphore::AcquireAwaiter
+                 */
+                AsyncSemaphore::AcquireAwaiter lock()noexcept
+                {
+                    return m_semaphore.acquire();
+                }
+                /**
+                 * @brief 加锁并返回守卫
+                 * @return ScopedLockAwaiter
+                 */
+                ScopedLockAwaiter scoped_lock()noexcept
+                {
+                    return ScopedLockAwaiter(*this);
+                }
+                /**
+                 * @brief 可取消地加锁
+                 * @note 取消时 co_await 抛出 OperationCancelled；成功时需配对调用 unlock()
+                 * @param token 取消令牌
+                 * @return AsyncSemaphore::AcquireAwaiter
+                 */
+                AsyncSemaphore::AcquireAwaiter lock(Cancellation::CancellationToken token)noexcept
+                {
+                    return m_semaphore.acquire(std::move(token));
+                }
+                /**
+                 * @brief 可取消地加锁并返回守卫
+                 * @param token 取消令牌
+                 * @return ScopedLockAwaiter
+                 */
+                ScopedLockAwaiter scoped_lock(Cancellation::CancellationToken token)noexcept
+                {
+                    return ScopedLockAwaiter(*this, std::move(token));
+                }
+                /**
+                 * @brief 尝试加锁
+                 * @return bool 是否加锁成功
+                 */
+                bool try_lock()noexcept
+                {
+                    return m_semaphore.try_acquire();
+                }
+                /**
+                 * @brief 解锁
+                 */
+                void unlock()
+                {
+                    m_semaphore.release();
+                }
+            private:
+                /**
+                 * @brief 拷贝构造函数
+                 * @note 禁止拷贝构造
+                 */
+                AsyncMutex(const AsyncMutex&) = delete;
+                /**
+                 * @brief 拷贝赋值运算符
+                 * @note 禁止拷贝赋值
+                 */
+                AsyncMutex& operator=(const AsyncMutex&) = delete;
+            private:
+                /// @brief 单许可信号量
+                AsyncSemaphore m_semaphore;
+            };
+            inline AsyncLockGuard::~AsyncLockGuard()
+            {
+                unlock();
+            }
+            inline void AsyncLockGuard::unlock()
+            {
+                if (m_mutex)
+                {
+                    std::exchange(m_mutex, nullptr)->unlock();
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,329 @@
+#pragma once
+
+/**
+ * @file async_semaphore.hpp
+ * @author DaneJoe001
+ * @version 0.1.1
+ * @brief 协程信号量
+ * @details 计数为负表示等待者数量；无竞争的获取与释放只有一次原子操作，
+ *          仅在需要挂起或唤醒时进入互斥锁保护的等待队列。
+ *          取消的等待者在队列中留下空句柄占位，轮到它时许可转交给下一个等待者
+ * @date 2026-10-18
+ */
+
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <cstdint>
+#include <utility>
+#include <optional>
+#include <algorithm>
+#include <coroutine>
+
+#include "danejoe/concurrent/thread_pool/task.hpp"
+#include "danejoe/concurrent/thread_pool/executor.hpp"
+#include "danejoe/concurrent/coroutine/co_task.hpp"
+#include "danejoe/concurrent/cancellation/cancellation_token.hpp"
+
+/**
+ * @namespace DaneJoe
+ * @brief DaneJoe命名空间
+ */
+namespace DaneJoe
+{
+    /**
+     * @namespace Concurrent
+     * @brief 并发命名空间
+     */
+    namespace Concurrent
+    {
+        /**
+         * @namespace Coroutine
+         * @brief 协程命名空间
+         */
+        namespace Coroutine
+        {
+            /**
+             * @class AsyncSemaphore
+             * @brief 协程信号量
+             * @note 等待者按 FIFO 顺序在执行器上恢复，而不是在释放方线程上内联恢复
+             */
+            class AsyncSemaphore
+            {
+            public:
+                /**
+                 * @brief 获取许可的 awaiter
+                 */
+                class AcquireAwaiter
+                {
+                public:
+                    /**
+                     * @brief 构造函数
+                     * @param semaphore 信号量
+                     * @param token 取消令牌
+                     */
+                    explicit AcquireAwaiter(AsyncSemaphore& semaphore, Cancellation::CancellationToken token = {})noexcept :
+                        m_semaphore(semaphore), m_token(std::move(token))
+                    {
+                    }
+                    /**
+                     * @brief 尝试直接获取许可
+                     * @note 失败时已登记为等待者，随后必定进入 await_suspend；令牌已取消时不登记
+                     * @return bool 是否无需挂起
+                     */
+                    bool await_ready()noexcept
+                    {
+                        if (m_token.is_cancellation_requested())
+                        {
+                            m_is_cancelled = true;
+                            return true;
+                        }
+                        return m_semaphore.m_count.fetch_sub(1, std::memory_order_acq_rel) > 0;
+                    }
+                    /**
+                     * @brief 挂起等待许可
+                     * @param handle 当前协程
+                     * @return bool 是否挂起；已有待领取的唤醒或已取消时不挂起
+                     */
+                    bool await_suspend(std::coroutine_handle<> handle)
+                    {
+                        m_handle = handle;
+                        if (m_token.get_stop_token().stop_possible())
+                        {
+                            m_callback.emplace(m_token, CancelWaiter{ this });
+                        }
+                        return m_semaphore.enqueue(*this);
+                    }
+                    /**
+                     * @brief 恢复，此时已持有许可
+                     * @throws Cancellation::OperationCancelled 等待被取消，未持有许可
+                     */
+                    void await_resume()const
+                    {
+                        if (m_is_cancelled)
+                        {
+                            throw Cancellation::OperationCancelled();
+                        }
+                    }
+                private:
+                    friend class AsyncSemaphore;
+                    /**
+                     * @brief 登记在令牌上的取消回调
+                     */
+                    struct CancelWaiter
+                    {
+                        /// @brief 等待者
+                        AcquireAwaiter* awaiter;
+                        /**
+                         * @brief 取消等待
+                         */
+                        void operator()()
+                        {
+                            awaiter->m_semaphore.cancel(*awaiter);
+                        }
+                    };
+                    /**
+                     * @enum State
+                     * @brief 登记状态
+                     */
+                    enum class State
+                    {
+                        /// @brief 尚未进入等待队列
+                        Pending,
+                        /// @brief 在等待队列中
+                        Enqueued,
+                        /// @brief 已领取待领取的唤醒
+                        Acquired
+                    };
+                private:
+                    /// @brief 信号量
+                    AsyncSemaphore& m_semaphore;
+                    /// @brief 取消令牌
+                    Cancellation::CancellationToken m_token;
+                    /// @brief 等待的协程
+                    std::coroutine_handle<> m_handle;
+                    /// @brief 登记状态，由信号量互斥锁保护
+                    State m_state = State::Pending;
+                    /// @brief 是否已取消
+                    bool m_is_cancelled = false;
+                    /// @brief 取消回调
+                    std::optional<Cancellation::CancellationCallback<CancelWaiter>> m_callback;
+                };
+            public:
+                /**
+                 * @brief 构造函数
+                 * @param executor 恢复等待者的执行器
+                 * @param initial_count 初始许可数
+                 */
+                AsyncSemaphore(ThreadPool::IExecutor& executor, std::int64_t initial_count) :
+                    m_executor(executor), m_count(initial_count)
+                {
+                }
+                /**
+                 * @brief 获取一个许可
+                 * @return AcquireAwaiter
+                 */
+                AcquireAwaiter acquire()noexcept
+                {
+                    return AcquireAwaiter(*this);
+                }
+                /**
+                 * @brief 可取消地获取一个许可
+                 * @note 取消时 co_await 抛出 OperationCancelled 且不持有许可
+                 * @param token 取消令牌
+                 * @return AcquireAwaiter
+                 */
+                AcquireAwaiter acquire(Cancellation::CancellationToken token)noexcept
+                {
+                    return AcquireAwaiter(*this, std::move(token));
+                }
+                /**
+                 * @brief 尝试获取一个许可
+                 * @return bool 是否获取成功
+                 */
+                bool try_acquire()noexcept
+                {
+                    std::int64_t count = m_count.load(std::memory_order_relaxed);
+                    while (count > 0)
+                    {
+                        if (m_count.compare_exchange_weak(count, count - 1, std::memory_order_acq_rel, std::memory_order_relaxed))
+                        {
+                            return true;
+                        }
+                    }
+                    return false;
+                }
+                /**
+                 * @brief 释放许可
+                 * @param count 释放数量
+                 */
+                void release(std::int64_t count = 1)
+                {
+                    for (std::int64_t i = 0; i < count; ++i)
+                    {
+                        if (m_count.fetch_add(1, std::memory_order_acq_rel) < 0)
+                        {
+                            wake_one();
+                        }
+                    }
+                }
+                /**
+                 * @brief 获取可用许可数
+                 * @return std::int64_t 可用许可数
+                 */
+                std::int64_t get_available()const noexcept
+                {
+                    std::int64_t count = m_count.load(std::memory_order_relaxed);
+                    return count > 0 ? count : 0;
+                }
+            private:
+                /**
+                 * @brief 拷贝构造函数
+                 * @note 禁止拷贝构造
+                 */
+                AsyncSemaphore(const AsyncSemaphore&) = delete;
+                /**
+                 * @brief 拷贝赋值运算符
+                 * @note 禁止拷贝赋值
+                 */
+                AsyncSemaphore& operator=(const AsyncSemaphore&) = delete;
+                /**
+                 * @brief 登记挂起的等待者
+                 * @param waiter 等待者
+                 * @return bool 是否需要挂起
+                 */
+                bool enqueue(AcquireAwaiter& waiter)
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    if (m_pending_wakeup_count > 0)
+                    {
+                        --m_pending_wakeup_count;
+                        waiter.m_state = AcquireAwaiter::State::Acquired;
+                        waiter.m_is_cancelled = false;
+                        return false;
+                    }
+                    if (waiter.m_is_cancelled)
+                    {
+                        // 已登记的计数由占位转交
+                        m_waiters.push_back(nullptr);
+                        return false;
+                    }
+                    m_waiters.push_back(waiter.m_handle);
+                    waiter.m_state = AcquireAwaiter::State::Enqueued;
+                    return true;
+                }
+                /**
+                 * @brief 取消等待者
+                 * @param waiter 等待者
+                 */
+                void cancel(AcquireAwaiter& waiter)
+                {
+                    std::coroutine_handle<> handle;
+                    {
+                        std::lock_guard<std::mutex> lock(m_mutex);
+                        if (waiter.m_state == AcquireAwaiter::State::Pending)
+                        {
+                            waiter.m_is_cancelled = true;
+                            return;
+                        }
+                        if (waiter.m_state == AcquireAwaiter::State::Acquired)
+                        {
+                            return;
+                        }
+                        auto iterator = std::find(m_waiters.begin(), m_waiters.end(), waiter.m_handle);
+                        if (iterator == m_waiters.end())
+                        {
+                            // 已被唤醒，按获取成功处理
+                            return;
+                        }
+                        *iterator = nullptr;
+                        waiter.m_is_cancelled = true;
+                        handle = waiter.m_handle;
+                    }
+                    m_executor.execute(ThreadPool::Task(ResumeOnExecutor{ handle }));
+                }
+                /**
+                 * @brief 唤醒一个等待者
+                 * @note 等待者已登记计数但尚未入队时，记为待领取的唤醒；遇到取消占位时把许可转交给下一个
+                 */
+                void wake_one()
+                {
+                    std::coroutine_handle<> handle;
+                    {
+                        std::lock_guard<std::mutex> lock(m_mutex);
+                        while (true)
+                        {
+                            if (m_waiters.empty())
+                            {
+                                ++m_pending_wakeup_count;
+                                return;
+                            }
+                            handle = m_waiters.front();
+                            m_waiters.pop_front();
+                            if (handle)
+                            {
+                                break;
+                            }
+                            if (m_count.fetch_add(1, std::memory_order_acq_rel) >= 0)
+                            {
+                                return;
+                            }
+                        }
+                    }
+                    m_executor.execute(ThreadPool::Task(ResumeOnExecutor{ handle }));
+                }
+            private:
+                /// @brief 恢复等待者的执行器
+                ThreadPool::IExecutor& m_executor;
+                /// @brief 许可计数，负数表示等待者数量
+                std::atomic<std::int64_t> m_count;
+                /// @brief 等待队列互斥锁
+                std::mutex m_mutex;
+                /// @brief 等待队列，空句柄为已取消等待者的占位
+                std::deque<std::coroutine_handle<>> m_waiters;
+                /// @brief 待领取的唤醒数
+                std::size_t m_pending_wakeup_count = 0;
+            };
+        }
+    }
+}
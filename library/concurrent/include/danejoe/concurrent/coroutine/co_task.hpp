@@ -0,0 +1,576 @@
+#pragma once
+
+/**
+ * @file co_task.hpp
+ * @author DaneJoe001
+ * @version 0.1.1
+ * @brief 协程任务
+ * @details 惰性启动的协程任务；被 co_await 时才开始执行，完成后对称转移回等待方
+ * @date 2026-10-18
+ */
+
+#include <utility>
+#include <optional>
+#include <exception>
+#include <coroutine>
+#include <type_traits>
+
+#include "danejoe/concurrent/thread_pool/task.hpp"
+#include "danejoe/concurrent/thread_pool/future.hpp"
+#include "danejoe/concurrent/thread_pool/executor.hpp"
+#include "danejoe/concurrent/cancellation/cancellation_token.hpp"
+
+/**
+ * @namespace DaneJoe
+ * @brief DaneJoe命名空间
+ */
+namespace DaneJoe
+{
+    /**
+     * @namespace Concurrent
+     * @brief 并发命名空间
+     */
+    namespace Concurrent
+    {
+        /**
+         * @namespace Coroutine
+         * @brief 协程命名空间
+         */
+        namespace Coroutine
+        {
+            template<class T>
+            class CoTask;
+            /**
+             * @namespace Detail
+             * @brief 实现细节
+             */
+            namespace Detail
+            {
+                /**
+                 * @class CoTaskPromiseBase
+                 * @brief 协程任务 promise 公共部分
+                 */
+                class CoTaskPromiseBase
+                {
+                public:
+                    /**
+                     * @brief 结束时转移回等待方
+                     */
+                    struct FinalAwaiter
+                    {
+                        /**
+                         * @brief 总是挂起
+                         * @return bool false
+                         */
+                        bool await_ready()const noexcept
+                        {
+                            return false;
+                        }
+                        /**
+                         * @brief 转移到等待方
+                         * @tparam Promise promise 类型
+                         * @param handle 当前协程
+                         * @return std::coroutine_handle<> 等待方，无等待方时为 noop
+                         */
+                        template<class Promise>
+                        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle)noexcept
+                        {
+                            std::coroutine_handle<> continuation = handle.promise().m_continuation;
+                            return continuation ? continuation : std::noop_coroutine();
+                        }
+                        /**
+                         * @brief 恢复（不会发生）
+                         */
+                        void await_resume()const noexcept {}
+                    };
+                public:
+                    /**
+                     * @brief 初始挂起，实现惰性启动
+                     * @return std::suspend_always
+                     */
+                    std::suspend_always initial_suspend()const noexcept
+                    {
+                        return {};
+                    }
+                    /**
+                     * @brief 结束挂起
+                     * @return FinalAwaiter
+                     */
+                    FinalAwaiter final_suspend()const noexcept
+                    {
+                        return {};
+                    }
+                    /**
+                     * @brief 记录未处理异常
+                     */
+                    void unhandled_exception()noexcept
+                    {
+                        m_exception = std::current_exception();
+                    }
+                    /**
+                     * @brief 设置等待方
+                     * @param continuation 等待方
+                     */
+                    void set_continuation(std::coroutine_handle<> continuation)noexcept
+                    {
+                        m_continuation = continuation;
+                    }
+                protected:
+                    /**
+                     * @brief 若以异常结束则重新抛出
+                     */
+                    void rethrow_if_exception()
+                    {
+                        if (m_exception)
+                        {
+                            std::rethrow_exception(m_exception);
+                        }
+                    }
+                private:
+                    /// @brief 等待方
+                    std::coroutine_handle<> m_continuation;
+                    /// @brief 异常
+                    std::exception_ptr m_exception;
+                };
+                /**
+                 * @class CoTaskPromise
+                 * @brief 带返回值的协程任务 promise
+                 * @tparam T 返回值类型
+                 */
+                template<class T>
+                class CoTaskPromise : public CoTaskPromiseBase
+                {
+                public:
+                    /**
+                     * @brief 获取协程任务
+                     * @return CoTask<T>
+                     */
+                    CoTask<T> get_return_object()noexcept;
+                    /**
+                     * @brief 设置返回值
+                     * @tparam U 值类型
+                     * @param value 返回值
+                     */
+                    template<class U>
+                    void return_value(U&& value)
+                    {
+                        m_value.emplace(std::forward<U>(value));
+                    }
+                    /**
+                     * @brief 取出结果
+                     * @return T 结果
+                     */
+                    T take_result()
+                    {
+                        rethrow_if_exception();
+                        return std::move(*m_value);
+                    }
+                private:
+                    /// @brief 返回值
+                    std::optional<T> m_value;
+                };
+                /**
+                 * @class CoTaskPromise<void>
+                 * @brief 无返回值的协程任务 promise
+                 */
+                template<>
+                class CoTaskPromise<void> : public CoTaskPromiseBase
+                {
+                public:
+                    /**
+                     * @brief 获取协程任务
+                     * @return CoTask<void>
+                     */
+                    CoTask<void> get_return_object()noexcept;
+                    /**
+                     * @brief 结束
+                     */
+                    void return_void()noexcept {}
+                    /**
+                     * @brief 取出结果
+                     */
+                    void take_result()
+                    {
+                        rethrow_if_exception();
+                    }
+                };
+            }
+            /**
+             * @class CoTask
+             * @brief 协程任务
+             * @tparam T 返回值类型
+             */
+            template<class T = void>
+            class CoTask
+            {
+            public:
+                /// @brief promise 类型
+                using promise_type = Detail::CoTaskPromise<T>;
+                /**
+                 * @brief 等待协程任务完成的 awaiter
+                 */
+                class Awaiter
+                {
+                public:
+                    /**
+                     * @brief 构造函数
+                     * @param handle 协程句柄
+                     */
+                    explicit Awaiter(std::coroutine_handle<promise_type> handle)noexcept :m_handle(handle) {}
+                    /**
+                     * @brief 判断是否无需挂起
+                     * @return bool 是否已完成
+                     */
+                    bool await_ready()const noexcept
+                    {
+                        return !m_handle || m_handle.done();
+                    }
+                    /**
+                     * @brief 启动协程任务并挂起等待方
+                     * @param continuation 等待方
+                     * @return std::coroutine_handle<> 协程任务
+                     */
+                    std::coroutine_handle<> await_suspend(std::coroutine_handle<> continuation)noexcept
+                    {
+                        m_handle.promise().set_continuation(continuation);
+                        return m_handle;
+                    }
+                    /**
+                     * @brief 获取结果
+                     * @return T 结果
+                     */
+                    T await_resume()
+                    {
+                        return m_handle.promise().take_result();
+                    }
+                private:
+                    /// @brief 协程句柄
+                    std::coroutine_handle<promise_type> m_handle;
+                };
+            public:
+                /**
+                 * @brief 构造空任务
+                 */
+                CoTask()noexcept = default;
+                /**
+                 * @brief 由协程句柄构造
+                 * @param handle 协程句柄
+                 */
+                explicit CoTask(std::coroutine_handle<promise_type> handle)noexcept :m_handle(handle) {}
+                /**
+                 * @brief 移动构造函数
+                 * @param other 其他任务
+                 */
+                CoTask(CoTask&& other)noexcept :m_handle(std::exchange(other.m_handle, nullptr)) {}
+                /**
+                 * @brief 移动赋值运算符
+                 * @param other 其他任务
+                 * @return CoTask&
+                 */
+                CoTask& operator=(CoTask&& other)noexcept
+                {
+                    if (this != &other)
+                    {
+                        reset();
+                        m_handle = std::exchange(other.m_handle, nullptr);
+                    }
+                    return *this;
+                }
+                /**
+                 * @brief 析构函数
+                 */
+                ~CoTask()
+                {
+                    reset();
+                }
+                /**
+                 * @brief 等待任务完成
+                 * @return Awaiter
+                 */
+                Awaiter operator co_await()const noexcept
+                {
+                    return Awaiter(m_handle);
+                }
+                /**
+                 * @brief 判断任务是否已完成
+                 * @return bool 是否已完成
+                 */
+                bool is_done()const noexcept
+                {
+                    return !m_handle || m_handle.done();
+                }
+            private:
+                /**
+                 * @brief 拷贝构造函数
+                 * @note 禁止拷贝构造
+                 */
+                CoTask(const CoTask&) = delete;
+                /**
+                 * @brief 拷贝赋值运算符
+                 * @note 禁止拷贝赋值
+                 */
+                CoTask& operator=(const CoTask&) = delete;
+                /**
+                 * @brief 销毁协程帧
+                 */
+                void reset()noexcept
+                {
+                    if (m_handle)
+                    {
+                        std::exchange(m_handle, nullptr).destroy();
+                    }
+                }
+            private:
+                /// @brief 协程句柄
+                std::coroutine_handle<promise_type> m_handle;
+            };
+            template<class T>
+            CoTask<T> Detail::CoTaskPromise<T>::get_return_object()noexcept
+            {
+                return CoTask<T>(std::coroutine_handle<CoTaskPromise<T>>::from_promise(*this));
+            }
+            inline CoTask<void> Detail::CoTaskPromise<void>::get_return_object()noexcept
+            {
+                return CoTask<void>(std::coroutine_handle<CoTaskPromise<void>>::from_promise(*this));
+            }
+            /**
+             * @brief 在执行器上恢复协程的任务体
+             */
+            struct ResumeOnExecutor
+            {
+                /// @brief 协程句柄
+                std::coroutine_handle<> handle;
+                /**
+                 * @brief 恢复协程
+                 */
+                void operator()()const
+                {
+                    handle.resume();
+                }
+            };
+            /**
+             * @brief 切换到执行器的 awaiter
+             */
+            class ScheduleAwaiter
+            {
+            public:
+                /**
+                 * @brief 构造函数
+                 * @param executor 执行器
+                 * @param token 取消令牌
+                 */
+                explicit ScheduleAwaiter(ThreadPool::IExecutor& executor, Cancellation::CancellationToken token = {})noexcept :
+                    m_executor(executor), m_token(std::move(token))
+                {
+                }
+                /**
+                 * @brief 已取消时不挂起，否则挂起
+                 * @return bool 是否已取消
+                 */
+                bool await_ready()const noexcept
+                {
+                    return m_token.is_cancellation_requested();
+                }
+                /**
+                 * @brief 投递恢复任务
+                 * @param handle 当前协程
+                 */
+                void await_suspend(std::coroutine_handle<> handle)
+                {
+                    m_executor.execute(ThreadPool::Task(ResumeOnExecutor{ handle }));
+                }
+                /**
+                 * @brief 恢复
+                 * @throws Cancellation::OperationCancelled 令牌已取消
+                 */
+                void await_resume()const
+                {
+                    m_token.throw_if_cancellation_requested();
+                }
+            private:
+                /// @brief 执行器
+                ThreadPool::IExecutor& m_executor;
+                /// @brief 取消令牌
+                Cancellation::CancellationToken m_token;
+            };
+            /**
+             * @brief 切换到执行器继续执行
+             * @note 执行器拒绝任务（如线程池已关闭）时协程不会恢复
+             * @param executor 执行器
+             * @return ScheduleAwaiter
+             */
+            inline ScheduleAwaiter schedule(ThreadPool::IExecutor& executor)noexcept
+            {
+                return ScheduleAwaiter(executor);
+            }
+            /**
+             * @brief 切换到执行器继续执行，令牌已取消时抛出 OperationCancelled
+             * @note 挂起前或恢复时检查令牌；可用作协程中的取消点
+             * @param executor 执行器
+             * @param token 取消令牌
+             * @return ScheduleAwaiter
+             */
+            inline ScheduleAwaiter schedule(ThreadPool::IExecutor& executor, Cancellation::CancellationToken token)noexcept
+            {
+                return ScheduleAwaiter(executor, std::move(token));
+            }
+            namespace Detail
+            {
+                /**
+                 * @class DetachedCoroutine
+                 * @brief 自行销毁的分离协程
+                 */
+                class DetachedCoroutine
+                {
+                public:
+                    /**
+                     * @brief 分离协程 promise
+                     */
+                    struct promise_type
+                    {
+                        /**
+                         * @brief 获取协程对象
+                         * @return DetachedCoroutine
+                         */
+                        DetachedCoroutine get_return_object()noexcept
+                        {
+                            return DetachedCoroutine(std::coroutine_handle<promise_type>::from_promise(*this));
+                        }
+                        /**
+                         * @brief 初始挂起，由执行器启动
+                         * @return std::suspend_always
+                         */
+                        std::suspend_always initial_suspend()const noexcept
+                        {
+                            return {};
+                        }
+                        /**
+                         * @brief 结束时不挂起，协程帧自动销毁
+                         * @return std::suspend_never
+                         */
+                        std::suspend_never final_suspend()const noexcept
+                        {
+                            return {};
+                        }
+                        /**
+                         * @brief 结束
+                         */
+                        void return_void()const noexcept {}
+                        /**
+                         * @brief 未处理异常
+                         * @note 分离协程内部已捕获全部异常
+                         */
+                        void unhandled_exception()const noexcept
+                        {
+                            std::terminate();
+                        }
+                    };
+                    /**
+                     * @brief 构造函数
+                     * @param handle 协程句柄
+                     */
+                    explicit DetachedCoroutine(std::coroutine_handle<promise_type> handle)noexcept :m_handle(handle) {}
+                    /**
+                     * @brief 获取协程句柄
+                     * @return std::coroutine_handle<promise_type>
+                     */
+                    std::coroutine_handle<promise_type> get_handle()const noexcept
+                    {
+                        return m_handle;
+                    }
+                private:
+                    /// @brief 协程句柄
+                    std::coroutine_handle<promise_type> m_handle;
+                };
+                /**
+                 * @class DetachedStarter
+                 * @brief 启动分离协程的任务体
+                 * @details 未执行即被销毁时销毁协程帧，其中的 Promise 随之以 broken_promise 结束
+                 */
+                class DetachedStarter
+                {
+                public:
+                    /**
+                     * @brief 构造函数
+                     * @param handle 协程句柄
+                     */
+                    explicit DetachedStarter(std::coroutine_handle<> handle)noexcept :m_handle(handle) {}
+                    /**
+                     * @brief 移动构造函数
+                     * @param other 其他任务体
+                     */
+                    DetachedStarter(DetachedStarter&& other)noexcept :m_handle(std::exchange(other.m_handle, nullptr)) {}
+                    /**
+                     * @brief 析构函数
+                     */
+                    ~DetachedStarter()
+                    {
+                        if (m_handle)
+                        {
+                            m_handle.destroy();
+                        }
+                    }
+                    /**
+                     * @brief 启动协程
+                     */
+                    void operator()()
+                    {
+                        std::exchange(m_handle, nullptr).resume();
+                    }
+                private:
+                    /**
+                     * @brief 移动赋值运算符
+                     * @note 禁止移动赋值
+                     */
+                    DetachedStarter& operator=(DetachedStarter&&) = delete;
+                private:
+                    /// @brief 协程句柄
+                    std::coroutine_handle<> m_handle;
+                };
+                /**
+                 * @brief 执行协程任务并将结果写入 Promise
+                 * @tparam T 返回值类型
+                 * @param task 协程任务
+                 * @param promise 结果
+                 * @return DetachedCoroutine
+                 */
+                template<class T>
+                DetachedCoroutine run_detached(CoTask<T> task, ThreadPool::Promise<T> promise)
+                {
+                    try
+                    {
+                        if constexpr (std::is_void_v<T>)
+                        {
+                            co_await task;
+                            promise.set_value();
+                        }
+                        else
+                        {
+                            promise.set_value(co_await task);
+                        }
+                    }
+                    catch (...)
+                    {
+                        promise.set_exception(std::current_exception());
+                    }
+                }
+            }
+            /**
+             * @brief 在执行器上启动协程任务
+             * @tparam T 返回值类型
+             * @param executor 执行器
+             * @param task 协程任务
+             * @return ThreadPool::Future<T> 结果；执行器拒绝时以 broken_promise 完成
+             */
+            template<class T>
+            ThreadPool::Future<T> spawn(ThreadPool::IExecutor& executor, CoTask<T> task)
+            {
+                ThreadPool::Promise<T> promise;
+                ThreadPool::Future<T> future = promise.get_future();
+                Detail::DetachedCoroutine coroutine = Detail::run_detached(std::move(task), std::move(promise));
+                executor.execute(ThreadPool::Task(Detail::DetachedStarter(coroutine.get_handle())));
+                return future;
+            }
+        }
+    }
+}
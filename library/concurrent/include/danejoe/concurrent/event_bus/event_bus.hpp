@@ -0,0 +1,125 @@
+#pragma once
+
+/**
+ * @file event_bus.hpp
+ * @author DaneJoe001
+ * @version 0.1.1
+ * @brief 进程内事件总线
+ * @details 按名称登记类型化主题；查找主题时持锁，发布直接作用于主题，不经过总线
+ * @date 2026-10-18
+ */
+
+#include <mutex>
+#include <memory>
+#include <string>
+#include <cstddef>
+#include <typeindex>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "danejoe/concurrent/event_bus/topic.hpp"
+
+/**
+ * @namespace DaneJoe
+ * @brief DaneJoe命名空间
+ */
+namespace DaneJoe
+{
+    /**
+     * @namespace Concurrent
+     * @brief 并发命名空间
+     */
+    namespace Concurrent
+    {
+        /**
+         * @namespace EventBus
+         * @brief 事件总线命名空间
+         */
+        namespace EventBus
+        {
+            /**
+             * @class EventBus
+             * @brief 进程内事件总线
+             * @note 调用方应缓存 get_topic() 返回的主题并直接在其上发布
+             */
+            class EventBus
+            {
+            public:
+                /**
+                 * @brief 构造函数
+                 */
+                EventBus() = default;
+                /**
+                 * @brief 获取或创建主题
+                 * @tparam T 事件类型
+                 * @param name 主题名
+                 * @return std::shared_ptr<Topic<T>> 主题
+                 * @throws std::invalid_argument 同名主题已以其他事件类型创建
+                 */
+                template<class T>
+                std::shared_ptr<Topic<T>> get_topic(const std::string& name)
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    auto iterator = m_topics.find(name);
+                    if (iterator == m_topics.end())
+                    {
+                        auto topic = std::make_shared<Topic<T>>();
+                        m_topics.emplace(name, Entry{ std::type_index(typeid(T)), topic });
+                        return topic;
+                    }
+                    if (iterator->second.type != std::type_index(typeid(T)))
+                    {
+                        throw std::invalid_argument("EventBus topic type mismatch: " + name);
+                    }
+                    return std::static_pointer_cast<Topic<T>>(iterator->second.topic);
+                }
+                /**
+                 * @brief 判断主题是否存在
+                 * @param name 主题名
+                 * @return bool 是否存在
+                 */
+                bool has_topic(const std::string& name)const
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    return m_topics.find(name) != m_topics.end();
+                }
+                /**
+                 * @brief 获取主题数
+                 * @return std::size_t 主题数
+                 */
+                std::size_t get_topic_count()const
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    return m_topics.size();
+                }
+            private:
+                /**
+                 * @brief 主题登记项
+                 */
+                struct Entry
+                {
+                    /// @brief 事件类型
+                    std::type_index type;
+                    /// @brief 主题
+                    std::shared_ptr<Detail::TopicBase> topic;
+                };
+            private:
+                /**
+                 * @brief 拷贝构造函数
+                 * @note 禁止拷贝构造
+                 */
+                EventBus(const EventBus&) = delete;
+                /**
+                 * @brief 拷贝赋值运算符
+                 * @note 禁止拷贝赋值
+                 */
+                EventBus& operator=(const EventBus&) = delete;
+            private:
+                /// @brief 互斥锁，仅保护主题表
+                mutable std::mutex m_mutex;
+                /// @brief 主题表
+                std::unordered_map<std::string, Entry> m_topics;
+            };
+        }
+    }
+}
@@ -0,0 +1,621 @@
+#pragma once
+
+/**
+ * @file topic.hpp
+ * @author DaneJoe001
+ * @version 0.1.1
+ * @brief 类型化发布订阅主题
+ * @details 订阅者列表为写时复制的不可变快照，以原始指针原子发布，被替换的快照经纪元回收释放；
+ *          发布只需进入纪元临界区并做一次原子加载再逐个投递，不持有主题级锁，也不修改任何共享计数。
+ *          订阅者可同步处理（在发布线程调用），也可在执行器上通过有界邮箱异步处理
+ * @date 2026-10-18
+ */
+
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include <optional>
+#include <algorithm>
+#include <functional>
+#include <condition_variable>
+
+#include "danejoe/concurrent/thread_pool/task.hpp"
+#include "danejoe/concurrent/thread_pool/executor.hpp"
+#include "danejoe/concurrent/lock_free/epoch_domain.hpp"
+
+/**
+ * @namespace DaneJoe
+ * @brief DaneJoe命名空间
+ */
+namespace DaneJoe
+{
+    /**
+     * @namespace Concurrent
+     * @brief 并发命名空间
+     */
+    namespace Concurrent
+    {
+        /**
+         * @namespace EventBus
+         * @brief 事件总线命名空间
+         */
+        namespace EventBus
+        {
+            /**
+             * @enum OverflowPolicy
+             * @brief 邮箱已满时的处理策略
+             */
+            enum class OverflowPolicy
+            {
+                /// @brief 丢弃新事件
+                DropNewest,
+                /// @brief 丢弃最旧的事件
+                DropOldest,
+                /// @brief 阻塞发布者直到有空位
+                Block
+            };
+            /**
+             * @struct MailboxOptions
+             * @brief 异步订阅者的邮箱配置
+             */
+            struct MailboxOptions
+            {
+                /// @brief 邮箱容量
+                std::size_t capacity = 1024;
+                /// @brief 已满时的处理策略
+                OverflowPolicy policy = OverflowPolicy::DropNewest;
+                /// @brief 单次调度最多处理的事件数
+                std::size_t batch_size = 64;
+            };
+            /**
+             * @namespace Detail
+             * @brief 实现细节
+             */
+            namespace Detail
+            {
+                /**
+                 * @class SubscriberBase
+                 * @brief 订阅者公共部分
+                 */
+                class SubscriberBase
+                {
+                public:
+                    /**
+                     * @brief 析构函数
+                     */
+                    virtual ~SubscriberBase() = default;
+                    /**
+                     * @brief 判断是否仍处于订阅状态
+                     * @return bool 是否订阅中
+                     */
+                    bool is_active()const noexcept
+                    {
+                        return m_is_active.load(std::memory_order_acquire);
+                    }
+                    /**
+                     * @brief 停止接收事件
+                     */
+                    virtual void deactivate()
+                    {
+                        m_is_active.store(false, std::memory_order_release);
+                    }
+                    /**
+                     * @brief 获取因溢出被丢弃的事件数
+                     * @return std::size_t 丢弃数
+                     */
+                    std::size_t get_dropped_count()const noexcept
+                    {
+                        return m_dropped_count.load(std::memory_order_relaxed);
+                    }
+                    /**
+                     * @brief 获取尚未处理的事件数
+                     * @return std::size_t 积压事件数
+                     */
+                    virtual std::size_t get_pending_count()const
+                    {
+                        return 0;
+                    }
+                protected:
+                    /// @brief 是否订阅中
+                    std::atomic<bool> m_is_active = true;
+                    /// @brief 因溢出被丢弃的事件数
+                    std::atomic<std::size_t> m_dropped_count = 0;
+                };
+                /**
+                 * @class TopicBase
+                 * @brief 主题公共部分，供取消订阅回调
+                 */
+                class TopicBase
+                {
+                public:
+                    /**
+                     * @brief 析构函数
+                     */
+                    virtual ~TopicBase() = default;
+                    /**
+                     * @brief 移除订阅者
+                     * @param subscriber 订阅者
+                     */
+                    virtual void remove(const SubscriberBase* subscriber) = 0;
+                };
+                /**
+                 * @class Subscriber
+                 * @brief 类型化订阅者
+                 * @tparam T 事件类型
+                 */
+                template<class T>
+                class Subscriber : public SubscriberBase
+                {
+                public:
+                    /**
+                     * @brief 投递事件
+                     * @param event 事件
+                     * @return bool 是否被接收
+                     */
+                    virtual bool deliver(const T& event) = 0;
+                };
+                /**
+                 * @class SyncSubscriber
+                 * @brief 同步订阅者，在发布线程上直接调用处理函数
+                 * @tparam T 事件类型
+                 */
+                template<class T>
+                class SyncSubscriber : public Subscriber<T>
+                {
+                public:
+                    /**
+                     * @brief 构造函数
+                     * @param handler 处理函数
+                     */
+                    explicit SyncSubscriber(std::function<void(const T&)> handler) :
+                        m_handler(std::move(handler))
+                    {
+                    }
+                    /**
+                     * @brief 投递事件
+                     * @note 处理函数抛出的异常被忽略，不影响其他订阅者
+                     * @param event 事件
+                     * @return bool 是否被接收
+                     */
+                    bool deliver(const T& event)override
+                    {
+                        if (!this->is_active())
+                        {
+                            return false;
+                        }
+                        try
+                        {
+                            m_handler(event);
+                        }
+                        catch (...)
+                        {
+                        }
+                        return true;
+                    }
+                private:
+                    /// @brief 处理函数
+                    std::function<void(const T&)> m_handler;
+                };
+                /**
+                 * @class PooledSubscriber
+                 * @brief 异步订阅者，事件进入有界邮箱后在执行器上按序处理
+                 * @details 邮箱由空变为非空时向执行器投递一次处理任务，每次最多处理 batch_size 个事件；
+                 *          同一订阅者的处理函数不会并发执行
+                 * @tparam T 事件类型
+                 */
+                template<class T>
+                class PooledSubscriber : public Subscriber<T>, public std::enable_shared_from_this<PooledSubscriber<T>>
+                {
+                public:
+                    /**
+                     * @brief 构造函数
+                     * @param executor 执行器，需在全部事件处理完之前保持有效
+                     * @param handler 处理函数
+                     * @param options 邮箱配置
+                     */
+                    PooledSubscriber(ThreadPool::IExecutor& executor, std::function<void(const T&)> handler, const MailboxOptions& options) :
+                        m_executor(executor),
+                        m_handler(std::move(handler)),
+                        m_capacity(options.capacity == 0 ? 1 : options.capacity),
+                        m_batch_size(options.batch_size == 0 ? 1 : options.batch_size),
+                        m_policy(options.policy)
+                    {
+                    }
+                    /**
+                     * @brief 投递事件
+                     * @note Block 策略下不要在本订阅者的处理函数中向同一主题发布，否则可能死锁
+                     * @param event 事件
+                     * @return bool 是否进入邮箱
+                     */
+                    bool deliver(const T& event)override
+                    {
+                        bool should_schedule = false;
+                        {
+                            std::unique_lock<std::mutex> lock(m_mutex);
+                            if (m_events.size() >= m_capacity)
+                            {
+                                switch (m_policy)
+                                {
+                                case OverflowPolicy::DropNewest:
+                                    this->m_dropped_count.fetch_add(1, std::memory_order_relaxed);
+                                    return false;
+                                case OverflowPolicy::DropOldest:
+                                    m_events.pop_front();
+                                    this->m_dropped_count.fetch_add(1, std::memory_order_relaxed);
+                                    break;
+                                case OverflowPolicy::Block:
+                                    m_space_cv.wait(lock, [this]()
+                                        {
+                                            return m_events.size() < m_capacity || !this->is_active();
+                                        });
+                                    break;
+                                }
+                            }
+                            if (!this->is_active())
+                            {
+                                return false;
+                            }
+                            m_events.push_back(event);
+                            should_schedule = !std::exchange(m_is_scheduled, true);
+                        }
+                        if (should_schedule)
+                        {
+                            schedule();
+                        }
+                        return true;
+                    }
+                    /**
+                     * @brief 停止接收事件并唤醒阻塞的发布者
+                     * @note 邮箱中尚未处理的事件被丢弃
+                     */
+                    void deactivate()override
+                    {
+                        {
+                            std::lock_guard<std::mutex> lock(m_mutex);
+                            this->m_is_active.store(false, std::memory_order_release);
+                            m_events.clear();
+                        }
+                        m_space_cv.notify_all();
+                    }
+                    /**
+                     * @brief 获取尚未处理的事件数
+                     * @return std::size_t 积压事件数
+                     */
+                    std::size_t get_pending_count()const override
+                    {
+                        std::lock_guard<std::mutex> lock(m_mutex);
+                        return m_events.size();
+                    }
+                private:
+                    /**
+                     * @brief 向执行器投递处理任务
+                     */
+                    void schedule()
+                    {
+                        m_executor.execute(ThreadPool::Task([self = this->shared_from_this()]()
+                            {
+                                self->drain();
+                            }));
+                    }
+                    /**
+                     * @brief 按序处理邮箱中的事件
+                     */
+                    void drain()
+                    {
+                        for (std::size_t i = 0; i < m_batch_size; ++i)
+                        {
+                            std::optional<T> event;
+                            {
+                                std::lock_guard<std::mutex> lock(m_mutex);
+                                if (m_events.empty())
+                                {
+                                    m_is_scheduled = false;
+                                    return;
+                                }
+                                event.emplace(std::move(m_events.front()));
+                                m_events.pop_front();
+                            }
+                            m_space_cv.notify_one();
+                            if (!this->is_active())
+                            {
+                                continue;
+                            }
+                            try
+                            {
+                                m_handler(*event);
+                            }
+                            catch (...)
+                            {
+                            }
+                        }
+                        {
+                            std::lock_guard<std::mutex> lock(m_mutex);
+                            if (m_events.empty())
+                            {
+                                m_is_scheduled = false;
+                                return;
+                            }
+                        }
+                        schedule();
+                    }
+                private:
+                    /// @brief 执行器
+                    ThreadPool::IExecutor& m_executor;
+                    /// @brief 处理函数
+                    std::function<void(const T&)> m_handler;
+                    /// @brief 邮箱容量
+                    std::size_t m_capacity;
+                    /// @brief 单次调度最多处理的事件数
+                    std::size_t m_batch_size;
+                    /// @brief 溢出策略
+                    OverflowPolicy m_policy;
+                    /// @brief 互斥锁
+                    mutable std::mutex m_mutex;
+                    /// @brief 有空位条件变量
+                    std::condition_variable m_space_cv;
+                    /// @brief 邮箱
+                    std::deque<T> m_events;
+                    /// @brief 是否已投递处理任务
+                    bool m_is_scheduled = false;
+                };
+            }
+            /**
+             * @class Subscription
+             * @brief 订阅句柄
+             * @details 析构或调用 unsubscribe() 时取消订阅；
+             *          取消前已开始的同步投递可能仍在其他线程上执行完
+             */
+            class Subscription
+            {
+            public:
+                /**
+                 * @brief 构造空句柄
+                 */
+                Subscription() = default;
+                /**
+                 * @brief 构造函数
+                 * @param topic 主题
+                 * @param subscriber 订阅者
+                 */
+                Subscription(std::weak_ptr<Detail::TopicBase> topic, std::shared_ptr<Detail::SubscriberBase> subscriber) :
+                    m_topic(std::move(topic)), m_subscriber(std::move(subscriber))
+                {
+                }
+                /**
+                 * @brief 移动构造函数
+                 * @param other 其他句柄
+                 */
+                Subscription(Subscription&& other)noexcept = default;
+                /**
+                 * @brief 移动赋值运算符
+                 * @param other 其他句柄
+                 * @return Subscription& 自身
+                 */
+                Subscription& operator=(Subscription&& other)noexcept
+                {
+                    if (this != &other)
+                    {
+                        unsubscribe();
+                        m_topic = std::move(other.m_topic);
+                        m_subscriber = std::move(other.m_subscriber);
+                    }
+                    return *this;
+                }
+                /**
+                 * @brief 析构函数
+                 */
+                ~Subscription()
+                {
+                    unsubscribe();
+                }
+                /**
+                 * @brief 取消订阅
+                 */
+                void unsubscribe()
+                {
+                    if (!m_subscriber)
+                    {
+                        return;
+                    }
+                    m_subscriber->deactivate();
+                    if (auto topic = m_topic.lock())
+                    {
+                        topic->remove(m_subscriber.get());
+                    }
+                    m_subscriber.reset();
+                    m_topic.reset();
+                }
+                /**
+                 * @brief 判断是否仍处于订阅状态
+                 * @return bool 是否订阅中
+                 */
+                bool is_active()const noexcept
+                {
+                    return m_subscriber && m_subscriber->is_active();
+                }
+                /**
+                 * @brief 获取因邮箱溢出被丢弃的事件数
+                 * @return std::size_t 丢弃数
+                 */
+                std::size_t get_dropped_count()const noexcept
+                {
+                    return m_subscriber ? m_subscriber->get_dropped_count() : 0;
+                }
+                /**
+                 * @brief 获取邮箱中尚未处理的事件数
+                 * @return std::size_t 积压事件数
+                 */
+                std::size_t get_pending_count()const
+                {
+                    return m_subscriber ? m_subscriber->get_pending_count() : 0;
+                }
+            private:
+                /**
+                 * @brief 拷贝构造函数
+                 * @note 禁止拷贝构造
+                 */
+                Subscription(const Subscription&) = delete;
+                /**
+                 * @brief 拷贝赋值运算符
+                 * @note 禁止拷贝赋值
+                 */
+                Subscription& operator=(const Subscription&) = delete;
+            private:
+                /// @brief 主题
+                std::weak_ptr<Detail::TopicBase> m_topic;
+                /// @brief 订阅者
+                std::shared_ptr<Detail::SubscriberBase> m_subscriber;
+            };
+            /**
+             * @class Topic
+             * @brief 类型化主题
+             * @details 订阅与取消订阅在写者互斥锁下复制并替换订阅者快照，旧快照交给纪元回收；
+             *          发布在 EpochGuard 内读取快照，投递期间快照不会被释放
+             * @note 需由 std::shared_ptr 管理，否则取消订阅时只停止投递而不从快照中移除；
+             *       投递期间持有纪元临界区，阻塞策略的发布者长时间等待会推迟全局的纪元回收
+             * @tparam T 事件类型，需可拷贝
+             */
+            template<class T>
+            class Topic : public Detail::TopicBase, public std::enable_shared_from_this<Topic<T>>
+            {
+            public:
+                /// @brief 事件类型
+                using EventType = T;
+                /// @brief 处理函数类型
+                using Handler = std::function<void(const T&)>;
+            public:
+                /**
+                 * @brief 构造函数
+                 */
+                Topic() :m_subscribers(new SubscriberList()) {}
+                /**
+                 * @brief 析构函数
+                 * @note 此时不应再有并发的发布或订阅
+                 */
+                ~Topic()
+                {
+                    delete m_subscribers.load(std::memory_order_acquire);
+                }
+                /**
+                 * @brief 同步订阅：处理函数在发布线程上调用
+                 * @param handler 处理函数
+                 * @return Subscription 订阅句柄
+                 */
+                Subscription subscribe(Handler handler)
+                {
+                    return add(std::make_shared<Detail::SyncSubscriber<T>>(std::move(handler)));
+                }
+                /**
+                 * @brief 异步订阅：事件进入有界邮箱，处理函数在执行器上串行调用
+                 * @param executor 执行器，需在全部事件处理完之前保持有效
+                 * @param handler 处理函数
+                 * @param options 邮箱配置
+                 * @return Subscription 订阅句柄
+                 */
+                Subscription subscribe(ThreadPool::IExecutor& executor, Handler handler, const MailboxOptions& options = MailboxOptions())
+                {
+                    return add(std::make_shared<Detail::PooledSubscriber<T>>(executor, std::move(handler), options));
+                }
+                /**
+                 * @brief 发布事件
+                 * @param event 事件
+                 * @return std::size_t 接收该事件的订阅者数
+                 */
+                std::size_t publish(const T& event)
+                {
+                    LockFree::EpochGuard guard;
+                    const SubscriberList* subscribers = m_subscribers.load(std::memory_order_acquire);
+                    std::size_t delivered_count = 0;
+                    for (const auto& subscriber : *subscribers)
+                    {
+                        if (subscriber->deliver(event))
+                        {
+                            ++delivered_count;
+                        }
+                    }
+                    return delivered_count;
+                }
+                /**
+                 * @brief 获取订阅者数
+                 * @return std::size_t 订阅者数
+                 */
+                std::size_t get_subscriber_count()const
+                {
+                    LockFree::EpochGuard guard;
+                    return m_subscribers.load(std::memory_order_acquire)->size();
+                }
+                /**
+                 * @brief 移除订阅者
+                 * @param subscriber 订阅者
+                 */
+                void remove(const Detail::SubscriberBase* subscriber)override
+                {
+                    std::lock_guard<std::mutex> lock(m_writer_mutex);
+                    SubscriberList* current = m_subscribers.load(std::memory_order_relaxed);
+                    auto updated = std::make_unique<SubscriberList>();
+                    updated->reserve(current->size());
+                    for (const auto& item : *current)
+                    {
+                        if (item.get() != subscriber)
+                        {
+                            updated->push_back(item);
+                        }
+                    }
+                    replace(current, updated.release());
+                }
+            private:
+                /// @brief 订阅者快照类型
+                using SubscriberList = std::vector<std::shared_ptr<Detail::Subscriber<T>>>;
+            private:
+                /**
+                 * @brief 拷贝构造函数
+                 * @note 禁止拷贝构造
+                 */
+                Topic(const Topic&) = delete;
+                /**
+                 * @brief 拷贝赋值运算符
+                 * @note 禁止拷贝赋值
+                 */
+                Topic& operator=(const Topic&) = delete;
+                /**
+                 * @brief 加入订阅者
+                 * @param subscriber 订阅者
+                 * @return Subscription 订阅句柄
+                 */
+                Subscription add(std::shared_ptr<Detail::Subscriber<T>> subscriber)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(m_writer_mutex);
+                        SubscriberList* current = m_subscribers.load(std::memory_order_relaxed);
+                        auto updated = std::make_unique<SubscriberList>(*current);
+                        updated->push_back(subscriber);
+                        replace(current, updated.release());
+                    }
+                    return Subscription(this->weak_from_this(), std::move(subscriber));
+                }
+                /**
+                 * @brief 发布新快照并退休旧快照（需持有写者互斥锁）
+                 * @details 订阅变更不频繁，退休后立即尝试回收，没有并发发布者时旧快照（及其中的订阅者）随即释放
+                 * @param current 当前快照
+                 * @param updated 新快照
+                 */
+                void replace(SubscriberList* current, SubscriberList* updated)
+                {
+                    m_subscribers.store(updated, std::memory_order_release);
+                    LockFree::EpochDomain& domain = LockFree::EpochDomain::get_global();
+                    domain.retire(current);
+                    domain.collect();
+                }
+            private:
+                /// @brief 订阅者快照，发布后不再修改
+                std::atomic<SubscriberList*> m_subscribers;
+                /// @brief 写者互斥锁，仅订阅与取消订阅使用
+                std::mutex m_writer_mutex;
+            };
+        }
+    }
+}
@@ -0,0 +1,425 @@
+#pragma once
+
+/**
+ * @file byte_ring.hpp
+ * @author DaneJoe001
+ * @version 0.1.1
+ * @brief 变长字节记录环形缓冲区
+ * @details 记录以 8 字节头（负载长度）加负载连续存放并按 8 字节对齐；剩余尾部空间放不下记录时写入填充头并回绕到起点，
+ *          保证每条记录在内存中连续。生产者 reserve() 取得可写区域、原地写入后 commit() 发布；
+ *          消费者 read() 原地读取、release() 归还，整个过程不发生堆分配
+ * @date 2026-10-18
+ */
+
+#include <span>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#include "danejoe/concurrent/sync/spin_lock.hpp"
+
+/**
+ * @namespace DaneJoe
+ * @brief DaneJoe命名空间
+ */
+namespace DaneJoe
+{
+    /**
+     * @namespace Concurrent
+     * @brief 并发命名空间
+     */
+    namespace Concurrent
+    {
+        /**
+         * @namespace LockFree
+         * @brief 无锁命名空间
+         */
+        namespace LockFree
+        {
+            /**
+             * @class SpscByteRing
+             * @brief 单生产者单消费者变长字节记录环形缓冲区
+             * @note reserve()/commit() 只能由单个生产者调用，read()/release()/consume() 只能由单个消费者调用
+             */
+            class SpscByteRing
+            {
+            public:
+                /**
+                 * @brief 构造函数
+                 * @param capacity 字节容量，向上取整为 2 的幂，最少 64 字节
+                 */
+                explicit SpscByteRing(std::size_t capacity)
+                {
+                    std::size_t rounded = 64;
+                    while (rounded < capacity)
+                    {
+                        rounded <<= 1;
+                    }
+                    m_mask = rounded - 1;
+                    m_buffer = std::make_unique<Header[]>(rounded / sizeof(Header));
+                }
+                /**
+                 * @brief 预留可写区域（生产者）
+                 * @note 未 commit() 前再次 reserve() 会放弃上一次预留
+                 * @param size 负载字节数
+                 * @return std::byte* 可写区域，空间不足或记录大于单条上限时为 nullptr
+                 */
+                std::byte* reserve(std::size_t size)noexcept
+                {
+                    if (size > get_max_record_size())
+                    {
+                        return nullptr;
+                    }
+                    std::size_t record_size = get_record_size(size);
+                    std::uint64_t head = m_head.load(std::memory_order_relaxed);
+                    std::size_t offset = static_cast<std::size_t>(head & m_mask);
+                    std::size_t contiguous = m_mask + 1 - offset;
+                    std::size_t padding = record_size > contiguous ? contiguous : 0;
+                    std::size_t total = padding + record_size;
+                    if (head + total - m_cached_tail > m_mask + 1)
+                    {
+                        m_cached_tail = m_tail.load(std::memory_order_acquire);
+                        if (head + total - m_cached_tail > m_mask + 1)
+                        {
+                            return nullptr;
+                        }
+                    }
+                    if (padding)
+                    {
+                        get_header(offset).length = PADDING_LENGTH;
+                        offset = 0;
+                    }
+                    m_reserved_padding = padding;
+                    m_reserved_size = size;
+                    return get_payload(offset);
+                }
+                /**
+                 * @brief 发布预留的记录（生产者）
+                 */
+                void commit()noexcept
+                {
+                    commit(m_reserved_size);
+                }
+                /**
+                 * @brief 以实际长度发布预留的记录（生产者）
+                 * @param size 实际写入的字节数，不大于预留长度
+                 */
+                void commit(std::size_t size)noexcept
+                {
+                    std::uint64_t head = m_head.load(std::memory_order_relaxed);
+                    std::size_t offset = m_reserved_padding ? 0 : static_cast<std::size_t>(head & m_mask);
+                    get_header(offset).length = static_cast<std::uint32_t>(size);
+                    m_head.store(head + m_reserved_padding + get_record_size(size), std::memory_order_release);
+                }
+                /**
+                 * @brief 复制写入一条记录（生产者）
+                 * @param data 数据
+                 * @param size 字节数
+                 * @return bool 是否成功
+                 */
+                bool try_push(const void* data, std::size_t size)noexcept
+                {
+                    std::byte* destination = reserve(size);
+                    if (!destination)
+                    {
+                        return false;
+                    }
+                    if (size)
+                    {
+                        std::memcpy(destination, data, size);
+                    }
+                    commit();
+                    return true;
+                }
+                /**
+                 * @brief 原地读取队首记录（消费者）
+                 * @return std::span<const std::byte> 记录负载，在 release() 前有效；队列为空时 data() 为 nullptr
+                 */
+                std::span<const std::byte> read()noexcept
+                {
+                    std::uint64_t tail = m_read_position;
+                    if (tail == m_cached_head)
+                    {
+                        m_cached_head = m_head.load(std::memory_order_acquire);
+                        if (tail == m_cached_head)
+                        {
+                            return {};
+                        }
+                    }
+                    std::size_t offset = static_cast<std::size_t>(tail & m_mask);
+                    std::uint32_t length = get_header(offset).length;
+                    if (length == PADDING_LENGTH)
+                    {
+                        // 跳过尾部填充，填充之后必有一条完整记录
+                        m_read_position += m_mask + 1 - offset;
+                        offset = 0;
+                        length = get_header(0).length;
+                    }
+                    return { get_payload(offset), length };
+                }
+                /**
+                 * @brief 归还 read() 返回的记录（消费者）
+                 */
+                void release()noexcept
+                {
+                    std::size_t offset = static_cast<std::size_t>(m_read_position & m_mask);
+                    m_read_position += get_record_size(get_header(offset).length);
+                    m_tail.store(m_read_position, std::memory_order_release);
+                }
+                /**
+                 * @brief 批量消费记录（消费者）
+                 * @details 依次对每条记录调用 handler，全部处理完后一次性归还空间
+                 * @tparam F 处理函数类型，签名为 void(std::span<const std::byte>)
+                 * @param handler 处理函数
+                 * @param max_count 最多处理的记录数
+                 * @return std::size_t 处理的记录数
+                 */
+                template<class F>
+                std::size_t consume(F&& handler, std::size_t max_count = SIZE_MAX)
+                {
+                    std::size_t count = 0;
+                    while (count < max_count)
+                    {
+                        std::span<const std::byte> record = read();
+                        if (!record.data())
+                        {
+                            break;
+                        }
+                        handler(record);
+                        m_read_position += get_record_size(record.size());
+                        ++count;
+                    }
+                    if (count)
+                    {
+                        m_tail.store(m_read_position, std::memory_order_release);
+                    }
+                    return count;
+                }
+                /**
+                 * @brief 判断是否为空
+                 * @return bool 是否为空
+                 */
+                bool empty()const noexcept
+                {
+                    return m_tail.load(std::memory_order_acquire) == m_head.load(std::memory_order_acquire);
+                }
+                /**
+                 * @brief 获取字节容量
+                 * @return std::size_t 容量
+                 */
+                std::size_t capacity()const noexcept
+                {
+                    return m_mask + 1;
+                }
+                /**
+                 * @brief 获取单条记录负载上限
+                 * @details 为容量的一半减去记录头，保证任意写入位置在回绕填充后仍放得下
+                 * @return std::size_t 字节数
+                 */
+                std::size_t get_max_record_size()const noexcept
+                {
+                    return (m_mask + 1) / 2 - sizeof(Header);
+                }
+            private:
+                /// @brief 填充记录的长度标记
+                static constexpr std::uint32_t PADDING_LENGTH = 0xFFFFFFFFu;
+                /**
+                 * @brief 记录头
+                 */
+                struct alignas(8) Header
+                {
+                    /// @brief 负载长度
+                    std::uint32_t length;
+                    /// @brief 保留
+                    std::uint32_t reserved;
+                };
+            private:
+                /**
+                 * @brief 拷贝构造函数
+                 * @note 禁止拷贝构造
+                 */
+                SpscByteRing(const SpscByteRing&) = delete;
+                /**
+                 * @brief 拷贝赋值运算符
+                 * @note 禁止拷贝赋值
+                 */
+                SpscByteRing& operator=(const SpscByteRing&) = delete;
+                /**
+                 * @brief 计算记录占用字节数
+                 * @param size 负载字节数
+                 * @return std::size_t 含记录头并按 8 字节对齐的字节数
+                 */
+                static std::size_t get_record_size(std::size_t size)noexcept
+                {
+                    return (sizeof(Header) + size + 7) & ~std::size_t(7);
+                }
+                /**
+                 * @brief 获取偏移处的记录头
+                 * @param offset 字节偏移
+                 * @return Header& 记录头
+                 */
+                Header& get_header(std::size_t offset)const noexcept
+                {
+                    return m_buffer[offset / sizeof(Header)];
+                }
+                /**
+                 * @brief 获取偏移处记录的负载
+                 * @param offset 字节偏移
+                 * @return std::byte* 负载
+                 */
+                std::byte* get_payload(std::size_t offset)const noexcept
+                {
+                    return reinterpret_cast<std::byte*>(&m_buffer[offset / sizeof(Header) + 1]);
+                }
+            private:
+                /// @brief 缓冲区，以记录头为单位分配以保证对齐
+                std::unique_ptr<Header[]> m_buffer;
+                /// @brief 下标掩码
+                std::size_t m_mask = 0;
+                /// @brief 写位置（已发布）
+                alignas(64) std::atomic<std::uint64_t> m_head = 0;
+                /// @brief 生产者缓存的读位置
+                std::uint64_t m_cached_tail = 0;
+                /// @brief 本次预留的填充字节数
+                std::size_t m_reserved_padding = 0;
+                /// @brief 本次预留的负载字节数
+                std::size_t m_reserved_size = 0;
+                /// @brief 读位置（已归还）
+                alignas(64) std::atomic<std::uint64_t> m_tail = 0;
+                /// @brief 消费者当前读位置
+                std::uint64_t m_read_position = 0;
+                /// @brief 消费者缓存的写位置
+                std::uint64_t m_cached_head = 0;
+            };
+            /**
+             * @class MpscByteRing
+             * @brief 多生产者单消费者变长字节记录环形缓冲区
+             * @details 生产者之间以自旋锁串行化 reserve() 到 commit() 之间的写入，消费端与 SpscByteRing 相同
+             * @note reserve() 成功后必须调用 commit()，期间其他生产者等待，应尽快完成写入
+             */
+            class MpscByteRing
+            {
+            public:
+                /**
+                 * @brief 构造函数
+                 * @param capacity 字节容量，向上取整为 2 的幂，最少 64 字节
+                 */
+                explicit MpscByteRing(std::size_t capacity) :m_ring(capacity) {}
+                /**
+                 * @brief 预留可写区域（生产者）
+                 * @param size 负载字节数
+                 * @return std::byte* 可写区域，失败时为 nullptr 且不持有锁
+                 */
+                std::byte* reserve(std::size_t size)noexcept
+                {
+                    m_producer_lock.lock();
+                    std::byte* destination = m_ring.reserve(size);
+                    if (!destination)
+                    {
+                        m_producer_lock.unlock();
+                    }
+                    return destination;
+                }
+                /**
+                 * @brief 发布预留的记录（生产者）
+                 */
+                void commit()noexcept
+                {
+                    m_ring.commit();
+                    m_producer_lock.unlock();
+                }
+                /**
+                 * @brief 以实际长度发布预留的记录（生产者）
+                 * @param size 实际写入的字节数
+                 */
+                void commit(std::size_t size)noexcept
+                {
+                    m_ring.commit(size);
+                    m_producer_lock.unlock();
+                }
+                /**
+                 * @brief 复制写入一条记录（生产者）
+                 * @param data 数据
+                 * @param size 字节数
+                 * @return bool 是否成功
+                 */
+                bool try_push(const void* data, std::size_t size)noexcept
+                {
+                    std::lock_guard<Sync::SpinLock> lock(m_producer_lock);
+                    return m_ring.try_push(data, size);
+                }
+                /**
+                 * @brief 原地读取队首记录（消费者）
+                 * @return std::span<const std::byte> 记录负载
+                 */
+                std::span<const std::byte> read()noexcept
+                {
+                    return m_ring.read();
+                }
+                /**
+                 * @brief 归还记录（消费者）
+                 */
+                void release()noexcept
+                {
+                    m_ring.release();
+                }
+                /**
+                 * @brief 批量消费记录（消费者）
+                 * @tparam F 处理函数类型
+                 * @param handler 处理函数
+                 * @param max_count 最多处理的记录数
+                 * @return std::size_t 处理的记录数
+                 */
+                template<class F>
+                std::size_t consume(F&& handler, std::size_t max_count = SIZE_MAX)
+                {
+                    return m_ring.consume(std::forward<F>(handler), max_count);
+                }
+                /**
+                 * @brief 判断是否为空
+                 * @return bool 是否为空
+                 */
+                bool empty()const noexcept
+                {
+                    return m_ring.empty();
+                }
+                /**
+                 * @brief 获取字节容量
+                 * @return std::size_t 容量
+                 */
+                std::size_t capacity()const noexcept
+                {
+                    return m_ring.capacity();
+                }
+                /**
+                 * @brief 获取单条记录负载上限
+                 * @return std::size_t 字节数
+                 */
+                std::size_t get_max_record_size()const noexcept
+                {
+                    return m_ring.get_max_record_size();
+                }
+            private:
+                /**
+                 * @brief 拷贝构造函数
+                 * @note 禁止拷贝构造
+                 */
+                MpscByteRing(const MpscByteRing&) = delete;
+                /**
+                 * @brief 拷贝赋值运算符
+                 * @note 禁止拷贝赋值
+                 */
+                MpscByteRing& operator=(const MpscByteRing&) = delete;
+            private:
+                /// @brief 底层环形缓冲区
+                SpscByteRing m_ring;
+                /// @brief 生产者锁
+                Sync::SpinLock m_producer_lock;
+            };
+        }
+    }
+}
@@ -0,0 +1,679 @@
+#pragma once
+
+/**
+ * @file concurrent_skip_list_map.hpp
+ * @author DaneJoe001
+ * @version 0.1.1
+ * @brief 无锁有序跳表
+ * @details 按 Herlihy–Shavit 的无锁跳表实现：删除先自顶向下在各层 next 指针上打删除标记，
+ *          第 0 层打标记成功者即删除者；查找路径上遇到带标记的节点顺手摘除。
+ *          插入线程与删除线程通过节点标志位握手，后完成的一方在确认节点已从各层摘除后将其退休，
+ *          节点经 EpochDomain 延迟释放。读取、lower_bound 与区间遍历不写共享状态，也不阻塞插入
+ * @date 2026-10-18
+ */
+
+#include <new>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <iterator>
+#include <optional>
+#include <functional>
+#include <type_traits>
+
+#include "danejoe/concurrent/lock_free/epoch_domain.hpp"
+
+/**
+ * @namespace DaneJoe
+ * @brief DaneJoe命名空间
+ */
+namespace DaneJoe
+{
+    /**
+     * @namespace Concurrent
+     * @brief 并发命名空间
+     */
+    namespace Concurrent
+    {
+        /**
+         * @namespace LockFree
+         * @brief 无锁命名空间
+         */
+        namespace LockFree
+        {
+            /**
+             * @class ConcurrentSkipListMap
+             * @brief 无锁有序映射
+             * @note 值在插入后不可修改，更新需先 erase 再 insert；迭代器持有 EpochGuard，只能在创建它的线程上使用
+             * @tparam K 键类型
+             * @tparam V 值类型
+             * @tparam Compare 键比较函数
+             */
+            template<class K, class V, class Compare = std::less<K>>
+            class ConcurrentSkipListMap
+            {
+            private:
+                struct Node;
+            public:
+                /// @brief 元素类型
+                using value_type = std::pair<const K, V>;
+                /// @brief 最大层数
+                static constexpr int MAX_LEVEL = 24;
+                /**
+                 * @class ConstIterator
+                 * @brief 按键升序的只读前向迭代器
+                 * @details 遍历期间插入的元素可能被看到也可能看不到，已删除的元素被跳过
+                 */
+                class ConstIterator
+                {
+                public:
+                    /// @brief 迭代器类别
+                    using iterator_category = std::forward_iterator_tag;
+                    /// @brief 元素类型
+                    using value_type = ConcurrentSkipListMap::value_type;
+                    /// @brief 距离类型
+                    using difference_type = std::ptrdiff_t;
+                    /// @brief 指针类型
+                    using pointer = const value_type*;
+                    /// @brief 引用类型
+                    using reference = const value_type&;
+                    /**
+                     * @brief 构造结束迭代器
+                     */
+                    ConstIterator() = default;
+                    /**
+                     * @brief 解引用
+                     * @return reference 元素
+                     */
+                    reference operator*()const noexcept
+                    {
+                        return m_node->entry;
+                    }
+                    /**
+                     * @brief 成员访问
+                     * @return pointer 元素指针
+                     */
+                    pointer operator->()const noexcept
+                    {
+                        return &m_node->entry;
+                    }
+                    /**
+                     * @brief 前进到下一个未删除的元素
+                     * @return ConstIterator& 本迭代器
+                     */
+                    ConstIterator& operator++()noexcept
+                    {
+                        m_node = get_next_live(m_node);
+                        return *this;
+                    }
+                    /**
+                     * @brief 后置前进
+                     * @return ConstIterator 前进前的迭代器
+                     */
+                    ConstIterator operator++(int)
+                    {
+                        ConstIterator previous = *this;
+                        ++*this;
+                        return previous;
+                    }
+                    /**
+                     * @brief 判断是否指向同一节点
+                     * @param other 其他迭代器
+                     * @return bool 是否相等
+                     */
+                    bool operator==(const ConstIterator& other)const noexcept
+                    {
+                        return m_node == other.m_node;
+                    }
+                private:
+                    friend class ConcurrentSkipListMap;
+                    /**
+                     * @brief 构造函数
+                     * @param node 节点，为空表示结束
+                     */
+                    explicit ConstIterator(const Node* node)noexcept :m_node(node) {}
+                private:
+                    /// @brief 节点
+                    const Node* m_node = nullptr;
+                    /// @brief 保证节点在迭代期间不被释放
+                    EpochGuard m_guard;
+                };
+                /**
+                 * @brief 构造函数
+                 * @param compare 键比较函数
+                 */
+                explicit ConcurrentSkipListMap(Compare compare = Compare()) :
+                    m_compare(std::move(compare))
+                {
+                    for (auto& head : m_head)
+                    {
+                        head.store(0, std::memory_order_relaxed);
+                    }
+                }
+                /**
+                 * @brief 析构函数
+                 * @note 析构时不能有其他线程访问本对象
+                 */
+                ~ConcurrentSkipListMap()
+                {
+                    Node* node = get_pointer(m_head[0].load(std::memory_order_acquire));
+                    while (node)
+                    {
+                        Node* next = get_pointer(node->get_next()[0].load(std::memory_order_relaxed));
+                        destroy_node(node);
+                        node = next;
+                    }
+                }
+                /**
+                 * @brief 插入键值对
+                 * @param key 键
+                 * @param value 值
+                 * @return bool 是否插入，键已存在时返回 false
+                 */
+                bool insert(const K& key, V value)
+                {
+                    EpochGuard guard;
+                    Link* preds[MAX_LEVEL];
+                    Node* succs[MAX_LEVEL];
+                    Node* node = nullptr;
+                    while (true)
+                    {
+                        if (find(key, preds, succs))
+                        {
+                            if (node)
+                            {
+                                destroy_node(node);
+                            }
+                            return false;
+                        }
+                        if (!node)
+                        {
+                            node = create_node(get_random_level(), key, std::move(value));
+                        }
+                        for (int level = 0; level < node->level; ++level)
+                        {
+                            node->get_next()[level].store(to_link(succs[level]), std::memory_order_relaxed);
+                        }
+                        std::uintptr_t expected = to_link(succs[0]);
+                        if (preds[0][0].compare_exchange_strong(expected, to_link(node), std::memory_order_release, std::memory_order_relaxed))
+                        {
+                            break;
+                        }
+                    }
+                    m_size.fetch_add(1, std::memory_order_relaxed);
+                    raise_top_level(node->level);
+                    link_upper_levels(node, preds, succs);
+                    if (node->flags.fetch_or(LINKED_FLAG, std::memory_order_acq_rel) & DELETED_FLAG)
+                    {
+                        unlink_and_retire(node);
+                    }
+                    return true;
+                }
+                /**
+                 * @brief 删除键
+                 * @param key 键
+                 * @return bool 是否由本次调用删除
+                 */
+                bool erase(const K& key)
+                {
+                    EpochGuard guard;
+                    Link* preds[MAX_LEVEL];
+                    Node* succs[MAX_LEVEL];
+                    if (!find(key, preds, succs))
+                    {
+                        return false;
+                    }
+                    Node* node = succs[0];
+                    for (int level = node->level - 1; level >= 1; --level)
+                    {
+                        std::uintptr_t next = node->get_next()[level].load(std::memory_order_acquire);
+                        while (!is_marked(next) &&
+                            !node->get_next()[level].compare_exchange_weak(next, next | MARK_BIT, std::memory_order_acq_rel, std::memory_order_acquire))
+                        {
+                        }
+                    }
+                    std::uintptr_t next = node->get_next()[0].load(std::memory_order_acquire);
+                    while (true)
+                    {
+                        if (is_marked(next))
+                        {
+                            return false;
+                        }
+                        if (node->get_next()[0].compare_exchange_weak(next, next | MARK_BIT, std::memory_order_acq_rel, std::memory_order_acquire))
+                        {
+                            break;
+                        }
+                    }
+                    m_size.fetch_sub(1, std::memory_order_relaxed);
+                    if (node->flags.fetch_or(DELETED_FLAG, std::memory_order_acq_rel) & LINKED_FLAG)
+                    {
+                        unlink_and_retire(node);
+                    }
+                    return true;
+                }
+                /**
+                 * @brief 查找
+                 * @param key 键
+                 * @return std::optional<V> 值的拷贝，不存在时返回std::nullopt
+                 */
+                std::optional<V> find(const K& key)const
+                {
+                    EpochGuard guard;
+                    const Node* node = search_lower_bound(key);
+                    if (!node || m_compare(key, node->entry.first))
+                    {
+                        return std::nullopt;
+                    }
+                    return node->entry.second;
+                }
+                /**
+                 * @brief 判断键是否存在
+                 * @param key 键
+                 * @return bool 是否存在
+                 */
+                bool contains(const K& key)const
+                {
+                    EpochGuard guard;
+                    const Node* node = search_lower_bound(key);
+                    return node && !m_compare(key, node->entry.first);
+                }
+                /**
+                 * @brief 获取首个不小于 key 的元素
+                 * @param key 键
+                 * @return ConstIterator 迭代器，不存在时为 end()
+                 */
+                ConstIterator lower_bound(const K& key)const
+                {
+                    EpochGuard guard;
+                    return ConstIterator(search_lower_bound(key));
+                }
+                /**
+                 * @brief 获取首个元素
+                 * @return ConstIterator 迭代器
+                 */
+                ConstIterator begin()const
+                {
+                    EpochGuard guard;
+                    const Node* node = get_pointer(m_head[0].load(std::memory_order_acquire));
+                    if (node && is_marked(node->get_next()[0].load(std::memory_order_acquire)))
+                    {
+                        node = get_next_live(node);
+                    }
+                    return ConstIterator(node);
+                }
+                /**
+                 * @brief 获取结束迭代器
+                 * @return ConstIterator 结束迭代器
+                 */
+                ConstIterator end()const
+                {
+                    return ConstIterator();
+                }
+                /**
+                 * @brief 按键升序访问 [first, last) 中的元素
+                 * @tparam F 访问函数类型，签名为 void(const K&, const V&)，返回 bool 时 false 表示停止
+                 * @param first 下界（含）
+                 * @param last 上界（不含）
+                 * @param visitor 访问函数
+                 */
+                template<class F>
+                void for_each_range(const K& first, const K& last, F&& visitor)const
+                {
+                    EpochGuard guard;
+                    for (const Node* node = search_lower_bound(first); node && m_compare(node->entry.first, last); node = get_next_live(node))
+                    {
+                        if constexpr (std::is_same_v<std::invoke_result_t<F&, const K&, const V&>, bool>)
+                        {
+                            if (!visitor(node->entry.first, node->entry.second))
+                            {
+                                return;
+                            }
+                        }
+                        else
+                        {
+                            visitor(node->entry.first, node->entry.second);
+                        }
+                    }
+                }
+                /**
+                 * @brief 获取元素数
+                 * @note 并发修改时为近似值
+                 * @return std::size_t 元素数
+                 */
+                std::size_t size()const noexcept
+                {
+                    std::ptrdiff_t size = m_size.load(std::memory_order_relaxed);
+                    return size < 0 ? 0 : static_cast<std::size_t>(size);
+                }
+                /**
+                 * @brief 判断是否为空
+                 * @return bool 是否为空
+                 */
+                bool empty()const
+                {
+                    return begin() == end();
+                }
+            private:
+                /// @brief 各层 next 指针，最低位为删除标记
+                using Link = std::atomic<std::uintptr_t>;
+                /// @brief 删除标记
+                static constexpr std::uintptr_t MARK_BIT = 1;
+                /// @brief 插入线程已完成各层链接
+                static constexpr int LINKED_FLAG = 1;
+                /// @brief 删除线程已在第 0 层打上标记
+                static constexpr int DELETED_FLAG = 2;
+                /**
+                 * @brief 节点，各层 next 指针紧随其后分配
+                 */
+                struct alignas(Link) Node
+                {
+                    /**
+                     * @brief 构造函数
+                     * @param level 层数
+                     * @param key 键
+                     * @param value 值
+                     */
+                    Node(int level, const K& key, V&& value) :
+                        entry(key, std::move(value)), level(level)
+                    {
+                    }
+                    /**
+                     * @brief 获取 next 指针数组
+                     * @return Link* next 指针数组
+                     */
+                    Link* get_next()noexcept
+                    {
+                        return reinterpret_cast<Link*>(reinterpret_cast<char*>(this) + NEXT_OFFSET);
+                    }
+                    /**
+                     * @brief 获取 next 指针数组
+                     * @return const Link* next 指针数组
+                     */
+                    const Link* get_next()const noexcept
+                    {
+                        return reinterpret_cast<const Link*>(reinterpret_cast<const char*>(this) + NEXT_OFFSET);
+                    }
+                    /// @brief 元素
+                    value_type entry;
+                    /// @brief 层数
+                    int level;
+                    /// @brief 插入与删除的握手标志
+                    std::atomic<int> flags = 0;
+                };
+                /// @brief next 指针数组相对节点起始的偏移
+                static constexpr std::size_t NEXT_OFFSET = (sizeof(Node) + alignof(Link) - 1) / alignof(Link) * alignof(Link);
+            private:
+                /**
+                 * @brief 拷贝构造函数
+                 * @note 禁止拷贝构造
+                 */
+                ConcurrentSkipListMap(const ConcurrentSkipListMap&) = delete;
+                /**
+                 * @brief 拷贝赋值运算符
+                 * @note 禁止拷贝赋值
+                 */
+                ConcurrentSkipListMap& operator=(const ConcurrentSkipListMap&) = delete;
+                /**
+                 * @brief 取出指针
+                 * @param link next 指针的值
+                 * @return Node* 节点
+                 */
+                static Node* get_pointer(std::uintptr_t link)noexcept
+                {
+                    return reinterpret_cast<Node*>(link & ~MARK_BIT);
+                }
+                /**
+                 * @brief 判断是否带删除标记
+                 * @param link next 指针的值
+                 * @return bool 是否带删除标记
+                 */
+                static bool is_marked(std::uintptr_t link)noexcept
+                {
+                    return link & MARK_BIT;
+                }
+                /**
+                 * @brief 转为 next 指针的值
+                 * @param node 节点
+                 * @return std::uintptr_t 值
+                 */
+                static std::uintptr_t to_link(const Node* node)noexcept
+                {
+                    return reinterpret_cast<std::uintptr_t>(node);
+                }
+                /**
+                 * @brief 分配节点
+                 * @param level 层数
+                 * @param key 键
+                 * @param value 值
+                 * @return Node* 节点
+                 */
+                static Node* create_node(int level, const K& key, V&& value)
+                {
+                    void* memory = ::operator new(NEXT_OFFSET + sizeof(Link) * static_cast<std::size_t>(level));
+                    Node* node = nullptr;
+                    try
+                    {
+                        node = new (memory) Node(level, key, std::move(value));
+                    }
+                    catch (...)
+                    {
+                        ::operator delete(memory);
+                        throw;
+                    }
+                    for (int i = 0; i < level; ++i)
+                    {
+                        new (node->get_next() + i) Link(0);
+                    }
+                    return node;
+                }
+                /**
+                 * @brief 释放节点
+                 * @param pointer 节点
+                 */
+                static void destroy_node(void* pointer)noexcept
+                {
+                    Node* node = static_cast<Node*>(pointer);
+                    node->~Node();
+                    ::operator delete(pointer);
+                }
+                /**
+                 * @brief 生成随机层数，每层晋升概率 1/4
+                 * @return int 层数
+                 */
+                static int get_random_level()noexcept
+                {
+                    thread_local std::uint64_t state = reinterpret_cast<std::uintptr_t>(&state) | 1;
+                    state ^= state << 13;
+                    state ^= state >> 7;
+                    state ^= state << 17;
+                    std::uint64_t bits = state;
+                    int level = 1;
+                    while ((bits & 3) == 0 && level < MAX_LEVEL)
+                    {
+                        ++level;
+                        bits >>= 2;
+                    }
+                    return level;
+                }
+                /**
+                 * @brief 查找 key 在各层的前驱与后继，摘除路径上带标记的节点
+                 * @param key 键
+                 * @param preds 输出各层前驱的 next 指针数组
+                 * @param succs 输出各层后继
+                 * @return bool 第 0 层后继是否为 key
+                 */
+                bool find(const K& key, Link** preds, Node** succs)
+                {
+                    while (!try_find(key, preds, succs))
+                    {
+                    }
+                    return succs[0] && !m_compare(key, succs[0]->entry.first);
+                }
+                /**
+                 * @brief 查找一遍，摘除失败时返回 false 以便重来
+                 * @param key 键
+                 * @param preds 输出各层前驱的 next 指针数组
+                 * @param succs 输出各层后继
+                 * @return bool 是否完成
+                 */
+                bool try_find(const K& key, Link** preds, Node** succs)
+                {
+                    int top_level = m_top_level.load(std::memory_order_acquire);
+                    for (int level = MAX_LEVEL - 1; level >= top_level; --level)
+                    {
+                        preds[level] = m_head;
+                        succs[level] = nullptr;
+                    }
+                    Link* pred = m_head;
+                    for (int level = top_level - 1; level >= 0; --level)
+                    {
+                        Node* curr = get_pointer(pred[level].load(std::memory_order_acquire));
+                        while (curr)
+                        {
+                            std::uintptr_t succ = curr->get_next()[level].load(std::memory_order_acquire);
+                            if (is_marked(succ))
+                            {
+                                std::uintptr_t expected = to_link(curr);
+                                if (!pred[level].compare_exchange_strong(expected, succ & ~MARK_BIT, std::memory_order_acq_rel, std::memory_order_acquire))
+                                {
+                                    return false;
+                                }
+                                curr = get_pointer(succ);
+                                continue;
+                            }
+                            if (!m_compare(curr->entry.first, key))
+                            {
+                                break;
+                            }
+                            pred = curr->get_next();
+                            curr = get_pointer(succ);
+                        }
+                        preds[level] = pred;
+                        succs[level] = curr;
+                    }
+                    return true;
+                }
+                /**
+                 * @brief 只读地查找首个不小于 key 的未删除节点
+                 * @note 需在 EpochGuard 内调用
+                 * @param key 键
+                 * @return const Node* 节点，不存在时为空
+                 */
+                const Node* search_lower_bound(const K& key)const
+                {
+                    const Link* pred = m_head;
+                    const Node* curr = nullptr;
+                    for (int level = m_top_level.load(std::memory_order_acquire) - 1; level >= 0; --level)
+                    {
+                        curr = get_pointer(pred[level].load(std::memory_order_acquire));
+                        while (curr)
+                        {
+                            std::uintptr_t succ = curr->get_next()[level].load(std::memory_order_acquire);
+                            if (is_marked(succ))
+                            {
+                                curr = get_pointer(succ);
+                                continue;
+                            }
+                            if (!m_compare(curr->entry.first, key))
+                            {
+                                break;
+                            }
+                            pred = curr->get_next();
+                            curr = get_pointer(succ);
+                        }
+                    }
+                    return curr;
+                }
+                /**
+                 * @brief 获取第 0 层的下一个未删除节点
+                 * @param node 节点
+                 * @return const Node* 下一个未删除节点，不存在时为空
+                 */
+                static const Node* get_next_live(const Node* node)noexcept
+                {
+                    const Node* next = get_pointer(node->get_next()[0].load(std::memory_order_acquire));
+                    while (next)
+                    {
+                        std::uintptr_t link = next->get_next()[0].load(std::memory_order_acquire);
+                        if (!is_marked(link))
+                        {
+                            break;
+                        }
+                        next = get_pointer(link);
+                    }
+                    return next;
+                }
+                /**
+                 * @brief 抬高最高层数
+                 * @param level 新节点的层数
+                 */
+                void raise_top_level(int level)noexcept
+                {
+                    int top_level = m_top_level.load(std::memory_order_relaxed);
+                    while (top_level < level &&
+                        !m_top_level.compare_exchange_weak(top_level, level, std::memory_order_release, std::memory_order_relaxed))
+                    {
+                    }
+                }
+                /**
+                 * @brief 链接第 1 层及以上，节点被删除时放弃
+                 * @param node 已链接第 0 层的节点
+                 * @param preds 各层前驱
+                 * @param succs 各层后继
+                 */
+                void link_upper_levels(Node* node, Link** preds, Node** succs)
+                {
+                    for (int level = 1; level < node->level; ++level)
+                    {
+                        while (true)
+                        {
+                            std::uintptr_t next = node->get_next()[level].load(std::memory_order_acquire);
+                            if (is_marked(next))
+                            {
+                                return;
+                            }
+                            // 只有删除线程会修改 next，交换失败即已被打上标记
+                            if (next != to_link(succs[level]) &&
+                                !node->get_next()[level].compare_exchange_strong(next, to_link(succs[level]), std::memory_order_acq_rel, std::memory_order_acquire))
+                            {
+                                return;
+                            }
+                            std::uintptr_t expected = to_link(succs[level]);
+                            if (preds[level][level].compare_exchange_strong(expected, to_link(node), std::memory_order_release, std::memory_order_relaxed))
+                            {
+                                break;
+                            }
+                            find(node->entry.first, preds, succs);
+                            if (succs[0] != node)
+                            {
+                                return;
+                            }
+                        }
+                    }
+                }
+                /**
+                 * @brief 从各层摘除已删除的节点并退休
+                 * @details 由插入线程与删除线程中后完成的一方调用，此后不会再有链接指向该节点
+                 * @param node 节点
+                 */
+                void unlink_and_retire(Node* node)
+                {
+                    Link* preds[MAX_LEVEL];
+                    Node* succs[MAX_LEVEL];
+                    find(node->entry.first, preds, succs);
+                    EpochDomain::get_global().retire(node, &ConcurrentSkipListMap::destroy_node);
+                }
+            private:
+                /// @brief 键比较函数
+                Compare m_compare;
+                /// @brief 各层头指针
+                Link m_head[MAX_LEVEL];
+                /// @brief 当前最高层数
+                std::atomic<int> m_top_level = 1;
+                /// @brief 元素数
+                std::atomic<std::ptrdiff_t> m_size = 0;
+            };
+        }
+    }
+}
@@ -0,0 +1,345 @@
+#pragma once
+
+/**
+ * @file concurrent_vector.hpp
+ * @author DaneJoe001
+ * @version 0.1.1
+ * @brief 无锁只追加并发向量
+ * @details 元素存放在按几何级数增长的分段中，分段一经分配不再移动，元素引用始终稳定；
+ *          追加通过对大小计数器 fetch_add 预留下标，按下标读取不加锁
+ * @date 2026-10-18
+ */
+
+#include <new>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <utility>
+#include <stdexcept>
+#include <type_traits>
+
+/**
+ * @namespace DaneJoe
+ * @brief DaneJoe命名空间
+ */
+namespace DaneJoe
+{
+    /**
+     * @namespace Concurrent
+     * @brief 并发命名空间
+     */
+    namespace Concurrent
+    {
+        /**
+         * @namespace LockFree
+         * @brief 无锁命名空间
+         */
+        namespace LockFree
+        {
+            /**
+             * @class ConcurrentVector
+             * @brief 无锁只追加并发向量
+             * @details 第 k 个分段容纳 FIRST_SEGMENT_SIZE << k 个元素；
+             *          每个槽位带就绪标记，读者通过 acquire 读取标记后才访问元素
+             * @note 只支持追加，不支持删除与修改大小；构造时抛出异常的槽位保持未就绪
+             * @tparam T 元素类型
+             */
+            template<class T>
+            class ConcurrentVector
+            {
+            public:
+                /// @brief 首个分段容量的位数
+                static constexpr std::size_t FIRST_SEGMENT_SHIFT = 5;
+                /// @brief 首个分段容量
+                static constexpr std::size_t FIRST_SEGMENT_SIZE = std::size_t(1) << FIRST_SEGMENT_SHIFT;
+                /// @brief 最大分段数
+                static constexpr std::size_t SEGMENT_COUNT = sizeof(std::size_t) * 8 - FIRST_SEGMENT_SHIFT;
+            public:
+                /**
+                 * @brief 构造函数
+                 */
+                ConcurrentVector() = default;
+                /**
+                 * @brief 构造函数
+                 * @param capacity 预先分配的容量
+                 */
+                explicit ConcurrentVector(std::size_t capacity)
+                {
+                    reserve(capacity);
+                }
+                /**
+                 * @brief 析构函数
+                 * @note 调用方需保证析构时没有并发的追加与读取
+                 */
+                ~ConcurrentVector()
+                {
+                    std::size_t size = m_size.load(std::memory_order_acquire);
+                    for (std::size_t segment_index = 0; segment_index < SEGMENT_COUNT; ++segment_index)
+                    {
+                        Slot* segment = m_segments[segment_index].load(std::memory_order_acquire);
+                        if (!segment)
+                        {
+                            continue;
+                        }
+                        std::size_t first = segment_first(segment_index);
+                        std::size_t count = segment_size(segment_index);
+                        for (std::size_t offset = 0; offset < count && first + offset < size; ++offset)
+                        {
+                            if (segment[offset].is_ready.load(std::memory_order_relaxed))
+                            {
+                                segment[offset].get()->~T();
+                            }
+                        }
+                        delete[] segment;
+                    }
+                }
+                /**
+                 * @brief 原地构造并追加元素
+                 * @tparam Args 构造参数类型
+                 * @param args 构造参数
+                 * @return std::size_t 新元素的下标
+                 */
+                template<class... Args>
+                std::size_t emplace_back(Args&&... args)
+                {
+                    std::size_t index = m_size.fetch_add(1, std::memory_order_relaxed);
+                    Slot& slot = get_slot(index, true);
+                    ::new (static_cast<void*>(slot.storage)) T(std::forward<Args>(args)...);
+                    slot.is_ready.store(true, std::memory_order_release);
+                    return index;
+                }
+                /**
+                 * @brief 追加元素
+                 * @param value 元素
+                 * @return std::size_t 新元素的下标
+                 */
+                std::size_t push_back(const T& value)
+                {
+                    return emplace_back(value);
+                }
+                /**
+                 * @brief 追加元素
+                 * @param value 元素
+                 * @return std::size_t 新元素的下标
+                 */
+                std::size_t push_back(T&& value)
+                {
+                    return emplace_back(std::move(value));
+                }
+                /**
+                 * @brief 按下标访问元素
+                 * @note 不做检查；调用方需保证该下标的追加已完成且对当前线程可见
+                 * @param index 下标
+                 * @return T& 元素引用
+                 */
+                T& operator[](std::size_t index)noexcept
+                {
+                    return *get_slot(index, false).get();
+                }
+                /**
+                 * @brief 按下标访问元素
+                 * @note 不做检查；调用方需保证该下标的追加已完成且对当前线程可见
+                 * @param index 下标
+                 * @return const T& 元素引用
+                 */
+                const T& operator[](std::size_t index)const noexcept
+                {
+                    return *const_cast<ConcurrentVector*>(this)->get_slot(index, false).get();
+                }
+                /**
+                 * @brief 按下标访问元素
+                 * @param index 下标
+                 * @return T& 元素引用
+                 * @throws std::out_of_range 下标越界或元素尚未构造完成
+                 */
+                T& at(std::size_t index)
+                {
+                    T* value = try_get(index);
+                    if (!value)
+                    {
+                        throw std::out_of_range("ConcurrentVector::at");
+                    }
+                    return *value;
+                }
+                /**
+                 * @brief 按下标访问元素
+                 * @param index 下标
+                 * @return const T& 元素引用
+                 * @throws std::out_of_range 下标越界或元素尚未构造完成
+                 */
+                const T& at(std::size_t index)const
+                {
+                    return const_cast<ConcurrentVector*>(this)->at(index);
+                }
+                /**
+                 * @brief 尝试按下标获取元素
+                 * @param index 下标
+                 * @return T* 元素指针，下标越界或元素尚未构造完成时为 nullptr
+                 */
+                T* try_get(std::size_t index)noexcept
+                {
+                    if (index >= m_size.load(std::memory_order_acquire))
+                    {
+                        return nullptr;
+                    }
+                    Slot* segment = m_segments[segment_of(index)].load(std::memory_order_acquire);
+                    if (!segment)
+                    {
+                        return nullptr;
+                    }
+                    Slot& slot = segment[index - segment_first(segment_of(index))];
+                    return slot.is_ready.load(std::memory_order_acquire) ? slot.get() : nullptr;
+                }
+                /**
+                 * @brief 遍历已就绪的元素
+                 * @tparam F 可调用对象类型，签名为 void(std::size_t, T&)
+                 * @param function 可调用对象
+                 */
+                template<class F>
+                void for_each(F&& function)
+                {
+                    std::size_t size = m_size.load(std::memory_order_acquire);
+                    for (std::size_t index = 0; index < size; ++index)
+                    {
+                        if (T* value = try_get(index))
+                        {
+                            function(index, *value);
+                        }
+                    }
+                }
+                /**
+                 * @brief 获取已预留的元素数
+                 * @note 包含正在构造的元素
+                 * @return std::size_t 元素数
+                 */
+                std::size_t size()const noexcept
+                {
+                    return m_size.load(std::memory_order_acquire);
+                }
+                /**
+                 * @brief 判断是否为空
+                 * @return bool 是否为空
+                 */
+                bool empty()const noexcept
+                {
+                    return size() == 0;
+                }
+                /**
+                 * @brief 预先分配分段使容量不小于指定值
+                 * @param capacity 容量
+                 */
+                void reserve(std::size_t capacity)
+                {
+                    if (capacity == 0)
+                    {
+                        return;
+                    }
+                    std::size_t last_segment = segment_of(capacity - 1);
+                    for (std::size_t segment_index = 0; segment_index <= last_segment; ++segment_index)
+                    {
+                        ensure_segment(segment_index);
+                    }
+                }
+            private:
+                /**
+                 * @brief 槽位
+                 */
+                struct Slot
+                {
+                    /// @brief 元素存储
+                    alignas(T) unsigned char storage[sizeof(T)];
+                    /// @brief 元素是否已构造完成
+                    std::atomic<bool> is_ready = false;
+                    /**
+                     * @brief 获取元素指针
+                     * @return T* 元素指针
+                     */
+                    T* get()noexcept
+                    {
+                        return std::launder(reinterpret_cast<T*>(storage));
+                    }
+                };
+            private:
+                /**
+                 * @brief 拷贝构造函数
+                 * @note 禁止拷贝构造
+                 */
+                ConcurrentVector(const ConcurrentVector&) = delete;
+                /**
+                 * @brief 拷贝赋值运算符
+                 * @note 禁止拷贝赋值
+                 */
+                ConcurrentVector& operator=(const ConcurrentVector&) = delete;
+                /**
+                 * @brief 计算下标所在分段
+                 * @param index 下标
+                 * @return std::size_t 分段序号
+                 */
+                static std::size_t segment_of(std::size_t index)noexcept
+                {
+                    return static_cast<std::size_t>(std::bit_width((index >> FIRST_SEGMENT_SHIFT) + 1)) - 1;
+                }
+                /**
+                 * @brief 计算分段首元素下标
+                 * @param segment_index 分段序号
+                 * @return std::size_t 首元素下标
+                 */
+                static std::size_t segment_first(std::size_t segment_index)noexcept
+                {
+                    return FIRST_SEGMENT_SIZE * ((std::size_t(1) << segment_index) - 1);
+                }
+                /**
+                 * @brief 计算分段容量
+                 * @param segment_index 分段序号
+                 * @return std::size_t 分段容量
+                 */
+                static std::size_t segment_size(std::size_t segment_index)noexcept
+                {
+                    return FIRST_SEGMENT_SIZE << segment_index;
+                }
+                /**
+                 * @brief 确保分段已分配
+                 * @details 并发分配时仅一个线程的分段被发布，其余线程释放自己的分段
+                 * @param segment_index 分段序号
+                 * @return Slot* 分段
+                 */
+                Slot* ensure_segment(std::size_t segment_index)
+                {
+                    std::atomic<Slot*>& entry = m_segments[segment_index];
+                    Slot* segment = entry.load(std::memory_order_acquire);
+                    if (segment)
+                    {
+                        return segment;
+                    }
+                    Slot* created = new Slot[segment_size(segment_index)];
+                    if (entry.compare_exchange_strong(segment, created, std::memory_order_acq_rel, std::memory_order_acquire))
+                    {
+                        return created;
+                    }
+                    delete[] created;
+                    return segment;
+                }
+                /**
+                 * @brief 获取槽位
+                 * @param index 下标
+                 * @param is_create 分段不存在时是否分配
+                 * @return Slot& 槽位
+                 */
+                Slot& get_slot(std::size_t index, bool is_create)
+                {
+                    std::size_t segment_index = segment_of(index);
+                    Slot* segment = is_create ?
+                        ensure_segment(segment_index) :
+                        m_segments[segment_index].load(std::memory_order_acquire);
+                    return segment[index - segment_first(segment_index)];
+                }
+            private:
+                /// @brief 分段表
+                std::array<std::atomic<Slot*>, SEGMENT_COUNT> m_segments = {};
+                /// @brief 已预留的元素数，独占缓存行以免与分段表伪共享
+                alignas(64) std::atomic<std::size_t> m_size = 0;
+            };
+        }
+    }
+}
@@ -0,0 +1,407 @@
+#pragma once
+
+/**
+ * @file epoch_domain.hpp
+ * @author DaneJoe001
+ * @version 0.1.1
+ * @brief 基于纪元的内存回收
+ * @details 读者在访问共享节点期间持有 EpochGuard，登记自己进入时的全局纪元；
+ *          摘除节点的线程调用 retire() 把节点连同当时的纪元放入本线程的待回收列表。
+ *          所有活跃线程都已观察到当前纪元时全局纪元才能前进，节点在全局纪元比退休时大 2 后释放，
+ *          此时退休前进入的读者都已离开。线程退出时未释放的节点转交全局孤儿列表
+ * @date 2026-10-18
+ */
+
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+/**
+ * @namespace DaneJoe
+ * @brief DaneJoe命名空间
+ */
+namespace DaneJoe
+{
+    /**
+     * @namespace Concurrent
+     * @brief 并发命名空间
+     */
+    namespace Concurrent
+    {
+        /**
+         * @namespace LockFree
+         * @brief 无锁命名空间
+         */
+        namespace LockFree
+        {
+            /**
+             * @class EpochDomain
+             * @brief 纪元回收域
+             * @details 进程内唯一，经 get_global() 获取。每个线程首次使用时认领一条线程记录，退出时归还
+             * @note 长时间持有 EpochGuard 会阻止纪元前进，待回收节点随之积压
+             */
+            class EpochDomain
+            {
+            public:
+                /// @brief 节点释放函数
+                using Deleter = void(*)(void*);
+                /// @brief 本线程待回收节点达到该数量时尝试推进纪元并回收
+                static constexpr std::size_t RECLAIM_THRESHOLD = 64;
+                /**
+                 * @brief 获取全局回收域
+                 * @return EpochDomain& 回收域
+                 */
+                static EpochDomain& get_global()
+                {
+                    static EpochDomain domain;
+                    return domain;
+                }
+                /**
+                 * @brief 析构函数
+                 * @details 释放所有尚未回收的节点
+                 */
+                ~EpochDomain()
+                {
+                    Record* record = m_records.load(std::memory_order_acquire);
+                    while (record)
+                    {
+                        Record* next = record->next;
+                        free_all(record->retired);
+                        delete record;
+                        record = next;
+                    }
+                    free_all(m_orphans);
+                }
+                /**
+                 * @brief 进入临界区
+                 * @note 可嵌套，只有最外层生效
+                 */
+                void enter()
+                {
+                    Record& record = get_record();
+                    if (record.nesting++ > 0)
+                    {
+                        return;
+                    }
+                    std::uint64_t epoch = m_epoch.load(std::memory_order_seq_cst);
+                    while (true)
+                    {
+                        record.epoch.store(epoch, std::memory_order_seq_cst);
+                        // 登记后重读：若纪元已前进，登记的旧纪元可能已不足以保护此后读到的节点
+                        std::uint64_t current = m_epoch.load(std::memory_order_seq_cst);
+                        if (current == epoch)
+                        {
+                            return;
+                        }
+                        epoch = current;
+                    }
+                }
+                /**
+                 * @brief 离开临界区
+                 */
+                void leave()noexcept
+                {
+                    Record& record = get_record();
+                    if (--record.nesting == 0)
+                    {
+                        record.epoch.store(INACTIVE, std::memory_order_release);
+                    }
+                }
+                /**
+                 * @brief 退休已摘除的节点
+                 * @note 调用前节点必须已从共享结构中摘除，之后新进入的读者不可能再访问到它
+                 * @param object 节点
+                 * @param deleter 释放函数
+                 */
+                void retire(void* object, Deleter deleter)
+                {
+                    Record& record = get_record();
+                    record.retired.push_back(Retired{ object, deleter, m_epoch.load(std::memory_order_seq_cst) });
+                    m_retired_count.fetch_add(1, std::memory_order_relaxed);
+                    if (record.retired.size() >= RECLAIM_THRESHOLD)
+                    {
+                        try_advance();
+                        reclaim(record.retired);
+                        std::unique_lock<std::mutex> lock(m_orphan_mutex, std::try_to_lock);
+                        if (lock.owns_lock())
+                        {
+                            reclaim(m_orphans);
+                        }
+                    }
+                }
+                /**
+                 * @brief 退休以 new 分配的对象
+                 * @tparam T 对象类型
+                 * @param object 对象
+                 */
+                template<class T>
+                void retire(T* object)
+                {
+                    retire(object, [](void* pointer)
+                        {
+                            delete static_cast<T*>(pointer);
+                        });
+                }
+                /**
+                 * @brief 尝试推进全局纪元
+                 * @return bool 是否所有活跃线程都已观察到当前纪元
+                 */
+                bool try_advance()
+                {
+                    std::uint64_t epoch = m_epoch.load(std::memory_order_seq_cst);
+                    for (Record* record = m_records.load(std::memory_order_acquire); record; record = record->next)
+                    {
+                        std::uint64_t local = record->epoch.load(std::memory_order_seq_cst);
+                        if (local != INACTIVE && local != epoch)
+                        {
+                            return false;
+                        }
+                    }
+                    m_epoch.compare_exchange_strong(epoch, epoch + 1, std::memory_order_seq_cst);
+                    return true;
+                }
+                /**
+                 * @brief 尽可能回收本线程与孤儿列表中的节点
+                 * @note 在临界区外调用；其他线程仍持有 EpochGuard 时只能回收其进入之前退休的节点
+                 */
+                void collect()
+                {
+                    for (int i = 0; i < 2; ++i)
+                    {
+                        try_advance();
+                    }
+                    reclaim(get_record().retired);
+                    std::lock_guard<std::mutex> lock(m_orphan_mutex);
+                    reclaim(m_orphans);
+                }
+                /**
+                 * @brief 获取全局纪元
+                 * @return std::uint64_t 全局纪元
+                 */
+                std::uint64_t get_epoch()const noexcept
+                {
+                    return m_epoch.load(std::memory_order_acquire);
+                }
+                /**
+                 * @brief 获取已退休尚未释放的节点数
+                 * @return std::size_t 节点数
+                 */
+                std::size_t get_retired_count()const noexcept
+                {
+                    return m_retired_count.load(std::memory_order_relaxed);
+                }
+            private:
+                /// @brief 线程不在临界区时登记的纪元
+                static constexpr std::uint64_t INACTIVE = 0;
+                /**
+                 * @brief 已退休的节点
+                 */
+                struct Retired
+                {
+                    /// @brief 节点
+                    void* object;
+                    /// @brief 释放函数
+                    Deleter deleter;
+                    /// @brief 退休时的全局纪元
+                    std::uint64_t epoch;
+                };
+                /**
+                 * @brief 线程记录
+                 */
+                struct alignas(64) Record
+                {
+                    /// @brief 进入临界区时登记的纪元，不在临界区时为 INACTIVE
+                    std::atomic<std::uint64_t> epoch = INACTIVE;
+                    /// @brief 是否已被线程认领
+                    std::atomic<bool> is_claimed = true;
+                    /// @brief 临界区嵌套深度（认领线程独占）
+                    std::uint32_t nesting = 0;
+                    /// @brief 待回收节点（认领线程独占）
+                    std::vector<Retired> retired;
+                    /// @brief 下一条记录，记录只增不减
+                    Record* next = nullptr;
+                };
+                /**
+                 * @brief 线程退出时归还记录
+                 */
+                struct ThreadState
+                {
+                    /// @brief 认领的记录
+                    Record* record = nullptr;
+                    /**
+                     * @brief 析构函数
+                     */
+                    ~ThreadState()
+                    {
+                        if (record)
+                        {
+                            get_global().release_record(record);
+                        }
+                    }
+                };
+            private:
+                /**
+                 * @brief 构造函数
+                 */
+                EpochDomain() = default;
+                /**
+                 * @brief 拷贝构造函数
+                 * @note 禁止拷贝构造
+                 */
+                EpochDomain(const EpochDomain&) = delete;
+                /**
+                 * @brief 拷贝赋值运算符
+                 * @note 禁止拷贝赋值
+                 */
+                EpochDomain& operator=(const EpochDomain&) = delete;
+                /**
+                 * @brief 获取本线程的记录，首次调用时认领
+                 * @return Record& 记录
+                 */
+                Record& get_record()
+                {
+                    thread_local ThreadState state;
+                    if (!state.record)
+                    {
+                        state.record = acquire_record();
+                    }
+                    return *state.record;
+                }
+                /**
+                 * @brief 认领空闲记录，没有时新建
+                 * @return Record* 记录
+                 */
+                Record* acquire_record()
+                {
+                    for (Record* record = m_records.load(std::memory_order_acquire); record; record = record->next)
+                    {
+                        bool expected = false;
+                        if (!record->is_claimed.load(std::memory_order_relaxed) &&
+                            record->is_claimed.compare_exchange_strong(expected, true, std::memory_order_acquire))
+                        {
+                            return record;
+                        }
+                    }
+                    Record* record = new Record();
+                    Record* head = m_records.load(std::memory_order_relaxed);
+                    do
+                    {
+                        record->next = head;
+                    } while (!m_records.compare_exchange_weak(head, record, std::memory_order_release, std::memory_order_relaxed));
+                    return record;
+                }
+                /**
+                 * @brief 归还记录，未释放的节点转入孤儿列表
+                 * @param record 记录
+                 */
+                void release_record(Record* record)
+                {
+                    record->nesting = 0;
+                    record->epoch.store(INACTIVE, std::memory_order_release);
+                    try_advance();
+                    reclaim(record->retired);
+                    if (!record->retired.empty())
+                    {
+                        std::lock_guard<std::mutex> lock(m_orphan_mutex);
+                        m_orphans.insert(m_orphans.end(), record->retired.begin(), record->retired.end());
+                        record->retired.clear();
+                    }
+                    record->is_claimed.store(false, std::memory_order_release);
+                }
+                /**
+                 * @brief 释放列表中已安全的节点
+                 * @param list 待回收列表
+                 */
+                void reclaim(std::vector<Retired>& list)
+                {
+                    std::uint64_t epoch = m_epoch.load(std::memory_order_seq_cst);
+                    std::size_t kept = 0;
+                    for (std::size_t i = 0; i < list.size(); ++i)
+                    {
+                        if (list[i].epoch + 2 <= epoch)
+                        {
+                            list[i].deleter(list[i].object);
+                        }
+                        else
+                        {
+                            list[kept++] = list[i];
+                        }
+                    }
+                    m_retired_count.fetch_sub(list.size() - kept, std::memory_order_relaxed);
+                    list.resize(kept);
+                }
+                /**
+                 * @brief 无条件释放列表中的节点
+                 * @param list 待回收列表
+                 */
+                void free_all(std::vector<Retired>& list)noexcept
+                {
+                    for (const Retired& retired : list)
+                    {
+                        retired.deleter(retired.object);
+                    }
+                    m_retired_count.fetch_sub(list.size(), std::memory_order_relaxed);
+                    list.clear();
+                }
+            private:
+                /// @brief 全局纪元，从 1 开始以区别于 INACTIVE
+                std::atomic<std::uint64_t> m_epoch = 1;
+                /// @brief 线程记录链表
+                std::atomic<Record*> m_records = nullptr;
+                /// @brief 已退休尚未释放的节点数
+                std::atomic<std::size_t> m_retired_count = 0;
+                /// @brief 保护孤儿列表
+                std::mutex m_orphan_mutex;
+                /// @brief 退出线程留下的待回收节点
+                std::vector<Retired> m_orphans;
+            };
+            /**
+             * @class EpochGuard
+             * @brief 纪元临界区守卫
+             * @details 构造时进入临界区，析构时离开；拷贝会再次进入，因此可作为迭代器成员
+             * @note 守卫只能在创建它的线程上使用与销毁
+             */
+            class EpochGuard
+            {
+            public:
+                /**
+                 * @brief 构造函数
+                 */
+                EpochGuard()
+                {
+                    EpochDomain::get_global().enter();
+                }
+                /**
+                 * @brief 拷贝构造函数
+                 * @param other 其他守卫
+                 */
+                EpochGuard(const EpochGuard& other)
+                {
+                    (void)other;
+                    EpochDomain::get_global().enter();
+                }
+                /**
+                 * @brief 拷贝赋值运算符
+                 * @note 双方都已在临界区内，无需操作
+                 * @param other 其他守卫
+                 * @return EpochGuard& 本守卫
+                 */
+                EpochGuard& operator=(const EpochGuard& other)noexcept
+                {
+                    (void)other;
+                    return *this;
+                }
+                /**
+                 * @brief 析构函数
+                 */
+                ~EpochGuard()
+                {
+                    EpochDomain::get_global().leave();
+                }
+            };
+        }
+    }
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+/**
+ * @file latest_value.hpp
+ * @author DaneJoe001
+ * @version 0.1.1
+ * @brief 基于顺序锁的最新值
+ * @details 单写者多读者：写者把序号置为奇数、写入、再置为偶数，从不等待；
+ *          读者在序号前后一致且为偶数时得到一致快照，否则重试。
+ *          数据按 64 位字以 relaxed 原子操作拷贝，避免与写者构成数据竞争
+ * @date 2026-10-18
+ */
+
+#include <atomic>
+#include <thread>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * @namespace DaneJoe
+ * @brief DaneJoe命名空间
+ */
+namespace DaneJoe
+{
+    /**
+     * @namespace Concurrent
+     * @brief 并发命名空间
+     */
+    namespace Concurrent
+    {
+        /**
+         * @namespace LockFree
+         * @brief 无锁命名空间
+         */
+        namespace LockFree
+        {
+            /**
+             * @class LatestValue
+             * @brief 基于顺序锁的最新值
+             * @note store() 只能由单个写者调用；读者数量不限。写入无等待，读取在写入期间重试
+             * @tparam T 值类型，需可平凡拷贝
+             */
+            template<class T>
+            class LatestValue
+            {
+                static_assert(std::is_trivially_copyable_v<T>, "LatestValue requires a trivially copyable type");
+                static_assert(std::is_default_constructible_v<T>, "LatestValue requires a default constructible type");
+            public:
+                /**
+                 * @brief 构造函数
+                 * @param initial 初始值
+                 */
+                explicit LatestValue(const T& initial = T())noexcept
+                {
+                    write_words(initial);
+                }
+                /**
+                 * @brief 发布新值（写者）
+                 * @param value 新值
+                 */
+                void store(const T& value)noexcept
+                {
+                    std::uint64_t sequence = m_sequence.load(std::memory_order_relaxed);
+                    m_sequence.store(sequence + 1, std::memory_order_relaxed);
+                    std::atomic_thread_fence(std::memory_order_release);
+                    write_words(value);
+                    m_sequence.store(sequence + 2, std::memory_order_release);
+                }
+                /**
+                 * @brief 读取一致快照
+                 * @return T 最新值
+                 */
+                T load()const noexcept
+                {
+                    T value;
+                    while (!try_load(value))
+                    {
+                        std::this_thread::yield();
+                    }
+                    return value;
+                }
+                /**
+                 * @brief 尝试读取一次
+                 * @param value 成功时写入快照
+                 * @return bool 是否读到一致快照，与写入重叠时返回 false
+                 */
+                bool try_load(T& value)const noexcept
+                {
+                    std::uint64_t before = m_sequence.load(std::memory_order_acquire);
+                    if (before & 1)
+                    {
+                        return false;
+                    }
+                    std::uint64_t words[WORD_COUNT];
+                    for (std::size_t i = 0; i < WORD_COUNT; ++i)
+                    {
+                        words[i] = m_words[i].load(std::memory_order_relaxed);
+                    }
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if (m_sequence.load(std::memory_order_relaxed) != before)
+                    {
+                        return false;
+                    }
+                    std::memcpy(&value, words, sizeof(T));
+                    return true;
+                }
+                /**
+                 * @brief 获取版本号
+                 * @details 每次 store() 加一，读者可据此判断值是否变化
+                 * @return std::uint64_t 版本号
+                 */
+                std::uint64_t get_version()const noexcept
+                {
+                    return m_sequence.load(std::memory_order_acquire) / 2;
+                }
+            private:
+                /// @brief 存放值所需的 64 位字数
+                static constexpr std::size_t WORD_COUNT = (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+            private:
+                /**
+                 * @brief 拷贝构造函数
+                 * @note 禁止拷贝构造
+                 */
+                LatestValue(const LatestValue&) = delete;
+                /**
+                 * @brief 拷贝赋值运算符
+                 * @note 禁止拷贝赋值
+                 */
+                LatestValue& operator=(const LatestValue&) = delete;
+                /**
+                 * @brief 按字写入值
+                 * @param value 值
+                 */
+                void write_words(const T& value)noexcept
+                {
+                    std::uint64_t words[WORD_COUNT] = {};
+                    std::memcpy(words, &value, sizeof(T));
+                    for (std::size_t i = 0; i < WORD_COUNT; ++i)
+                    {
+                        m_words[i].store(words[i], std::memory_order_relaxed);
+                    }
+                }
+            private:
+                /// @brief 序号，奇数表示写入中
+                alignas(64) std::atomic<std::uint64_t> m_sequence = 0;
+                /// @brief 值
+                std::atomic<std::uint64_t> m_words[WORD_COUNT];
+            };
+        }
+    }
+}
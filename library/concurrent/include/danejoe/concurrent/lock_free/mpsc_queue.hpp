@@ -0,0 +1,193 @@
+#pragma once
+
+/**
+ * @file mpsc_queue.hpp
+ * @author DaneJoe001
+ * @version 0.1.1
+ * @brief 无锁多生产者单消费者队列
+ * @details 侵入式链表队列（Vyukov）：入队为一次 exchange 加一次 store，出队无原子读改写；
+ *          节点由 FramePool 池化分配，空队列只占三个指针
+ * @date 2026-10-18
+ */
+
+#include <atomic>
+#include <utility>
+#include <optional>
+
+#include "danejoe/concurrent/thread_pool/frame_pool.hpp"
+
+/**
+ * @namespace DaneJoe
+ * @brief DaneJoe命名空间
+ */
+namespace DaneJoe
+{
+    /**
+     * @namespace Concurrent
+     * @brief 并发命名空间
+     */
+    namespace Concurrent
+    {
+        /**
+         * @namespace LockFree
+         * @brief 无锁命名空间
+         */
+        namespace LockFree
+        {
+            /**
+             * @class MpscQueue
+             * @brief 无锁多生产者单消费者队列
+             * @note 无界；try_pop() 只能由单个消费者调用。
+             *       生产者在 exchange 与链接之间被挂起时，后续元素对消费者暂不可见，try_pop() 返回空
+             * @tparam T 元素类型
+             */
+            template<class T>
+            class MpscQueue
+            {
+            public:
+                /**
+                 * @brief 构造函数
+                 */
+                MpscQueue()noexcept :m_head(&m_stub), m_tail(&m_stub) {}
+                /**
+                 * @brief 析构函数
+                 * @note 调用方需保证析构时没有并发的入队
+                 */
+                ~MpscQueue()
+                {
+                    while (try_pop())
+                    {
+                    }
+                }
+                /**
+                 * @brief 原地构造并入队
+                 * @tparam Args 构造参数类型
+                 * @param args 构造参数
+                 */
+                template<class... Args>
+                void emplace(Args&&... args)
+                {
+                    push_node(ThreadPool::FramePool::create<Node>(std::forward<Args>(args)...));
+                }
+                /**
+                 * @brief 入队
+                 * @param value 元素
+                 */
+                void push(T value)
+                {
+                    emplace(std::move(value));
+                }
+                /**
+                 * @brief 出队
+                 * @return std::optional<T> 队首元素，队列为空（或队首尚未链接完成）时为空
+                 */
+                std::optional<T> try_pop()
+                {
+                    NodeBase* tail = m_tail;
+                    NodeBase* next = tail->next.load(std::memory_order_acquire);
+                    if (tail == &m_stub)
+                    {
+                        if (!next)
+                        {
+                            return std::nullopt;
+                        }
+                        m_tail = next;
+                        tail = next;
+                        next = next->next.load(std::memory_order_acquire);
+                    }
+                    if (next)
+                    {
+                        m_tail = next;
+                        return take(tail);
+                    }
+                    if (tail != m_head.load(std::memory_order_acquire))
+                    {
+                        return std::nullopt;
+                    }
+                    // 队列只剩一个元素：重新挂入哨兵，使该元素可以被取走
+                    m_stub.next.store(nullptr, std::memory_order_relaxed);
+                    push_node(&m_stub);
+                    next = tail->next.load(std::memory_order_acquire);
+                    if (next)
+                    {
+                        m_tail = next;
+                        return take(tail);
+                    }
+                    return std::nullopt;
+                }
+                /**
+                 * @brief 判断队列是否为空
+                 * @note 仅消费者调用时结果准确
+                 * @return bool 是否为空
+                 */
+                bool empty()const noexcept
+                {
+                    return m_tail == &m_stub && m_head.load(std::memory_order_acquire) == &m_stub;
+                }
+            private:
+                /**
+                 * @brief 链表节点公共部分
+                 */
+                struct NodeBase
+                {
+                    /// @brief 下一个节点
+                    std::atomic<NodeBase*> next = nullptr;
+                };
+                /**
+                 * @brief 元素节点
+                 */
+                struct Node : NodeBase
+                {
+                    /**
+                     * @brief 构造函数
+                     * @tparam Args 构造参数类型
+                     * @param args 构造参数
+                     */
+                    template<class... Args>
+                    explicit Node(Args&&... args) :value(std::forward<Args>(args)...) {}
+                    /// @brief 元素
+                    T value;
+                };
+            private:
+                /**
+                 * @brief 拷贝构造函数
+                 * @note 禁止拷贝构造
+                 */
+                MpscQueue(const MpscQueue&) = delete;
+                /**
+                 * @brief 拷贝赋值运算符
+                 * @note 禁止拷贝赋值
+                 */
+                MpscQueue& operator=(const MpscQueue&) = delete;
+                /**
+                 * @brief 链接节点到队头
+                 * @param node 节点
+                 */
+                void push_node(NodeBase* node)noexcept
+                {
+                    NodeBase* previous = m_head.exchange(node, std::memory_order_acq_rel);
+                    previous->next.store(node, std::memory_order_release);
+                }
+                /**
+                 * @brief 取出节点中的元素并释放节点
+                 * @param node 节点
+                 * @return std::optional<T> 元素
+                 */
+                static std::optional<T> take(NodeBase* node)
+                {
+                    Node* value_node = static_cast<Node*>(node);
+                    std::optional<T> value(std::move(value_node->value));
+                    ThreadPool::FramePool::destroy(value_node);
+                    return value;
+                }
+            private:
+                /// @brief 最近入队的节点（生产者端）
+                std::atomic<NodeBase*> m_head;
+                /// @brief 下一个出队的节点（消费者端）
+                NodeBase* m_tail;
+                /// @brief 哨兵节点
+                NodeBase m_stub;
+            };
+        }
+    }
+}
@@ -0,0 +1,426 @@
+#pragma once
+
+/**
+ * @file shm_spsc_ring.hpp
+ * @author DaneJoe001
+ * @version 0.1.1
+ * @brief 共享内存中的跨进程单生产者单消费者环形队列
+ * @details 队列位于 shm_open/mmap 映射的共享内存，头部带魔数、版本号与元素大小供打开方校验；
+ *          读写索引各占一个缓存行，入队出队只访问共享内存，不发生系统调用。
+ *          双方定期调用 heartbeat() 写入单调时钟时间戳，对方据此判断进程是否已崩溃
+ * @note 仅支持 POSIX 平台；元素需可平凡拷贝，变长数据可封装为定长帧
+ * @date 2026-10-18
+ */
+
+#if !defined(_WIN32)
+
+#include <new>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <system_error>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * @namespace DaneJoe
+ * @brief DaneJoe命名空间
+ */
+namespace DaneJoe
+{
+    /**
+     * @namespace Concurrent
+     * @brief 并发命名空间
+     */
+    namespace Concurrent
+    {
+        /**
+         * @namespace LockFree
+         * @brief 无锁命名空间
+         */
+        namespace LockFree
+        {
+            /**
+             * @enum ShmRole
+             * @brief 进程在共享队列中的角色
+             */
+            enum class ShmRole
+            {
+                /// @brief 生产者
+                Producer,
+                /// @brief 消费者
+                Consumer
+            };
+            /**
+             * @class ShmSpscRing
+             * @brief 共享内存中的跨进程单生产者单消费者环形队列
+             * @note 一方 create() 创建，另一方 open() 打开；共享内存名由调用方在不再需要时 unlink()
+             * @tparam T 元素类型，需可平凡拷贝且可默认构造
+             */
+            template<class T>
+            class ShmSpscRing
+            {
+                static_assert(std::is_trivially_copyable_v<T>, "ShmSpscRing requires a trivially copyable type");
+                static_assert(std::is_default_constructible_v<T>, "ShmSpscRing requires a default constructible type");
+                static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "ShmSpscRing requires lock-free 64-bit atomics");
+            public:
+                /// @brief 共享内存布局版本
+                static constexpr std::uint32_t VERSION = 1;
+                /**
+                 * @brief 创建共享队列
+                 * @param name 共享内存名，形如 "/name"
+                 * @param capacity 容量，向上取整为 2 的幂
+                 * @param role 本进程角色
+                 * @return ShmSpscRing 队列
+                 * @throws std::system_error 同名共享内存已存在或创建失败
+                 */
+                static ShmSpscRing create(const std::string& name, std::size_t capacity, ShmRole role)
+                {
+                    std::size_t rounded = 1;
+                    while (rounded < capacity)
+                    {
+                        rounded <<= 1;
+                    }
+                    std::size_t size = sizeof(Header) + rounded * sizeof(T);
+                    int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+                    if (fd < 0)
+                    {
+                        throw std::system_error(errno, std::generic_category(), "shm_open " + name);
+                    }
+                    if (::ftruncate(fd, static_cast<off_t>(size)) != 0)
+                    {
+                        int error = errno;
+                        ::close(fd);
+                        ::shm_unlink(name.c_str());
+                        throw std::system_error(error, std::generic_category(), "ftruncate " + name);
+                    }
+                    void* memory = map(fd, size);
+                    Header* header = new (memory) Header();
+                    header->version = VERSION;
+                    header->element_size = sizeof(T);
+                    header->capacity = rounded;
+                    // 魔数最后写入，打开方看到魔数即可读取其余字段
+                    header->magic.store(MAGIC, std::memory_order_release);
+                    return ShmSpscRing(header, size, role);
+                }
+                /**
+                 * @brief 打开已创建的共享队列
+                 * @param name 共享内存名
+                 * @param role 本进程角色
+                 * @return ShmSpscRing 队列
+                 * @throws std::system_error 打开或映射失败
+                 * @throws std::runtime_error 尚未初始化、版本或元素大小不匹配
+                 */
+                static ShmSpscRing open(const std::string& name, ShmRole role)
+                {
+                    int fd = ::shm_open(name.c_str(), O_RDWR, 0600);
+                    if (fd < 0)
+                    {
+                        throw std::system_error(errno, std::generic_category(), "shm_open " + name);
+                    }
+                    struct stat status {};
+                    if (::fstat(fd, &status) != 0)
+                    {
+                        int error = errno;
+                        ::close(fd);
+                        throw std::system_error(error, std::generic_category(), "fstat " + name);
+                    }
+                    std::size_t size = static_cast<std::size_t>(status.st_size);
+                    if (size < sizeof(Header))
+                    {
+                        ::close(fd);
+                        throw std::runtime_error("ShmSpscRing not initialized: " + name);
+                    }
+                    Header* header = static_cast<Header*>(map(fd, size));
+                    const char* error = nullptr;
+                    if (header->magic.load(std::memory_order_acquire) != MAGIC)
+                    {
+                        error = "ShmSpscRing not initialized: ";
+                    }
+                    else if (header->version != VERSION)
+                    {
+                        error = "ShmSpscRing version mismatch: ";
+                    }
+                    else if (header->element_size != sizeof(T) || sizeof(Header) + header->capacity * sizeof(T) > size)
+                    {
+                        error = "ShmSpscRing element size mismatch: ";
+                    }
+                    if (error)
+                    {
+                        ::munmap(header, size);
+                        throw std::runtime_error(error + name);
+                    }
+                    return ShmSpscRing(header, size, role);
+                }
+                /**
+                 * @brief 删除共享内存名
+                 * @note 已映射的进程仍可继续使用
+                 * @param name 共享内存名
+                 * @return bool 是否删除
+                 */
+                static bool unlink(const std::string& name)noexcept
+                {
+                    return ::shm_unlink(name.c_str()) == 0;
+                }
+                /**
+                 * @brief 移动构造函数
+                 * @param other 另一队列
+                 */
+                ShmSpscRing(ShmSpscRing&& other)noexcept :
+                    m_header(std::exchange(other.m_header, nullptr)),
+                    m_slots(other.m_slots),
+                    m_mapped_size(other.m_mapped_size),
+                    m_mask(other.m_mask),
+                    m_role(other.m_role),
+                    m_cached_index(other.m_cached_index)
+                {
+                }
+                /**
+                 * @brief 移动赋值运算符
+                 * @param other 另一队列
+                 * @return ShmSpscRing& 本队列
+                 */
+                ShmSpscRing& operator=(ShmSpscRing&& other)noexcept
+                {
+                    if (this != &other)
+                    {
+                        release();
+                        m_header = std::exchange(other.m_header, nullptr);
+                        m_slots = other.m_slots;
+                        m_mapped_size = other.m_mapped_size;
+                        m_mask = other.m_mask;
+                        m_role = other.m_role;
+                        m_cached_index = other.m_cached_index;
+                    }
+                    return *this;
+                }
+                /**
+                 * @brief 析构函数
+                 * @note 解除映射，不删除共享内存名
+                 */
+                ~ShmSpscRing()
+                {
+                    release();
+                }
+                /**
+                 * @brief 入队（生产者）
+                 * @param value 元素
+                 * @return bool 是否成功，队列满时返回 false
+                 */
+                bool try_push(const T& value)noexcept
+                {
+                    std::uint64_t head = m_header->head.load(std::memory_order_relaxed);
+                    if (head - m_cached_index > m_mask)
+                    {
+                        // 缓存的读索引过旧时才读取共享读索引
+                        m_cached_index = m_header->tail.load(std::memory_order_acquire);
+                        if (head - m_cached_index > m_mask)
+                        {
+                            return false;
+                        }
+                    }
+                    std::memcpy(&m_slots[head & m_mask], &value, sizeof(T));
+                    m_header->head.store(head + 1, std::memory_order_release);
+                    return true;
+                }
+                /**
+                 * @brief 出队（消费者）
+                 * @return std::optional<T> 队首元素，队列为空时为空
+                 */
+                std::optional<T> try_pop()noexcept
+                {
+                    std::uint64_t tail = m_header->tail.load(std::memory_order_relaxed);
+                    if (tail == m_cached_index)
+                    {
+                        m_cached_index = m_header->head.load(std::memory_order_acquire);
+                        if (tail == m_cached_index)
+                        {
+                            return std::nullopt;
+                        }
+                    }
+                    std::optional<T> value(std::in_place);
+                    std::memcpy(&*value, &m_slots[tail & m_mask], sizeof(T));
+                    m_header->tail.store(tail + 1, std::memory_order_release);
+                    return value;
+                }
+                /**
+                 * @brief 写入本进程心跳
+                 * @note 读取单调时钟（vDSO），不进入内核
+                 */
+                void heartbeat()noexcept
+                {
+                    get_heartbeat(m_role).store(now(), std::memory_order_release);
+                }
+                /**
+                 * @brief 判断对方进程是否存活
+                 * @param timeout 心跳超时
+                 * @return bool 对方在超时内写过心跳时返回 true
+                 */
+                bool is_peer_alive(std::chrono::nanoseconds timeout)const noexcept
+                {
+                    ShmRole peer = m_role == ShmRole::Producer ? ShmRole::Consumer : ShmRole::Producer;
+                    std::int64_t last = get_heartbeat(peer).load(std::memory_order_acquire);
+                    return last != 0 && now() - last <= timeout.count();
+                }
+                /**
+                 * @brief 关闭队列，通知对方不再有新元素
+                 */
+                void close()noexcept
+                {
+                    m_header->is_closed.store(1, std::memory_order_release);
+                }
+                /**
+                 * @brief 判断队列是否已关闭
+                 * @return bool 是否已关闭
+                 */
+                bool is_closed()const noexcept
+                {
+                    return m_header->is_closed.load(std::memory_order_acquire) != 0;
+                }
+                /**
+                 * @brief 获取元素数
+                 * @return std::size_t 元素数（近似）
+                 */
+                std::size_t size()const noexcept
+                {
+                    std::uint64_t tail = m_header->tail.load(std::memory_order_acquire);
+                    std::uint64_t head = m_header->head.load(std::memory_order_acquire);
+                    return static_cast<std::size_t>(head - tail);
+                }
+                /**
+                 * @brief 获取容量
+                 * @return std::size_t 容量
+                 */
+                std::size_t capacity()const noexcept
+                {
+                    return static_cast<std::size_t>(m_mask + 1);
+                }
+            private:
+                /// @brief 头部魔数
+                static constexpr std::uint64_t MAGIC = 0x444A53504D52494EULL;
+                /**
+                 * @brief 共享内存头部
+                 */
+                struct Header
+                {
+                    /// @brief 魔数，初始化完成后写入
+                    std::atomic<std::uint64_t> magic = 0;
+                    /// @brief 布局版本
+                    std::uint32_t version = 0;
+                    /// @brief 元素大小
+                    std::uint32_t element_size = 0;
+                    /// @brief 容量
+                    std::uint64_t capacity = 0;
+                    /// @brief 是否已关闭
+                    std::atomic<std::uint32_t> is_closed = 0;
+                    /// @brief 生产者心跳（单调时钟纳秒）
+                    alignas(64) std::atomic<std::int64_t> producer_heartbeat = 0;
+                    /// @brief 消费者心跳（单调时钟纳秒）
+                    alignas(64) std::atomic<std::int64_t> consumer_heartbeat = 0;
+                    /// @brief 写索引
+                    alignas(64) std::atomic<std::uint64_t> head = 0;
+                    /// @brief 读索引
+                    alignas(64) std::atomic<std::uint64_t> tail = 0;
+                };
+            private:
+                /**
+                 * @brief 构造函数
+                 * @param header 映射的头部
+                 * @param mapped_size 映射大小
+                 * @param role 本进程角色
+                 */
+                ShmSpscRing(Header* header, std::size_t mapped_size, ShmRole role)noexcept :
+                    m_header(header),
+                    m_slots(reinterpret_cast<T*>(reinterpret_cast<std::byte*>(header) + sizeof(Header))),
+                    m_mapped_size(mapped_size),
+                    m_mask(header->capacity - 1),
+                    m_role(role)
+                {
+                    m_cached_index = role == ShmRole::Producer ? header->tail.load(std::memory_order_acquire) : header->head.load(std::memory_order_acquire);
+                    heartbeat();
+                }
+                /**
+                 * @brief 拷贝构造函数
+                 * @note 禁止拷贝构造
+                 */
+                ShmSpscRing(const ShmSpscRing&) = delete;
+                /**
+                 * @brief 拷贝赋值运算符
+                 * @note 禁止拷贝赋值
+                 */
+                ShmSpscRing& operator=(const ShmSpscRing&) = delete;
+                /**
+                 * @brief 映射共享内存并关闭 fd
+                 * @param fd 文件描述符
+                 * @param size 映射大小
+                 * @return void* 映射地址
+                 */
+                static void* map(int fd, std::size_t size)
+                {
+                    void* memory = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                    int error = errno;
+                    ::close(fd);
+                    if (memory == MAP_FAILED)
+                    {
+                        throw std::system_error(error, std::generic_category(), "mmap");
+                    }
+                    return memory;
+                }
+                /**
+                 * @brief 获取单调时钟纳秒数
+                 * @return std::int64_t 纳秒数
+                 */
+                static std::int64_t now()noexcept
+                {
+                    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+                }
+                /**
+                 * @brief 获取角色对应的心跳字段
+                 * @param role 角色
+                 * @return std::atomic<std::int64_t>& 心跳字段
+                 */
+                std::atomic<std::int64_t>& get_heartbeat(ShmRole role)const noexcept
+                {
+                    return role == ShmRole::Producer ? m_header->producer_heartbeat : m_header->consumer_heartbeat;
+                }
+                /**
+                 * @brief 解除映射
+                 */
+                void release()noexcept
+                {
+                    if (m_header)
+                    {
+                        ::munmap(m_header, m_mapped_size);
+                        m_header = nullptr;
+                    }
+                }
+            private:
+                /// @brief 共享内存头部
+                Header* m_header;
+                /// @brief 元素槽位
+                T* m_slots;
+                /// @brief 映射大小
+                std::size_t m_mapped_size;
+                /// @brief 下标掩码
+                std::uint64_t m_mask;
+                /// @brief 本进程角色
+                ShmRole m_role;
+                /// @brief 本进程缓存的对方索引（生产者缓存读索引，消费者缓存写索引）
+                std::uint64_t m_cached_index = 0;
+            };
+        }
+    }
+}
+
+#endif
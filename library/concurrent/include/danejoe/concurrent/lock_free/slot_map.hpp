@@ -0,0 +1,543 @@
+#pragma once
+
+/**
+ * @file slot_map.hpp
+ * @author DaneJoe001
+ * @version 0.1.1
+ * @brief 带代数的无锁句柄分配器与槽位表
+ * @details 空闲槽位组成带标签的无锁栈（Treiber），分配与释放各为一次 CAS；
+ *          句柄由槽位下标与代数组成，槽位每次分配与释放代数各加一，奇数表示占用，
+ *          槽位被回收再分配后旧句柄的代数不再匹配，从而识别过期句柄。
+ *          占用位图按 64 个槽位一字记录，遍历时整字跳过空闲区域，只访问占用的槽位
+ * @date 2026-10-18
+ */
+
+#include <bit>
+#include <new>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <stdexcept>
+#include <type_traits>
+
+/**
+ * @namespace DaneJoe
+ * @brief DaneJoe命名空间
+ */
+namespace DaneJoe
+{
+    /**
+     * @namespace Concurrent
+     * @brief 并发命名空间
+     */
+    namespace Concurrent
+    {
+        /**
+         * @namespace LockFree
+         * @brief 无锁命名空间
+         */
+        namespace LockFree
+        {
+            /**
+             * @class SlotHandle
+             * @brief 槽位句柄
+             * @details 高 32 位为代数，低 32 位为槽位下标；默认构造的空句柄代数为 0，永远无效。
+             *          可经 get_value()/from_value() 与 64 位整数互转，用作连接 ID 等
+             */
+            class SlotHandle
+            {
+            public:
+                /**
+                 * @brief 构造空句柄
+                 */
+                constexpr SlotHandle()noexcept = default;
+                /**
+                 * @brief 构造函数
+                 * @param index 槽位下标
+                 * @param generation 代数
+                 */
+                constexpr SlotHandle(std::uint32_t index, std::uint32_t generation)noexcept :
+                    m_value((static_cast<std::uint64_t>(generation) << 32) | index)
+                {
+                }
+                /**
+                 * @brief 由整数值还原句柄
+                 * @param value get_value() 的返回值
+                 * @return SlotHandle 句柄
+                 */
+                static constexpr SlotHandle from_value(std::uint64_t value)noexcept
+                {
+                    SlotHandle handle;
+                    handle.m_value = value;
+                    return handle;
+                }
+                /**
+                 * @brief 获取整数值
+                 * @return std::uint64_t 整数值
+                 */
+                constexpr std::uint64_t get_value()const noexcept
+                {
+                    return m_value;
+                }
+                /**
+                 * @brief 获取槽位下标
+                 * @return std::uint32_t 槽位下标
+                 */
+                constexpr std::uint32_t get_index()const noexcept
+                {
+                    return static_cast<std::uint32_t>(m_value);
+                }
+                /**
+                 * @brief 获取代数
+                 * @return std::uint32_t 代数
+                 */
+                constexpr std::uint32_t get_generation()const noexcept
+                {
+                    return static_cast<std::uint32_t>(m_value >> 32);
+                }
+                /**
+                 * @brief 判断是否为空句柄
+                 * @return bool 是否为空句柄
+                 */
+                constexpr bool is_null()const noexcept
+                {
+                    return get_generation() == 0;
+                }
+                /**
+                 * @brief 判断两个句柄是否相同
+                 * @param other 其他句柄
+                 * @return bool 是否相同
+                 */
+                constexpr bool operator==(const SlotHandle& other)const noexcept = default;
+            private:
+                /// @brief 代数与下标
+                std::uint64_t m_value = 0;
+            };
+            /**
+             * @class HandleAllocator
+             * @brief 无锁句柄分配器
+             * @details 容量固定；acquire()/release() 可由任意线程并发调用，重复释放或释放过期句柄返回 false
+             * @note 同一槽位的代数在约 2^31 次复用后回绕，回绕后极旧的句柄可能再次匹配
+             */
+            class HandleAllocator
+            {
+            public:
+                /// @brief 最大容量
+                static constexpr std::size_t MAX_CAPACITY = 0xFFFFFFFEu;
+                /**
+                 * @brief 构造函数
+                 * @param capacity 槽位数
+                 * @throw std::length_error 容量超过 MAX_CAPACITY
+                 */
+                explicit HandleAllocator(std::size_t capacity) :
+                    m_capacity(check_capacity(capacity)),
+                    m_slots(capacity),
+                    m_live_words((capacity + 63) / 64)
+                {
+                    // 下标小的槽位先分配
+                    for (std::size_t i = 0; i < capacity; ++i)
+                    {
+                        std::uint32_t next = i + 1 < capacity ? static_cast<std::uint32_t>(i + 1) : NIL;
+                        m_slots[i].next.store(next, std::memory_order_relaxed);
+                    }
+                    m_free_head.store(pack(0, capacity > 0 ? 0 : NIL), std::memory_order_relaxed);
+                }
+                /**
+                 * @brief 分配句柄
+                 * @return SlotHandle 句柄；槽位耗尽时返回空句柄
+                 */
+                SlotHandle acquire()
+                {
+                    return acquire([](std::uint32_t) {});
+                }
+                /**
+                 * @brief 分配句柄，发布前先初始化槽位
+                 * @details construct 在句柄生效与占用位设置之前调用，其写入对之后经句柄或遍历访问该槽位的线程可见
+                 * @tparam F 初始化函数类型，签名为 void(std::uint32_t index)
+                 * @param construct 初始化函数，抛出异常时槽位归还并继续传播异常
+                 * @return SlotHandle 句柄；槽位耗尽时返回空句柄且不调用 construct
+                 */
+                template<class F>
+                SlotHandle acquire(F&& construct)
+                {
+                    std::uint32_t index = pop_free();
+                    if (index == NIL)
+                    {
+                        return SlotHandle();
+                    }
+                    try
+                    {
+                        construct(index);
+                    }
+                    catch (...)
+                    {
+                        push_free(index);
+                        throw;
+                    }
+                    Slot& slot = m_slots[index];
+                    // 空闲槽位的代数为偶数，只由持有它的线程修改；加一后为奇数，不会是空句柄的 0
+                    std::uint32_t generation = slot.generation.load(std::memory_order_relaxed) + 1;
+                    slot.generation.store(generation, std::memory_order_release);
+                    m_live_words[index / 64].fetch_or(std::uint64_t(1) << (index % 64), std::memory_order_release);
+                    m_size.fetch_add(1, std::memory_order_relaxed);
+                    return SlotHandle(index, generation);
+                }
+                /**
+                 * @brief 释放句柄
+                 * @param handle 句柄
+                 * @return bool 是否释放；句柄为空、过期或已释放时返回 false
+                 */
+                bool release(SlotHandle handle)
+                {
+                    return release(handle, [](std::uint32_t) {});
+                }
+                /**
+                 * @brief 释放句柄，归还槽位前先清理
+                 * @details 代数先前进使句柄失效，再清除占用位，之后调用 destroy，最后归还槽位
+                 * @tparam F 清理函数类型，签名为 void(std::uint32_t index)，不应抛出异常
+                 * @param handle 句柄
+                 * @param destroy 清理函数，仅在释放成功时调用
+                 * @return bool 是否释放；并发释放同一句柄时只有一个成功
+                 */
+                template<class F>
+                bool release(SlotHandle handle, F&& destroy)
+                {
+                    if (!is_live_generation(handle))
+                    {
+                        return false;
+                    }
+                    std::uint32_t index = handle.get_index();
+                    Slot& slot = m_slots[index];
+                    std::uint32_t expected = handle.get_generation();
+                    if (!slot.generation.compare_exchange_strong(expected, expected + 1, std::memory_order_acq_rel, std::memory_order_relaxed))
+                    {
+                        return false;
+                    }
+                    m_live_words[index / 64].fetch_and(~(std::uint64_t(1) << (index % 64)), std::memory_order_relaxed);
+                    destroy(index);
+                    m_size.fetch_sub(1, std::memory_order_relaxed);
+                    push_free(index);
+                    return true;
+                }
+                /**
+                 * @brief 判断句柄是否有效
+                 * @param handle 句柄
+                 * @return bool 是否有效
+                 */
+                bool is_valid(SlotHandle handle)const noexcept
+                {
+                    return is_live_generation(handle) &&
+                        m_slots[handle.get_index()].generation.load(std::memory_order_acquire) == handle.get_generation();
+                }
+                /**
+                 * @brief 遍历占用的槽位
+                 * @details 按下标升序访问，整字跳过空闲区域；并发分配的槽位可能访问到也可能未访问到
+                 * @note 调用方需保证遍历期间被访问的槽位不会被并发释放
+                 * @tparam F 访问函数类型，签名为 void(SlotHandle)
+                 * @param visitor 访问函数
+                 */
+                template<class F>
+                void for_each(F&& visitor)const
+                {
+                    for (std::size_t word_index = 0; word_index < m_live_words.size(); ++word_index)
+                    {
+                        std::uint64_t word = m_live_words[word_index].load(std::memory_order_acquire);
+                        while (word != 0)
+                        {
+                            std::uint32_t index = static_cast<std::uint32_t>(word_index * 64 + std::countr_zero(word));
+                            word &= word - 1;
+                            visitor(SlotHandle(index, m_slots[index].generation.load(std::memory_order_acquire)));
+                        }
+                    }
+                }
+                /**
+                 * @brief 获取占用的槽位数
+                 * @return std::size_t 槽位数
+                 */
+                std::size_t size()const noexcept
+                {
+                    return m_size.load(std::memory_order_relaxed);
+                }
+                /**
+                 * @brief 获取容量
+                 * @return std::size_t 槽位数
+                 */
+                std::size_t capacity()const noexcept
+                {
+                    return m_capacity;
+                }
+            private:
+                /// @brief 空闲栈的空下标
+                static constexpr std::uint32_t NIL = 0xFFFFFFFFu;
+                /**
+                 * @brief 槽位
+                 */
+                struct Slot
+                {
+                    /// @brief 代数，奇数表示占用
+                    std::atomic<std::uint32_t> generation = 0;
+                    /// @brief 空闲栈中的下一个下标
+                    std::atomic<std::uint32_t> next = NIL;
+                };
+            private:
+                /**
+                 * @brief 拷贝构造函数
+                 * @note 禁止拷贝构造
+                 */
+                HandleAllocator(const HandleAllocator&) = delete;
+                /**
+                 * @brief 拷贝赋值运算符
+                 * @note 禁止拷贝赋值
+                 */
+                HandleAllocator& operator=(const HandleAllocator&) = delete;
+                /**
+                 * @brief 检查容量
+                 * @param capacity 槽位数
+                 * @return std::size_t 槽位数
+                 * @throw std::length_error 容量超过 MAX_CAPACITY
+                 */
+                static std::size_t check_capacity(std::size_t capacity)
+                {
+                    if (capacity > MAX_CAPACITY)
+                    {
+                        throw std::length_error("HandleAllocator capacity");
+                    }
+                    return capacity;
+                }
+                /**
+                 * @brief 组合空闲栈栈顶
+                 * @param tag 标签，每次出栈加一以避免 ABA
+                 * @param index 栈顶下标
+                 * @return std::uint64_t 栈顶
+                 */
+                static constexpr std::uint64_t pack(std::uint32_t tag, std::uint32_t index)noexcept
+                {
+                    return (static_cast<std::uint64_t>(tag) << 32) | index;
+                }
+                /**
+                 * @brief 判断句柄的下标在范围内且代数表示占用
+                 * @param handle 句柄
+                 * @return bool 是否可能有效
+                 */
+                bool is_live_generation(SlotHandle handle)const noexcept
+                {
+                    return handle.get_index() < m_capacity && (handle.get_generation() & 1) != 0;
+                }
+                /**
+                 * @brief 弹出空闲槽位
+                 * @return std::uint32_t 下标；没有空闲槽位时返回 NIL
+                 */
+                std::uint32_t pop_free()noexcept
+                {
+                    std::uint64_t head = m_free_head.load(std::memory_order_acquire);
+                    while (true)
+                    {
+                        std::uint32_t index = static_cast<std::uint32_t>(head);
+                        if (index == NIL)
+                        {
+                            return NIL;
+                        }
+                        // 读到的 next 可能已因其他线程出栈再入栈而过时，此时标签已变，CAS 失败
+                        std::uint32_t next = m_slots[index].next.load(std::memory_order_relaxed);
+                        std::uint64_t desired = pack(static_cast<std::uint32_t>(head >> 32) + 1, next);
+                        if (m_free_head.compare_exchange_weak(head, desired, std::memory_order_acquire, std::memory_order_acquire))
+                        {
+                            return index;
+                        }
+                    }
+                }
+                /**
+                 * @brief 压入空闲槽位
+                 * @param index 下标
+                 */
+                void push_free(std::uint32_t index)noexcept
+                {
+                    std::uint64_t head = m_free_head.load(std::memory_order_relaxed);
+                    while (true)
+                    {
+                        m_slots[index].next.store(static_cast<std::uint32_t>(head), std::memory_order_relaxed);
+                        std::uint64_t desired = pack(static_cast<std::uint32_t>(head >> 32), index);
+                        if (m_free_head.compare_exchange_weak(head, desired, std::memory_order_release, std::memory_order_relaxed))
+                        {
+                            return;
+                        }
+                    }
+                }
+            private:
+                /// @brief 槽位数
+                std::size_t m_capacity = 0;
+                /// @brief 槽位
+                std::vector<Slot> m_slots;
+                /// @brief 占用位图
+                std::vector<std::atomic<std::uint64_t>> m_live_words;
+                /// @brief 空闲栈栈顶：高 32 位为标签，低 32 位为下标
+                alignas(64) std::atomic<std::uint64_t> m_free_head = 0;
+                /// @brief 占用的槽位数
+                alignas(64) std::atomic<std::size_t> m_size = 0;
+            };
+            /**
+             * @class SlotMap
+             * @brief 无锁槽位表
+             * @details 在 HandleAllocator 之上为每个槽位存放一个值：emplace() 构造值后才发布句柄，
+             *          erase() 使句柄失效后才析构值。值存放在连续数组中，for_each() 按下标顺序访问
+             * @note get() 返回的指针在句柄被 erase() 之前有效；调用方需保证访问值期间同一句柄不被并发释放
+             * @tparam T 值类型
+             */
+            template<class T>
+            class SlotMap
+            {
+            public:
+                /**
+                 * @brief 构造函数
+                 * @param capacity 槽位数
+                 * @throw std::length_error 容量超过 HandleAllocator::MAX_CAPACITY
+                 */
+                explicit SlotMap(std::size_t capacity) :
+                    m_allocator(capacity),
+                    m_storage(std::make_unique<Storage[]>(capacity))
+                {
+                }
+                /**
+                 * @brief 析构函数
+                 * @note 调用方需保证析构时没有并发操作
+                 */
+                ~SlotMap()
+                {
+                    m_allocator.for_each([this](SlotHandle handle)
+                        {
+                            get_slot(handle.get_index())->~T();
+                        });
+                }
+                /**
+                 * @brief 原地构造值并分配句柄
+                 * @tparam Args 构造参数类型
+                 * @param args 构造参数
+                 * @return SlotHandle 句柄；槽位耗尽时返回空句柄
+                 */
+                template<class... Args>
+                SlotHandle emplace(Args&&... args)
+                {
+                    return m_allocator.acquire([&](std::uint32_t index)
+                        {
+                            ::new (static_cast<void*>(m_storage[index].bytes)) T(std::forward<Args>(args)...);
+                        });
+                }
+                /**
+                 * @brief 插入值并分配句柄
+                 * @param value 值
+                 * @return SlotHandle 句柄；槽位耗尽时返回空句柄
+                 */
+                SlotHandle insert(T value)
+                {
+                    return emplace(std::move(value));
+                }
+                /**
+                 * @brief 删除值并释放句柄
+                 * @param handle 句柄
+                 * @return bool 是否删除；句柄过期或已删除时返回 false
+                 */
+                bool erase(SlotHandle handle)
+                {
+                    return m_allocator.release(handle, [this](std::uint32_t index)
+                        {
+                            get_slot(index)->~T();
+                        });
+                }
+                /**
+                 * @brief 获取值
+                 * @param handle 句柄
+                 * @return T* 值；句柄无效时返回 nullptr
+                 */
+                T* get(SlotHandle handle)noexcept
+                {
+                    return m_allocator.is_valid(handle) ? get_slot(handle.get_index()) : nullptr;
+                }
+                /**
+                 * @brief 获取值
+                 * @param handle 句柄
+                 * @return const T* 值；句柄无效时返回 nullptr
+                 */
+                const T* get(SlotHandle handle)const noexcept
+                {
+                    return m_allocator.is_valid(handle) ? get_slot(handle.get_index()) : nullptr;
+                }
+                /**
+                 * @brief 判断句柄是否有效
+                 * @param handle 句柄
+                 * @return bool 是否有效
+                 */
+                bool contains(SlotHandle handle)const noexcept
+                {
+                    return m_allocator.is_valid(handle);
+                }
+                /**
+                 * @brief 遍历所有值
+                 * @note 调用方需保证遍历期间被访问的槽位不会被并发删除
+                 * @tparam F 访问函数类型，签名为 void(SlotHandle, T&)
+                 * @param visitor 访问函数
+                 */
+                template<class F>
+                void for_each(F&& visitor)
+                {
+                    m_allocator.for_each([this, &visitor](SlotHandle handle)
+                        {
+                            visitor(handle, *get_slot(handle.get_index()));
+                        });
+                }
+                /**
+                 * @brief 获取值的数量
+                 * @return std::size_t 数量
+                 */
+                std::size_t size()const noexcept
+                {
+                    return m_allocator.size();
+                }
+                /**
+                 * @brief 获取容量
+                 * @return std::size_t 槽位数
+                 */
+                std::size_t capacity()const noexcept
+                {
+                    return m_allocator.capacity();
+                }
+            private:
+                /**
+                 * @brief 值存储
+                 */
+                struct Storage
+                {
+                    /// @brief 未构造的值
+                    alignas(T) std::byte bytes[sizeof(T)];
+                };
+            private:
+                /**
+                 * @brief 拷贝构造函数
+                 * @note 禁止拷贝构造
+                 */
+                SlotMap(const SlotMap&) = delete;
+                /**
+                 * @brief 拷贝赋值运算符
+                 * @note 禁止拷贝赋值
+                 */
+                SlotMap& operator=(const SlotMap&) = delete;
+                /**
+                 * @brief 获取槽位中的值
+                 * @param index 下标
+                 * @return T* 值
+                 */
+                T* get_slot(std::uint32_t index)const noexcept
+                {
+                    return std::launder(reinterpret_cast<T*>(m_storage[index].bytes));
+                }
+            private:
+                /// @brief 句柄分配器
+                HandleAllocator m_allocator;
+                /// @brief 值存储
+                std::unique_ptr<Storage[]> m_storage;
+            };
+        }
+    }
+}
@@ -0,0 +1,152 @@
+#pragma once
+
+/**
+ * @file triple_buffer.hpp
+ * @author DaneJoe001
+ * @version 0.1.1
+ * @brief 无等待三缓冲
+ * @details 单写者单读者的最新值发布：写者与读者各持有一个缓冲区，第三个缓冲区经一次 exchange 在二者之间交换。
+ *          写入与读取都不等待对方，读者总是拿到最近一次完整发布的值，中间的旧值被直接覆盖
+ * @date 2026-10-18
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <utility>
+
+/**
+ * @namespace DaneJoe
+ * @brief DaneJoe命名空间
+ */
+namespace DaneJoe
+{
+    /**
+     * @namespace Concurrent
+     * @brief 并发命名空间
+     */
+    namespace Concurrent
+    {
+        /**
+         * @namespace LockFree
+         * @brief 无锁命名空间
+         */
+        namespace LockFree
+        {
+            /**
+             * @class TripleBuffer
+             * @brief 无等待三缓冲
+             * @note 写入接口只能由单个写者调用，读取接口只能由单个读者调用
+             * @tparam T 值类型，需可默认构造
+             */
+            template<class T>
+            class TripleBuffer
+            {
+            public:
+                /**
+                 * @brief 构造函数
+                 * @param initial 初始值，读者在首次发布前读到该值
+                 */
+                explicit TripleBuffer(const T& initial = T()) :
+                    m_buffers{ Slot{initial}, Slot{initial}, Slot{initial} }
+                {
+                }
+                /**
+                 * @brief 发布新值（写者）
+                 * @param value 新值
+                 */
+                void write(T value)
+                {
+                    get_write_buffer() = std::move(value);
+                    publish();
+                }
+                /**
+                 * @brief 获取写缓冲区（写者）
+                 * @details 原地修改后调用 publish() 发布；缓冲区内容是三次发布前的旧值
+                 * @return T& 写缓冲区
+                 */
+                T& get_write_buffer()noexcept
+                {
+                    return m_buffers[m_back].value;
+                }
+                /**
+                 * @brief 发布写缓冲区（写者）
+                 */
+                void publish()noexcept
+                {
+                    m_back = m_middle.exchange(static_cast<std::uint8_t>(m_back | DIRTY_BIT), std::memory_order_acq_rel) & INDEX_MASK;
+                }
+                /**
+                 * @brief 取得最新发布的值（读者）
+                 * @return bool 自上次更新以来是否有新值
+                 */
+                bool update()noexcept
+                {
+                    if (!(m_middle.load(std::memory_order_relaxed) & DIRTY_BIT))
+                    {
+                        return false;
+                    }
+                    m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & INDEX_MASK;
+                    return true;
+                }
+                /**
+                 * @brief 读取最新值（读者）
+                 * @return const T& 最新值，在下次 update()/read() 前有效
+                 */
+                const T& read()noexcept
+                {
+                    update();
+                    return m_buffers[m_front].value;
+                }
+                /**
+                 * @brief 获取读缓冲区，不检查新值（读者）
+                 * @return const T& 读缓冲区
+                 */
+                const T& get_read_buffer()const noexcept
+                {
+                    return m_buffers[m_front].value;
+                }
+                /**
+                 * @brief 判断是否有未读取的新值
+                 * @return bool 是否有新值
+                 */
+                bool has_update()const noexcept
+                {
+                    return m_middle.load(std::memory_order_relaxed) & DIRTY_BIT;
+                }
+            private:
+                /// @brief 中间缓冲区已发布未读取标志
+                static constexpr std::uint8_t DIRTY_BIT = 0x4;
+                /// @brief 缓冲区下标掩码
+                static constexpr std::uint8_t INDEX_MASK = 0x3;
+                /**
+                 * @brief 独占缓存行的缓冲区
+                 */
+                struct alignas(64) Slot
+                {
+                    /// @brief 值
+                    T value;
+                };
+            private:
+                /**
+                 * @brief 拷贝构造函数
+                 * @note 禁止拷贝构造
+                 */
+                TripleBuffer(const TripleBuffer&) = delete;
+                /**
+                 * @brief 拷贝赋值运算符
+                 * @note 禁止拷贝赋值
+                 */
+                TripleBuffer& operator=(const TripleBuffer&) = delete;
+            private:
+                /// @brief 三个缓冲区
+                Slot m_buffers[3];
+                /// @brief 中间缓冲区下标及新值标志
+                alignas(64) std::atomic<std::uint8_t> m_middle = 1;
+                /// @brief 写缓冲区下标（写者独占）
+                alignas(64) std::uint8_t m_back = 2;
+                /// @brief 读缓冲区下标（读者独占）
+                alignas(64) std::uint8_t m_front = 0;
+            };
+        }
+    }
+}
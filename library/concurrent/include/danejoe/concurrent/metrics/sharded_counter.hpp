@@ -0,0 +1,183 @@
+#pragma once
+
+/**
+ * @file sharded_counter.hpp
+ * @author DaneJoe001
+ * @version 0.1.1
+ * @brief 分片计数器
+ * @details 每个线程固定写入一个独占缓存行的分片，读取时汇总全部分片；
+ *          线程数不超过分片数时各线程写入互不干扰，自增开销不随线程数增长
+ * @date 2026-10-18
+ */
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+
+/**
+ * @namespace DaneJoe
+ * @brief DaneJoe命名空间
+ */
+namespace DaneJoe
+{
+    /**
+     * @namespace Concurrent
+     * @brief 并发命名空间
+     */
+    namespace Concurrent
+    {
+        /**
+         * @namespace Metrics
+         * @brief 统计命名空间
+         */
+        namespace Metrics
+        {
+            /**
+             * @namespace Detail
+             * @brief 实现细节
+             */
+            namespace Detail
+            {
+                /**
+                 * @brief 获取默认分片数
+                 * @return std::size_t 不小于硬件并发数的 2 的幂
+                 */
+                inline std::size_t get_default_shard_count()noexcept
+                {
+                    std::size_t hardware = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+                    std::size_t shard_count = 1;
+                    while (shard_count < hardware)
+                    {
+                        shard_count <<= 1;
+                    }
+                    return shard_count;
+                }
+                /**
+                 * @brief 获取当前线程的分片序号
+                 * @details 线程首次使用时按轮转分配，此后固定不变
+                 * @return std::size_t 分片序号，调用方对分片数取模
+                 */
+                inline std::size_t get_thread_shard()noexcept
+                {
+                    static std::atomic<std::size_t> next_shard = 0;
+                    thread_local std::size_t shard = next_shard.fetch_add(1, std::memory_order_relaxed);
+                    return shard;
+                }
+                /**
+                 * @brief 将分片数向上取整为 2 的幂
+                 * @param shard_count 分片数，为0时使用默认分片数
+                 * @return std::size_t 分片数
+                 */
+                inline std::size_t round_shard_count(std::size_t shard_count)noexcept
+                {
+                    if (shard_count == 0)
+                    {
+                        return get_default_shard_count();
+                    }
+                    std::size_t rounded = 1;
+                    while (rounded < shard_count)
+                    {
+                        rounded <<= 1;
+                    }
+                    return rounded;
+                }
+            }
+            /**
+             * @class ShardedCounter
+             * @brief 分片计数器
+             * @note get() 在并发写入期间返回近似值；写入停止后结果精确
+             */
+            class ShardedCounter
+            {
+            public:
+                /**
+                 * @brief 构造函数
+                 * @param shard_count 分片数，向上取整为 2 的幂；为0时按硬件并发数确定
+                 */
+                explicit ShardedCounter(std::size_t shard_count = 0) :
+                    m_shard_mask(Detail::round_shard_count(shard_count) - 1),
+                    m_slots(std::make_unique<Slot[]>(m_shard_mask + 1))
+                {
+                }
+                /**
+                 * @brief 增加计数
+                 * @param delta 增量，可为负
+                 */
+                void add(std::int64_t delta)noexcept
+                {
+                    m_slots[Detail::get_thread_shard() & m_shard_mask].value.fetch_add(delta, std::memory_order_relaxed);
+                }
+                /**
+                 * @brief 计数加一
+                 */
+                void increment()noexcept
+                {
+                    add(1);
+                }
+                /**
+                 * @brief 汇总计数
+                 * @return std::int64_t 计数
+                 */
+                std::int64_t get()const noexcept
+                {
+                    std::int64_t total = 0;
+                    for (std::size_t i = 0; i <= m_shard_mask; ++i)
+                    {
+                        total += m_slots[i].value.load(std::memory_order_relaxed);
+                    }
+                    return total;
+                }
+                /**
+                 * @brief 汇总计数并清零
+                 * @details 每个分片原子地取走，并发写入不会丢失，只会计入下一次
+                 * @return std::int64_t 清零前的计数
+                 */
+                std::int64_t exchange_reset()noexcept
+                {
+                    std::int64_t total = 0;
+                    for (std::size_t i = 0; i <= m_shard_mask; ++i)
+                    {
+                        total += m_slots[i].value.exchange(0, std::memory_order_relaxed);
+                    }
+                    return total;
+                }
+                /**
+                 * @brief 获取分片数
+                 * @return std::size_t 分片数
+                 */
+                std::size_t get_shard_count()const noexcept
+                {
+                    return m_shard_mask + 1;
+                }
+            private:
+                /**
+                 * @brief 独占缓存行的分片
+                 */
+                struct alignas(64) Slot
+                {
+                    /// @brief 分片计数
+                    std::atomic<std::int64_t> value = 0;
+                };
+            private:
+                /**
+                 * @brief 拷贝构造函数
+                 * @note 禁止拷贝构造
+                 */
+                ShardedCounter(const ShardedCounter&) = delete;
+                /**
+                 * @brief 拷贝赋值运算符
+                 * @note 禁止拷贝赋值
+                 */
+                ShardedCounter& operator=(const ShardedCounter&) = delete;
+            private:
+                /// @brief 分片掩码
+                std::size_t m_shard_mask;
+                /// @brief 分片
+                std::unique_ptr<Slot[]> m_slots;
+            };
+        }
+    }
+}
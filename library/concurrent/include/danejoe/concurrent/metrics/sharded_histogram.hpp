@@ -0,0 +1,198 @@
+#pragma once
+
+/**
+ * @file sharded_histogram.hpp
+ * @author DaneJoe001
+ * @version 0.1.1
+ * @brief 分片直方图
+ * @details 按 2 的幂划分桶（桶 0 为值 0，桶 k 为 [2^(k-1), 2^k)），每个线程写入独占的分片，
+ *          读取时合并为快照，可估算分位数；记录一次只修改本分片的计数、总和与最值
+ * @date 2026-10-18
+ */
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <limits>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#include "danejoe/concurrent/metrics/sharded_counter.hpp"
+
+/**
+ * @namespace DaneJoe
+ * @brief DaneJoe命名空间
+ */
+namespace DaneJoe
+{
+    /**
+     * @namespace Concurrent
+     * @brief 并发命名空间
+     */
+    namespace Concurrent
+    {
+        /**
+         * @namespace Metrics
+         * @brief 统计命名空间
+         */
+        namespace Metrics
+        {
+            /// @brief 直方图桶数
+            inline constexpr std::size_t HISTOGRAM_BUCKET_COUNT = 65;
+            /**
+             * @struct HistogramSnapshot
+             * @brief 直方图快照
+             */
+            struct HistogramSnapshot
+            {
+                /// @brief 记录数
+                std::uint64_t count = 0;
+                /// @brief 总和
+                std::uint64_t sum = 0;
+                /// @brief 最小值，无记录时为 0
+                std::uint64_t min = 0;
+                /// @brief 最大值
+                std::uint64_t max = 0;
+                /// @brief 各桶记录数
+                std::array<std::uint64_t, HISTOGRAM_BUCKET_COUNT> buckets = {};
+                /**
+                 * @brief 获取平均值
+                 * @return double 平均值，无记录时为 0
+                 */
+                double get_mean()const noexcept
+                {
+                    return count == 0 ? 0.0 : static_cast<double>(sum) / static_cast<double>(count);
+                }
+                /**
+                 * @brief 估算分位数
+                 * @param quantile 分位，取值 [0, 1]
+                 * @return std::uint64_t 分位所在桶的上界，并限制在 [min, max] 内
+                 */
+                std::uint64_t get_percentile(double quantile)const noexcept
+                {
+                    if (count == 0)
+                    {
+                        return 0;
+                    }
+                    quantile = quantile < 0.0 ? 0.0 : (quantile > 1.0 ? 1.0 : quantile);
+                    std::uint64_t rank = static_cast<std::uint64_t>(quantile * static_cast<double>(count - 1)) + 1;
+                    std::uint64_t seen = 0;
+                    for (std::size_t i = 0; i < HISTOGRAM_BUCKET_COUNT; ++i)
+                    {
+                        seen += buckets[i];
+                        if (seen >= rank)
+                        {
+                            std::uint64_t upper = i == 0 ? 0 : (i == 64 ? std::numeric_limits<std::uint64_t>::max() : (std::uint64_t(1) << i) - 1);
+                            return upper < min ? min : (upper > max ? max : upper);
+                        }
+                    }
+                    return max;
+                }
+            };
+            /**
+             * @class ShardedHistogram
+             * @brief 分片直方图
+             * @note get_snapshot() 在并发写入期间各字段可能相差少量记录
+             */
+            class ShardedHistogram
+            {
+            public:
+                /**
+                 * @brief 构造函数
+                 * @param shard_count 分片数，向上取整为 2 的幂；为0时按硬件并发数确定
+                 */
+                explicit ShardedHistogram(std::size_t shard_count = 0) :
+                    m_shard_mask(Detail::round_shard_count(shard_count) - 1),
+                    m_shards(std::make_unique<Shard[]>(m_shard_mask + 1))
+                {
+                }
+                /**
+                 * @brief 记录一个值
+                 * @param value 值
+                 */
+                void record(std::uint64_t value)noexcept
+                {
+                    Shard& shard = m_shards[Detail::get_thread_shard() & m_shard_mask];
+                    shard.buckets[std::bit_width(value)].fetch_add(1, std::memory_order_relaxed);
+                    shard.count.fetch_add(1, std::memory_order_relaxed);
+                    shard.sum.fetch_add(value, std::memory_order_relaxed);
+                    std::uint64_t min = shard.min.load(std::memory_order_relaxed);
+                    while (value < min && !shard.min.compare_exchange_weak(min, value, std::memory_order_relaxed))
+                    {
+                    }
+                    std::uint64_t max = shard.max.load(std::memory_order_relaxed);
+                    while (value > max && !shard.max.compare_exchange_weak(max, value, std::memory_order_relaxed))
+                    {
+                    }
+                }
+                /**
+                 * @brief 合并全部分片
+                 * @return HistogramSnapshot 快照
+                 */
+                HistogramSnapshot get_snapshot()const noexcept
+                {
+                    HistogramSnapshot snapshot;
+                    std::uint64_t min = std::numeric_limits<std::uint64_t>::max();
+                    for (std::size_t s = 0; s <= m_shard_mask; ++s)
+                    {
+                        const Shard& shard = m_shards[s];
+                        for (std::size_t i = 0; i < HISTOGRAM_BUCKET_COUNT; ++i)
+                        {
+                            snapshot.buckets[i] += shard.buckets[i].load(std::memory_order_relaxed);
+                        }
+                        snapshot.count += shard.count.load(std::memory_order_relaxed);
+                        snapshot.sum += shard.sum.load(std::memory_order_relaxed);
+                        std::uint64_t shard_min = shard.min.load(std::memory_order_relaxed);
+                        std::uint64_t shard_max = shard.max.load(std::memory_order_relaxed);
+                        min = shard_min < min ? shard_min : min;
+                        snapshot.max = shard_max > snapshot.max ? shard_max : snapshot.max;
+                    }
+                    snapshot.min = snapshot.count == 0 ? 0 : min;
+                    return snapshot;
+                }
+                /**
+                 * @brief 获取分片数
+                 * @return std::size_t 分片数
+                 */
+                std::size_t get_shard_count()const noexcept
+                {
+                    return m_shard_mask + 1;
+                }
+            private:
+                /**
+                 * @brief 独占缓存行的分片
+                 */
+                struct alignas(64) Shard
+                {
+                    /// @brief 各桶记录数
+                    std::atomic<std::uint64_t> buckets[HISTOGRAM_BUCKET_COUNT] = {};
+                    /// @brief 记录数
+                    std::atomic<std::uint64_t> count = 0;
+                    /// @brief 总和
+                    std::atomic<std::uint64_t> sum = 0;
+                    /// @brief 最小值
+                    std::atomic<std::uint64_t> min = std::numeric_limits<std::uint64_t>::max();
+                    /// @brief 最大值
+                    std::atomic<std::uint64_t> max = 0;
+                };
+            private:
+                /**
+                 * @brief 拷贝构造函数
+                 * @note 禁止拷贝构造
+                 */
+                ShardedHistogram(const ShardedHistogram&) = delete;
+                /**
+                 * @brief 拷贝赋值运算符
+                 * @note 禁止拷贝赋值
+                 */
+                ShardedHistogram& operator=(const ShardedHistogram&) = delete;
+            private:
+                /// @brief 分片掩码
+                std::size_t m_shard_mask;
+                /// @brief 分片
+                std::unique_ptr<Shard[]> m_shards;
+            };
+        }
+    }
+}
@@ -0,0 +1,623 @@
+#pragma once
+
+/**
+ * @file event_loop.hpp
+ * @author DaneJoe001
+ * @version 0.1.1
+ * @brief 基于 epoll 的事件循环
+ * @details 单线程反应器：fd 就绪回调、定时器与投递到循环线程的任务都在 run() 所在线程上执行。
+ *          跨线程唤醒使用 eventfd，全部定时器共用一个按最早截止时间设置的 timerfd；
+ *          post() 把耗时的完成处理交给构造时传入的执行器（通常为线程池），不占用循环线程
+ * @note 仅支持 Linux
+ * @date 2026-10-18
+ */
+
+#if defined(__linux__)
+
+#include <mutex>
+#include <queue>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <functional>
+#include <system_error>
+#include <unordered_map>
+
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+
+#include "danejoe/concurrent/thread_pool/task.hpp"
+#include "danejoe/concurrent/thread_pool/executor.hpp"
+
+/**
+ * @namespace DaneJoe
+ * @brief DaneJoe命名空间
+ */
+namespace DaneJoe
+{
+    /**
+     * @namespace Concurrent
+     * @brief 并发命名空间
+     */
+    namespace Concurrent
+    {
+        /**
+         * @namespace Reactor
+         * @brief 反应器命名空间
+         */
+        namespace Reactor
+        {
+            /// @brief 可读事件
+            inline constexpr std::uint32_t EVENT_READABLE = EPOLLIN;
+            /// @brief 可写事件
+            inline constexpr std::uint32_t EVENT_WRITABLE = EPOLLOUT;
+            /// @brief 对端关闭写端
+            inline constexpr std::uint32_t EVENT_PEER_CLOSED = EPOLLRDHUP;
+            /// @brief 挂起（总是上报）
+            inline constexpr std::uint32_t EVENT_HANGUP = EPOLLHUP;
+            /// @brief 错误（总是上报）
+            inline constexpr std::uint32_t EVENT_ERROR = EPOLLERR;
+            /// @brief fd 就绪回调，参数为就绪的事件位
+            using IoHandler = std::function<void(std::uint32_t events)>;
+            /// @brief 定时器标识
+            using TimerId = std::uint64_t;
+            /// @brief 定时器使用的时钟，与 CLOCK_MONOTONIC 一致
+            using Clock = std::chrono::steady_clock;
+            class EventLoop;
+            /**
+             * @class EventNotifier
+             * @brief 基于 eventfd 的跨线程通知
+             * @details 生产者向队列推入元素后调用 notify()，循环线程上执行处理函数一次性取走队列内容；
+             *          处理函数执行前的多次通知合并为一次
+             * @note 必须在所属事件循环之前析构
+             */
+            class EventNotifier
+            {
+            public:
+                /**
+                 * @brief 析构函数
+                 * @note 从事件循环注销并关闭 eventfd
+                 */
+                ~EventNotifier();
+                /**
+                 * @brief 发出通知，可在任意线程调用
+                 */
+                void notify()noexcept
+                {
+                    std::uint64_t one = 1;
+                    [[maybe_unused]] ssize_t result = ::write(m_fd, &one, sizeof(one));
+                }
+                /**
+                 * @brief 获取 eventfd
+                 * @return int 文件描述符
+                 */
+                int get_fd()const noexcept
+                {
+                    return m_fd;
+                }
+            private:
+                friend class EventLoop;
+                /**
+                 * @brief 构造函数
+                 * @param loop 事件循环
+                 * @param fd eventfd
+                 */
+                EventNotifier(EventLoop& loop, int fd)noexcept :m_loop(loop), m_fd(fd) {}
+                /**
+                 * @brief 拷贝构造函数
+                 * @note 禁止拷贝构造
+                 */
+                EventNotifier(const EventNotifier&) = delete;
+                /**
+                 * @brief 拷贝赋值运算符
+                 * @note 禁止拷贝赋值
+                 */
+                EventNotifier& operator=(const EventNotifier&) = delete;
+            private:
+                /// @brief 所属事件循环
+                EventLoop& m_loop;
+                /// @brief eventfd
+                int m_fd;
+            };
+            /**
+             * @class EventLoop
+             * @brief 基于 epoll 的事件循环
+             * @note 注册、定时器、execute() 与 stop() 可在任意线程调用；回调均在循环线程上执行，不应阻塞
+             */
+            class EventLoop : public ThreadPool::IExecutor
+            {
+            public:
+                /**
+                 * @brief 构造函数
+                 * @param completion_executor post() 使用的执行器，为空时 post() 在循环线程上执行
+                 * @throws std::system_error 创建 epoll、eventfd 或 timerfd 失败
+                 */
+                explicit EventLoop(ThreadPool::IExecutor* completion_executor = nullptr) :
+                    m_completion_executor(completion_executor)
+                {
+                    m_epoll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+                    if (m_epoll_fd < 0)
+                    {
+                        throw std::system_error(errno, std::generic_category(), "epoll_create1");
+                    }
+                    m_wakeup_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+                    m_timer_fd = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+                    if (m_wakeup_fd < 0 || m_timer_fd < 0)
+                    {
+                        int error = errno;
+                        close_fds();
+                        throw std::system_error(error, std::generic_category(), "EventLoop fd");
+                    }
+                    try
+                    {
+                        control(EPOLL_CTL_ADD, m_wakeup_fd, EPOLLIN, WAKEUP_ID);
+                        control(EPOLL_CTL_ADD, m_timer_fd, EPOLLIN, TIMER_ID);
+                    }
+                    catch (...)
+                    {
+                        close_fds();
+                        throw;
+                    }
+                }
+                /**
+                 * @brief 析构函数
+                 * @note 未执行的循环任务与定时器被丢弃；已注册的 fd 不会被关闭
+                 */
+                ~EventLoop()
+                {
+                    close_fds();
+                }
+                /**
+                 * @brief 注册 fd
+                 * @param fd 文件描述符，调用方负责其生命周期与非阻塞设置
+                 * @param events 关注的事件位（EVENT_READABLE 等），水平触发
+                 * @param handler 就绪回调
+                 * @throws std::system_error fd 已注册或 epoll_ctl 失败
+                 */
+                void add_fd(int fd, std::uint32_t events, IoHandler handler)
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    if (m_fd_ids.find(fd) != m_fd_ids.end())
+                    {
+                        throw std::system_error(EEXIST, std::generic_category(), "EventLoop add_fd");
+                    }
+                    std::uint64_t id = m_next_id++;
+                    control(EPOLL_CTL_ADD, fd, events, id);
+                    m_fd_ids.emplace(fd, id);
+                    m_registrations.emplace(id, std::make_shared<IoHandler>(std::move(handler)));
+                }
+                /**
+                 * @brief 修改关注的事件
+                 * @param fd 文件描述符
+                 * @param events 事件位
+                 * @throws std::system_error fd 未注册或 epoll_ctl 失败
+                 */
+                void modify_fd(int fd, std::uint32_t events)
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    auto iterator = m_fd_ids.find(fd);
+                    if (iterator == m_fd_ids.end())
+                    {
+                        throw std::system_error(ENOENT, std::generic_category(), "EventLoop modify_fd");
+                    }
+                    control(EPOLL_CTL_MOD, fd, events, iterator->second);
+                }
+                /**
+                 * @brief 注销 fd
+                 * @note 可在回调内调用；返回后该 fd 不会再触发回调（正在执行的回调除外）
+                 * @param fd 文件描述符
+                 * @return bool 是否曾注册
+                 */
+                bool remove_fd(int fd)
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    auto iterator = m_fd_ids.find(fd);
+                    if (iterator == m_fd_ids.end())
+                    {
+                        return false;
+                    }
+                    ::epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+                    m_registrations.erase(iterator->second);
+                    m_fd_ids.erase(iterator);
+                    return true;
+                }
+                /**
+                 * @brief 创建跨线程通知
+                 * @param handler 在循环线程上执行的处理函数
+                 * @return std::unique_ptr<EventNotifier> 通知
+                 * @throws std::system_error 创建 eventfd 失败
+                 */
+                std::unique_ptr<EventNotifier> create_notifier(ThreadPool::Task handler)
+                {
+                    int fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+                    if (fd < 0)
+                    {
+                        throw std::system_error(errno, std::generic_category(), "eventfd");
+                    }
+                    std::unique_ptr<EventNotifier> notifier(new EventNotifier(*this, fd));
+                    auto shared_handler = std::make_shared<ThreadPool::Task>(std::move(handler));
+                    try
+                    {
+                        add_fd(fd, EVENT_READABLE, [fd, shared_handler](std::uint32_t)
+                            {
+                                std::uint64_t count = 0;
+                                [[maybe_unused]] ssize_t result = ::read(fd, &count, sizeof(count));
+                                (*shared_handler)();
+                            });
+                    }
+                    catch (...)
+                    {
+                        ::close(fd);
+                        notifier->m_fd = -1;
+                        throw;
+                    }
+                    return notifier;
+                }
+                /**
+                 * @brief 添加定时器
+                 * @param delay 首次触发延迟
+                 * @param callback 在循环线程上执行的回调
+                 * @param interval 重复间隔，为0时只触发一次
+                 * @return TimerId 定时器标识
+                 */
+                TimerId add_timer(Clock::duration delay, ThreadPool::Task callback, Clock::duration interval = Clock::duration::zero())
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    TimerId id = m_next_id++;
+                    Clock::time_point deadline = Clock::now() + delay;
+                    m_timers.emplace(id, Timer{ std::make_shared<ThreadPool::Task>(std::move(callback)), interval });
+                    m_timer_queue.push(TimerEntry{ deadline, id });
+                    arm_timer_locked();
+                    return id;
+                }
+                /**
+                 * @brief 取消定时器
+                 * @param id 定时器标识
+                 * @return bool 是否取消成功；已触发的一次性定时器返回 false
+                 */
+                bool cancel_timer(TimerId id)
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    return m_timers.erase(id) > 0;
+                }
+                /**
+                 * @brief 在循环线程上执行任务
+                 * @param task 任务
+                 */
+                void execute(ThreadPool::Task task)override
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(m_mutex);
+                        m_tasks.push_back(std::move(task));
+                    }
+                    wakeup();
+                }
+                /**
+                 * @brief 把完成处理交给执行器
+                 * @details 供回调内把耗时工作移出循环线程
+                 * @param task 任务
+                 */
+                void post(ThreadPool::Task task)
+                {
+                    if (m_completion_executor)
+                    {
+                        m_completion_executor->execute(std::move(task));
+                    }
+                    else
+                    {
+                        execute(std::move(task));
+                    }
+                }
+                /**
+                 * @brief 运行事件循环，直到 stop()
+                 */
+                void run()
+                {
+                    m_loop_thread.store(std::this_thread::get_id(), std::memory_order_relaxed);
+                    while (!m_is_stopped.load(std::memory_order_acquire))
+                    {
+                        poll(-1);
+                    }
+                    m_loop_thread.store(std::thread::id(), std::memory_order_relaxed);
+                }
+                /**
+                 * @brief 等待并处理一轮事件
+                 * @param timeout_ms 等待毫秒数，-1 表示无限等待，0 表示不等待
+                 * @return std::size_t 处理的事件数
+                 */
+                std::size_t poll(int timeout_ms)
+                {
+                    epoll_event events[MAX_EVENTS];
+                    int count = ::epoll_wait(m_epoll_fd, events, MAX_EVENTS, timeout_ms);
+                    if (count < 0)
+                    {
+                        if (errno == EINTR)
+                        {
+                            return 0;
+                        }
+                        throw std::system_error(errno, std::generic_category(), "epoll_wait");
+                    }
+                    for (int i = 0; i < count; ++i)
+                    {
+                        std::uint64_t id = events[i].data.u64;
+                        if (id == WAKEUP_ID)
+                        {
+                            std::uint64_t value = 0;
+                            [[maybe_unused]] ssize_t result = ::read(m_wakeup_fd, &value, sizeof(value));
+                            run_tasks();
+                        }
+                        else if (id == TIMER_ID)
+                        {
+                            std::uint64_t expirations = 0;
+                            [[maybe_unused]] ssize_t result = ::read(m_timer_fd, &expirations, sizeof(expirations));
+                            run_timers();
+                        }
+                        else
+                        {
+                            std::shared_ptr<IoHandler> handler;
+                            {
+                                std::lock_guard<std::mutex> lock(m_mutex);
+                                auto iterator = m_registrations.find(id);
+                                if (iterator != m_registrations.end())
+                                {
+                                    handler = iterator->second;
+                                }
+                            }
+                            if (handler)
+                            {
+                                (*handler)(events[i].events);
+                            }
+                        }
+                    }
+                    return static_cast<std::size_t>(count);
+                }
+                /**
+                 * @brief 停止事件循环，可在任意线程调用
+                 */
+                void stop()noexcept
+                {
+                    m_is_stopped.store(true, std::memory_order_release);
+                    wakeup();
+                }
+                /**
+                 * @brief 判断当前线程是否为循环线程
+                 * @return bool 是否为循环线程
+                 */
+                bool is_in_loop_thread()const noexcept
+                {
+                    return m_loop_thread.load(std::memory_order_relaxed) == std::this_thread::get_id();
+                }
+                /**
+                 * @brief 获取已注册的 fd 数
+                 * @return std::size_t fd 数
+                 */
+                std::size_t get_fd_count()const
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    return m_fd_ids.size();
+                }
+                /**
+                 * @brief 获取未触发的定时器数
+                 * @return std::size_t 定时器数
+                 */
+                std::size_t get_timer_count()const
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    return m_timers.size();
+                }
+            private:
+                /// @brief 唤醒 eventfd 的注册标识
+                static constexpr std::uint64_t WAKEUP_ID = 0;
+                /// @brief timerfd 的注册标识
+                static constexpr std::uint64_t TIMER_ID = 1;
+                /// @brief 单轮最多处理的事件数
+                static constexpr int MAX_EVENTS = 64;
+                /**
+                 * @brief 定时器
+                 */
+                struct Timer
+                {
+                    /// @brief 回调
+                    std::shared_ptr<ThreadPool::Task> callback;
+                    /// @brief 重复间隔
+                    Clock::duration interval;
+                };
+                /**
+                 * @brief 定时器队列项
+                 */
+                struct TimerEntry
+                {
+                    /// @brief 截止时间
+                    Clock::time_point deadline;
+                    /// @brief 定时器标识
+                    TimerId id;
+                    /**
+                     * @brief 按截止时间排序，构成小顶堆
+                     * @param other 另一项
+                     * @return bool 是否晚于另一项
+                     */
+                    bool operator<(const TimerEntry& other)const noexcept
+                    {
+                        return deadline > other.deadline;
+                    }
+                };
+            private:
+                /**
+                 * @brief 拷贝构造函数
+                 * @note 禁止拷贝构造
+                 */
+                EventLoop(const EventLoop&) = delete;
+                /**
+                 * @brief 拷贝赋值运算符
+                 * @note 禁止拷贝赋值
+                 */
+                EventLoop& operator=(const EventLoop&) = delete;
+                /**
+                 * @brief 调用 epoll_ctl
+                 * @param operation 操作
+                 * @param fd 文件描述符
+                 * @param events 事件位
+                 * @param id 注册标识
+                 */
+                void control(int operation, int fd, std::uint32_t events, std::uint64_t id)
+                {
+                    epoll_event event{};
+                    event.events = events;
+                    event.data.u64 = id;
+                    if (::epoll_ctl(m_epoll_fd, operation, fd, &event) != 0)
+                    {
+                        throw std::system_error(errno, std::generic_category(), "epoll_ctl");
+                    }
+                }
+                /**
+                 * @brief 唤醒循环线程
+                 */
+                void wakeup()noexcept
+                {
+                    std::uint64_t one = 1;
+                    [[maybe_unused]] ssize_t result = ::write(m_wakeup_fd, &one, sizeof(one));
+                }
+                /**
+                 * @brief 执行投递到循环线程的任务
+                 */
+                void run_tasks()
+                {
+                    std::vector<ThreadPool::Task> tasks;
+                    {
+                        std::lock_guard<std::mutex> lock(m_mutex);
+                        tasks.swap(m_tasks);
+                    }
+                    for (auto& task : tasks)
+                    {
+                        task();
+                    }
+                }
+                /**
+                 * @brief 执行到期的定时器
+                 */
+                void run_timers()
+                {
+                    std::vector<std::shared_ptr<ThreadPool::Task>> due;
+                    {
+                        std::lock_guard<std::mutex> lock(m_mutex);
+                        Clock::time_point now = Clock::now();
+                        while (!m_timer_queue.empty() && m_timer_queue.top().deadline <= now)
+                        {
+                            TimerEntry entry = m_timer_queue.top();
+                            m_timer_queue.pop();
+                            auto iterator = m_timers.find(entry.id);
+                            if (iterator == m_timers.end())
+                            {
+                                // 已取消
+                                continue;
+                            }
+                            due.push_back(iterator->second.callback);
+                            if (iterator->second.interval > Clock::duration::zero())
+                            {
+                                Clock::time_point next = entry.deadline + iterator->second.interval;
+                                m_timer_queue.push(TimerEntry{ next > now ? next : now + iterator->second.interval, entry.id });
+                            }
+                            else
+                            {
+                                m_timers.erase(iterator);
+                            }
+                        }
+                        arm_timer_locked();
+                    }
+                    for (auto& callback : due)
+                    {
+                        (*callback)();
+                    }
+                }
+                /**
+                 * @brief 按最早截止时间设置 timerfd（需持锁）
+                 * @details 已取消定时器的队列项在此处清理
+                 */
+                void arm_timer_locked()noexcept
+                {
+                    while (!m_timer_queue.empty() && m_timers.find(m_timer_queue.top().id) == m_timers.end())
+                    {
+                        m_timer_queue.pop();
+                    }
+                    itimerspec spec{};
+                    if (!m_timer_queue.empty())
+                    {
+                        auto since_epoch = m_timer_queue.top().deadline.time_since_epoch();
+                        auto seconds = std::chrono::duration_cast<std::chrono::seconds>(since_epoch);
+                        auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(since_epoch - seconds);
+                        spec.it_value.tv_sec = static_cast<time_t>(seconds.count());
+                        spec.it_value.tv_nsec = static_cast<long>(nanoseconds.count());
+                        if (spec.it_value.tv_sec == 0 && spec.it_value.tv_nsec == 0)
+                        {
+                            // 全零表示解除，用最小时间代替
+                            spec.it_value.tv_nsec = 1;
+                        }
+                    }
+                    ::timerfd_settime(m_timer_fd, TFD_TIMER_ABSTIME, &spec, nullptr);
+                }
+                /**
+                 * @brief 关闭内部 fd
+                 */
+                void close_fds()noexcept
+                {
+                    for (int* fd : { &m_timer_fd, &m_wakeup_fd, &m_epoll_fd })
+                    {
+                        if (*fd >= 0)
+                        {
+                            ::close(*fd);
+                            *fd = -1;
+                        }
+                    }
+                }
+            private:
+                /// @brief 完成处理执行器
+                ThreadPool::IExecutor* m_completion_executor;
+                /// @brief epoll 文件描述符
+                int m_epoll_fd = -1;
+                /// @brief 唤醒 eventfd
+                int m_wakeup_fd = -1;
+                /// @brief 定时器 timerfd
+                int m_timer_fd = -1;
+                /// @brief 互斥锁，保护注册表、任务与定时器
+                mutable std::mutex m_mutex;
+                /// @brief 下一个注册或定时器标识
+                std::uint64_t m_next_id = 2;
+                /// @brief fd 到注册标识
+                std::unordered_map<int, std::uint64_t> m_fd_ids;
+                /// @brief 注册标识到回调
+                std::unordered_map<std::uint64_t, std::shared_ptr<IoHandler>> m_registrations;
+                /// @brief 投递到循环线程的任务
+                std::vector<ThreadPool::Task> m_tasks;
+                /// @brief 未触发的定时器
+                std::unordered_map<TimerId, Timer> m_timers;
+                /// @brief 定时器截止时间小顶堆
+                std::priority_queue<TimerEntry> m_timer_queue;
+                /// @brief 是否已停止
+                std::atomic<bool> m_is_stopped = false;
+                /// @brief 循环线程
+                std::atomic<std::thread::id> m_loop_thread;
+            };
+            /**
+             * @brief 析构函数
+             */
+            inline EventNotifier::~EventNotifier()
+            {
+                if (m_fd >= 0)
+                {
+                    m_loop.remove_fd(m_fd);
+                    ::close(m_fd);
+                }
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,100 @@
+#pragma once
+
+/**
+ * @file backoff.hpp
+ * @author DaneJoe001
+ * @version 0.1.1
+ * @brief 自旋等待退避
+ * @details cpu_relax() 发出处理器自旋提示（x86 PAUSE / ARM YIELD），降低自旋对同核超线程与内存总线的干扰；
+ *          Backoff 按指数增加每轮提示次数，超过上限后让出时间片，避免持锁线程被抢占时空转
+ * @date 2026-10-18
+ */
+
+#include <thread>
+#include <cstdint>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <immintrin.h>
+#endif
+
+/**
+ * @namespace DaneJoe
+ * @brief DaneJoe命名空间
+ */
+namespace DaneJoe
+{
+    /**
+     * @namespace Concurrent
+     * @brief 并发命名空间
+     */
+    namespace Concurrent
+    {
+        /**
+         * @namespace Sync
+         * @brief 同步原语命名空间
+         */
+        namespace Sync
+        {
+            /**
+             * @brief 处理器自旋提示
+             */
+            inline void cpu_relax()noexcept
+            {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+                _mm_pause();
+#elif defined(__x86_64__) || defined(__i386__)
+                __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+                __asm__ __volatile__("yield");
+#endif
+            }
+            /**
+             * @class Backoff
+             * @brief 指数退避
+             * @note 每次等待开始时构造，等待期间反复调用 pause()
+             */
+            class Backoff
+            {
+            public:
+                /**
+                 * @brief 退避一轮
+                 * @details 第 n 轮发出 2^n 次自旋提示，达到上限后改为让出时间片
+                 */
+                void pause()noexcept
+                {
+                    if (m_spin_count > MAX_SPIN_COUNT)
+                    {
+                        std::this_thread::yield();
+                        return;
+                    }
+                    for (std::uint32_t i = 0; i < m_spin_count; ++i)
+                    {
+                        cpu_relax();
+                    }
+                    m_spin_count <<= 1;
+                }
+                /**
+                 * @brief 判断自旋阶段是否已结束
+                 * @note 之后的 pause() 只让出时间片；需要有界自旋的调用方可据此改为休眠
+                 * @return bool 是否已超过单轮自旋上限
+                 */
+                bool is_exhausted()const noexcept
+                {
+                    return m_spin_count > MAX_SPIN_COUNT;
+                }
+                /**
+                 * @brief 重置为第一轮
+                 */
+                void reset()noexcept
+                {
+                    m_spin_count = 1;
+                }
+            private:
+                /// @brief 让出时间片前单轮最多的自旋提示次数
+                static constexpr std::uint32_t MAX_SPIN_COUNT = 64;
+                /// @brief 本轮自旋提示次数
+                std::uint32_t m_spin_count = 1;
+            };
+        }
+    }
+}
@@ -0,0 +1,178 @@
+#pragma once
+
+/**
+ * @file mcs_lock.hpp
+ * @author DaneJoe001
+ * @version 0.1.1
+ * @brief MCS 队列锁
+ * @details 等待者排成链表，每个等待者只在自己节点的标志上自旋，释放时只写后继一个缓存行，
+ *          核数增加时锁交接开销不随等待者数量增长；按到达顺序 FIFO 获得锁
+ * @date 2026-10-18
+ */
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "danejoe/concurrent/sync/backoff.hpp"
+
+/**
+ * @namespace DaneJoe
+ * @brief DaneJoe命名空间
+ */
+namespace DaneJoe
+{
+    /**
+     * @namespace Concurrent
+     * @brief 并发命名空间
+     */
+    namespace Concurrent
+    {
+        /**
+         * @namespace Sync
+         * @brief 同步原语命名空间
+         */
+        namespace Sync
+        {
+            /**
+             * @class McsLock
+             * @brief MCS 队列锁
+             * @note 满足 Lockable；队列节点取自线程本地缓存，同一线程可同时持有多把锁，但必须由加锁线程解锁
+             */
+            class McsLock
+            {
+            public:
+                /**
+                 * @brief 构造函数
+                 */
+                McsLock() = default;
+                /**
+                 * @brief 加锁
+                 * @throws std::bad_alloc 分配队列节点失败
+                 */
+                void lock()
+                {
+                    Node* node = acquire_node();
+                    Node* predecessor = m_tail.exchange(node, std::memory_order_acq_rel);
+                    if (predecessor)
+                    {
+                        node->is_waiting.store(true, std::memory_order_relaxed);
+                        predecessor->next.store(node, std::memory_order_release);
+                        Backoff backoff;
+                        while (node->is_waiting.load(std::memory_order_acquire))
+                        {
+                            backoff.pause();
+                        }
+                    }
+                    m_owner = node;
+                }
+                /**
+                 * @brief 尝试加锁
+                 * @return bool 是否成功
+                 * @throws std::bad_alloc 分配队列节点失败
+                 */
+                bool try_lock()
+                {
+                    Node* node = acquire_node();
+                    Node* expected = nullptr;
+                    if (!m_tail.compare_exchange_strong(expected, node, std::memory_order_acquire, std::memory_order_relaxed))
+                    {
+                        release_node(node);
+                        return false;
+                    }
+                    m_owner = node;
+                    return true;
+                }
+                /**
+                 * @brief 解锁
+                 */
+                void unlock()noexcept
+                {
+                    Node* node = m_owner;
+                    Node* successor = node->next.load(std::memory_order_acquire);
+                    if (!successor)
+                    {
+                        Node* expected = node;
+                        if (m_tail.compare_exchange_strong(expected, nullptr, std::memory_order_release, std::memory_order_relaxed))
+                        {
+                            release_node(node);
+                            return;
+                        }
+                        // 后继已入队但尚未链接
+                        while (!(successor = node->next.load(std::memory_order_acquire)))
+                        {
+                            cpu_relax();
+                        }
+                    }
+                    successor->is_waiting.store(false, std::memory_order_release);
+                    release_node(node);
+                }
+            private:
+                /**
+                 * @brief 队列节点
+                 */
+                struct alignas(64) Node
+                {
+                    /// @brief 后继节点
+                    std::atomic<Node*> next = nullptr;
+                    /// @brief 是否仍在等待
+                    std::atomic<bool> is_waiting = false;
+                };
+            private:
+                /**
+                 * @brief 拷贝构造函数
+                 * @note 禁止拷贝构造
+                 */
+                McsLock(const McsLock&) = delete;
+                /**
+                 * @brief 拷贝赋值运算符
+                 * @note 禁止拷贝赋值
+                 */
+                McsLock& operator=(const McsLock&) = delete;
+                /**
+                 * @brief 获取线程本地节点缓存
+                 * @return std::vector<std::unique_ptr<Node>>& 节点缓存
+                 */
+                static std::vector<std::unique_ptr<Node>>& get_node_cache()
+                {
+                    thread_local std::vector<std::unique_ptr<Node>> cache;
+                    return cache;
+                }
+                /**
+                 * @brief 取出一个空闲节点
+                 * @note 仅在线程首次使用或嵌套持锁数超过缓存数时分配
+                 * @return Node* 节点
+                 */
+                static Node* acquire_node()
+                {
+                    auto& cache = get_node_cache();
+                    Node* node = nullptr;
+                    if (cache.empty())
+                    {
+                        node = new Node();
+                    }
+                    else
+                    {
+                        node = cache.back().release();
+                        cache.pop_back();
+                    }
+                    node->next.store(nullptr, std::memory_order_relaxed);
+                    return node;
+                }
+                /**
+                 * @brief 归还节点
+                 * @param node 节点
+                 */
+                static void release_node(Node* node)
+                {
+                    get_node_cache().emplace_back(node);
+                }
+            private:
+                /// @brief 队尾节点，为空时锁空闲
+                std::atomic<Node*> m_tail = nullptr;
+                /// @brief 持锁者的节点，仅持锁者访问
+                Node* m_owner = nullptr;
+            };
+        }
+    }
+}
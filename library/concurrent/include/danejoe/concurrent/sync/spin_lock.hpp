@@ -0,0 +1,92 @@
+#pragma once
+
+/**
+ * @file spin_lock.hpp
+ * @author DaneJoe001
+ * @version 0.1.1
+ * @brief 自旋锁
+ * @details 先读后交换（TTAS）：等待时只读本地缓存行并退避，锁看似空闲时才尝试一次交换，避免缓存行在等待者间来回失效
+ * @date 2026-10-18
+ */
+
+#include <atomic>
+
+#include "danejoe/concurrent/sync/backoff.hpp"
+
+/**
+ * @namespace DaneJoe
+ * @brief DaneJoe命名空间
+ */
+namespace DaneJoe
+{
+    /**
+     * @namespace Concurrent
+     * @brief 并发命名空间
+     */
+    namespace Concurrent
+    {
+        /**
+         * @namespace Sync
+         * @brief 同步原语命名空间
+         */
+        namespace Sync
+        {
+            /**
+             * @class SpinLock
+             * @brief 带退避的自旋锁
+             * @note 满足 Lockable，可用于 std::lock_guard / std::unique_lock；不公平，只适合极短的临界区
+             */
+            class SpinLock
+            {
+            public:
+                /**
+                 * @brief 构造函数
+                 */
+                SpinLock() = default;
+                /**
+                 * @brief 加锁
+                 */
+                void lock()noexcept
+                {
+                    while (m_is_locked.exchange(true, std::memory_order_acquire))
+                    {
+                        Backoff backoff;
+                        while (m_is_locked.load(std::memory_order_relaxed))
+                        {
+                            backoff.pause();
+                        }
+                    }
+                }
+                /**
+                 * @brief 尝试加锁
+                 * @return bool 是否成功
+                 */
+                bool try_lock()noexcept
+                {
+                    return !m_is_locked.load(std::memory_order_relaxed) && !m_is_locked.exchange(true, std::memory_order_acquire);
+                }
+                /**
+                 * @brief 解锁
+                 */
+                void unlock()noexcept
+                {
+                    m_is_locked.store(false, std::memory_order_release);
+                }
+            private:
+                /**
+                 * @brief 拷贝构造函数
+                 * @note 禁止拷贝构造
+                 */
+                SpinLock(const SpinLock&) = delete;
+                /**
+                 * @brief 拷贝赋值运算符
+                 * @note 禁止拷贝赋值
+                 */
+                SpinLock& operator=(const SpinLock&) = delete;
+            private:
+                /// @brief 是否已加锁
+                std::atomic<bool> m_is_locked = false;
+            };
+        }
+    }
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+/**
+ * @file ticket_lock.hpp
+ * @author DaneJoe001
+ * @version 0.1.1
+ * @brief 票据锁
+ * @details 加锁时领取递增票号，按票号顺序获得锁，保证 FIFO 公平；等待者按前方排队人数成比例退避
+ * @date 2026-10-18
+ */
+
+#include <atomic>
+#include <thread>
+#include <cstdint>
+
+#include "danejoe/concurrent/sync/backoff.hpp"
+
+/**
+ * @namespace DaneJoe
+ * @brief DaneJoe命名空间
+ */
+namespace DaneJoe
+{
+    /**
+     * @namespace Concurrent
+     * @brief 并发命名空间
+     */
+    namespace Concurrent
+    {
+        /**
+         * @namespace Sync
+         * @brief 同步原语命名空间
+         */
+        namespace Sync
+        {
+            /**
+             * @class TicketLock
+             * @brief 公平的票据锁
+             * @note 满足 Lockable；线程数超过核数时，排在前面的线程被抢占会拖慢所有后续线程
+             */
+            class TicketLock
+            {
+            public:
+                /**
+                 * @brief 构造函数
+                 */
+                TicketLock() = default;
+                /**
+                 * @brief 加锁
+                 */
+                void lock()noexcept
+                {
+                    std::uint32_t ticket = m_next_ticket.fetch_add(1, std::memory_order_relaxed);
+                    std::uint32_t serving = m_now_serving.load(std::memory_order_acquire);
+                    std::uint32_t spin_count = 0;
+                    while (serving != ticket)
+                    {
+                        // 前方每多一个等待者多等一段，减少对 m_now_serving 的轮询
+                        for (std::uint32_t i = (ticket - serving) * SPIN_PER_WAITER; i > 0; --i)
+                        {
+                            cpu_relax();
+                        }
+                        if (++spin_count > MAX_SPIN_ROUND)
+                        {
+                            std::this_thread::yield();
+                        }
+                        serving = m_now_serving.load(std::memory_order_acquire);
+                    }
+                }
+                /**
+                 * @brief 尝试加锁
+                 * @return bool 是否成功
+                 */
+                bool try_lock()noexcept
+                {
+                    std::uint32_t serving = m_now_serving.load(std::memory_order_acquire);
+                    std::uint32_t ticket = serving;
+                    return m_next_ticket.compare_exchange_strong(ticket, serving + 1, std::memory_order_acquire, std::memory_order_relaxed);
+                }
+                /**
+                 * @brief 解锁
+                 */
+                void unlock()noexcept
+                {
+                    // 只有持锁者写 m_now_serving
+                    m_now_serving.store(m_now_serving.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+                }
+            private:
+                /// @brief 每个前方等待者对应的自旋提示次数
+                static constexpr std::uint32_t SPIN_PER_WAITER = 16;
+                /// @brief 开始让出时间片前的轮询次数
+                static constexpr std::uint32_t MAX_SPIN_ROUND = 64;
+            private:
+                /**
+                 * @brief 拷贝构造函数
+                 * @note 禁止拷贝构造
+                 */
+                TicketLock(const TicketLock&) = delete;
+                /**
+                 * @brief 拷贝赋值运算符
+                 * @note 禁止拷贝赋值
+                 */
+                TicketLock& operator=(const TicketLock&) = delete;
+            private:
+                /// @brief 下一个票号
+                std::atomic<std::uint32_t> m_next_ticket = 0;
+                /// @brief 当前服务的票号
+                std::atomic<std::uint32_t> m_now_serving = 0;
+            };
+        }
+    }
+}
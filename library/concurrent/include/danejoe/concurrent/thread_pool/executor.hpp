@@ -0,0 +1,75 @@
+#pragma once
+
+/**
+ * @file executor.hpp
+ * @author DaneJoe001
+ * @version 0.1.1
+ * @brief 执行器接口
+ * @date 2026-10-18
+ */
+
+#include "danejoe/concurrent/thread_pool/task.hpp"
+
+/**
+ * @namespace DaneJoe
+ * @brief DaneJoe命名空间
+ */
+namespace DaneJoe
+{
+    /**
+     * @namespace Concurrent
+     * @brief 并发命名空间
+     */
+    namespace Concurrent
+    {
+        /**
+         * @namespace ThreadPool
+         * @brief 线程池命名空间
+         */
+        namespace ThreadPool
+        {
+            /**
+             * @class IExecutor
+             * @brief 执行器接口
+             */
+            class IExecutor
+            {
+            public:
+                /**
+                 * @brief 析构函数
+                 */
+                virtual ~IExecutor() = default;
+                /**
+                 * @brief 提交任务执行
+                 * @param task 任务
+                 */
+                virtual void execute(Task task) = 0;
+            };
+            /**
+             * @class InlineExecutor
+             * @brief 在调用线程上立即执行任务的执行器
+             */
+            class InlineExecutor : public IExecutor
+            {
+            public:
+                /**
+                 * @brief 立即执行任务
+                 * @param task 任务
+                 */
+                void execute(Task task)override
+                {
+                    task();
+                }
+                /**
+                 * @brief 获取全局实例
+                 * @return InlineExecutor& 全局实例
+                 */
+                static InlineExecutor& get_instance()
+                {
+                    static InlineExecutor instance;
+                    return instance;
+                }
+            };
+        }
+    }
+}
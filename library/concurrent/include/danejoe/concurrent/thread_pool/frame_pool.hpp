@@ -0,0 +1,183 @@
+#pragma once
+
+/**
+ * @file frame_pool.hpp
+ * @author DaneJoe001
+ * @version 0.1.1
+ * @brief 任务帧内存池
+ * @details 按大小分级的线程本地空闲链表，稳态下任务帧的申请与释放不触发堆分配
+ * @date 2026-10-18
+ */
+
+#include <new>
+#include <cstddef>
+#include <utility>
+
+/**
+ * @namespace DaneJoe
+ * @brief DaneJoe命名空间
+ */
+namespace DaneJoe
+{
+    /**
+     * @namespace Concurrent
+     * @brief 并发命名空间
+     */
+    namespace Concurrent
+    {
+        /**
+         * @namespace ThreadPool
+         * @brief 线程池命名空间
+         */
+        namespace ThreadPool
+        {
+            /**
+             * @class FramePool
+             * @brief 任务帧内存池
+             * @note 内存块可在任意线程释放，释放后归入释放线程的缓存
+             */
+            class FramePool
+            {
+            public:
+                /// @brief 分级粒度
+                static constexpr std::size_t GRANULARITY = 64;
+                /// @brief 分级数量，超过 GRANULARITY * CLASS_COUNT 的块直接使用堆
+                static constexpr std::size_t CLASS_COUNT = 8;
+                /// @brief 每个分级在单个线程上缓存的最大块数
+                static constexpr std::size_t MAX_CACHED_BLOCKS = 1024;
+            public:
+                /**
+                 * @brief 申请内存块
+                 * @param size 字节数
+                 * @return void* 内存块
+                 */
+                static void* allocate(std::size_t size)
+                {
+                    std::size_t class_index = get_class_index(size);
+                    if (class_index >= CLASS_COUNT)
+                    {
+                        return ::operator new(size);
+                    }
+                    LocalCache& cache = get_local_cache();
+                    FreeBlock* block = cache.heads[class_index];
+                    if (block)
+                    {
+                        cache.heads[class_index] = block->next;
+                        --cache.counts[class_index];
+                        return block;
+                    }
+                    return ::operator new((class_index + 1) * GRANULARITY);
+                }
+                /**
+                 * @brief 释放内存块
+                 * @param block 内存块
+                 * @param size 申请时的字节数
+                 */
+                static void deallocate(void* block, std::size_t size)noexcept
+                {
+                    std::size_t class_index = get_class_index(size);
+                    if (class_index >= CLASS_COUNT)
+                    {
+                        ::operator delete(block);
+                        return;
+                    }
+                    LocalCache& cache = get_local_cache();
+                    if (cache.counts[class_index] >= MAX_CACHED_BLOCKS)
+                    {
+                        ::operator delete(block);
+                        return;
+                    }
+                    FreeBlock* free_block = ::new (block) FreeBlock{ cache.heads[class_index] };
+                    cache.heads[class_index] = free_block;
+                    ++cache.counts[class_index];
+                }
+                /**
+                 * @brief 在池内存上构造对象
+                 * @tparam U 对象类型
+                 * @tparam Args 构造参数类型
+                 * @param args 构造参数
+                 * @return U* 对象指针
+                 */
+                template<class U, class... Args>
+                static U* create(Args&&... args)
+                {
+                    static_assert(alignof(U) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "over-aligned frame");
+                    void* memory = allocate(sizeof(U));
+                    try
+                    {
+                        return ::new (memory) U(std::forward<Args>(args)...);
+                    }
+                    catch (...)
+                    {
+                        deallocate(memory, sizeof(U));
+                        throw;
+                    }
+                }
+                /**
+                 * @brief 析构对象并归还内存
+                 * @tparam U 对象类型
+                 * @param object 对象指针
+                 */
+                template<class U>
+                static void destroy(U* object)noexcept
+                {
+                    object->~U();
+                    deallocate(object, sizeof(U));
+                }
+            private:
+                /**
+                 * @brief 空闲块
+                 */
+                struct FreeBlock
+                {
+                    /// @brief 下一个空闲块
+                    FreeBlock* next;
+                };
+                /**
+                 * @brief 线程本地缓存
+                 */
+                struct LocalCache
+                {
+                    /// @brief 各分级空闲链表头
+                    FreeBlock* heads[CLASS_COUNT] = {};
+                    /// @brief 各分级缓存块数
+                    std::size_t counts[CLASS_COUNT] = {};
+                    /**
+                     * @brief 析构函数
+                     * @note 线程退出时归还全部缓存
+                     */
+                    ~LocalCache()
+                    {
+                        for (FreeBlock*& head : heads)
+                        {
+                            while (head)
+                            {
+                                FreeBlock* next = head->next;
+                                ::operator delete(head);
+                                head = next;
+                            }
+                        }
+                    }
+                };
+                /**
+                 * @brief 获取分级索引
+                 * @param size 字节数
+                 * @return std::size_t 分级索引
+                 */
+                static constexpr std::size_t get_class_index(std::size_t size)noexcept
+                {
+                    return size == 0 ? 0 : (size - 1) / GRANULARITY;
+                }
+                /**
+                 * @brief 获取线程本地缓存
+                 * @return LocalCache& 线程本地缓存
+                 */
+                static LocalCache& get_local_cache()
+                {
+                    thread_local LocalCache cache;
+                    return cache;
+                }
+            };
+        }
+    }
+}
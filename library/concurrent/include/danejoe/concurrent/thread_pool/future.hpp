@@ -0,0 +1,1013 @@
+#pragma once
+
+/**
+ * @file future.hpp
+ * @author DaneJoe001
+ * @version 0.1.1
+ * @brief 支持延续的 Future/Promise
+ * @details 共享状态由 FramePool 分配，并可与任务本体合并为同一帧；
+ *          then() 在完成线程上内联执行或投递到执行器，when_all/when_any 用于组合
+ * @date 2026-10-18
+ */
+
+#include <tuple>
+#include <atomic>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <optional>
+#include <stdexcept>
+#include <exception>
+#include <functional>
+#include <future>
+#include <type_traits>
+
+#include "danejoe/concurrent/thread_pool/task.hpp"
+#include "danejoe/concurrent/thread_pool/executor.hpp"
+#include "danejoe/concurrent/thread_pool/frame_pool.hpp"
+
+/**
+ * @namespace DaneJoe
+ * @brief DaneJoe命名空间
+ */
+namespace DaneJoe
+{
+    /**
+     * @namespace Concurrent
+     * @brief 并发命名空间
+     */
+    namespace Concurrent
+    {
+        /**
+         * @namespace ThreadPool
+         * @brief 线程池命名空间
+         */
+        namespace ThreadPool
+        {
+            template<class T>
+            class Future;
+            template<class T>
+            class Promise;
+            /**
+             * @namespace Detail
+             * @brief 实现细节
+             */
+            namespace Detail
+            {
+                /**
+                 * @class SharedStateBase
+                 * @brief 共享状态基类
+                 * @details 侵入式引用计数；完成标志与延续标志合并在一个原子量中，
+                 *          先设置另一方标志的一侧负责执行延续
+                 */
+                class SharedStateBase
+                {
+                public:
+                    /**
+                     * @brief 增加引用
+                     */
+                    void add_ref()noexcept
+                    {
+                        m_ref_count.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    /**
+                     * @brief 释放引用
+                     * @note 最后一个引用释放时销毁状态
+                     */
+                    void release()noexcept
+                    {
+                        if (m_ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                        {
+                            destroy();
+                        }
+                    }
+                    /**
+                     * @brief 判断是否已完成
+                     * @return bool 是否已完成
+                     */
+                    bool is_ready()const noexcept
+                    {
+                        return (m_flags.load(std::memory_order_acquire) & READY) != 0;
+                    }
+                    /**
+                     * @brief 阻塞等待完成
+                     */
+                    void wait()const noexcept
+                    {
+                        std::uint32_t flags = m_flags.load(std::memory_order_acquire);
+                        while ((flags & READY) == 0)
+                        {
+                            m_flags.wait(flags, std::memory_order_acquire);
+                            flags = m_flags.load(std::memory_order_acquire);
+                        }
+                    }
+                    /**
+                     * @brief 设置完成回调
+                     * @note 每个状态只能设置一次；若已完成则在当前线程立即执行
+                     * @param callback 回调
+                     */
+                    void set_callback(Task callback)
+                    {
+                        m_callback = std::move(callback);
+                        std::uint32_t previous = m_flags.fetch_or(CALLBACK, std::memory_order_acq_rel);
+                        if (previous & READY)
+                        {
+                            run_callback();
+                        }
+                    }
+                    /**
+                     * @brief 以异常完成
+                     * @param exception 异常
+                     */
+                    void set_exception(std::exception_ptr exception)
+                    {
+                        m_exception = std::move(exception);
+                        mark_ready();
+                    }
+                    /**
+                     * @brief 以 broken_promise 完成
+                     * @note 生产者未完成即被销毁时调用
+                     */
+                    void abandon()
+                    {
+                        set_exception(std::make_exception_ptr(std::future_error(std::future_errc::broken_promise)));
+                    }
+                protected:
+                    /**
+                     * @brief 析构函数
+                     */
+                    ~SharedStateBase() = default;
+                    /**
+                     * @brief 标记完成并唤醒等待者
+                     */
+                    void mark_ready()
+                    {
+                        std::uint32_t previous = m_flags.fetch_or(READY, std::memory_order_acq_rel);
+                        m_flags.notify_all();
+                        if (previous & CALLBACK)
+                        {
+                            run_callback();
+                        }
+                    }
+                    /**
+                     * @brief 若以异常完成则重新抛出
+                     */
+                    void rethrow_if_exception()const
+                    {
+                        if (m_exception)
+                        {
+                            std::rethrow_exception(m_exception);
+                        }
+                    }
+                    /**
+                     * @brief 销毁状态
+                     */
+                    virtual void destroy()noexcept = 0;
+                private:
+                    /**
+                     * @brief 执行回调
+                     * @note 回调执行期间状态可能被释放，此后不得再访问成员
+                     */
+                    void run_callback()
+                    {
+                        Task callback = std::move(m_callback);
+                        callback();
+                    }
+                private:
+                    /// @brief 完成标志
+                    static constexpr std::uint32_t READY = 1;
+                    /// @brief 回调已设置标志
+                    static constexpr std::uint32_t CALLBACK = 2;
+                    /// @brief 引用计数
+                    std::atomic<std::uint32_t> m_ref_count = 1;
+                    /// @brief 状态标志
+                    std::atomic<std::uint32_t> m_flags = 0;
+                    /// @brief 完成回调
+                    Task m_callback;
+                    /// @brief 异常
+                    std::exception_ptr m_exception;
+                };
+                /**
+                 * @class SharedState
+                 * @brief 带结果值的共享状态
+                 * @tparam T 结果类型
+                 */
+                template<class T>
+                class SharedState : public SharedStateBase
+                {
+                public:
+                    /**
+                     * @brief 以值完成
+                     * @tparam Args 构造参数类型
+                     * @param args 构造参数
+                     */
+                    template<class... Args>
+                    void set_value(Args&&... args)
+                    {
+                        m_value.emplace(std::forward<Args>(args)...);
+                        mark_ready();
+                    }
+                    /**
+                     * @brief 取出结果
+                     * @note 以异常完成时重新抛出
+                     * @return T 结果
+                     */
+                    T take_value()
+                    {
+                        rethrow_if_exception();
+                        return std::move(*m_value);
+                    }
+                protected:
+                    /**
+                     * @brief 析构函数
+                     */
+                    ~SharedState() = default;
+                private:
+                    /// @brief 结果
+                    std::optional<T> m_value;
+                };
+                /**
+                 * @class SharedState<void>
+                 * @brief 无结果值的共享状态
+                 */
+                template<>
+                class SharedState<void> : public SharedStateBase
+                {
+                public:
+                    /**
+                     * @brief 完成
+                     */
+                    void set_value()
+                    {
+                        mark_ready();
+                    }
+                    /**
+                     * @brief 取出结果
+                     * @note 以异常完成时重新抛出
+                     */
+                    void take_value()
+                    {
+                        rethrow_if_exception();
+                    }
+                protected:
+                    /**
+                     * @brief 析构函数
+                     */
+                    ~SharedState() = default;
+                };
+                /**
+                 * @class PromiseState
+                 * @brief Promise 使用的共享状态
+                 * @tparam T 结果类型
+                 */
+                template<class T>
+                class PromiseState final : public SharedState<T>
+                {
+                protected:
+                    /**
+                     * @brief 销毁状态
+                     */
+                    void destroy()noexcept override
+                    {
+                        FramePool::destroy(this);
+                    }
+                };
+                /**
+                 * @brief 以可调用对象的返回值完成状态
+                 * @tparam T 结果类型
+                 * @tparam F 可调用对象类型
+                 * @param state 共享状态
+                 * @param func 可调用对象
+                 */
+                template<class T, class F>
+                void fulfill(SharedState<T>& state, F&& func)
+                {
+                    try
+                    {
+                        if constexpr (std::is_void_v<T>)
+                        {
+                            std::forward<F>(func)();
+                            state.set_value();
+                        }
+                        else
+                        {
+                            state.set_value(std::forward<F>(func)());
+                        }
+                    }
+                    catch (...)
+                    {
+                        state.set_exception(std::current_exception());
+                    }
+                }
+                /**
+                 * @class CallableState
+                 * @brief 任务帧：可调用对象与其结果状态位于同一块内存
+                 * @tparam T 结果类型
+                 * @tparam F 可调用对象类型
+                 */
+                template<class T, class F>
+                class CallableState final : public SharedState<T>
+                {
+                public:
+                    /**
+                     * @brief 构造函数
+                     * @param func 可调用对象
+                     */
+                    explicit CallableState(F func) :m_func(std::move(func)) {}
+                    /**
+                     * @brief 执行任务并设置结果
+                     */
+                    void run()
+                    {
+                        fulfill(*this, std::move(m_func));
+                    }
+                protected:
+                    /**
+                     * @brief 销毁状态
+                     */
+                    void destroy()noexcept override
+                    {
+                        FramePool::destroy(this);
+                    }
+                private:
+                    /// @brief 可调用对象
+                    F m_func;
+                };
+                /**
+                 * @class ContinuationState
+                 * @brief 延续帧：持有上游状态与延续函数
+                 * @tparam T 上游结果类型
+                 * @tparam R 延续结果类型
+                 * @tparam F 延续函数类型
+                 */
+                template<class T, class R, class F>
+                class ContinuationState final : public SharedState<R>
+                {
+                public:
+                    /**
+                     * @brief 构造函数
+                     * @param source 上游状态（接管其引用）
+                     * @param func 延续函数
+                     */
+                    ContinuationState(SharedState<T>* source, F func) :m_source(source), m_func(std::move(func)) {}
+                    /**
+                     * @brief 获取上游状态
+                     * @return SharedState<T>* 上游状态
+                     */
+                    SharedState<T>* get_source()const noexcept
+                    {
+                        return m_source;
+                    }
+                    /**
+                     * @brief 以上游结果执行延续
+                     * @note 上游异常直接传递，不调用延续函数
+                     */
+                    void run()
+                    {
+                        SharedState<T>* source = std::exchange(m_source, nullptr);
+                        fulfill(*this, [this, source]() -> R
+                            {
+                                if constexpr (std::is_void_v<T>)
+                                {
+                                    source->take_value();
+                                    return std::invoke(std::move(m_func));
+                                }
+                                else
+                                {
+                                    return std::invoke(std::move(m_func), source->take_value());
+                                }
+                            });
+                        source->release();
+                    }
+                protected:
+                    /**
+                     * @brief 销毁状态
+                     */
+                    void destroy()noexcept override
+                    {
+                        if (m_source)
+                        {
+                            m_source->release();
+                        }
+                        FramePool::destroy(this);
+                    }
+                private:
+                    /// @brief 上游状态
+                    SharedState<T>* m_source;
+                    /// @brief 延续函数
+                    F m_func;
+                };
+                /**
+                 * @class StateRunner
+                 * @brief 持有一个状态引用的任务体
+                 * @details 任务未执行就被销毁（执行器拒绝、关闭时丢弃）时以 broken_promise 结束状态
+                 * @tparam S 状态类型
+                 */
+                template<class S>
+                class StateRunner
+                {
+                public:
+                    /**
+                     * @brief 构造函数
+                     * @param state 状态（接管一个引用）
+                     */
+                    explicit StateRunner(S* state)noexcept :m_state(state) {}
+                    /**
+                     * @brief 移动构造函数
+                     * @param other 其他任务体
+                     */
+                    StateRunner(StateRunner&& other)noexcept :m_state(std::exchange(other.m_state, nullptr)) {}
+                    /**
+                     * @brief 析构函数
+                     */
+                    ~StateRunner()
+                    {
+                        if (m_state)
+                        {
+                            m_state->abandon();
+                            m_state->release();
+                        }
+                    }
+                    /**
+                     * @brief 执行状态
+                     */
+                    void operator()()
+                    {
+                        S* state = std::exchange(m_state, nullptr);
+                        state->run();
+                        state->release();
+                    }
+                private:
+                    /**
+                     * @brief 移动赋值运算符
+                     * @note 禁止移动赋值
+                     */
+                    StateRunner& operator=(StateRunner&&) = delete;
+                private:
+                    /// @brief 状态
+                    S* m_state;
+                };
+                /**
+                 * @class ContinuationRunner
+                 * @brief 上游完成时执行的回调：内联执行延续或投递到执行器
+                 * @tparam S 延续状态类型
+                 */
+                template<class S>
+                class ContinuationRunner
+                {
+                public:
+                    /**
+                     * @brief 构造函数
+                     * @param state 延续状态（接管一个引用）
+                     * @param executor 执行器，为空时内联执行
+                     */
+                    ContinuationRunner(S* state, IExecutor* executor)noexcept :m_runner(state), m_executor(executor) {}
+                    /**
+                     * @brief 执行或投递延续
+                     */
+                    void operator()()
+                    {
+                        if (m_executor)
+                        {
+                            m_executor->execute(Task(std::move(m_runner)));
+                        }
+                        else
+                        {
+                            m_runner();
+                        }
+                    }
+                private:
+                    /// @brief 延续任务体
+                    StateRunner<S> m_runner;
+                    /// @brief 执行器
+                    IExecutor* m_executor;
+                };
+                /**
+                 * @brief 延续函数的结果类型
+                 * @tparam T 上游结果类型
+                 * @tparam F 延续函数类型
+                 */
+                template<class T, class F>
+                struct ContinuationResult
+                {
+                    /// @brief 结果类型
+                    using type = std::invoke_result_t<F, T>;
+                };
+                /**
+                 * @brief 延续函数的结果类型（上游无结果值）
+                 * @tparam F 延续函数类型
+                 */
+                template<class F>
+                struct ContinuationResult<void, F>
+                {
+                    /// @brief 结果类型
+                    using type = std::invoke_result_t<F>;
+                };
+                /**
+                 * @class FutureAccess
+                 * @brief 访问 Future 内部状态的桥接类
+                 */
+                class FutureAccess
+                {
+                public:
+                    /**
+                     * @brief 由状态构造 Future
+                     * @tparam T 结果类型
+                     * @param state 状态（接管一个引用）
+                     * @return Future<T>
+                     */
+                    template<class T>
+                    static Future<T> make_future(SharedState<T>* state)noexcept
+                    {
+                        return Future<T>(state);
+                    }
+                    /**
+                     * @brief 获取 Future 的状态
+                     * @tparam T 结果类型
+                     * @param future Future
+                     * @return SharedState<T>* 状态
+                     */
+                    template<class T>
+                    static SharedState<T>* get_state(const Future<T>& future)noexcept
+                    {
+                        return future.m_state;
+                    }
+                };
+            }
+            /**
+             * @class Future
+             * @brief 单消费者的异步结果
+             * @tparam T 结果类型
+             */
+            template<class T>
+            class Future
+            {
+            public:
+                /**
+                 * @brief 构造无效 Future
+                 */
+                Future()noexcept = default;
+                /**
+                 * @brief 移动构造函数
+                 * @param other 其他 Future
+                 */
+                Future(Future&& other)noexcept :m_state(std::exchange(other.m_state, nullptr)) {}
+                /**
+                 * @brief 移动赋值运算符
+                 * @param other 其他 Future
+                 * @return Future&
+                 */
+                Future& operator=(Future&& other)noexcept
+                {
+                    if (this != &other)
+                    {
+                        reset();
+                        m_state = std::exchange(other.m_state, nullptr);
+                    }
+                    return *this;
+                }
+                /**
+                 * @brief 析构函数
+                 */
+                ~Future()
+                {
+                    reset();
+                }
+                /**
+                 * @brief 判断是否持有状态
+                 * @return bool 是否持有状态
+                 */
+                bool valid()const noexcept
+                {
+                    return m_state != nullptr;
+                }
+                /**
+                 * @brief 判断结果是否就绪
+                 * @return bool 是否就绪
+                 */
+                bool is_ready()const
+                {
+                    return get_state()->is_ready();
+                }
+                /**
+                 * @brief 阻塞等待结果就绪
+                 * @note 在线程池工作线程中等待同一线程池的任务可能死锁，应优先使用 then()
+                 */
+                void wait()const
+                {
+                    get_state()->wait();
+                }
+                /**
+                 * @brief 阻塞获取结果
+                 * @note 调用后 Future 失效；以异常完成时重新抛出
+                 * @return T 结果
+                 */
+                T get()
+                {
+                    Detail::SharedState<T>* state = get_state();
+                    state->wait();
+                    m_state = nullptr;
+                    struct Releaser
+                    {
+                        Detail::SharedState<T>* state;
+                        ~Releaser() { state->release(); }
+                    } releaser{ state };
+                    return state->take_value();
+                }
+                /**
+                 * @brief 注册延续，在完成线程上内联执行
+                 * @note 调用后 Future 失效；上游异常直接传递给返回的 Future
+                 * @tparam F 延续函数类型
+                 * @param func 延续函数，参数为上游结果
+                 * @return Future<R> 延续结果
+                 */
+                template<class F>
+                auto then(F&& func)
+                {
+                    return then_on(nullptr, std::forward<F>(func));
+                }
+                /**
+                 * @brief 注册延续，在指定执行器上执行
+                 * @note 调用后 Future 失效；执行器需在延续执行前保持有效
+                 * @tparam F 延续函数类型
+                 * @param executor 执行器
+                 * @param func 延续函数，参数为上游结果
+                 * @return Future<R> 延续结果
+                 */
+                template<class F>
+                auto then(IExecutor& executor, F&& func)
+                {
+                    return then_on(&executor, std::forward<F>(func));
+                }
+            private:
+                friend class Detail::FutureAccess;
+                /**
+                 * @brief 由状态构造
+                 * @param state 状态（接管一个引用）
+                 */
+                explicit Future(Detail::SharedState<T>* state)noexcept :m_state(state) {}
+                /**
+                 * @brief 拷贝构造函数
+                 * @note 禁止拷贝构造
+                 */
+                Future(const Future&) = delete;
+                /**
+                 * @brief 拷贝赋值运算符
+                 * @note 禁止拷贝赋值
+                 */
+                Future& operator=(const Future&) = delete;
+                /**
+                 * @brief 获取状态
+                 * @note 无状态时抛出 std::future_error(no_state)
+                 * @return Detail::SharedState<T>* 状态
+                 */
+                Detail::SharedState<T>* get_state()const
+                {
+                    if (!m_state)
+                    {
+                        throw std::future_error(std::future_errc::no_state);
+                    }
+                    return m_state;
+                }
+                /**
+                 * @brief 释放状态
+                 */
+                void reset()noexcept
+                {
+                    if (m_state)
+                    {
+                        std::exchange(m_state, nullptr)->release();
+                    }
+                }
+                /**
+                 * @brief 注册延续
+                 * @tparam F 延续函数类型
+                 * @param executor 执行器，为空时内联执行
+                 * @param func 延续函数
+                 * @return Future<R> 延续结果
+                 */
+                template<class F>
+                auto then_on(IExecutor* executor, F&& func)
+                {
+                    using Function = std::decay_t<F>;
+                    using Result = typename Detail::ContinuationResult<T, Function>::type;
+                    using State = Detail::ContinuationState<T, Result, Function>;
+                    get_state();
+                    State* next = FramePool::create<State>(m_state, std::forward<F>(func));
+                    m_state = nullptr;
+                    next->add_ref();
+                    next->get_source()->set_callback(Task(Detail::ContinuationRunner<State>(next, executor)));
+                    return Detail::FutureAccess::make_future<Result>(next);
+                }
+            private:
+                /// @brief 共享状态
+                Detail::SharedState<T>* m_state = nullptr;
+            };
+            /**
+             * @class Promise
+             * @brief Future 的生产端
+             * @note 未设置结果即销毁时，对应 Future 以 broken_promise 完成
+             * @tparam T 结果类型
+             */
+            template<class T>
+            class Promise
+            {
+            public:
+                /**
+                 * @brief 构造函数
+                 */
+                Promise() :m_state(FramePool::create<Detail::PromiseState<T>>()) {}
+                /**
+                 * @brief 移动构造函数
+                 * @param other 其他 Promise
+                 */
+                Promise(Promise&& other)noexcept :
+                    m_state(std::exchange(other.m_state, nullptr)),
+                    m_is_future_retrieved(other.m_is_future_retrieved),
+                    m_is_satisfied(other.m_is_satisfied)
+                {
+                }
+                /**
+                 * @brief 移动赋值运算符
+                 * @param other 其他 Promise
+                 * @return Promise&
+                 */
+                Promise& operator=(Promise&& other)noexcept
+                {
+                    if (this != &other)
+                    {
+                        reset();
+                        m_state = std::exchange(other.m_state, nullptr);
+                        m_is_future_retrieved = other.m_is_future_retrieved;
+                        m_is_satisfied = other.m_is_satisfied;
+                    }
+                    return *this;
+                }
+                /**
+                 * @brief 析构函数
+                 */
+                ~Promise()
+                {
+                    reset();
+                }
+                /**
+                 * @brief 获取 Future
+                 * @note 只能获取一次
+                 * @return Future<T>
+                 */
+                Future<T> get_future()
+                {
+                    check_state();
+                    if (m_is_future_retrieved)
+                    {
+                        throw std::future_error(std::future_errc::future_already_retrieved);
+                    }
+                    m_is_future_retrieved = true;
+                    m_state->add_ref();
+                    return Detail::FutureAccess::make_future<T>(m_state);
+                }
+                /**
+                 * @brief 设置结果
+                 * @tparam Args 构造参数类型
+                 * @param args 构造参数
+                 */
+                template<class... Args>
+                void set_value(Args&&... args)
+                {
+                    satisfy();
+                    m_state->set_value(std::forward<Args>(args)...);
+                }
+                /**
+                 * @brief 设置异常
+                 * @param exception 异常
+                 */
+                void set_exception(std::exception_ptr exception)
+                {
+                    satisfy();
+                    m_state->set_exception(std::move(exception));
+                }
+            private:
+                /**
+                 * @brief 拷贝构造函数
+                 * @note 禁止拷贝构造
+                 */
+                Promise(const Promise&) = delete;
+                /**
+                 * @brief 拷贝赋值运算符
+                 * @note 禁止拷贝赋值
+                 */
+                Promise& operator=(const Promise&) = delete;
+                /**
+                 * @brief 检查是否持有状态
+                 */
+                void check_state()const
+                {
+                    if (!m_state)
+                    {
+                        throw std::future_error(std::future_errc::no_state);
+                    }
+                }
+                /**
+                 * @brief 标记已设置结果
+                 */
+                void satisfy()
+                {
+                    check_state();
+                    if (m_is_satisfied)
+                    {
+                        throw std::future_error(std::future_errc::promise_already_satisfied);
+                    }
+                    m_is_satisfied = true;
+                }
+                /**
+                 * @brief 释放状态
+                 */
+                void reset()noexcept
+                {
+                    if (!m_state)
+                    {
+                        return;
+                    }
+                    if (!m_is_satisfied)
+                    {
+                        m_state->abandon();
+                    }
+                    std::exchange(m_state, nullptr)->release();
+                }
+            private:
+                /// @brief 共享状态
+                Detail::PromiseState<T>* m_state = nullptr;
+                /// @brief 是否已获取 Future
+                bool m_is_future_retrieved = false;
+                /// @brief 是否已设置结果
+                bool m_is_satisfied = false;
+            };
+            /**
+             * @brief when_any 的结果
+             * @tparam T 结果类型
+             */
+            template<class T>
+            struct WhenAnyResult
+            {
+                /// @brief 最先完成的 Future 下标
+                std::size_t index = 0;
+                /// @brief 最先完成的 Future
+                Future<T> future;
+            };
+            /**
+             * @brief 创建已完成的 Future
+             * @tparam T 结果类型
+             * @param value 结果
+             * @return Future<std::decay_t<T>>
+             */
+            template<class T>
+            Future<std::decay_t<T>> make_ready_future(T&& value)
+            {
+                Promise<std::decay_t<T>> promise;
+                Future<std::decay_t<T>> future = promise.get_future();
+                promise.set_value(std::forward<T>(value));
+                return future;
+            }
+            /**
+             * @brief 创建已完成的 Future
+             * @return Future<void>
+             */
+            inline Future<void> make_ready_future()
+            {
+                Promise<void> promise;
+                Future<void> future = promise.get_future();
+                promise.set_value();
+                return future;
+            }
+            /**
+             * @brief 创建以异常完成的 Future
+             * @tparam T 结果类型
+             * @param exception 异常
+             * @return Future<T>
+             */
+            template<class T>
+            Future<T> make_exceptional_future(std::exception_ptr exception)
+            {
+                Promise<T> promise;
+                Future<T> future = promise.get_future();
+                promise.set_exception(std::move(exception));
+                return future;
+            }
+            /**
+             * @brief 等待全部 Future 完成
+             * @note 结果中的 Future 均已就绪，逐个 get() 获取值或异常
+             * @tparam T 结果类型
+             * @param futures Future 列表
+             * @return Future<std::vector<Future<T>>>
+             */
+            template<class T>
+            Future<std::vector<Future<T>>> when_all(std::vector<Future<T>> futures)
+            {
+                if (futures.empty())
+                {
+                    return make_ready_future(std::move(futures));
+                }
+                struct Context
+                {
+                    std::vector<Future<T>> futures;
+                    Promise<std::vector<Future<T>>> promise;
+                    std::atomic<std::size_t> remaining;
+                };
+                std::size_t count = futures.size();
+                Context* context = FramePool::create<Context>(std::move(futures), Promise<std::vector<Future<T>>>(), count);
+                Future<std::vector<Future<T>>> result = context->promise.get_future();
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    Detail::FutureAccess::get_state(context->futures[i])->set_callback(Task([context]()
+                        {
+                            if (context->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                            {
+                                context->promise.set_value(std::move(context->futures));
+                                FramePool::destroy(context);
+                            }
+                        }));
+                }
+                return result;
+            }
+            /**
+             * @brief 等待全部 Future 完成
+             * @note 结果中的 Future 均已就绪，逐个 get() 获取值或异常
+             * @tparam Ts 结果类型
+             * @param futures Future 列表
+             * @return Future<std::tuple<Future<Ts>...>>
+             */
+            template<class... Ts>
+            Future<std::tuple<Future<Ts>...>> when_all(Future<Ts>... futures)
+            {
+                using Tuple = std::tuple<Future<Ts>...>;
+                if constexpr (sizeof...(Ts) == 0)
+                {
+                    return make_ready_future(Tuple());
+                }
+                else
+                {
+                    struct Context
+                    {
+                        Tuple futures;
+                        Promise<Tuple> promise;
+                        std::atomic<std::size_t> remaining;
+                    };
+                    Context* context = FramePool::create<Context>(Tuple(std::move(futures)...), Promise<Tuple>(), sizeof...(Ts));
+                    Future<Tuple> result = context->promise.get_future();
+                    std::apply([context](auto&... items)
+                        {
+                            (Detail::FutureAccess::get_state(items)->set_callback(Task([context]()
+                                {
+                                    if (context->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                                    {
+                                        context->promise.set_value(std::move(context->futures));
+                                        FramePool::destroy(context);
+                                    }
+                                })), ...);
+                        }, context->futures);
+                    return result;
+                }
+            }
+            /**
+             * @brief 等待任一 Future 完成
+             * @note 其余 Future 在各自完成后释放
+             * @tparam T 结果类型
+             * @param futures Future 列表，不可为空
+             * @return Future<WhenAnyResult<T>>
+             */
+            template<class T>
+            Future<WhenAnyResult<T>> when_any(std::vector<Future<T>> futures)
+            {
+                if (futures.empty())
+                {
+                    throw std::invalid_argument("when_any requires at least one future");
+                }
+                struct Context
+                {
+                    std::vector<Future<T>> futures;
+                    Promise<WhenAnyResult<T>> promise;
+                    std::atomic<std::size_t> remaining;
+                    std::atomic<bool> is_done = false;
+                };
+                std::size_t count = futures.size();
+                Context* context = FramePool::create<Context>(std::move(futures), Promise<WhenAnyResult<T>>(), count);
+                Future<WhenAnyResult<T>> result = context->promise.get_future();
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    Detail::FutureAccess::get_state(context->futures[i])->set_callback(Task([context, i]()
+                        {
+                            if (!context->is_done.exchange(true, std::memory_order_acq_rel))
+                            {
+                                context->promise.set_value(WhenAnyResult<T>{ i, std::move(context->futures[i]) });
+                            }
+                            if (context->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                            {
+                                FramePool::destroy(context);
+                            }
+                        }));
+                }
+                return result;
+            }
+        }
+    }
+}
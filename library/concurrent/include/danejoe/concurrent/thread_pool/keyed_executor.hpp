@@ -0,0 +1,280 @@
+#pragma once
+
+/**
+ * @file keyed_executor.hpp
+ * @author DaneJoe001
+ * @version 0.1.1
+ * @brief 按键串行执行器
+ * @details 相同键的任务按 FIFO 顺序串行执行，不同键并行；
+ *          每个活跃键对应一个按需创建的串行队列，排空后自动回收
+ * @date 2026-10-18
+ */
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include <functional>
+#include <type_traits>
+#include <unordered_map>
+
+#include "danejoe/concurrent/thread_pool/task.hpp"
+#include "danejoe/concurrent/thread_pool/future.hpp"
+#include "danejoe/concurrent/thread_pool/strand.hpp"
+#include "danejoe/concurrent/thread_pool/executor.hpp"
+#include "danejoe/concurrent/thread_pool/frame_pool.hpp"
+
+/**
+ * @namespace DaneJoe
+ * @brief DaneJoe命名空间
+ */
+namespace DaneJoe
+{
+    /**
+     * @namespace Concurrent
+     * @brief 并发命名空间
+     */
+    namespace Concurrent
+    {
+        /**
+         * @namespace ThreadPool
+         * @brief 线程池命名空间
+         */
+        namespace ThreadPool
+        {
+            /**
+             * @class KeyedExecutor
+             * @brief 按键串行执行器
+             * @tparam Key 键类型
+             * @tparam Hash 哈希函数类型
+             */
+            template<class Key, class Hash = std::hash<Key>>
+            class KeyedExecutor
+            {
+            public:
+                /// @brief 默认每键积压任务上限
+                static constexpr std::size_t DEFAULT_CAPACITY = 1024;
+                /// @brief 默认分片数
+                static constexpr std::size_t DEFAULT_SHARD_COUNT = 16;
+            public:
+                /**
+                 * @brief 构造函数
+                 * @param executor 底层执行器，需在全部任务执行完之前保持有效
+                 * @param capacity_per_key 每键积压任务上限
+                 * @param shard_count 键表分片数
+                 * @param batch_size 单次排空最多执行的任务数
+                 */
+                explicit KeyedExecutor(IExecutor& executor,
+                    std::size_t capacity_per_key = DEFAULT_CAPACITY,
+                    std::size_t shard_count = DEFAULT_SHARD_COUNT,
+                    std::size_t batch_size = Strand::DEFAULT_BATCH_SIZE) :
+                    m_table(std::make_shared<Table>(executor, capacity_per_key, shard_count, batch_size))
+                {
+                }
+                /**
+                 * @brief 提交任务
+                 * @param key 键
+                 * @param task 任务
+                 * @return bool 是否成功；该键积压已满时返回 false 并丢弃任务
+                 */
+                bool post(const Key& key, Task task)
+                {
+                    std::shared_ptr<KeyedQueue> queue;
+                    {
+                        Shard& shard = m_table->get_shard(key);
+                        std::lock_guard<std::mutex> lock(shard.mutex);
+                        auto it = shard.queues.find(key);
+                        if (it == shard.queues.end())
+                        {
+                            it = shard.queues.emplace(key, std::make_shared<KeyedQueue>(m_table, key)).first;
+                        }
+                        queue = it->second;
+                        queue->begin_post();
+                    }
+                    // 在分片锁外入队：底层执行器可能就地排空（如 InlineExecutor），排空结束时需要获取分片锁
+                    bool is_posted = queue->try_post(task);
+                    queue->end_post();
+                    return is_posted;
+                }
+                /**
+                 * @brief 提交任务并获取结果
+                 * @note 该键积压已满时返回的 Future 以 broken_promise 完成
+                 * @tparam F 可调用对象类型
+                 * @param key 键
+                 * @param func 可调用对象
+                 * @return Future<R> 结果
+                 */
+                template<class F>
+                auto submit(const Key& key, F&& func)
+                {
+                    using Result = std::invoke_result_t<std::decay_t<F>>;
+                    using State = Detail::CallableState<Result, std::decay_t<F>>;
+                    State* state = FramePool::create<State>(std::forward<F>(func));
+                    state->add_ref();
+                    Future<Result> future = Detail::FutureAccess::make_future<Result>(state);
+                    post(key, Task(Detail::StateRunner<State>(state)));
+                    return future;
+                }
+                /**
+                 * @brief 获取活跃键数量
+                 * @return std::size_t 有积压或正在执行的键数量
+                 */
+                std::size_t get_active_key_count()const
+                {
+                    std::size_t count = 0;
+                    for (auto& shard : m_table->shards)
+                    {
+                        std::lock_guard<std::mutex> lock(shard->mutex);
+                        count += shard->queues.size();
+                    }
+                    return count;
+                }
+            private:
+                class KeyedQueue;
+                /**
+                 * @brief 键表分片
+                 */
+                struct Shard
+                {
+                    /// @brief 互斥锁
+                    std::mutex mutex;
+                    /// @brief 活跃键的串行队列
+                    std::unordered_map<Key, std::shared_ptr<KeyedQueue>, Hash> queues;
+                };
+                /**
+                 * @brief 键表
+                 * @note 由执行器独占持有，活跃队列只持有弱引用以免循环引用；
+                 *       执行器销毁后已调度的队列由排空任务持有，剩余任务仍会执行
+                 */
+                struct Table
+                {
+                    /**
+                     * @brief 构造函数
+                     * @param executor 底层执行器
+                     * @param capacity 每键积压任务上限
+                     * @param shard_count 分片数
+                     * @param batch_size 单次排空最多执行的任务数
+                     */
+                    Table(IExecutor& executor, std::size_t capacity, std::size_t shard_count, std::size_t batch_size) :
+                        executor(executor), capacity(capacity), batch_size(batch_size)
+                    {
+                        shards.reserve(shard_count == 0 ? 1 : shard_count);
+                        for (std::size_t i = 0; i < shards.capacity(); ++i)
+                        {
+                            shards.emplace_back(std::make_unique<Shard>());
+                        }
+                    }
+                    /**
+                     * @brief 获取键所在分片
+                     * @param key 键
+                     * @return Shard& 分片
+                     */
+                    Shard& get_shard(const Key& key)
+                    {
+                        return *shards[hash(key) % shards.size()];
+                    }
+                    /// @brief 底层执行器
+                    IExecutor& executor;
+                    /// @brief 每键积压任务上限
+                    std::size_t capacity;
+                    /// @brief 单次排空最多执行的任务数
+                    std::size_t batch_size;
+                    /// @brief 哈希函数
+                    Hash hash;
+                    /// @brief 分片
+                    std::vector<std::unique_ptr<Shard>> shards;
+                };
+                /**
+                 * @brief 单个键的串行队列
+                 * @details 排空后若仍空闲且没有线程正在向其投递，则从键表中移除自身
+                 */
+                class KeyedQueue : public Detail::SerialQueue
+                {
+                public:
+                    /**
+                     * @brief 构造函数
+                     * @param table 键表
+                     * @param key 键
+                     */
+                    KeyedQueue(const std::shared_ptr<Table>& table, const Key& key) :
+                        Detail::SerialQueue(table->executor, table->capacity, table->batch_size),
+                        m_table(table),
+                        m_key(key)
+                    {
+                    }
+                    /**
+                     * @brief 登记一次分片锁外的投递
+                     * @note 需持有分片锁；登记期间队列不会从键表移除，保证同一键始终只有一个队列
+                     */
+                    void begin_post()noexcept
+                    {
+                        m_posting_count.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    /**
+                     * @brief 结束投递
+                     * @details 最后一个投递者离开时若队列已空闲（排空期间因投递中未能移除），代为移除
+                     */
+                    void end_post()
+                    {
+                        if (m_posting_count.fetch_sub(1, std::memory_order_seq_cst) == 1 && is_idle())
+                        {
+                            try_remove();
+                        }
+                    }
+                protected:
+                    /**
+                     * @brief 空闲时从键表移除
+                     */
+                    void on_idle()override
+                    {
+                        try_remove();
+                    }
+                private:
+                    /**
+                     * @brief 空闲且无投递者时从键表移除
+                     * @note 持有分片锁再检查，与投递路径的登记互斥；只移除键表中仍指向自身的项
+                     */
+                    void try_remove()
+                    {
+                        std::shared_ptr<Table> table = m_table.lock();
+                        if (!table)
+                        {
+                            return;
+                        }
+                        Shard& shard = table->get_shard(m_key);
+                        std::lock_guard<std::mutex> lock(shard.mutex);
+                        auto it = shard.queues.find(m_key);
+                        if (it != shard.queues.end() && it->second.get() == this &&
+                            m_posting_count.load(std::memory_order_seq_cst) == 0 && is_idle())
+                        {
+                            shard.queues.erase(it);
+                        }
+                    }
+                private:
+                    /// @brief 键表，执行器销毁后失效
+                    std::weak_ptr<Table> m_table;
+                    /// @brief 键
+                    Key m_key;
+                    /// @brief 正在分片锁外投递的线程数
+                    std::atomic<std::size_t> m_posting_count = 0;
+                };
+            private:
+                /**
+                 * @brief 拷贝构造函数
+                 * @note 禁止拷贝构造
+                 */
+                KeyedExecutor(const KeyedExecutor&) = delete;
+                /**
+                 * @brief 拷贝赋值运算符
+                 * @note 禁止拷贝赋值
+                 */
+                KeyedExecutor& operator=(const KeyedExecutor&) = delete;
+            private:
+                /// @brief 键表
+                std::shared_ptr<Table> m_table;
+            };
+        }
+    }
+}
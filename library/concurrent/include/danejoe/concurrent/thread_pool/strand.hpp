@@ -0,0 +1,312 @@
+#pragma once
+
+/**
+ * @file strand.hpp
+ * @author DaneJoe001
+ * @version 0.1.1
+ * @brief 串行执行器
+ * @details 在底层执行器上按提交顺序、互不并发地执行任务，不占用专属线程
+ * @date 2026-10-18
+ */
+
+#include <mutex>
+#include <memory>
+#include <cstddef>
+#include <utility>
+#include <system_error>
+#include <condition_variable>
+
+#include "danejoe/concurrent/thread_pool/task.hpp"
+#include "danejoe/concurrent/thread_pool/task_ring.hpp"
+#include "danejoe/concurrent/thread_pool/executor.hpp"
+
+/**
+ * @namespace DaneJoe
+ * @brief DaneJoe命名空间
+ */
+namespace DaneJoe
+{
+    /**
+     * @namespace Concurrent
+     * @brief 并发命名空间
+     */
+    namespace Concurrent
+    {
+        /**
+         * @namespace ThreadPool
+         * @brief 线程池命名空间
+         */
+        namespace ThreadPool
+        {
+            /**
+             * @namespace Detail
+             * @brief 实现细节
+             */
+            namespace Detail
+            {
+                /**
+                 * @class SerialQueue
+                 * @brief 有界串行任务队列
+                 * @details 队列由空变为非空时向底层执行器投递一个排空任务；
+                 *          排空任务每次最多执行 batch_size 个任务，剩余任务重新投递以让出工作线程
+                 * @note 底层执行器需在全部任务执行完之前保持有效
+                 */
+                class SerialQueue : public std::enable_shared_from_this<SerialQueue>
+                {
+                public:
+                    /**
+                     * @brief 构造函数
+                     * @param executor 底层执行器
+                     * @param capacity 积压任务上限
+                     * @param batch_size 单次排空最多执行的任务数
+                     */
+                    SerialQueue(IExecutor& executor, std::size_t capacity, std::size_t batch_size) :
+                        m_executor(executor),
+                        m_capacity(capacity == 0 ? 1 : capacity),
+                        m_batch_size(batch_size == 0 ? 1 : batch_size)
+                    {
+                    }
+                    /**
+                     * @brief 析构函数
+                     */
+                    virtual ~SerialQueue() = default;
+                    /**
+                     * @brief 尝试入队
+                     * @param task 任务，仅在成功时被移走
+                     * @return bool 是否成功；积压已满时返回 false
+                     */
+                    bool try_post(Task& task)
+                    {
+                        bool should_schedule = false;
+                        {
+                            std::lock_guard<std::mutex> lock(m_mutex);
+                            if (m_tasks.size() >= m_capacity)
+                            {
+                                return false;
+                            }
+                            m_tasks.push_back(std::move(task));
+                            should_schedule = !std::exchange(m_is_scheduled, true);
+                        }
+                        if (should_schedule)
+                        {
+                            schedule();
+                        }
+                        return true;
+                    }
+                    /**
+                     * @brief 入队，积压已满时阻塞等待
+                     * @param task 任务
+                     * @throw std::system_error 在本队列的任务中调用且积压已满（resource_deadlock_would_occur），
+                     *        此时等待空位会使执行线程等待自己
+                     */
+                    void post(Task task)
+                    {
+                        bool should_schedule = false;
+                        {
+                            std::unique_lock<std::mutex> lock(m_mutex);
+                            if (m_tasks.size() >= m_capacity && is_running_in_this_thread())
+                            {
+                                throw std::system_error(std::make_error_code(std::errc::resource_deadlock_would_occur), "SerialQueue post");
+                            }
+                            m_space_cv.wait(lock, [this]()
+                                {
+                                    return m_tasks.size() < m_capacity;
+                                });
+                            m_tasks.push_back(std::move(task));
+                            should_schedule = !std::exchange(m_is_scheduled, true);
+                        }
+                        if (should_schedule)
+                        {
+                            schedule();
+                        }
+                    }
+                    /**
+                     * @brief 获取积压任务数
+                     * @return std::size_t 积压任务数
+                     */
+                    std::size_t size()const
+                    {
+                        std::lock_guard<std::mutex> lock(m_mutex);
+                        return m_tasks.size();
+                    }
+                    /**
+                     * @brief 获取积压任务上限
+                     * @return std::size_t 积压任务上限
+                     */
+                    std::size_t get_capacity()const
+                    {
+                        return m_capacity;
+                    }
+                    /**
+                     * @brief 判断当前线程是否正在执行本队列的任务
+                     * @return bool 是否正在执行
+                     */
+                    bool is_running_in_this_thread()const
+                    {
+                        return get_current() == this;
+                    }
+                protected:
+                    /**
+                     * @brief 判断是否空闲（无积压且未调度）
+                     * @return bool 是否空闲
+                     */
+                    bool is_idle()const
+                    {
+                        std::lock_guard<std::mutex> lock(m_mutex);
+                        return m_tasks.empty() && !m_is_scheduled;
+                    }
+                    /**
+                     * @brief 排空结束且队列为空时调用
+                     */
+                    virtual void on_idle() {}
+                private:
+                    /**
+                     * @brief 获取当前线程正在执行的串行队列
+                     * @return const SerialQueue*& 当前串行队列
+                     */
+                    static const SerialQueue*& get_current()
+                    {
+                        thread_local const SerialQueue* current = nullptr;
+                        return current;
+                    }
+                    /**
+                     * @brief 向底层执行器投递排空任务
+                     */
+                    void schedule()
+                    {
+                        m_executor.execute(Task([self = shared_from_this()]()
+                            {
+                                self->drain();
+                            }));
+                    }
+                    /**
+                     * @brief 按顺序执行积压任务
+                     */
+                    void drain()
+                    {
+                        const SerialQueue* previous = std::exchange(get_current(), this);
+                        bool is_idle_now = false;
+                        for (std::size_t i = 0; i < m_batch_size && !is_idle_now; ++i)
+                        {
+                            Task task;
+                            {
+                                std::lock_guard<std::mutex> lock(m_mutex);
+                                if (!m_tasks.pop_front(task))
+                                {
+                                    m_is_scheduled = false;
+                                    is_idle_now = true;
+                                    break;
+                                }
+                            }
+                            m_space_cv.notify_one();
+                            try
+                            {
+                                task();
+                            }
+                            catch (...)
+                            {
+                            }
+                        }
+                        if (!is_idle_now)
+                        {
+                            std::lock_guard<std::mutex> lock(m_mutex);
+                            if (m_tasks.empty())
+                            {
+                                m_is_scheduled = false;
+                                is_idle_now = true;
+                            }
+                        }
+                        get_current() = previous;
+                        if (is_idle_now)
+                        {
+                            on_idle();
+                        }
+                        else
+                        {
+                            schedule();
+                        }
+                    }
+                private:
+                    /// @brief 底层执行器
+                    IExecutor& m_executor;
+                    /// @brief 积压任务上限
+                    std::size_t m_capacity;
+                    /// @brief 单次排空最多执行的任务数
+                    std::size_t m_batch_size;
+                    /// @brief 互斥锁
+                    mutable std::mutex m_mutex;
+                    /// @brief 有空位条件变量
+                    std::condition_variable m_space_cv;
+                    /// @brief 积压任务
+                    TaskRing m_tasks;
+                    /// @brief 是否已投递排空任务
+                    bool m_is_scheduled = false;
+                };
+            }
+            /**
+             * @class Strand
+             * @brief 串行执行器
+             * @details 提交到同一 Strand 的任务按 FIFO 顺序执行且互不并发，不同 Strand 之间并行
+             */
+            class Strand : public IExecutor
+            {
+            public:
+                /// @brief 默认积压任务上限
+                static constexpr std::size_t DEFAULT_CAPACITY = 1024;
+                /// @brief 默认单次排空任务数
+                static constexpr std::size_t DEFAULT_BATCH_SIZE = 64;
+            public:
+                /**
+                 * @brief 构造函数
+                 * @param executor 底层执行器，需在全部任务执行完之前保持有效
+                 * @param capacity 积压任务上限
+                 * @param batch_size 单次排空最多执行的任务数
+                 */
+                explicit Strand(IExecutor& executor,
+                    std::size_t capacity = DEFAULT_CAPACITY,
+                    std::size_t batch_size = DEFAULT_BATCH_SIZE) :
+                    m_queue(std::make_shared<Detail::SerialQueue>(executor, capacity, batch_size))
+                {
+                }
+                /**
+                 * @brief 提交任务，积压已满时阻塞等待
+                 * @param task 任务
+                 * @throw std::system_error 在本 Strand 的任务中提交且积压已满（resource_deadlock_would_occur）；
+                 *        需要非阻塞提交时使用 try_post()
+                 */
+                void execute(Task task)override
+                {
+                    m_queue->post(std::move(task));
+                }
+                /**
+                 * @brief 尝试提交任务
+                 * @param task 任务
+                 * @return bool 是否成功；积压已满时返回 false 并丢弃任务
+                 */
+                bool try_post(Task task)
+                {
+                    return m_queue->try_post(task);
+                }
+                /**
+                 * @brief 获取积压任务数
+                 * @return std::size_t 积压任务数
+                 */
+                std::size_t size()const
+                {
+                    return m_queue->size();
+                }
+                /**
+                 * @brief 判断当前线程是否正在执行本 Strand 的任务
+                 * @return bool 是否正在执行
+                 */
+                bool is_running_in_this_thread()const
+                {
+                    return m_queue->is_running_in_this_thread();
+                }
+            private:
+                /// @brief 串行队列，Strand 销毁后由未完成的排空任务继续持有
+                std::shared_ptr<Detail::SerialQueue> m_queue;
+            };
+        }
+    }
+}
@@ -0,0 +1,218 @@
+#pragma once
+
+/**
+ * @file task.hpp
+ * @author DaneJoe001
+ * @version 0.1.1
+ * @brief 可移动的任务包装
+ * @details 小对象内联存储，避免 std::function 对大多数任务的堆分配
+ * @date 2026-10-18
+ */
+
+#include <new>
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+
+/**
+ * @namespace DaneJoe
+ * @brief DaneJoe命名空间
+ */
+namespace DaneJoe
+{
+    /**
+     * @namespace Concurrent
+     * @brief 并发命名空间
+     */
+    namespace Concurrent
+    {
+        /**
+         * @namespace ThreadPool
+         * @brief 线程池命名空间
+         */
+        namespace ThreadPool
+        {
+            /**
+             * @brief 仅可移动的无参任务
+             * @details 可调用对象不超过 INLINE_SIZE 且可无异常移动时内联存储，否则退化为堆分配
+             */
+            class Task
+            {
+            public:
+                /// @brief 内联存储大小
+                static constexpr std::size_t INLINE_SIZE = 48;
+            public:
+                /**
+                 * @brief 构造空任务
+                 */
+                Task()noexcept = default;
+                /**
+                 * @brief 由可调用对象构造任务
+                 * @tparam F 可调用对象类型
+                 * @param func 可调用对象
+                 */
+                template<class F, class = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Task>>>
+                Task(F&& func)
+                {
+                    using Callable = std::decay_t<F>;
+                    if constexpr (is_inline<Callable>())
+                    {
+                        ::new (static_cast<void*>(m_storage)) Callable(std::forward<F>(func));
+                        m_operations = &INLINE_OPERATIONS<Callable>;
+                    }
+                    else
+                    {
+                        ::new (static_cast<void*>(m_storage)) Callable* (new Callable(std::forward<F>(func)));
+                        m_operations = &HEAP_OPERATIONS<Callable>;
+                    }
+                }
+                /**
+                 * @brief 移动构造函数
+                 * @param other 其他任务
+                 */
+                Task(Task&& other)noexcept
+                {
+                    move_from(other);
+                }
+                /**
+                 * @brief 移动赋值运算符
+                 * @param other 其他任务
+                 * @return Task&
+                 */
+                Task& operator=(Task&& other)noexcept
+                {
+                    if (this != &other)
+                    {
+                        reset();
+                        move_from(other);
+                    }
+                    return *this;
+                }
+                /**
+                 * @brief 析构函数
+                 */
+                ~Task()
+                {
+                    reset();
+                }
+                /**
+                 * @brief 执行任务
+                 * @note 空任务调用无效果
+                 */
+                void operator()()
+                {
+                    if (m_operations)
+                    {
+                        m_operations->invoke(m_storage);
+                    }
+                }
+                /**
+                 * @brief 判断任务是否非空
+                 * @return bool 是否非空
+                 */
+                explicit operator bool()const noexcept
+                {
+                    return m_operations != nullptr;
+                }
+                /**
+                 * @brief 销毁持有的可调用对象
+                 */
+                void reset()noexcept
+                {
+                    if (m_operations)
+                    {
+                        m_operations->destroy(m_storage);
+                        m_operations = nullptr;
+                    }
+                }
+            private:
+                /**
+                 * @brief 拷贝构造函数
+                 * @note 禁止拷贝构造
+                 */
+                Task(const Task&) = delete;
+                /**
+                 * @brief 拷贝赋值运算符
+                 * @note 禁止拷贝赋值
+                 */
+                Task& operator=(const Task&) = delete;
+                /**
+                 * @brief 可调用对象的类型擦除操作表
+                 */
+                struct Operations
+                {
+                    /// @brief 调用
+                    void (*invoke)(void* storage);
+                    /// @brief 移动到新存储并销毁原对象
+                    void (*relocate)(void* dst, void* src)noexcept;
+                    /// @brief 销毁
+                    void (*destroy)(void* storage)noexcept;
+                };
+                /**
+                 * @brief 判断可调用对象能否内联存储
+                 * @tparam Callable 可调用对象类型
+                 * @return bool 能否内联存储
+                 */
+                template<class Callable>
+                static constexpr bool is_inline()
+                {
+                    return sizeof(Callable) <= INLINE_SIZE &&
+                        alignof(Callable) <= alignof(std::max_align_t) &&
+                        std::is_nothrow_move_constructible_v<Callable>;
+                }
+                /// @brief 内联存储的操作表
+                template<class Callable>
+                static constexpr Operations INLINE_OPERATIONS = {
+                    [](void* storage)
+                    {
+                        (*std::launder(static_cast<Callable*>(storage)))();
+                    },
+                    [](void* dst, void* src)noexcept
+                    {
+                        Callable* source = std::launder(static_cast<Callable*>(src));
+                        ::new (dst) Callable(std::move(*source));
+                        source->~Callable();
+                    },
+                    [](void* storage)noexcept
+                    {
+                        std::launder(static_cast<Callable*>(storage))->~Callable();
+                    }
+                };
+                /// @brief 堆存储的操作表
+                template<class Callable>
+                static constexpr Operations HEAP_OPERATIONS = {
+                    [](void* storage)
+                    {
+                        (**std::launder(static_cast<Callable**>(storage)))();
+                    },
+                    [](void* dst, void* src)noexcept
+                    {
+                        ::new (dst) Callable* (*std::launder(static_cast<Callable**>(src)));
+                    },
+                    [](void* storage)noexcept
+                    {
+                        delete* std::launder(static_cast<Callable**>(storage));
+                    }
+                };
+                /**
+                 * @brief 从其他任务移动
+                 * @param other 其他任务
+                 */
+                void move_from(Task& other)noexcept
+                {
+                    if (other.m_operations)
+                    {
+                        other.m_operations->relocate(m_storage, other.m_storage);
+                        m_operations = other.m_operations;
+                        other.m_operations = nullptr;
+                    }
+                }
+            private:
+                /// @brief 内联存储
+                alignas(std::max_align_t) unsigned char m_storage[INLINE_SIZE];
+                /// @brief 操作表
+                const Operations* m_operations = nullptr;
+            };
+        }
+    }
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+/**
+ * @file task_ring.hpp
+ * @author DaneJoe001
+ * @version 0.1.1
+ * @brief 任务环形队列
+ * @date 2026-10-18
+ */
+
+#include <vector>
+#include <cstddef>
+#include <utility>
+
+#include "danejoe/concurrent/thread_pool/task.hpp"
+
+/**
+ * @namespace DaneJoe
+ * @brief DaneJoe命名空间
+ */
+namespace DaneJoe
+{
+    /**
+     * @namespace Concurrent
+     * @brief 并发命名空间
+     */
+    namespace Concurrent
+    {
+        /**
+         * @namespace ThreadPool
+         * @brief 线程池命名空间
+         */
+        namespace ThreadPool
+        {
+            /**
+             * @brief 任务环形队列
+             * @details 容量按需倍增且不回缩，稳态下入队出队不触发堆分配
+             * @note 非线程安全，由调用方加锁
+             */
+            class TaskRing
+            {
+            public:
+                /**
+                 * @brief 队尾入队
+                 * @param task 任务
+                 */
+                void push_back(Task task)
+                {
+                    if (m_size == m_slots.size())
+                    {
+                        grow();
+                    }
+                    m_slots[(m_head + m_size) & (m_slots.size() - 1)] = std::move(task);
+                    ++m_size;
+                }
+                /**
+                 * @brief 队首出队
+                 * @param task 出队的任务
+                 * @return bool 是否成功
+                 */
+                bool pop_front(Task& task)
+                {
+                    if (m_size == 0)
+                    {
+                        return false;
+                    }
+                    task = std::move(m_slots[m_head]);
+                    m_head = (m_head + 1) & (m_slots.size() - 1);
+                    --m_size;
+                    return true;
+                }
+                /**
+                 * @brief 队尾出队
+                 * @param task 出队的任务
+                 * @return bool 是否成功
+                 */
+                bool pop_back(Task& task)
+                {
+                    if (m_size == 0)
+                    {
+                        return false;
+                    }
+                    --m_size;
+                    task = std::move(m_slots[(m_head + m_size) & (m_slots.size() - 1)]);
+                    return true;
+                }
+                /**
+                 * @brief 获取任务数
+                 * @return std::size_t 任务数
+                 */
+                std::size_t size()const noexcept
+                {
+                    return m_size;
+                }
+                /**
+                 * @brief 判断是否为空
+                 * @return bool 是否为空
+                 */
+                bool empty()const noexcept
+                {
+                    return m_size == 0;
+                }
+            private:
+                /**
+                 * @brief 容量倍增
+                 */
+                void grow()
+                {
+                    std::vector<Task> slots(m_slots.empty() ? 64 : m_slots.size() * 2);
+                    for (std::size_t i = 0; i < m_size; ++i)
+                    {
+                        slots[i] = std::move(m_slots[(m_head + i) & (m_slots.size() - 1)]);
+                    }
+                    m_slots = std::move(slots);
+                    m_head = 0;
+                }
+            private:
+                /// @brief 槽位，容量为2的幂
+                std::vector<Task> m_slots;
+                /// @brief 队首下标
+                std::size_t m_head = 0;
+                /// @brief 任务数
+                std::size_t m_size = 0;
+            };
+        }
+    }
+}
@@ -2,13 +2,36 @@
 
 /**
  * @file thread_pool.hpp
- * @author DaneJoe001 
+ * @author DaneJoe001
  * @version 0.1.1
  * @brief 线程池
- * @note 当前未实现
+ * @details 每个工作线程持有本地任务队列，空闲时从全局队列获取或从其他线程窃取任务；
+ *          可按队列深度与等待时间弹性伸缩，受管阻塞的任务由补偿线程顶替。
+ *          截止时间调度模式下，带截止时间的任务按最早截止时间优先出队，先于普通任务执行
  * @date 2025-10-24
  */
 
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include <functional>
+#include <type_traits>
+#include <condition_variable>
+
+#include "danejoe/concurrent/thread_pool/task.hpp"
+#include "danejoe/concurrent/thread_pool/task_ring.hpp"
+#include "danejoe/concurrent/thread_pool/future.hpp"
+#include "danejoe/concurrent/thread_pool/executor.hpp"
+#include "danejoe/concurrent/thread_pool/frame_pool.hpp"
+#include "danejoe/concurrent/cancellation/cancellation_token.hpp"
+
  /**
   * @namespace DaneJoe
   * @brief DaneJoe命名空间
@@ -27,13 +50,1127 @@ namespace DaneJoe
          */
         namespace ThreadPool
         {
+            /**
+             * @enum SchedulingPolicy
+             * @brief 调度策略
+             */
+            enum class SchedulingPolicy
+            {
+                /// @brief 先进先出，截止时间只用于出队时判断超时
+                Fifo,
+                /// @brief 最早截止时间优先，带截止时间的任务先于普通任务执行
+                EarliestDeadlineFirst,
+            };
+            /**
+             * @enum DeadlineMissPolicy
+             * @brief 任务出队时已超过截止时间的处理方式
+             */
+            enum class DeadlineMissPolicy
+            {
+                /// @brief 丢弃，不执行任务体
+                Drop,
+                /// @brief 降级为普通任务，排在所有未超时的截止时间任务之后；先进先出模式下直接执行
+                Deprioritize,
+            };
+            /**
+             * @struct DeadlineMiss
+             * @brief 超时任务信息，传给超时回调
+             */
+            struct DeadlineMiss
+            {
+                /// @brief 截止时间
+                std::chrono::steady_clock::time_point deadline;
+                /// @brief 发现超时（任务出队）的时间
+                std::chrono::steady_clock::time_point detected_time;
+                /// @brief 采取的处理方式
+                DeadlineMissPolicy policy = DeadlineMissPolicy::Drop;
+            };
+            /**
+             * @struct ThreadPoolOptions
+             * @brief 线程池配置
+             * @details max_thread_count 大于 min_thread_count 时启用弹性伸缩：
+             *          采样线程每个 sample_interval 检查一次，待执行任务数达到 grow_queue_depth
+             *          或任务等待时间达到 grow_wait_time 时增加一个线程，两次扩容至少间隔 grow_cooldown；
+             *          线程空闲 idle_timeout 且距上次扩容已过 idle_timeout 时退出，两个阈值之间的间隔即为回差
+             * @note 等待时间不逐个记录任务入队时刻，而是取有任务待执行期间距上次出队（或队列由空变为非空）的时长，
+             *       即最早待执行任务等待时间的下界：任务持续出队但出队速度不足时不会触发，由 grow_queue_depth 兜底
+             */
+            struct ThreadPoolOptions
+            {
+                /// @brief 最少（常驻）线程数，为0时使用硬件并发数
+                std::size_t min_thread_count = 0;
+                /// @brief 最多线程数，不大于 min_thread_count 时线程数固定
+                std::size_t max_thread_count = 0;
+                /// @brief 触发扩容的待执行任务数
+                std::size_t grow_queue_depth = 64;
+                /// @brief 触发扩容的任务等待时间
+                std::chrono::milliseconds grow_wait_time = std::chrono::milliseconds(20);
+                /// @brief 两次按采样扩容的最小间隔，使新线程有时间消化积压后再判断是否继续扩容
+                std::chrono::milliseconds grow_cooldown = std::chrono::milliseconds(50);
+                /// @brief 多余线程的空闲退出时间
+                std::chrono::milliseconds idle_timeout = std::chrono::seconds(30);
+                /// @brief 采样间隔
+                std::chrono::milliseconds sample_interval = std::chrono::milliseconds(5);
+                /// @brief 调度策略
+                SchedulingPolicy scheduling_policy = SchedulingPolicy::Fifo;
+                /// @brief 超时任务的处理方式
+                DeadlineMissPolicy deadline_miss_policy = DeadlineMissPolicy::Drop;
+                /// @brief 超时回调，在出队的工作线程上调用，抛出的异常被忽略
+                std::function<void(const DeadlineMiss&)> on_deadline_miss = nullptr;
+            };
+            /**
+             * @struct ThreadPoolStats
+             * @brief 线程池统计
+             */
+            struct ThreadPoolStats
+            {
+                /// @brief 当前线程数
+                std::size_t thread_count = 0;
+                /// @brief 历史最多线程数
+                std::size_t peak_thread_count = 0;
+                /// @brief 处于受管阻塞中的线程数
+                std::size_t blocked_count = 0;
+                /// @brief 待执行任务数
+                std::size_t pending_count = 0;
+                /// @brief 因队列深度扩容次数
+                std::uint64_t queue_depth_grow_count = 0;
+                /// @brief 因等待时间扩容次数
+                std::uint64_t wait_time_grow_count = 0;
+                /// @brief 为受管阻塞补偿扩容次数
+                std::uint64_t compensation_count = 0;
+                /// @brief 空闲退出次数
+                std::uint64_t shrink_count = 0;
+                /// @brief 已出队的截止时间任务数
+                std::uint64_t deadline_task_count = 0;
+                /// @brief 出队时已超过截止时间的任务数
+                std::uint64_t deadline_miss_count = 0;
+                /// @brief 因超时被丢弃的任务数
+                std::uint64_t deadline_drop_count = 0;
+                /// @brief 因超时被降级的任务数
+                std::uint64_t deadline_deprioritize_count = 0;
+            };
+            /**
+             * @namespace Detail
+             * @brief 实现细节
+             */
+            namespace Detail
+            {
+                /**
+                 * @class GuardedRunner
+                 * @brief 执行前先检查条件的任务体
+                 * @details 任务与条件位于同一池化帧，任务体只持有帧指针，可内联存储于 Task；
+                 *          直接在 Task 中嵌套 Task 会超出 Task::INLINE_SIZE 而退化为堆分配
+                 * @tparam Guard 条件类型，调用返回 bool 表示是否执行任务
+                 */
+                template<class Guard>
+                class GuardedRunner
+                {
+                public:
+                    /**
+                     * @brief 构造函数
+                     * @param task 任务
+                     * @param guard 条件
+                     */
+                    GuardedRunner(Task task, Guard guard) :
+                        m_frame(FramePool::create<Frame>(std::move(task), std::move(guard)))
+                    {
+                    }
+                    /**
+                     * @brief 移动构造函数
+                     * @param other 其他任务体
+                     */
+                    GuardedRunner(GuardedRunner&& other)noexcept :m_frame(std::exchange(other.m_frame, nullptr)) {}
+                    /**
+                     * @brief 析构函数
+                     */
+                    ~GuardedRunner()
+                    {
+                        if (m_frame)
+                        {
+                            FramePool::destroy(m_frame);
+                        }
+                    }
+                    /**
+                     * @brief 条件满足时执行任务
+                     */
+                    void operator()()
+                    {
+                        struct FrameGuard
+                        {
+                            Frame* frame;
+                            ~FrameGuard()
+                            {
+                                FramePool::destroy(frame);
+                            }
+                        } guard{ std::exchange(m_frame, nullptr) };
+                        if (guard.frame->guard())
+                        {
+                            guard.frame->task();
+                        }
+                    }
+                private:
+                    /**
+                     * @brief 池化帧
+                     */
+                    struct Frame
+                    {
+                        /**
+                         * @brief 构造函数
+                         * @param task 任务
+                         * @param guard 条件
+                         */
+                        Frame(Task task, Guard guard) :task(std::move(task)), guard(std::move(guard)) {}
+                        /// @brief 任务
+                        Task task;
+                        /// @brief 条件
+                        Guard guard;
+                    };
+                    /**
+                     * @brief 移动赋值运算符
+                     * @note 禁止移动赋值
+                     */
+                    GuardedRunner& operator=(GuardedRunner&&) = delete;
+                private:
+                    /// @brief 帧
+                    Frame* m_frame;
+                };
+                /**
+                 * @brief 构造执行前先检查条件的任务
+                 * @tparam Guard 条件类型
+                 * @param task 任务
+                 * @param guard 条件
+                 * @return Task 任务
+                 */
+                template<class Guard>
+                Task make_guarded_task(Task task, Guard guard)
+                {
+                    static_assert(sizeof(GuardedRunner<Guard>) <= Task::INLINE_SIZE, "guarded runner must be stored inline");
+                    return Task(GuardedRunner<Guard>(std::move(task), std::move(guard)));
+                }
+            }
             /**
              * @brief 线程池
              */
-            class ThreadPool
+            class ThreadPool : public IExecutor
             {
-
+            public:
+                /// @brief 截止时间与伸缩计时使用的时钟
+                using Clock = std::chrono::steady_clock;
+            public:
+                /**
+                 * @brief 构造函数
+                 * @param thread_count 工作线程数，为0时使用硬件并发数
+                 */
+                explicit ThreadPool(std::size_t thread_count = 0) :
+                    ThreadPool(ThreadPoolOptions{ thread_count })
+                {
+                }
+                /**
+                 * @brief 构造函数
+                 * @param options 配置
+                 */
+                explicit ThreadPool(const ThreadPoolOptions& options) :
+                    m_options(options)
+                {
+                    if (m_options.min_thread_count == 0)
+                    {
+                        m_options.min_thread_count = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+                    }
+                    m_options.max_thread_count = std::max(m_options.max_thread_count, m_options.min_thread_count);
+                    m_options.sample_interval = std::max(m_options.sample_interval, std::chrono::milliseconds(1));
+                    m_is_elastic = m_options.max_thread_count > m_options.min_thread_count;
+                    m_is_deadline_mode = m_options.scheduling_policy == SchedulingPolicy::EarliestDeadlineFirst;
+                    // 工作线程槽位按上限预先分配，窃取时遍历全部槽位，扩缩容不移动槽位
+                    m_workers.reserve(m_options.max_thread_count);
+                    for (std::size_t i = 0; i < m_options.max_thread_count; ++i)
+                    {
+                        m_workers.emplace_back(std::make_unique<Worker>());
+                    }
+                    std::lock_guard<std::mutex> lock(m_resize_mutex);
+                    for (std::size_t i = 0; i < m_options.min_thread_count; ++i)
+                    {
+                        start_worker_locked(i);
+                    }
+                    if (m_is_elastic)
+                    {
+                        m_monitor = std::thread(&ThreadPool::monitor_loop, this);
+                    }
+                }
+                /**
+                 * @brief 析构函数
+                 * @note 执行完已提交的任务后退出
+                 */
+                ~ThreadPool()
+                {
+                    shutdown();
+                }
+                /**
+                 * @brief 投递任务
+                 * @note 关闭后仅接受本线程池工作线程的投递，以便排空期间的延续仍能执行
+                 * @param task 任务
+                 * @return bool 是否成功投递；失败时任务被丢弃
+                 */
+                bool post(Task task)
+                {
+                    return try_push(task);
+                }
+                /**
+                 * @brief 投递任务
+                 * @note 线程池已关闭、任务被拒绝时在调用线程上直接执行，保证交给执行器的任务总会运行：
+                 *       Strand、协程调度与 Actor 等在调用前已置位“已调度”标志，任务丢失会使其永久停滞
+                 * @param task 任务
+                 */
+                void execute(Task task)override
+                {
+                    if (!try_push(task))
+                    {
+                        run_task(task);
+                    }
+                }
+                /**
+                 * @brief 提交任务并获取结果
+                 * @note 任务与结果状态位于同一池化帧；线程池已关闭时返回的 Future 以 broken_promise 完成
+                 * @tparam F 可调用对象类型
+                 * @tparam Args 参数类型
+                 * @param func 可调用对象
+                 * @param args 参数
+                 * @return Future<R> 结果
+                 */
+                template<class F, class... Args>
+                auto submit(F&& func, Args&&... args)
+                {
+                    Task task;
+                    auto future = make_future_task(task, std::forward<F>(func), std::forward<Args>(args)...);
+                    post(std::move(task));
+                    return future;
+                }
+                /**
+                 * @brief 投递可取消的任务
+                 * @note 任务出队时令牌已取消则直接丢弃，不执行任务体
+                 * @param task 任务
+                 * @param token 取消令牌
+                 * @return bool 是否成功投递
+                 */
+                bool post(Task task, Cancellation::CancellationToken token)
+                {
+                    return post(Detail::make_guarded_task(std::move(task), [token = std::move(token)]()
+                        {
+                            return !token.is_cancellation_requested();
+                        }));
+                }
+                /**
+                 * @brief 提交可取消的任务并获取结果
+                 * @note 任务出队时令牌已取消则不执行，返回的 Future 以 OperationCancelled 完成
+                 * @tparam F 可调用对象类型
+                 * @tparam Args 参数类型
+                 * @param token 取消令牌
+                 * @param func 可调用对象
+                 * @param args 参数
+                 * @return Future<R> 结果
+                 */
+                template<class F, class... Args>
+                auto submit(Cancellation::CancellationToken token, F&& func, Args&&... args)
+                {
+                    using Result = std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>;
+                    return submit([token = std::move(token), func = std::forward<F>(func), ...args = std::forward<Args>(args)]() mutable -> Result
+                        {
+                            token.throw_if_cancellation_requested();
+                            return std::invoke(std::move(func), std::move(args)...);
+                        });
+                }
+                /**
+                 * @brief 投递带截止时间的任务
+                 * @details 截止时间调度模式下按截止时间排序，先进先出模式下与普通任务同序；
+                 *          出队时已超过截止时间则计入超时统计、调用超时回调，并按 deadline_miss_policy 丢弃或降级
+                 * @param task 任务
+                 * @param deadline 截止时间
+                 * @return bool 是否成功投递
+                 */
+                bool post(Task task, Clock::time_point deadline)
+                {
+                    if (!m_is_deadline_mode)
+                    {
+                        return post(Detail::make_guarded_task(std::move(task), [this, deadline]()
+                            {
+                                return !check_deadline(deadline) || m_options.deadline_miss_policy != DeadlineMissPolicy::Drop;
+                            }));
+                    }
+                    DeadlineTask entry{ deadline, m_deadline_sequence.fetch_add(1, std::memory_order_relaxed), std::move(task) };
+                    WorkerContext& context = get_worker_context();
+                    if (context.pool == this)
+                    {
+                        Worker& worker = *m_workers[context.index];
+                        std::lock_guard<std::mutex> lock(worker.mutex);
+                        push_deadline_task(worker.deadline_tasks, std::move(entry));
+                        m_deadline_pending_count.fetch_add(1, std::memory_order_relaxed);
+                        on_task_added();
+                    }
+                    else
+                    {
+                        std::lock_guard<std::mutex> lock(m_global_mutex);
+                        if (!m_is_running.load(std::memory_order_relaxed))
+                        {
+                            return false;
+                        }
+                        push_deadline_task(m_global_deadline_tasks, std::move(entry));
+                        m_deadline_pending_count.fetch_add(1, std::memory_order_relaxed);
+                        on_task_added();
+                    }
+                    notify_task_added();
+                    return true;
+                }
+                /**
+                 * @brief 提交带截止时间的任务并获取结果
+                 * @note 任务因超时被丢弃时返回的 Future 以 broken_promise 完成
+                 * @tparam F 可调用对象类型
+                 * @tparam Args 参数类型
+                 * @param deadline 截止时间
+                 * @param func 可调用对象
+                 * @param args 参数
+                 * @return Future<R> 结果
+                 */
+                template<class F, class... Args>
+                auto submit(Clock::time_point deadline, F&& func, Args&&... args)
+                {
+                    Task task;
+                    auto future = make_future_task(task, std::forward<F>(func), std::forward<Args>(args)...);
+                    post(std::move(task), deadline);
+                    return future;
+                }
+                /**
+                 * @brief 关闭线程池
+                 * @note 不再接受外部投递，执行完剩余任务后等待工作线程退出；可重复调用
+                 */
+                void shutdown()
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(m_global_mutex);
+                        m_is_running.store(false);
+                    }
+                    {
+                        std::lock_guard<std::mutex> lock(m_wait_mutex);
+                    }
+                    m_wait_cv.notify_all();
+                    {
+                        // 此后不再启动新线程
+                        std::lock_guard<std::mutex> lock(m_resize_mutex);
+                    }
+                    m_monitor_cv.notify_all();
+                    if (m_monitor.joinable() && m_monitor.get_id() != std::this_thread::get_id())
+                    {
+                        m_monitor.join();
+                    }
+                    for (auto& worker : m_workers)
+                    {
+                        if (worker->thread.joinable() && worker->thread.get_id() != std::this_thread::get_id())
+                        {
+                            worker->thread.join();
+                        }
+                    }
+                }
+                /**
+                 * @brief 判断线程池是否正在运行
+                 * @return bool 是否正在运行
+                 */
+                bool is_running()const
+                {
+                    return m_is_running.load();
+                }
+                /**
+                 * @brief 获取工作线程数
+                 * @return std::size_t 工作线程数
+                 */
+                std::size_t get_thread_count()const
+                {
+                    return m_thread_count.load(std::memory_order_relaxed);
+                }
+                /**
+                 * @brief 获取统计信息
+                 * @return ThreadPoolStats 统计信息
+                 */
+                ThreadPoolStats get_stats()const
+                {
+                    ThreadPoolStats stats;
+                    stats.thread_count = m_thread_count.load(std::memory_order_relaxed);
+                    stats.peak_thread_count = m_peak_thread_count.load(std::memory_order_relaxed);
+                    stats.blocked_count = m_blocked_count.load(std::memory_order_relaxed);
+                    stats.pending_count = m_pending_count.load(std::memory_order_relaxed);
+                    stats.queue_depth_grow_count = m_queue_depth_grow_count.load(std::memory_order_relaxed);
+                    stats.wait_time_grow_count = m_wait_time_grow_count.load(std::memory_order_relaxed);
+                    stats.compensation_count = m_compensation_count.load(std::memory_order_relaxed);
+                    stats.shrink_count = m_shrink_count.load(std::memory_order_relaxed);
+                    stats.deadline_task_count = m_deadline_task_count.load(std::memory_order_relaxed);
+                    stats.deadline_miss_count = m_deadline_miss_count.load(std::memory_order_relaxed);
+                    stats.deadline_drop_count = m_deadline_drop_count.load(std::memory_order_relaxed);
+                    stats.deadline_deprioritize_count = m_deadline_deprioritize_count.load(std::memory_order_relaxed);
+                    return stats;
+                }
+                /**
+                 * @brief 以受管阻塞方式执行可能长时间阻塞的调用
+                 * @details 在工作线程上调用时，阻塞期间不计入有效线程；有效线程少于最少线程数时
+                 *          立即补偿启动一个线程（受 max_thread_count 限制，不受 grow_cooldown 限制），多余线程之后按空闲超时退出
+                 * @note 仅弹性线程池（max_thread_count 大于 min_thread_count）会补偿；固定线程数的线程池中
+                 *       阻塞调用照常占用工作线程，全部工作线程阻塞等待池内任务时会死锁
+                 * @tparam F 可调用对象类型
+                 * @param func 可调用对象
+                 * @return func 的返回值
+                 */
+                template<class F>
+                decltype(auto) managed_block(F&& func)
+                {
+                    if (!is_worker_thread())
+                    {
+                        return std::invoke(std::forward<F>(func));
+                    }
+                    std::size_t blocked_count = m_blocked_count.fetch_add(1, std::memory_order_relaxed) + 1;
+                    if (m_is_elastic && m_thread_count.load(std::memory_order_relaxed) < m_options.min_thread_count + blocked_count)
+                    {
+                        std::lock_guard<std::mutex> lock(m_resize_mutex);
+                        if (try_grow_locked())
+                        {
+                            m_compensation_count.fetch_add(1, std::memory_order_relaxed);
+                        }
+                    }
+                    struct BlockedGuard
+                    {
+                        std::atomic<std::size_t>& blocked_count;
+                        ~BlockedGuard()
+                        {
+                            blocked_count.fetch_sub(1, std::memory_order_relaxed);
+                        }
+                    } guard{ m_blocked_count };
+                    return std::invoke(std::forward<F>(func));
+                }
+                /**
+                 * @brief 获取待执行任务数
+                 * @return std::size_t 待执行任务数
+                 */
+                std::size_t get_pending_count()const
+                {
+                    return m_pending_count.load(std::memory_order_relaxed);
+                }
+                /**
+                 * @brief 在当前线程上执行一个待执行任务
+                 * @note 用于等待子任务时协助执行而不阻塞工作线程；非工作线程也可调用
+                 * @return bool 是否执行了任务
+                 */
+                bool run_pending_task()
+                {
+                    WorkerContext& context = get_worker_context();
+                    std::size_t index = context.pool == this ? context.index : m_workers.size();
+                    Task task;
+                    if (!try_take(index, task))
+                    {
+                        return false;
+                    }
+                    run_task(task);
+                    return true;
+                }
+                /**
+                 * @brief 判断当前线程是否为本线程池的工作线程
+                 * @return bool 是否为工作线程
+                 */
+                bool is_worker_thread()const
+                {
+                    return get_worker_context().pool == this;
+                }
+            private:
+                /**
+                 * @brief 拷贝构造函数
+                 * @note 禁止拷贝构造
+                 */
+                ThreadPool(const ThreadPool&) = delete;
+                /**
+                 * @brief 拷贝赋值运算符
+                 * @note 禁止拷贝赋值
+                 */
+                ThreadPool& operator=(const ThreadPool&) = delete;
+                /**
+                 * @brief 带截止时间的任务
+                 */
+                struct DeadlineTask
+                {
+                    /// @brief 截止时间
+                    Clock::time_point deadline;
+                    /// @brief 投递序号，截止时间相同时先投递者优先
+                    std::uint64_t sequence = 0;
+                    /// @brief 任务
+                    Task task;
+                };
+                /**
+                 * @brief 截止时间任务的堆序比较，使最早截止的任务位于堆顶
+                 */
+                struct DeadlineLater
+                {
+                    /**
+                     * @brief 比较
+                     * @param lhs 左操作数
+                     * @param rhs 右操作数
+                     * @return bool lhs 是否应排在 rhs 之后
+                     */
+                    bool operator()(const DeadlineTask& lhs, const DeadlineTask& rhs)const noexcept
+                    {
+                        if (lhs.deadline != rhs.deadline)
+                        {
+                            return lhs.deadline > rhs.deadline;
+                        }
+                        return lhs.sequence > rhs.sequence;
+                    }
+                };
+                /**
+                 * @brief 工作线程
+                 */
+                struct Worker
+                {
+                    /// @brief 本地队列互斥锁
+                    std::mutex mutex;
+                    /// @brief 本地队列
+                    TaskRing tasks;
+                    /// @brief 本地截止时间任务堆
+                    std::vector<DeadlineTask> deadline_tasks;
+                    /// @brief 线程
+                    std::thread thread;
+                    /// @brief 线程是否存活，由 m_resize_mutex 保护
+                    bool is_alive = false;
+                };
+                /**
+                 * @brief 当前线程的工作线程信息
+                 */
+                struct WorkerContext
+                {
+                    /// @brief 所属线程池
+                    ThreadPool* pool = nullptr;
+                    /// @brief 工作线程下标
+                    std::size_t index = 0;
+                };
+                /**
+                 * @brief 获取当前线程的工作线程信息
+                 * @return WorkerContext& 工作线程信息
+                 */
+                static WorkerContext& get_worker_context()
+                {
+                    thread_local WorkerContext context;
+                    return context;
+                }
+                /**
+                 * @brief 任务入队
+                 * @note 关闭后仅接受本线程池工作线程的投递，以便排空期间的延续仍能执行
+                 * @param task 任务，仅在成功时被移走
+                 * @return bool 是否成功
+                 */
+                bool try_push(Task& task)
+                {
+                    WorkerContext& context = get_worker_context();
+                    if (context.pool == this)
+                    {
+                        Worker& worker = *m_workers[context.index];
+                        std::lock_guard<std::mutex> lock(worker.mutex);
+                        worker.tasks.push_back(std::move(task));
+                        on_task_added();
+                    }
+                    else
+                    {
+                        std::lock_guard<std::mutex> lock(m_global_mutex);
+                        if (!m_is_running.load(std::memory_order_relaxed))
+                        {
+                            return false;
+                        }
+                        m_global_tasks.push_back(std::move(task));
+                        on_task_added();
+                    }
+                    notify_task_added();
+                    return true;
+                }
+                /**
+                 * @brief 任务入队后更新计数
+                 * @note 在持有入队所用的队列锁时调用：取走任务的线程须先获得同一把锁，
+                 *       其出队时的减计数因此总在本次加计数之后，待执行任务数不会下溢
+                 */
+                void on_task_added()
+                {
+                    if (m_pending_count.fetch_add(1, std::memory_order_release) == 0 && m_is_elastic)
+                    {
+                        // 队列由空变为非空，等待时间从此刻起算
+                        m_last_take_time.store(Clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+                    }
+                }
+                /**
+                 * @brief 任务入队后唤醒空闲线程
+                 */
+                void notify_task_added()
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(m_wait_mutex);
+                    }
+                    m_wait_cv.notify_one();
+                }
+                /**
+                 * @brief 获取任务
+                 * @details 截止时间调度模式下先取截止时间任务，超时任务按策略丢弃或降级后继续；
+                 *          之后依次尝试：本地队尾、全局队首、其他线程队首。
+                 *          没有待执行的截止时间任务时跳过截止时间任务堆，不逐个加锁
+                 * @param index 工作线程下标，非工作线程传入工作线程数
+                 * @param task 获取的任务
+                 * @return bool 是否获取到任务
+                 */
+                bool try_take(std::size_t index, Task& task)
+                {
+                    Clock::time_point deadline;
+                    while (m_is_deadline_mode && m_deadline_pending_count.load(std::memory_order_relaxed) > 0
+                        && try_take_deadline(index, task, deadline))
+                    {
+                        if (!check_deadline(deadline))
+                        {
+                            on_task_taken();
+                            return true;
+                        }
+                        if (m_options.deadline_miss_policy == DeadlineMissPolicy::Drop)
+                        {
+                            task.reset();
+                            on_task_taken();
+                            continue;
+                        }
+                        // 降级：仍计入待执行任务数，移入普通队列
+                        if (index < m_workers.size())
+                        {
+                            Worker& worker = *m_workers[index];
+                            std::lock_guard<std::mutex> lock(worker.mutex);
+                            worker.tasks.push_back(std::move(task));
+                        }
+                        else
+                        {
+                            std::lock_guard<std::mutex> lock(m_global_mutex);
+                            m_global_tasks.push_back(std::move(task));
+                        }
+                    }
+                    bool is_taken = false;
+                    if (index < m_workers.size())
+                    {
+                        Worker& worker = *m_workers[index];
+                        std::lock_guard<std::mutex> lock(worker.mutex);
+                        is_taken = worker.tasks.pop_back(task);
+                    }
+                    if (!is_taken)
+                    {
+                        std::lock_guard<std::mutex> lock(m_global_mutex);
+                        is_taken = m_global_tasks.pop_front(task);
+                    }
+                    for (std::size_t i = 1; !is_taken && i <= m_workers.size(); ++i)
+                    {
+                        std::size_t victim_index = (index + i) % m_workers.size();
+                        if (victim_index == index)
+                        {
+                            continue;
+                        }
+                        Worker& victim = *m_workers[victim_index];
+                        std::lock_guard<std::mutex> lock(victim.mutex);
+                        is_taken = victim.tasks.pop_front(task);
+                    }
+                    if (is_taken)
+                    {
+                        on_task_taken();
+                    }
+                    return is_taken;
+                }
+                /**
+                 * @brief 任务出队后更新计数
+                 */
+                void on_task_taken()
+                {
+                    m_pending_count.fetch_sub(1, std::memory_order_relaxed);
+                    if (m_is_elastic)
+                    {
+                        m_last_take_time.store(Clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+                    }
+                }
+                /**
+                 * @brief 截止时间任务入堆
+                 * @param heap 任务堆
+                 * @param entry 任务
+                 */
+                static void push_deadline_task(std::vector<DeadlineTask>& heap, DeadlineTask entry)
+                {
+                    heap.push_back(std::move(entry));
+                    std::push_heap(heap.begin(), heap.end(), DeadlineLater{});
+                }
+                /**
+                 * @brief 弹出堆顶的截止时间任务
+                 * @note 在持有该堆所属的锁时调用
+                 * @param heap 非空任务堆
+                 * @param task 弹出的任务
+                 * @param deadline 弹出任务的截止时间
+                 */
+                void pop_deadline_task(std::vector<DeadlineTask>& heap, Task& task, Clock::time_point& deadline)
+                {
+                    std::pop_heap(heap.begin(), heap.end(), DeadlineLater{});
+                    task = std::move(heap.back().task);
+                    deadline = heap.back().deadline;
+                    heap.pop_back();
+                    m_deadline_pending_count.fetch_sub(1, std::memory_order_relaxed);
+                }
+                /**
+                 * @brief 获取截止时间最早的任务
+                 * @details 比较本地堆与全局堆的堆顶取较早者；两者都为空时从堆顶最早的其他线程窃取。
+                 *          各堆分别加锁读取，并发投递下结果为近似的全局最早
+                 * @param index 工作线程下标，非工作线程传入工作线程数
+                 * @param task 获取的任务
+                 * @param deadline 获取任务的截止时间
+                 * @return bool 是否获取到任务
+                 */
+                bool try_take_deadline(std::size_t index, Task& task, Clock::time_point& deadline)
+                {
+                    bool has_local = false;
+                    Clock::time_point local_deadline;
+                    if (index < m_workers.size())
+                    {
+                        Worker& worker = *m_workers[index];
+                        std::lock_guard<std::mutex> lock(worker.mutex);
+                        if (!worker.deadline_tasks.empty())
+                        {
+                            has_local = true;
+                            local_deadline = worker.deadline_tasks.front().deadline;
+                        }
+                    }
+                    {
+                        std::lock_guard<std::mutex> lock(m_global_mutex);
+                        if (!m_global_deadline_tasks.empty() &&
+                            (!has_local || m_global_deadline_tasks.front().deadline < local_deadline))
+                        {
+                            pop_deadline_task(m_global_deadline_tasks, task, deadline);
+                            return true;
+                        }
+                    }
+                    if (has_local)
+                    {
+                        // 两次加锁之间本地任务可能已被窃取
+                        Worker& worker = *m_workers[index];
+                        std::lock_guard<std::mutex> lock(worker.mutex);
+                        if (!worker.deadline_tasks.empty())
+                        {
+                            pop_deadline_task(worker.deadline_tasks, task, deadline);
+                            return true;
+                        }
+                    }
+                    // 多次尝试，窃取期间被选中的堆可能被取空
+                    for (int attempt = 0; attempt < 2; ++attempt)
+                    {
+                        std::size_t victim_index = m_workers.size();
+                        Clock::time_point victim_deadline;
+                        for (std::size_t i = 0; i < m_workers.size(); ++i)
+                        {
+                            if (i == index)
+                            {
+                                continue;
+                            }
+                            Worker& victim = *m_workers[i];
+                            std::lock_guard<std::mutex> lock(victim.mutex);
+                            if (!victim.deadline_tasks.empty() &&
+                                (victim_index == m_workers.size() || victim.deadline_tasks.front().deadline < victim_deadline))
+                            {
+                                victim_index = i;
+                                victim_deadline = victim.deadline_tasks.front().deadline;
+                            }
+                        }
+                        if (victim_index == m_workers.size())
+                        {
+                            return false;
+                        }
+                        Worker& victim = *m_workers[victim_index];
+                        std::lock_guard<std::mutex> lock(victim.mutex);
+                        if (!victim.deadline_tasks.empty())
+                        {
+                            pop_deadline_task(victim.deadline_tasks, task, deadline);
+                            return true;
+                        }
+                    }
+                    return false;
+                }
+                /**
+                 * @brief 截止时间任务出队时检查是否超时
+                 * @details 统计出队与超时次数，超时时调用超时回调
+                 * @param deadline 截止时间
+                 * @return bool 是否已超时
+                 */
+                bool check_deadline(Clock::time_point deadline)
+                {
+                    m_deadline_task_count.fetch_add(1, std::memory_order_relaxed);
+                    Clock::time_point now = Clock::now();
+                    if (now <= deadline)
+                    {
+                        return false;
+                    }
+                    m_deadline_miss_count.fetch_add(1, std::memory_order_relaxed);
+                    DeadlineMissPolicy policy = m_options.deadline_miss_policy;
+                    if (policy == DeadlineMissPolicy::Drop)
+                    {
+                        m_deadline_drop_count.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    else
+                    {
+                        m_deadline_deprioritize_count.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    if (m_options.on_deadline_miss)
+                    {
+                        try
+                        {
+                            m_options.on_deadline_miss(DeadlineMiss{ deadline, now, policy });
+                        }
+                        catch (...)
+                        {
+                        }
+                    }
+                    return true;
+                }
+                /**
+                 * @brief 构造提交任务及其结果
+                 * @note 任务与结果状态位于同一池化帧
+                 * @tparam F 可调用对象类型
+                 * @tparam Args 参数类型
+                 * @param task 输出的任务
+                 * @param func 可调用对象
+                 * @param args 参数
+                 * @return Future<R> 结果
+                 */
+                template<class F, class... Args>
+                static auto make_future_task(Task& task, F&& func, Args&&... args)
+                {
+                    using Result = std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>;
+                    auto bound = [func = std::forward<F>(func), ...args = std::forward<Args>(args)]() mutable -> Result
+                        {
+                            return std::invoke(std::move(func), std::move(args)...);
+                        };
+                    using State = Detail::CallableState<Result, decltype(bound)>;
+                    State* state = FramePool::create<State>(std::move(bound));
+                    state->add_ref();
+                    Future<Result> future = Detail::FutureAccess::make_future<Result>(state);
+                    task = Task(Detail::StateRunner<State>(state));
+                    return future;
+                }
+                /**
+                 * @brief 工作线程主循环
+                 * @param index 工作线程下标
+                 */
+                void worker_loop(std::size_t index)
+                {
+                    WorkerContext& context = get_worker_context();
+                    context.pool = this;
+                    context.index = index;
+                    Task task;
+                    while (true)
+                    {
+                        if (try_take(index, task))
+                        {
+                            run_task(task);
+                            continue;
+                        }
+                        std::unique_lock<std::mutex> lock(m_wait_mutex);
+                        auto is_ready = [this]()
+                            {
+                                return m_pending_count.load(std::memory_order_acquire) > 0 || !m_is_running.load();
+                            };
+                        if (!m_is_elastic)
+                        {
+                            m_wait_cv.wait(lock, is_ready);
+                        }
+                        else if (!m_wait_cv.wait_for(lock, m_options.idle_timeout, is_ready))
+                        {
+                            lock.unlock();
+                            if (try_retire(index))
+                            {
+                                break;
+                            }
+                            continue;
+                        }
+                        if (m_pending_count.load(std::memory_order_acquire) == 0 && !m_is_running.load())
+                        {
+                            break;
+                        }
+                    }
+                    context.pool = nullptr;
+                }
+                /**
+                 * @brief 在空闲槽位启动工作线程（需持有 m_resize_mutex）
+                 * @param index 槽位下标
+                 */
+                void start_worker_locked(std::size_t index)
+                {
+                    Worker& worker = *m_workers[index];
+                    if (worker.thread.joinable())
+                    {
+                        // 槽位上已退出的线程
+                        worker.thread.join();
+                    }
+                    worker.is_alive = true;
+                    worker.thread = std::thread(&ThreadPool::worker_loop, this, index);
+                    std::size_t thread_count = m_thread_count.fetch_add(1, std::memory_order_relaxed) + 1;
+                    if (thread_count > m_peak_thread_count.load(std::memory_order_relaxed))
+                    {
+                        m_peak_thread_count.store(thread_count, std::memory_order_relaxed);
+                    }
+                }
+                /**
+                 * @brief 增加一个工作线程（需持有 m_resize_mutex）
+                 * @return bool 是否增加；已达上限或已关闭时返回 false
+                 */
+                bool try_grow_locked()
+                {
+                    if (!m_is_running.load() || m_thread_count.load(std::memory_order_relaxed) >= m_options.max_thread_count)
+                    {
+                        return false;
+                    }
+                    for (std::size_t i = 0; i < m_workers.size(); ++i)
+                    {
+                        if (!m_workers[i]->is_alive)
+                        {
+                            start_worker_locked(i);
+                            m_last_grow_time = Clock::now();
+                            m_next_grow_time = m_last_grow_time + m_options.grow_cooldown;
+                            return true;
+                        }
+                    }
+                    return false;
+                }
+                /**
+                 * @brief 空闲超时的工作线程尝试退出
+                 * @details 有效线程数须多于最少线程数，且距上次扩容已过空闲超时，避免刚扩容即收缩
+                 * @param index 工作线程下标
+                 * @return bool 是否退出
+                 */
+                bool try_retire(std::size_t index)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(m_resize_mutex);
+                        std::size_t active_count = m_thread_count.load(std::memory_order_relaxed) - m_blocked_count.load(std::memory_order_relaxed);
+                        if (!m_is_running.load() || active_count <= m_options.min_thread_count
+                            || Clock::now() - m_last_grow_time < m_options.idle_timeout)
+                        {
+                            return false;
+                        }
+                        m_workers[index]->is_alive = false;
+                        m_thread_count.fetch_sub(1, std::memory_order_relaxed);
+                        m_shrink_count.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    if (m_pending_count.load(std::memory_order_acquire) > 0)
+                    {
+                        // 超时后到达的任务可能只唤醒了本线程
+                        std::lock_guard<std::mutex> lock(m_wait_mutex);
+                        m_wait_cv.notify_one();
+                    }
+                    return true;
+                }
+                /**
+                 * @brief 采样线程主循环
+                 * @details 每个采样间隔至多增加一个线程，距上次扩容不足 grow_cooldown 时不扩容
+                 */
+                void monitor_loop()
+                {
+                    std::unique_lock<std::mutex> lock(m_resize_mutex);
+                    while (m_is_running.load())
+                    {
+                        m_monitor_cv.wait_for(lock, m_options.sample_interval, [this]()
+                            {
+                                return !m_is_running.load();
+                            });
+                        std::size_t pending_count = m_pending_count.load(std::memory_order_relaxed);
+                        if (!m_is_running.load() || pending_count == 0 || Clock::now() < m_next_grow_time)
+                        {
+                            continue;
+                        }
+                        Clock::duration wait_time = Clock::now().time_since_epoch() - Clock::duration(m_last_take_time.load(std::memory_order_relaxed));
+                        if (pending_count >= m_options.grow_queue_depth)
+                        {
+                            if (try_grow_locked())
+                            {
+                                m_queue_depth_grow_count.fetch_add(1, std::memory_order_relaxed);
+                            }
+                        }
+                        else if (wait_time >= m_options.grow_wait_time)
+                        {
+                            if (try_grow_locked())
+                            {
+                                m_wait_time_grow_count.fetch_add(1, std::memory_order_relaxed);
+                            }
+                        }
+                    }
+                }
+                /**
+                 * @brief 执行任务
+                 * @note 直接投递的任务抛出的异常被忽略；需要结果或异常时使用 submit()
+                 * @param task 任务
+                 */
+                static void run_task(Task& task)
+                {
+                    try
+                    {
+                        task();
+                    }
+                    catch (...)
+                    {
+                    }
+                    task.reset();
+                }
+            private:
+                /// @brief 配置
+                ThreadPoolOptions m_options;
+                /// @brief 是否启用弹性伸缩
+                bool m_is_elastic = false;
+                /// @brief 是否为截止时间调度模式
+                bool m_is_deadline_mode = false;
+                /// @brief 工作线程槽位，数量为 max_thread_count
+                std::vector<std::unique_ptr<Worker>> m_workers;
+                /// @brief 全局队列互斥锁
+                std::mutex m_global_mutex;
+                /// @brief 全局队列
+                TaskRing m_global_tasks;
+                /// @brief 全局截止时间任务堆，由 m_global_mutex 保护
+                std::vector<DeadlineTask> m_global_deadline_tasks;
+                /// @brief 截止时间任务投递序号
+                std::atomic<std::uint64_t> m_deadline_sequence = 0;
+                /// @brief 各截止时间任务堆中的任务总数，为0时出队跳过截止时间任务堆
+                std::atomic<std::size_t> m_deadline_pending_count = 0;
+                /// @brief 等待互斥锁
+                std::mutex m_wait_mutex;
+                /// @brief 等待条件变量
+                std::condition_variable m_wait_cv;
+                /// @brief 待执行任务数
+                std::atomic<std::size_t> m_pending_count = 0;
+                /// @brief 是否正在运行
+                std::atomic<bool> m_is_running = true;
+                /// @brief 伸缩互斥锁，保护槽位存活状态与线程启动
+                std::mutex m_resize_mutex;
+                /// @brief 采样线程条件变量
+                std::condition_variable m_monitor_cv;
+                /// @brief 采样线程
+                std::thread m_monitor;
+                /// @brief 上次扩容时间
+                Clock::time_point m_last_grow_time = Clock::now();
+                /// @brief 采样线程允许再次扩容的时间，由 m_resize_mutex 保护
+                Clock::time_point m_next_grow_time = Clock::time_point::min();
+                /// @brief 上次取出任务（或队列变为非空）的时间
+                std::atomic<Clock::rep> m_last_take_time = Clock::now().time_since_epoch().count();
+                /// @brief 当前线程数
+                std::atomic<std::size_t> m_thread_count = 0;
+                /// @brief 历史最多线程数
+                std::atomic<std::size_t> m_peak_thread_count = 0;
+                /// @brief 受管阻塞中的线程数
+                std::atomic<std::size_t> m_blocked_count = 0;
+                /// @brief 因队列深度扩容次数
+                std::atomic<std::uint64_t> m_queue_depth_grow_count = 0;
+                /// @brief 因等待时间扩容次数
+                std::atomic<std::uint64_t> m_wait_time_grow_count = 0;
+                /// @brief 补偿扩容次数
+                std::atomic<std::uint64_t> m_compensation_count = 0;
+                /// @brief 空闲退出次数
+                std::atomic<std::uint64_t> m_shrink_count = 0;
+                /// @brief 已出队的截止时间任务数
+                std::atomic<std::uint64_t> m_deadline_task_count = 0;
+                /// @brief 超时任务数
+                std::atomic<std::uint64_t> m_deadline_miss_count = 0;
+                /// @brief 因超时丢弃的任务数
+                std::atomic<std::uint64_t> m_deadline_drop_count = 0;
+                /// @brief 因超时降级的任务数
+                std::atomic<std::uint64_t> m_deadline_deprioritize_count = 0;
             };
         }
     }
-}
\ No newline at end of file
+}
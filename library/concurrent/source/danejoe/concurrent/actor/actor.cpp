@@ -0,0 +1 @@
+#include "danejoe/concurrent/actor/actor.hpp"
\ No newline at end of file
@@ -0,0 +1 @@
+#include "danejoe/concurrent/algorithm/fork_join.hpp"
\ No newline at end of file
@@ -0,0 +1 @@
+#include "danejoe/concurrent/algorithm/parallel_merge.hpp"
\ No newline at end of file
@@ -0,0 +1 @@
+#include "danejoe/concurrent/algorithm/parallel_sort.hpp"
\ No newline at end of file
@@ -0,0 +1 @@
+#include "danejoe/concurrent/algorithm/pipeline.hpp"
\ No newline at end of file
@@ -0,0 +1 @@
+#include "danejoe/concurrent/blocking/queue_selector.hpp"
\ No newline at end of file
@@ -0,0 +1 @@
+#include "danejoe/concurrent/blocking/select_notifier.hpp"
\ No newline at end of file
@@ -0,0 +1 @@
+#include "danejoe/concurrent/blocking/spill_queue.hpp"
\ No newline at end of file
@@ -0,0 +1 @@
+#include "danejoe/concurrent/cache/concurrent_lru_cache.hpp"
\ No newline at end of file
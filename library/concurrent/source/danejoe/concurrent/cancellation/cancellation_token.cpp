@@ -0,0 +1 @@
+#include "danejoe/concurrent/cancellation/cancellation_token.hpp"
\ No newline at end of file
@@ -0,0 +1 @@
+#include "danejoe/concurrent/coroutine/async_event.hpp"
\ No newline at end of file
@@ -0,0 +1 @@
+#include "danejoe/concurrent/coroutine/async_latch.hpp"
\ No newline at end of file
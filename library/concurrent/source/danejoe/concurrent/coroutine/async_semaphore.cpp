@@ -0,0 +1 @@
+#include "danejoe/concurrent/coroutine/async_semaphore.hpp"
\ No newline at end of file
@@ -0,0 +1 @@
+#include "danejoe/concurrent/coroutine/co_task.hpp"
\ No newline at end of file
@@ -0,0 +1 @@
+#include "danejoe/concurrent/event_bus/event_bus.hpp"
\ No newline at end of file
@@ -0,0 +1 @@
+#include "danejoe/concurrent/event_bus/topic.hpp"
\ No newline at end of file
@@ -0,0 +1 @@
+#include "danejoe/concurrent/lock_free/byte_ring.hpp"
\ No newline at end of file
@@ -0,0 +1 @@
+#include "danejoe/concurrent/lock_free/concurrent_skip_list_map.hpp"
\ No newline at end of file
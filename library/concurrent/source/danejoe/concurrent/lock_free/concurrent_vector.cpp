@@ -0,0 +1 @@
+#include "danejoe/concurrent/lock_free/concurrent_vector.hpp"
\ No newline at end of file
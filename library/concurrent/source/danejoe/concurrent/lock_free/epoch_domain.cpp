@@ -0,0 +1 @@
+#include "danejoe/concurrent/lock_free/epoch_domain.hpp"
\ No newline at end of file
@@ -0,0 +1 @@
+#include "danejoe/concurrent/lock_free/latest_value.hpp"
\ No newline at end of file
@@ -0,0 +1 @@
+#include "danejoe/concurrent/lock_free/mpsc_queue.hpp"
\ No newline at end of file
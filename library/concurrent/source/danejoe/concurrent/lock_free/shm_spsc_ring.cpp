@@ -0,0 +1 @@
+#include "danejoe/concurrent/lock_free/shm_spsc_ring.hpp"
\ No newline at end of file
@@ -0,0 +1 @@
+#include "danejoe/concurrent/lock_free/slot_map.hpp"
\ No newline at end of file
@@ -0,0 +1 @@
+#include "danejoe/concurrent/lock_free/triple_buffer.hpp"
\ No newline at end of file
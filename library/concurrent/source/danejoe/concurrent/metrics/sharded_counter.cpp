@@ -0,0 +1 @@
+#include "danejoe/concurrent/metrics/sharded_counter.hpp"
\ No newline at end of file
@@ -0,0 +1 @@
+#include "danejoe/concurrent/metrics/sharded_histogram.hpp"
\ No newline at end of file
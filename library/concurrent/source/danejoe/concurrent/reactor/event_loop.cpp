@@ -0,0 +1 @@
+#include "danejoe/concurrent/reactor/event_loop.hpp"
\ No newline at end of file
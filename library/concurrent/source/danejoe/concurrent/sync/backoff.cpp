@@ -0,0 +1 @@
+#include "danejoe/concurrent/sync/backoff.hpp"
\ No newline at end of file
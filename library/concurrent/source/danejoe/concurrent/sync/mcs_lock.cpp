@@ -0,0 +1 @@
+#include "danejoe/concurrent/sync/mcs_lock.hpp"
\ No newline at end of file
@@ -0,0 +1 @@
+#include "danejoe/concurrent/sync/spin_lock.hpp"
\ No newline at end of file
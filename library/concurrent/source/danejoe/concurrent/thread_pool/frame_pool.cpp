@@ -0,0 +1 @@
+#include "danejoe/concurrent/thread_pool/frame_pool.hpp"
\ No newline at end of file
@@ -0,0 +1 @@
+#include "danejoe/concurrent/thread_pool/future.hpp"
\ No newline at end of file
@@ -0,0 +1 @@
+#include "danejoe/concurrent/thread_pool/strand.hpp"
\ No newline at end of file
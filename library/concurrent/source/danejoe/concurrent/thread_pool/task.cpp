@@ -0,0 +1 @@
+#include "danejoe/concurrent/thread_pool/task.hpp"
\ No newline at end of file
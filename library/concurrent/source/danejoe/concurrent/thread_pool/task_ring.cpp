@@ -0,0 +1 @@
+#include "danejoe/concurrent/thread_pool/task_ring.hpp"
\ No newline at end of file
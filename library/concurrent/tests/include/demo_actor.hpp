@@ -0,0 +1,7 @@
+#pragma once
+
+namespace demo {
+
+void run_actor_demo();
+
+} // namespace demo
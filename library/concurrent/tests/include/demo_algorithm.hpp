@@ -0,0 +1,7 @@
+#pragma once
+
+namespace demo {
+
+void run_algorithm_demo();
+
+} // namespace demo
@@ -0,0 +1,7 @@
+#pragma once
+
+namespace demo {
+
+void run_event_bus_demo();
+
+} // namespace demo
@@ -0,0 +1,7 @@
+#pragma once
+
+namespace demo {
+
+void run_lock_free_demo();
+
+} // namespace demo
@@ -0,0 +1,7 @@
+#pragma once
+
+namespace demo {
+
+void run_thread_pool_demo();
+
+} // namespace demo
@@ -0,0 +1,205 @@
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "danejoe/concurrent/thread_pool/thread_pool.hpp"
+#include "danejoe/concurrent/lock_free/mpsc_queue.hpp"
+#include "danejoe/concurrent/actor/actor.hpp"
+#include "demo_actor.hpp"
+
+using DaneJoe::Concurrent::Actor::Actor;
+using DaneJoe::Concurrent::Actor::ActorBase;
+using DaneJoe::Concurrent::Actor::ActorRef;
+using DaneJoe::Concurrent::Actor::ActorSystem;
+using DaneJoe::Concurrent::Actor::FailureAction;
+using DaneJoe::Concurrent::LockFree::MpscQueue;
+using DaneJoe::Concurrent::ThreadPool::ThreadPool;
+
+namespace demo {
+
+/**
+ * @brief 按发送者检查消息顺序的计数 Actor
+ */
+class CounterActor : public Actor<int>
+{
+public:
+    explicit CounterActor(std::atomic<int>& total) :m_total(total) {}
+    int get_count()const { return m_count; }
+protected:
+    void receive(int& message)override
+    {
+        if (message < 0)
+        {
+            throw std::runtime_error("negative");
+        }
+        // 同一发送者的消息单调递增
+        assert(message / 1000 >= 4 || message % 1000 > m_last[message / 1000]);
+        if (message / 1000 < 4)
+        {
+            m_last[message / 1000] = message % 1000;
+        }
+        ++m_count;
+        m_total.fetch_add(1);
+    }
+private:
+    std::atomic<int>& m_total;
+    int m_count = 0;
+    int m_last[4] = { -1, -1, -1, -1 };
+};
+
+static void wait_for(const std::atomic<int>& value, int expected)
+{
+    while (value.load() < expected)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+static void test_mpsc_queue()
+{
+    MpscQueue<int> queue;
+    assert(queue.empty());
+    assert(!queue.try_pop());
+    constexpr int PER_THREAD = 20000;
+    std::vector<std::thread> producers;
+    for (int t = 0; t < 4; ++t)
+    {
+        producers.emplace_back([&queue, t]()
+            {
+                for (int i = 0; i < PER_THREAD; ++i)
+                {
+                    queue.push(t * PER_THREAD + i);
+                }
+            });
+    }
+    std::vector<int> last(4, -1);
+    int popped = 0;
+    while (popped < 4 * PER_THREAD)
+    {
+        auto value = queue.try_pop();
+        if (!value)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        int producer = *value / PER_THREAD;
+        assert(*value % PER_THREAD > last[producer]);
+        last[producer] = *value % PER_THREAD;
+        ++popped;
+    }
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+    assert(queue.empty());
+}
+
+static void test_many_actors()
+{
+    ThreadPool pool(4);
+    ActorSystem system(pool, 16);
+    std::atomic<int> total = 0;
+    constexpr int ACTOR_COUNT = 5000;
+    std::vector<ActorRef<int>> actors;
+    for (int i = 0; i < ACTOR_COUNT; ++i)
+    {
+        actors.push_back(system.spawn<CounterActor>(total));
+    }
+    assert(system.get_actor_count() == ACTOR_COUNT);
+    // 空闲 Actor 的对象本身（不含 shared_ptr 控制块）远小于 256 字节
+    static_assert(sizeof(CounterActor) + 2 * sizeof(void*) < 256);
+
+    std::vector<std::thread> senders;
+    for (int t = 0; t < 4; ++t)
+    {
+        senders.emplace_back([&actors, t]()
+            {
+                for (int i = 0; i < 20; ++i)
+                {
+                    for (auto& actor : actors)
+                    {
+                        actor.tell(t * 1000 + i);
+                    }
+                }
+            });
+    }
+    for (auto& sender : senders)
+    {
+        sender.join();
+    }
+    wait_for(total, 4 * 20 * ACTOR_COUNT);
+    for (auto& actor : actors)
+    {
+        while (actor.get_mailbox_size() != 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+    actors.clear();
+    pool.shutdown();
+    assert(system.get_actor_count() == 0);
+}
+
+static void test_failure_handling()
+{
+    ThreadPool pool(2);
+    ActorSystem system(pool);
+    std::atomic<int> total = 0;
+    std::atomic<int> failures = 0;
+
+    // 未设置处理函数时默认停止
+    ActorRef<int> stopping = system.spawn<CounterActor>(total);
+    stopping.tell(-1);
+    while (!stopping.is_stopped())
+    {
+        std::this_thread::yield();
+    }
+    assert(!stopping.tell(4000));
+
+    system.set_failure_handler([&](ActorBase&, std::exception_ptr)
+        {
+            ++failures;
+            return FailureAction::Resume;
+        });
+    ActorRef<int> resuming = system.spawn<CounterActor>(total);
+    resuming.tell(-1);
+    resuming.tell(4001);
+    wait_for(total, 1);
+    assert(failures.load() == 1);
+    assert(!resuming.is_stopped());
+    assert(system.get_failure_count() == 2);
+    pool.shutdown();
+}
+
+static void test_actor_outlives_system()
+{
+    ThreadPool pool(2);
+    std::atomic<int> total = 0;
+    std::optional<ActorRef<int>> actor;
+    {
+        ActorSystem system(pool);
+        actor = system.spawn<CounterActor>(total);
+    }
+    // 系统销毁后 Actor 仍可投递与释放
+    actor->tell(4000);
+    wait_for(total, 1);
+    actor.reset();
+    pool.shutdown();
+}
+
+void run_actor_demo()
+{
+    std::cout << "Actor demo:\n";
+    test_mpsc_queue();
+    test_many_actors();
+    test_failure_handling();
+    test_actor_outlives_system();
+    std::cout << "  mpsc queue, actor scheduling and failure handling ok\n";
+}
+
+} // namespace demo
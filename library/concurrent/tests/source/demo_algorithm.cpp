@@ -0,0 +1,349 @@
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <ctime>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <algorithm>
+
+#include "danejoe/concurrent/thread_pool/thread_pool.hpp"
+#include "danejoe/concurrent/algorithm/fork_join.hpp"
+#include "danejoe/concurrent/algorithm/parallel_merge.hpp"
+#include "danejoe/concurrent/algorithm/parallel_sort.hpp"
+#include "danejoe/concurrent/algorithm/pipeline.hpp"
+#include "demo_algorithm.hpp"
+
+using DaneJoe::Concurrent::Algorithm::fork_join;
+using DaneJoe::Concurrent::Algorithm::parallel_merge;
+using DaneJoe::Concurrent::Algorithm::parallel_sort;
+using DaneJoe::Concurrent::Algorithm::parallel_stable_sort;
+using DaneJoe::Concurrent::Algorithm::Pipeline;
+using DaneJoe::Concurrent::Algorithm::PipelineBuilder;
+using DaneJoe::Concurrent::Algorithm::StageMode;
+using DaneJoe::Concurrent::Algorithm::StageStats;
+using DaneJoe::Concurrent::ThreadPool::ThreadPool;
+
+namespace demo {
+
+static std::vector<int> make_random(std::size_t size, int max_value)
+{
+    std::mt19937 engine(42);
+    std::uniform_int_distribution<int> distribution(0, max_value);
+    std::vector<int> values(size);
+    for (auto& value : values)
+    {
+        value = distribution(engine);
+    }
+    return values;
+}
+
+static long long fibonacci(ThreadPool& pool, int n)
+{
+    if (n < 12)
+    {
+        return n < 2 ? n : fibonacci(pool, n - 1) + fibonacci(pool, n - 2);
+    }
+    long long left = 0;
+    long long right = 0;
+    fork_join(pool,
+        [&]() { left = fibonacci(pool, n - 1); },
+        [&]() { right = fibonacci(pool, n - 2); });
+    return left + right;
+}
+
+static void test_fork_join()
+{
+    ThreadPool pool(4);
+    assert(fibonacci(pool, 24) == 46368);
+
+    bool is_thrown = false;
+    try
+    {
+        fork_join(pool, []() { throw std::runtime_error("left"); }, []() {});
+    }
+    catch (const std::runtime_error&)
+    {
+        is_thrown = true;
+    }
+    assert(is_thrown);
+}
+
+static void test_parallel_sort()
+{
+    ThreadPool pool(4);
+    // 大量重复值覆盖三路划分
+    for (int max_value : { 3, 1000, 1 << 30 })
+    {
+        auto values = make_random(100000, max_value);
+        auto expected = values;
+        std::sort(expected.begin(), expected.end());
+        parallel_sort(pool, values.begin(), values.end(), std::less<>(), 1024);
+        assert(values == expected);
+    }
+
+    auto descending = make_random(50000, 1 << 20);
+    parallel_sort(pool, descending.begin(), descending.end(), std::greater<>(), 512);
+    assert(std::is_sorted(descending.begin(), descending.end(), std::greater<>()));
+
+    std::vector<int> small = { 3, 1, 2 };
+    parallel_sort(pool, small.begin(), small.end());
+    assert((small == std::vector<int>{ 1, 2, 3 }));
+}
+
+static void test_parallel_sort_adversarial()
+{
+    ThreadPool pool(4);
+    constexpr int size = 100000;
+    // McIlroy 对抗比较器：值在比较时才确定，使每次三数取中都选出最差枢轴；
+    // 比较由锁串行化，划分后的子区间互不相交，生成的输入与并发交错无关
+    std::vector<int> values(size, size);
+    int solid_count = 0;
+    int candidate = -1;
+    std::mutex mutex;
+    auto adversary = [&](int left, int right)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (values[left] == size && values[right] == size)
+            {
+                values[left == candidate ? left : right] = solid_count++;
+            }
+            if (values[left] == size)
+            {
+                candidate = left;
+            }
+            else if (values[right] == size)
+            {
+                candidate = right;
+            }
+            return values[left] < values[right];
+        };
+    std::vector<int> indices(size);
+    for (int i = 0; i < size; ++i)
+    {
+        indices[i] = i;
+    }
+    parallel_sort(pool, indices.begin(), indices.end(), adversary, 64);
+    for (auto& value : values)
+    {
+        if (value == size)
+        {
+            value = solid_count++;
+        }
+    }
+    // 没有深度上限时递归深度与 n 同阶（栈溢出），比较次数为平方级
+    std::atomic<long long> compare_count = 0;
+    parallel_sort(pool, values.begin(), values.end(), [&compare_count](int left, int right)
+        {
+            compare_count.fetch_add(1, std::memory_order_relaxed);
+            return left < right;
+        }, 64);
+    assert(std::is_sorted(values.begin(), values.end()));
+    assert(compare_count.load() < 20LL * size * 17);
+}
+
+static void test_parallel_stable_sort()
+{
+    ThreadPool pool(4);
+    // 键有大量重复，第二分量记录原始位置以检验稳定性
+    auto keys = make_random(100000, 50);
+    std::vector<std::pair<int, int>> values(keys.size());
+    for (std::size_t i = 0; i < keys.size(); ++i)
+    {
+        values[i] = { keys[i], static_cast<int>(i) };
+    }
+    auto by_key = [](const auto& left, const auto& right) { return left.first < right.first; };
+    auto expected = values;
+    std::stable_sort(expected.begin(), expected.end(), by_key);
+    parallel_stable_sort(pool, values.begin(), values.end(), by_key, 1000);
+    assert(values == expected);
+
+    // 元素类型不可默认构造
+    struct Record
+    {
+        explicit Record(int key, int index) : key(key), index(index) {}
+        int key;
+        int index;
+    };
+    std::vector<Record> records;
+    for (std::size_t i = 0; i < keys.size(); ++i)
+    {
+        records.emplace_back(keys[i], static_cast<int>(i));
+    }
+    parallel_stable_sort(pool, records.begin(), records.end(), [](const Record& left, const Record& right) { return left.key < right.key; }, 1000);
+    for (std::size_t i = 0; i < records.size(); ++i)
+    {
+        assert(records[i].key == expected[i].first && records[i].index == expected[i].second);
+    }
+}
+
+static void test_parallel_merge()
+{
+    ThreadPool pool(4);
+    auto first = make_random(30000, 100);
+    auto second = make_random(70000, 100);
+    std::sort(first.begin(), first.end());
+    std::sort(second.begin(), second.end());
+    std::vector<int> expected(first.size() + second.size());
+    std::merge(first.begin(), first.end(), second.begin(), second.end(), expected.begin());
+    std::vector<int> merged(first.size() + second.size());
+    auto end = parallel_merge(pool, first.begin(), first.end(), second.begin(), second.end(), merged.begin(), std::less<>(), 256);
+    assert(end == merged.end());
+    assert(merged == expected);
+}
+
+static void test_pipeline_order_and_tokens()
+{
+    constexpr int item_count = 2000;
+    constexpr std::size_t max_tokens = 8;
+    int next = 0;
+    std::atomic<int> in_flight{ 0 };
+    std::atomic<int> peak_in_flight{ 0 };
+    std::vector<std::string> written;
+    Pipeline pipeline = PipelineBuilder(max_tokens)
+        .add_source("decode", [&]() -> std::optional<int>
+            {
+                if (next == item_count)
+                {
+                    return std::nullopt;
+                }
+                int current = in_flight.fetch_add(1) + 1;
+                int peak = peak_in_flight.load();
+                while (current > peak && !peak_in_flight.compare_exchange_weak(peak, current))
+                {
+                }
+                return next++;
+            })
+        .add_stage("enrich", StageMode::Parallel, [](int value) { return static_cast<long>(value) * value; }, 3)
+        .add_stage("serialize", StageMode::Parallel, [](long value) { return std::to_string(value); }, 2)
+        .add_sink("write", StageMode::SerialInOrder, [&](std::string text)
+            {
+                written.push_back(std::move(text));
+                in_flight.fetch_sub(1);
+            });
+    assert(pipeline.get_stage_count() == 4);
+    pipeline.run();
+
+    assert(written.size() == static_cast<std::size_t>(item_count));
+    for (int i = 0; i < item_count; ++i)
+    {
+        assert(written[i] == std::to_string(static_cast<long>(i) * i));
+    }
+    assert(peak_in_flight.load() <= static_cast<int>(max_tokens));
+
+    std::vector<StageStats> stats = pipeline.get_stats();
+    assert(stats.size() == 4);
+    assert(stats[0].name == "decode" && stats[0].concurrency == 1);
+    assert(stats[1].mode == StageMode::Parallel && stats[1].concurrency == 3);
+    for (const auto& stage : stats)
+    {
+        assert(stage.item_count == static_cast<std::uint64_t>(item_count));
+    }
+
+    // 再次运行：源已耗尽，立即结束
+    pipeline.run();
+    assert(written.size() == static_cast<std::size_t>(item_count));
+}
+
+static void test_pipeline_bottleneck()
+{
+    int next = 0;
+    int sum = 0;
+    Pipeline pipeline = PipelineBuilder(4)
+        .add_source("source", [&next]() -> std::optional<int>
+            {
+                return next < 40 ? std::optional<int>(next++) : std::nullopt;
+            })
+        .add_stage("slow", StageMode::SerialInOrder, [](int value)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                return value;
+            })
+        .add_sink("sink", StageMode::SerialInOrder, [&sum](int value) { sum += value; });
+    pipeline.run();
+    assert(sum == 39 * 40 / 2);
+    std::vector<StageStats> stats = pipeline.get_stats();
+    assert(stats[1].busy_time >= std::chrono::milliseconds(40));
+    assert(stats[1].busy_time > stats[2].busy_time);
+    assert(stats[2].idle_time > stats[2].busy_time);
+}
+
+static void test_pipeline_idle_parks()
+{
+    // 源每 20ms 产生一个令牌，其余工作线程大部分时间空闲，应休眠而非持续让出时间片
+    int next = 0;
+    int sum = 0;
+    Pipeline pipeline = PipelineBuilder(4)
+        .add_source("source", [&next]() -> std::optional<int>
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                return next < 5 ? std::optional<int>(next++) : std::nullopt;
+            })
+        .add_stage("square", StageMode::Parallel, [](int value) { return value * value; }, 4)
+        .add_sink("sink", StageMode::SerialInOrder, [&sum](int value) { sum += value; });
+    std::clock_t cpu_start = std::clock();
+    auto wall_start = std::chrono::steady_clock::now();
+    pipeline.run();
+    double cpu_seconds = static_cast<double>(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+    double wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+    assert(sum == 0 + 1 + 4 + 9 + 16);
+    // 空转时等待中的工作线程占满可用核心，CPU 时间不低于墙钟时间
+    assert(cpu_seconds < wall_seconds / 2);
+}
+
+static void test_pipeline_exception()
+{
+    int next = 0;
+    Pipeline pipeline = PipelineBuilder(4)
+        .add_source("source", [&next]() -> std::optional<int>
+            {
+                return next < 1000 ? std::optional<int>(next++) : std::nullopt;
+            })
+        .add_stage("check", StageMode::Parallel, [](int value)
+            {
+                if (value == 100)
+                {
+                    throw std::runtime_error("bad record");
+                }
+                return value;
+            }, 2)
+        .add_sink("sink", StageMode::SerialInOrder, [](int) {});
+    bool is_thrown = false;
+    try
+    {
+        pipeline.run();
+    }
+    catch (const std::runtime_error&)
+    {
+        is_thrown = true;
+    }
+    assert(is_thrown);
+
+    // 中止后残留的令牌被丢弃，可以继续运行
+    pipeline.run();
+    assert(next == 1000);
+}
+
+void run_algorithm_demo()
+{
+    std::cout << "Algorithm demo:\n";
+    test_fork_join();
+    test_parallel_sort();
+    test_parallel_sort_adversarial();
+    test_parallel_stable_sort();
+    test_parallel_merge();
+    std::cout << "  fork_join, parallel sort/stable sort/merge ok\n";
+    test_pipeline_order_and_tokens();
+    test_pipeline_bottleneck();
+    test_pipeline_idle_parks();
+    test_pipeline_exception();
+    std::cout << "  pipeline ok\n";
+}
+
+} // namespace demo
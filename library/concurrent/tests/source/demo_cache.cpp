@@ -0,0 +1,155 @@
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "danejoe/concurrent/cache/concurrent_lru_cache.hpp"
+#include "demo_cache.hpp"
+
+using DaneJoe::Concurrent::Cache::CacheStats;
+using DaneJoe::Concurrent::Cache::ConcurrentLruCache;
+
+namespace demo {
+
+/// 每个条目按 1 字节计，便于按条目数断言
+struct UnitSizer
+{
+    std::size_t operator()(int, const std::string&)const noexcept
+    {
+        return 1;
+    }
+};
+
+static void test_cache_basic()
+{
+    ConcurrentLruCache<std::string, std::string> cache(1 << 20, 4);
+    assert(cache.get_shard_count() == 4);
+    assert(cache.get("missing") == nullptr);
+
+    bool is_put = cache.put("select 1", "plan-1");
+    assert(is_put);
+    auto value = cache.get("select 1");
+    assert(value && *value == "plan-1");
+    cache.put("select 1", "plan-2");
+    assert(*cache.get("select 1") == "plan-2");
+    assert(*value == "plan-1");
+    assert(cache.size() == 1);
+
+    bool is_erased = cache.erase("select 1");
+    assert(is_erased);
+    assert(!cache.contains("select 1"));
+
+    CacheStats stats = cache.get_stats();
+    assert(stats.hit_count == 2);
+    assert(stats.miss_count == 1);
+    assert(stats.insert_count == 2);
+    assert(stats.entry_count == 0 && stats.bytes == 0);
+
+    int load_count = 0;
+    auto loaded = cache.get_or_load("select 2", [&load_count](const std::string& key)
+        {
+            ++load_count;
+            return key + "!";
+        });
+    assert(*loaded == "select 2!");
+    cache.get_or_load("select 2", [&load_count](const std::string&)
+        {
+            ++load_count;
+            return std::string();
+        });
+    assert(load_count == 1);
+
+    cache.clear();
+    assert(cache.size() == 0);
+    std::cout << "  basic ok\n";
+}
+
+static void test_cache_byte_accounting()
+{
+    ConcurrentLruCache<std::string, std::string> cache(1024, 1);
+    std::string large(2000, 'x');
+    bool is_put = cache.put("large", large);
+    assert(!is_put);
+    assert(cache.size() == 0);
+
+    std::string value(100, 'v');
+    for (int i = 0; i < 20; ++i)
+    {
+        cache.put("key" + std::to_string(i), value);
+    }
+    CacheStats stats = cache.get_stats();
+    assert(stats.bytes <= 1024);
+    assert(stats.eviction_count > 0);
+    assert(stats.entry_count + stats.eviction_count == 20);
+    std::cout << "  byte accounting ok\n";
+}
+
+static void test_cache_clock_eviction()
+{
+    ConcurrentLruCache<int, std::string, std::hash<int>, std::equal_to<int>, UnitSizer> cache(4, 1);
+    for (int i = 0; i < 4; ++i)
+    {
+        cache.put(i, std::to_string(i));
+    }
+    // 访问过的条目获得第二次机会，未访问的 2 先被淘汰
+    cache.get(0);
+    cache.get(1);
+    cache.get(3);
+    cache.put(4, "4");
+    assert(!cache.contains(2));
+    assert(cache.contains(0) && cache.contains(1) && cache.contains(3) && cache.contains(4));
+    assert(cache.get_stats().eviction_count == 1);
+    std::cout << "  clock eviction ok\n";
+}
+
+static void test_cache_concurrent()
+{
+    ConcurrentLruCache<int, std::string, std::hash<int>, std::equal_to<int>, UnitSizer> cache(256, 8);
+    constexpr int thread_count = 4;
+    constexpr int per_thread = 5000;
+    std::atomic<int> wrong{ 0 };
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thread_count; ++t)
+    {
+        threads.emplace_back([&cache, &wrong, t]()
+            {
+                for (int i = 0; i < per_thread; ++i)
+                {
+                    int key = (i * 7 + t) % 512;
+                    auto value = cache.get_or_load(key, [](int k) { return std::to_string(k); });
+                    if (*value != std::to_string(key))
+                    {
+                        wrong.fetch_add(1);
+                    }
+                    if (i % 97 == 0)
+                    {
+                        cache.erase(key);
+                    }
+                }
+            });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    assert(wrong.load() == 0);
+    CacheStats stats = cache.get_stats();
+    assert(stats.hit_count + stats.miss_count == thread_count * per_thread);
+    assert(stats.entry_count <= 256);
+    assert(stats.bytes == stats.entry_count);
+    std::cout << "  concurrent ok\n";
+}
+
+void run_cache_demo()
+{
+    std::cout << "Cache demo:\n";
+    test_cache_basic();
+    test_cache_byte_accounting();
+    test_cache_clock_eviction();
+    test_cache_concurrent();
+}
+
+} // namespace demo
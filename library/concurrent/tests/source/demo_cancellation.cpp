@@ -0,0 +1,195 @@
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "danejoe/concurrent/cancellation/cancellation_token.hpp"
+#include "danejoe/concurrent/blocking/mpmc_bounded_queue.hpp"
+#include "danejoe/concurrent/thread_pool/thread_pool.hpp"
+#include "danejoe/concurrent/coroutine/co_task.hpp"
+#include "danejoe/concurrent/coroutine/async_semaphore.hpp"
+#include "demo_cancellation.hpp"
+
+using namespace std::chrono_literals;
+using DaneJoe::Concurrent::Blocking::MpmcBoundedQueue;
+using DaneJoe::Concurrent::Cancellation::CancellationCallback;
+using DaneJoe::Concurrent::Cancellation::CancellationSource;
+using DaneJoe::Concurrent::Cancellation::CancellationToken;
+using DaneJoe::Concurrent::Cancellation::Clock;
+using DaneJoe::Concurrent::Cancellation::OperationCancelled;
+using DaneJoe::Concurrent::Coroutine::AsyncSemaphore;
+using DaneJoe::Concurrent::Coroutine::CoTask;
+using DaneJoe::Concurrent::Coroutine::schedule;
+using DaneJoe::Concurrent::Coroutine::spawn;
+using DaneJoe::Concurrent::ThreadPool::Future;
+using DaneJoe::Concurrent::ThreadPool::ThreadPool;
+
+namespace demo {
+
+static void test_token_and_linking()
+{
+    CancellationToken never;
+    assert(!never.can_be_cancelled());
+    assert(!never.is_cancellation_requested());
+
+    CancellationSource parent;
+    CancellationSource child = CancellationSource::create_linked(parent.get_token());
+    CancellationToken child_token = child.get_token();
+    int callback_count = 0;
+    {
+        CancellationCallback callback(child_token, [&]() { ++callback_count; });
+        assert(!child_token.is_cancellation_requested());
+        parent.cancel();
+    }
+    assert(child_token.is_cancellation_requested());
+    assert(callback_count == 1);
+
+    // 已取消的令牌注册回调时立即执行
+    CancellationCallback late(child_token, [&]() { ++callback_count; });
+    assert(callback_count == 2);
+
+    CancellationSource expired(Clock::now() - 1ms);
+    assert(expired.get_token().is_cancellation_requested());
+    CancellationSource linked_deadline = CancellationSource::create_linked(expired.get_token(), Clock::now() + 1h);
+    assert(linked_deadline.get_token().get_deadline() == expired.get_token().get_deadline());
+}
+
+static void test_queue_waits()
+{
+    MpmcBoundedQueue<int> queue(1);
+    CancellationSource source;
+    std::thread canceller([&]()
+        {
+            std::this_thread::sleep_for(20ms);
+            source.cancel();
+        });
+    auto value = queue.pop(source.get_token());
+    assert(!value.has_value());
+    canceller.join();
+
+    assert(queue.push(1, CancellationToken()));
+    CancellationSource deadline(Clock::now() + 20ms);
+    auto start = Clock::now();
+    bool is_pushed = queue.push(2, deadline.get_token());
+    assert(!is_pushed);
+    assert(Clock::now() - start >= 15ms);
+    (void)start;
+    auto popped = queue.pop(CancellationToken());
+    assert(popped.has_value() && *popped == 1);
+
+    CancellationSource sleeper;
+    std::thread waker([&]()
+        {
+            std::this_thread::sleep_for(10ms);
+            sleeper.cancel();
+        });
+    bool is_cancelled = sleeper.get_token().sleep_for(10s);
+    assert(is_cancelled);
+    waker.join();
+    assert(!CancellationToken().sleep_for(1ms));
+}
+
+static void test_pool_tasks()
+{
+    ThreadPool pool(1);
+    std::atomic<bool> is_released = false;
+    // 阻塞唯一的工作线程，使后续任务排队
+    pool.post([&]()
+        {
+            while (!is_released.load())
+            {
+                std::this_thread::yield();
+            }
+        });
+    CancellationSource source;
+    std::atomic<int> executed = 0;
+    for (int i = 0; i < 100; ++i)
+    {
+        pool.post([&]() { ++executed; }, source.get_token());
+    }
+    Future<int> cancelled = pool.submit(source.get_token(), [](int value) { return value; }, 7);
+    Future<int> kept = pool.submit(CancellationToken(), [](int value) { return value; }, 8);
+    source.cancel();
+    is_released.store(true);
+    bool is_thrown = false;
+    try
+    {
+        cancelled.get();
+    }
+    catch (const OperationCancelled&)
+    {
+        is_thrown = true;
+    }
+    assert(is_thrown);
+    assert(kept.get() == 8);
+    assert(executed.load() == 0);
+}
+
+static CoTask<int> acquire_or_cancel(AsyncSemaphore& semaphore, CancellationToken token)
+{
+    try
+    {
+        co_await semaphore.acquire(std::move(token));
+    }
+    catch (const OperationCancelled&)
+    {
+        co_return 0;
+    }
+    co_return 1;
+}
+
+static CoTask<void> cancellation_point(ThreadPool& pool, CancellationToken token)
+{
+    co_await schedule(pool, std::move(token));
+}
+
+static void test_coroutine_awaits()
+{
+    ThreadPool pool(2);
+    AsyncSemaphore semaphore(pool, 0);
+    CancellationSource source;
+    std::vector<Future<int>> waiters;
+    for (int i = 0; i < 4; ++i)
+    {
+        waiters.push_back(spawn(pool, acquire_or_cancel(semaphore, source.get_token())));
+    }
+    Future<int> survivor = spawn(pool, acquire_or_cancel(semaphore, CancellationToken()));
+    std::this_thread::sleep_for(20ms);
+    source.cancel();
+    for (auto& waiter : waiters)
+    {
+        assert(waiter.get() == 0);
+    }
+    // 取消的等待者不占用许可：一次释放即唤醒存活的等待者
+    semaphore.release();
+    assert(survivor.get() == 1);
+    semaphore.release();
+    assert(semaphore.get_available() == 1);
+
+    CancellationSource cancelled;
+    cancelled.cancel();
+    bool is_thrown = false;
+    try
+    {
+        spawn(pool, cancellation_point(pool, cancelled.get_token())).get();
+    }
+    catch (const OperationCancelled&)
+    {
+        is_thrown = true;
+    }
+    assert(is_thrown);
+}
+
+void run_cancellation_demo()
+{
+    std::cout << "Cancellation demo:\n";
+    test_token_and_linking();
+    test_queue_waits();
+    test_pool_tasks();
+    test_coroutine_awaits();
+    std::cout << "  tokens, queue waits, pool tasks and coroutine awaits ok\n";
+}
+
+} // namespace demo
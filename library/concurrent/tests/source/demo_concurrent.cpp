@@ -1,13 +1,286 @@
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
 #include <iostream>
 #include <optional>
 #include <string>
+#include <thread>
+#include <vector>
 #include "danejoe/concurrent/blocking/mpmc_bounded_queue.hpp"
+#include "danejoe/concurrent/blocking/queue_selector.hpp"
+#include "danejoe/concurrent/cancellation/cancellation_token.hpp"
+#include "danejoe/concurrent/blocking/spill_queue.hpp"
 #include "demo_concurrent.hpp"
 
 using DaneJoe::Concurrent::Blocking::MpmcBoundedQueue;
+using DaneJoe::Concurrent::Blocking::QueueSelector;
+using DaneJoe::Concurrent::Blocking::wait_any;
+using DaneJoe::Concurrent::Blocking::wait_any_until;
+using DaneJoe::Concurrent::Cancellation::CancellationSource;
+using DaneJoe::Concurrent::Blocking::SpillQueue;
+using DaneJoe::Concurrent::Blocking::SpillQueueOptions;
 
 namespace demo {
 
+struct Order
+{
+    int id;
+    std::string symbol;
+};
+
+struct OrderSerializer
+{
+    static std::size_t size(const Order& order)
+    {
+        return sizeof(int) + order.symbol.size();
+    }
+    static void serialize(const Order& order, std::byte* out)
+    {
+        std::memcpy(out, &order.id, sizeof(int));
+        std::memcpy(out + sizeof(int), order.symbol.data(), order.symbol.size());
+    }
+    static Order deserialize(const std::byte* data, std::size_t size)
+    {
+        Order order{};
+        std::memcpy(&order.id, data, sizeof(int));
+        order.symbol.assign(reinterpret_cast<const char*>(data + sizeof(int)), size - sizeof(int));
+        return order;
+    }
+};
+
+static SpillQueueOptions make_spill_options(std::size_t memory_capacity, std::size_t segment_size)
+{
+    SpillQueueOptions options;
+    options.memory_capacity = memory_capacity;
+    options.segment_size = segment_size;
+    options.directory = std::filesystem::temp_directory_path() / "danejoe_spill_demo";
+    return options;
+}
+
+static void test_spill_fifo()
+{
+    SpillQueue<int> queue(make_spill_options(8, 64));
+    for (int i = 0; i < 100; ++i)
+    {
+        bool is_pushed = queue.push(i);
+        assert(is_pushed);
+    }
+    assert(queue.size() == 100);
+    assert(queue.get_memory_size() == 8);
+    assert(queue.get_spilled_count() == 92);
+    assert(queue.get_segment_count() > 1);
+
+    // 消费者追上一部分后继续写入，新元素仍排在磁盘记录之后
+    for (int i = 0; i < 50; ++i)
+    {
+        auto value = queue.try_pop();
+        assert(value && *value == i);
+    }
+    for (int i = 100; i < 120; ++i)
+    {
+        queue.push(i);
+    }
+    for (int i = 50; i < 120; ++i)
+    {
+        auto value = queue.try_pop();
+        assert(value && *value == i);
+    }
+    assert(queue.empty());
+    assert(queue.get_segment_count() <= 1);
+
+    // 磁盘清空后重新使用内存队列
+    queue.push(7);
+    assert(queue.get_memory_size() == 1);
+    assert(queue.get_spilled_count() == 0);
+}
+
+static void test_spill_custom_serializer()
+{
+    SpillQueue<Order, OrderSerializer> queue(make_spill_options(2, 128));
+    std::string long_symbol(1000, 'x');
+    queue.push(Order{ 1, "AAPL" });
+    queue.push(Order{ 2, "MSFT" });
+    queue.push(Order{ 3, "GOOG" });
+    // 超过分段大小的记录使用独立分段
+    queue.push(Order{ 4, long_symbol });
+    queue.push(Order{ 5, "TSLA" });
+    assert(queue.get_spilled_count() == 3);
+
+    auto first = queue.try_pop();
+    assert(first && first->id == 1 && first->symbol == "AAPL");
+    queue.try_pop();
+    auto third = queue.try_pop();
+    assert(third && third->id == 3 && third->symbol == "GOOG");
+    auto fourth = queue.try_pop();
+    assert(fourth && fourth->id == 4 && fourth->symbol == long_symbol);
+    auto fifth = queue.try_pop();
+    assert(fifth && fifth->id == 5 && fifth->symbol == "TSLA");
+    assert(!queue.try_pop());
+
+    SpillQueue<std::string> strings(make_spill_options(1, 64));
+    strings.push("memory");
+    strings.push("disk");
+    assert(*strings.try_pop() == "memory");
+    assert(*strings.try_pop() == "disk");
+}
+
+static void test_spill_producers_consumer()
+{
+    SpillQueue<int> queue(make_spill_options(16, 256));
+    constexpr int producer_count = 4;
+    constexpr int per_producer = 2000;
+    std::vector<std::thread> producers;
+    for (int p = 0; p < producer_count; ++p)
+    {
+        producers.emplace_back([&queue, p]()
+            {
+                for (int i = 0; i < per_producer; ++i)
+                {
+                    queue.push(p * per_producer + i);
+                }
+            });
+    }
+    std::vector<int> last(producer_count, -1);
+    int received = 0;
+    while (received < producer_count * per_producer)
+    {
+        auto value = queue.pop();
+        assert(value);
+        int producer = *value / per_producer;
+        // 单个生产者的元素保持先进先出
+        assert(*value > last[producer]);
+        last[producer] = *value;
+        ++received;
+    }
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+    queue.close();
+    assert(!queue.push(0));
+    assert(!queue.pop());
+}
+
+static void test_select_priority()
+{
+    MpmcBoundedQueue<std::string> control(8);
+    MpmcBoundedQueue<int> data(8);
+    std::vector<std::string> commands;
+    std::vector<int> values;
+    QueueSelector selector;
+    std::size_t data_index = selector.add(data, [&values](int value) { values.push_back(value); });
+    std::size_t control_index = selector.add(control, [&commands](std::string command) { commands.push_back(std::move(command)); }, 1);
+    assert(selector.get_source_count() == 2);
+    assert(!selector.try_select());
+
+    data.push(1);
+    data.push(2);
+    control.push("pause");
+    // 控制队列优先级更高，先于已在排队的数据被处理
+    assert(selector.select() == control_index);
+    assert(selector.select() == data_index);
+    assert(selector.select() == data_index);
+    assert(commands.size() == 1 && values.size() == 2);
+
+    // 同优先级之间轮转
+    MpmcBoundedQueue<int> first(8);
+    MpmcBoundedQueue<int> second(8);
+    QueueSelector fair;
+    std::size_t first_index = fair.add(first, [](int) {});
+    std::size_t second_index = fair.add(second, [](int) {});
+    for (int i = 0; i < 4; ++i)
+    {
+        first.push(i);
+        second.push(i);
+    }
+    std::size_t first_count = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        std::optional<std::size_t> index = fair.select();
+        first_count += index == first_index ? 1 : 0;
+        assert(index == first_index || index == second_index);
+    }
+    assert(first_count == 2);
+}
+
+static void test_select_blocking()
+{
+    MpmcBoundedQueue<int> control(8);
+    MpmcBoundedQueue<int> data(8);
+    int sum = 0;
+    QueueSelector selector;
+    selector.add(control, [&sum](int value) { sum -= value; }, 1);
+    selector.add(data, [&sum](int value) { sum += value; });
+
+    std::thread producer([&control, &data]()
+        {
+            for (int i = 1; i <= 100; ++i)
+            {
+                data.push(i);
+                if (i % 10 == 0)
+                {
+                    control.push(1);
+                }
+            }
+            control.close();
+            data.close();
+        });
+    std::size_t handled = 0;
+    while (selector.select())
+    {
+        ++handled;
+    }
+    producer.join();
+    assert(handled == 110);
+    assert(sum == 5050 - 10);
+
+    bool is_timed_out = !selector.select_for(std::chrono::milliseconds(10));
+    assert(is_timed_out);
+
+    MpmcBoundedQueue<int> idle(8);
+    QueueSelector idle_selector;
+    idle_selector.add(idle, [](int) {});
+    auto start = std::chrono::steady_clock::now();
+    assert(!idle_selector.select_for(std::chrono::milliseconds(20)));
+    assert(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(20));
+
+    CancellationSource source;
+    std::thread canceller([&source]()
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            source.cancel();
+        });
+    assert(!idle_selector.select(source.get_token()));
+    canceller.join();
+}
+
+static void test_wait_any()
+{
+    MpmcBoundedQueue<int> control(8);
+    MpmcBoundedQueue<std::string> data(8);
+    std::thread producer([&data]()
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            data.push("row");
+        });
+    assert(wait_any(control, data) == 1u);
+    producer.join();
+    assert(data.try_pop() == std::string("row"));
+
+    control.push(7);
+    data.push("row");
+    assert(wait_any(control, data) == 0u);
+    control.try_pop();
+    data.try_pop();
+
+    bool is_timed_out = !wait_any_until(std::chrono::steady_clock::now() + std::chrono::milliseconds(10), control, data);
+    assert(is_timed_out);
+    control.close();
+    data.close();
+    assert(!wait_any(control, data));
+}
+
 void run_concurrent_demo()
 {
     std::cout << "Concurrent demo:\n";
@@ -24,6 +297,16 @@ void run_concurrent_demo()
               << ", "
               << (b.has_value() ? *b : std::string{"<none>"})
               << "\n";
+
+    test_spill_fifo();
+    test_spill_custom_serializer();
+    test_spill_producers_consumer();
+    std::cout << "  spill queue ok\n";
+
+    test_select_priority();
+    test_select_blocking();
+    test_wait_any();
+    std::cout << "  queue select ok\n";
 }
 
 } // namespace demo
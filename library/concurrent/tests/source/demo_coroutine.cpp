@@ -0,0 +1,147 @@
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+#include "danejoe/concurrent/thread_pool/thread_pool.hpp"
+#include "danejoe/concurrent/coroutine/co_task.hpp"
+#include "danejoe/concurrent/coroutine/async_mutex.hpp"
+#include "danejoe/concurrent/coroutine/async_semaphore.hpp"
+#include "danejoe/concurrent/coroutine/async_latch.hpp"
+#include "danejoe/concurrent/coroutine/async_event.hpp"
+#include "demo_coroutine.hpp"
+
+using DaneJoe::Concurrent::Coroutine::AsyncEvent;
+using DaneJoe::Concurrent::Coroutine::AsyncLatch;
+using DaneJoe::Concurrent::Coroutine::AsyncMutex;
+using DaneJoe::Concurrent::Coroutine::AsyncSemaphore;
+using DaneJoe::Concurrent::Coroutine::CoTask;
+using DaneJoe::Concurrent::Coroutine::schedule;
+using DaneJoe::Concurrent::Coroutine::spawn;
+using DaneJoe::Concurrent::ThreadPool::Future;
+using DaneJoe::Concurrent::ThreadPool::ThreadPool;
+using DaneJoe::Concurrent::ThreadPool::when_all;
+
+namespace demo {
+
+static CoTask<int> add_async(int a, int b)
+{
+    co_return a + b;
+}
+
+static CoTask<int> nested_task()
+{
+    int first = co_await add_async(1, 2);
+    int second = co_await add_async(first, 3);
+    co_return second;
+}
+
+static void test_co_task_and_spawn()
+{
+    ThreadPool pool(2);
+    assert(spawn(pool, nested_task()).get() == 6);
+}
+
+static CoTask<void> locked_increment(ThreadPool& pool, AsyncMutex& mutex, int& counter, std::atomic<int>& holders)
+{
+    for (int i = 0; i < 50; ++i)
+    {
+        auto guard = co_await mutex.scoped_lock();
+        int previous_holders = holders.fetch_add(1);
+        assert(previous_holders == 0);
+        (void)previous_holders;
+        int value = counter;
+        co_await schedule(pool);
+        counter = value + 1;
+        holders.fetch_sub(1);
+    }
+}
+
+static void test_async_mutex()
+{
+    ThreadPool pool(4);
+    AsyncMutex mutex(pool);
+    int counter = 0;
+    std::atomic<int> holders = 0;
+    std::vector<Future<void>> futures;
+    for (int i = 0; i < 8; ++i)
+    {
+        futures.push_back(spawn(pool, locked_increment(pool, mutex, counter, holders)));
+    }
+    when_all(std::move(futures)).get();
+    assert(counter == 400);
+    assert(mutex.try_lock());
+    mutex.unlock();
+}
+
+static CoTask<void> limited_work(ThreadPool& pool, AsyncSemaphore& semaphore, std::atomic<int>& active, std::atomic<int>& peak)
+{
+    co_await semaphore.acquire();
+    int now = active.fetch_add(1) + 1;
+    int previous = peak.load();
+    while (now > previous && !peak.compare_exchange_weak(previous, now))
+    {
+    }
+    co_await schedule(pool);
+    active.fetch_sub(1);
+    semaphore.release();
+}
+
+static void test_async_semaphore()
+{
+    ThreadPool pool(4);
+    AsyncSemaphore semaphore(pool, 2);
+    std::atomic<int> active = 0;
+    std::atomic<int> peak = 0;
+    std::vector<Future<void>> futures;
+    for (int i = 0; i < 32; ++i)
+    {
+        futures.push_back(spawn(pool, limited_work(pool, semaphore, active, peak)));
+    }
+    when_all(std::move(futures)).get();
+    assert(peak.load() <= 2);
+    assert(semaphore.get_available() == 2);
+}
+
+static CoTask<int> wait_for_latch(AsyncLatch& latch, AsyncEvent& event)
+{
+    co_await latch.wait();
+    co_await event.wait();
+    co_return 1;
+}
+
+static void test_async_latch_and_event()
+{
+    ThreadPool pool(2);
+    AsyncLatch latch(pool, 3);
+    AsyncEvent event(pool);
+    std::vector<Future<int>> futures;
+    for (int i = 0; i < 4; ++i)
+    {
+        futures.push_back(spawn(pool, wait_for_latch(latch, event)));
+    }
+    latch.count_down();
+    latch.count_down(2);
+    assert(latch.is_ready());
+    event.set();
+    int total = 0;
+    for (auto& future : when_all(std::move(futures)).get())
+    {
+        total += future.get();
+    }
+    assert(total == 4);
+    event.reset();
+    assert(!event.is_set());
+}
+
+void run_coroutine_demo()
+{
+    std::cout << "Coroutine demo:\n";
+    test_co_task_and_spawn();
+    test_async_mutex();
+    test_async_semaphore();
+    test_async_latch_and_event();
+    std::cout << "  co_task, async mutex/semaphore/latch/event ok\n";
+}
+
+} // namespace demo
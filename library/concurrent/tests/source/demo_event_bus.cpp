@@ -0,0 +1,210 @@
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "danejoe/concurrent/thread_pool/thread_pool.hpp"
+#include "danejoe/concurrent/event_bus/event_bus.hpp"
+#include "demo_event_bus.hpp"
+
+using DaneJoe::Concurrent::EventBus::EventBus;
+using DaneJoe::Concurrent::EventBus::MailboxOptions;
+using DaneJoe::Concurrent::EventBus::OverflowPolicy;
+using DaneJoe::Concurrent::EventBus::Subscription;
+using DaneJoe::Concurrent::EventBus::Topic;
+using DaneJoe::Concurrent::ThreadPool::ThreadPool;
+
+namespace demo {
+
+/**
+ * @brief 手动执行的执行器，用于构造邮箱积压
+ */
+class ManualExecutor : public DaneJoe::Concurrent::ThreadPool::IExecutor
+{
+public:
+    void execute(DaneJoe::Concurrent::ThreadPool::Task task)override
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.push_back(std::move(task));
+    }
+    void run_all()
+    {
+        while (true)
+        {
+            DaneJoe::Concurrent::ThreadPool::Task task;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_tasks.empty())
+                {
+                    return;
+                }
+                task = std::move(m_tasks.front());
+                m_tasks.erase(m_tasks.begin());
+            }
+            task();
+        }
+    }
+private:
+    std::mutex m_mutex;
+    std::vector<DaneJoe::Concurrent::ThreadPool::Task> m_tasks;
+};
+
+static void test_sync_subscribers()
+{
+    EventBus bus;
+    auto topic = bus.get_topic<int>("config");
+    assert(bus.get_topic<int>("config") == topic);
+    assert(bus.has_topic("config"));
+
+    bool is_thrown = false;
+    try
+    {
+        bus.get_topic<std::string>("config");
+    }
+    catch (const std::invalid_argument&)
+    {
+        is_thrown = true;
+    }
+    assert(is_thrown);
+
+    int sum_a = 0;
+    int sum_b = 0;
+    {
+        Subscription a = topic->subscribe([&](const int& value) { sum_a += value; });
+        Subscription b = topic->subscribe([&](const int& value) { sum_b += value; });
+        assert(topic->get_subscriber_count() == 2);
+        std::size_t delivered = topic->publish(5);
+        assert(delivered == 2);
+        b.unsubscribe();
+        assert(!b.is_active());
+        topic->publish(1);
+    }
+    assert(topic->get_subscriber_count() == 0);
+    assert(topic->publish(100) == 0);
+    assert(sum_a == 6);
+    assert(sum_b == 5);
+}
+
+static void test_concurrent_publish_and_subscribe()
+{
+    EventBus bus;
+    auto topic = bus.get_topic<int>("churn");
+    std::atomic<long long> received = 0;
+    Subscription steady = topic->subscribe([&received](const int& value) { received.fetch_add(value); });
+    std::atomic<bool> is_done = false;
+    std::vector<std::thread> publishers;
+    for (int i = 0; i < 4; ++i)
+    {
+        publishers.emplace_back([&]()
+            {
+                while (!is_done.load())
+                {
+                    topic->publish(1);
+                }
+            });
+    }
+    // 发布期间反复替换订阅者快照，旧快照经纪元回收释放
+    for (int i = 0; i < 2000; ++i)
+    {
+        Subscription transient = topic->subscribe([](const int&) {});
+        transient.unsubscribe();
+    }
+    is_done.store(true);
+    for (auto& publisher : publishers)
+    {
+        publisher.join();
+    }
+    assert(received.load() > 0);
+    assert(topic->get_subscriber_count() == 1);
+
+    // 没有并发发布时，取消订阅后处理函数捕获的对象随即释放
+    auto captured = std::make_shared<int>(0);
+    std::weak_ptr<int> weak_captured = captured;
+    Subscription owner = topic->subscribe([captured = std::move(captured)](const int&) {});
+    owner.unsubscribe();
+    owner = Subscription();
+    assert(weak_captured.expired());
+}
+
+static void test_pooled_subscribers()
+{
+    ThreadPool pool(4);
+    auto topic = std::make_shared<Topic<int>>();
+    std::mutex mutex;
+    std::vector<int> received;
+    std::atomic<int> count = 0;
+    Subscription subscription = topic->subscribe(pool, [&](const int& value)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            received.push_back(value);
+            ++count;
+        }, MailboxOptions{ 16, OverflowPolicy::Block, 4 });
+    std::vector<std::thread> publishers;
+    for (int t = 0; t < 3; ++t)
+    {
+        publishers.emplace_back([&topic, t]()
+            {
+                for (int i = 0; i < 1000; ++i)
+                {
+                    topic->publish(t * 1000 + i);
+                }
+            });
+    }
+    for (auto& publisher : publishers)
+    {
+        publisher.join();
+    }
+    while (count.load() < 3000)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    assert(subscription.get_dropped_count() == 0);
+    // 每个发布者的事件保持相对顺序
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<int> last(3, -1);
+    for (int value : received)
+    {
+        assert(value % 1000 > last[value / 1000]);
+        last[value / 1000] = value % 1000;
+    }
+}
+
+static void test_overflow_policies()
+{
+    ManualExecutor executor;
+    auto topic = std::make_shared<Topic<int>>();
+    std::vector<int> newest_kept;
+    std::vector<int> oldest_kept;
+    Subscription drop_newest = topic->subscribe(executor, [&](const int& value) { newest_kept.push_back(value); },
+        MailboxOptions{ 3, OverflowPolicy::DropNewest, 64 });
+    Subscription drop_oldest = topic->subscribe(executor, [&](const int& value) { oldest_kept.push_back(value); },
+        MailboxOptions{ 3, OverflowPolicy::DropOldest, 64 });
+    for (int i = 0; i < 5; ++i)
+    {
+        topic->publish(i);
+    }
+    assert(drop_newest.get_pending_count() == 3);
+    assert(drop_newest.get_dropped_count() == 2);
+    assert(drop_oldest.get_dropped_count() == 2);
+    executor.run_all();
+    assert((newest_kept == std::vector<int>{ 0, 1, 2 }));
+    assert((oldest_kept == std::vector<int>{ 2, 3, 4 }));
+}
+
+void run_event_bus_demo()
+{
+    std::cout << "Event bus demo:\n";
+    test_sync_subscribers();
+    test_concurrent_publish_and_subscribe();
+    test_pooled_subscribers();
+    test_overflow_policies();
+    std::cout << "  topics, sync/pooled subscribers and overflow policies ok\n";
+}
+
+} // namespace demo
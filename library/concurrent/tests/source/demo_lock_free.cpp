@@ -0,0 +1,751 @@
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <unistd.h>
+#include <sys/wait.h>
+#endif
+
+#include "danejoe/concurrent/lock_free/concurrent_vector.hpp"
+#include "danejoe/concurrent/lock_free/latest_value.hpp"
+#include "danejoe/concurrent/lock_free/triple_buffer.hpp"
+#include "danejoe/concurrent/lock_free/shm_spsc_ring.hpp"
+#include "danejoe/concurrent/lock_free/byte_ring.hpp"
+#include "danejoe/concurrent/lock_free/concurrent_skip_list_map.hpp"
+#include "danejoe/concurrent/lock_free/epoch_domain.hpp"
+#include "danejoe/concurrent/lock_free/slot_map.hpp"
+#include "demo_lock_free.hpp"
+
+using DaneJoe::Concurrent::LockFree::ConcurrentSkipListMap;
+using DaneJoe::Concurrent::LockFree::ConcurrentVector;
+using DaneJoe::Concurrent::LockFree::EpochDomain;
+using DaneJoe::Concurrent::LockFree::HandleAllocator;
+using DaneJoe::Concurrent::LockFree::LatestValue;
+using DaneJoe::Concurrent::LockFree::MpscByteRing;
+using DaneJoe::Concurrent::LockFree::SlotHandle;
+using DaneJoe::Concurrent::LockFree::SlotMap;
+using DaneJoe::Concurrent::LockFree::SpscByteRing;
+using DaneJoe::Concurrent::LockFree::TripleBuffer;
+#if !defined(_WIN32)
+using DaneJoe::Concurrent::LockFree::ShmRole;
+using DaneJoe::Concurrent::LockFree::ShmSpscRing;
+#endif
+
+namespace demo {
+
+static void test_concurrent_vector_single_thread()
+{
+    ConcurrentVector<std::string> values;
+    assert(values.empty());
+    for (int i = 0; i < 1000; ++i)
+    {
+        std::size_t index = values.push_back(std::to_string(i));
+        assert(index == static_cast<std::size_t>(i));
+    }
+    assert(values.size() == 1000);
+    // 引用在后续追加后保持稳定
+    const std::string* first = &values[0];
+    for (int i = 0; i < 10000; ++i)
+    {
+        values.emplace_back(3, 'x');
+    }
+    assert(first == &values[0]);
+    assert(values[999] == "999");
+    assert(values.at(10999) == "xxx");
+    assert(values.try_get(11000) == nullptr);
+
+    bool is_thrown = false;
+    try
+    {
+        values.at(11000);
+    }
+    catch (const std::out_of_range&)
+    {
+        is_thrown = true;
+    }
+    assert(is_thrown);
+
+    std::size_t visited = 0;
+    values.for_each([&](std::size_t, std::string&) { ++visited; });
+    assert(visited == values.size());
+
+    ConcurrentVector<std::unique_ptr<int>> move_only(100);
+    move_only.push_back(std::make_unique<int>(7));
+    assert(*move_only[0] == 7);
+}
+
+static void test_concurrent_vector_concurrent_append()
+{
+    constexpr int THREAD_COUNT = 4;
+    constexpr int PER_THREAD = 20000;
+    ConcurrentVector<int> values;
+    std::atomic<bool> is_done = false;
+    std::atomic<long long> reader_sum = 0;
+    // 读者并发扫描已就绪元素
+    std::thread reader([&]()
+        {
+            while (!is_done.load())
+            {
+                long long sum = 0;
+                values.for_each([&](std::size_t, int& value) { sum += value; });
+                reader_sum.store(sum);
+            }
+        });
+    std::vector<std::thread> writers;
+    for (int t = 0; t < THREAD_COUNT; ++t)
+    {
+        writers.emplace_back([&values, t]()
+            {
+                for (int i = 0; i < PER_THREAD; ++i)
+                {
+                    std::size_t index = values.push_back(t * PER_THREAD + i);
+                    assert(values[index] == t * PER_THREAD + i);
+                    (void)index;
+                }
+            });
+    }
+    for (auto& writer : writers)
+    {
+        writer.join();
+    }
+    is_done.store(true);
+    reader.join();
+
+    assert(values.size() == static_cast<std::size_t>(THREAD_COUNT * PER_THREAD));
+    std::vector<bool> is_seen(THREAD_COUNT * PER_THREAD, false);
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        assert(!is_seen[values[i]]);
+        is_seen[values[i]] = true;
+    }
+}
+
+struct Frame
+{
+    long sequence;
+    long checksum;
+    double values[6];
+};
+
+static Frame make_frame(long sequence)
+{
+    Frame frame{};
+    frame.sequence = sequence;
+    frame.checksum = sequence * 7;
+    for (int i = 0; i < 6; ++i)
+    {
+        frame.values[i] = static_cast<double>(sequence + i);
+    }
+    return frame;
+}
+
+static bool is_consistent(const Frame& frame)
+{
+    if (frame.checksum != frame.sequence * 7)
+    {
+        return false;
+    }
+    for (int i = 0; i < 6; ++i)
+    {
+        if (frame.values[i] != static_cast<double>(frame.sequence + i))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void test_triple_buffer()
+{
+    TripleBuffer<std::string> buffer("initial");
+    assert(!buffer.has_update());
+    assert(buffer.read() == "initial");
+    buffer.write("first");
+    buffer.write("second");
+    assert(buffer.has_update());
+    // 读者只看到最新发布的值
+    assert(buffer.read() == "second");
+    assert(!buffer.update());
+    buffer.get_write_buffer() = "in place";
+    buffer.publish();
+    assert(buffer.update());
+    assert(buffer.get_read_buffer() == "in place");
+
+    constexpr long count = 200000;
+    TripleBuffer<Frame> frames(make_frame(0));
+    std::thread writer([&frames]()
+        {
+            for (long i = 1; i <= count; ++i)
+            {
+                frames.get_write_buffer() = make_frame(i);
+                frames.publish();
+            }
+        });
+    long last = 0;
+    while (last < count)
+    {
+        const Frame& frame = frames.read();
+        assert(is_consistent(frame));
+        assert(frame.sequence >= last);
+        last = frame.sequence;
+    }
+    writer.join();
+}
+
+static void test_latest_value()
+{
+    LatestValue<Frame> latest(make_frame(0));
+    assert(latest.get_version() == 0);
+    latest.store(make_frame(5));
+    assert(latest.get_version() == 1);
+    assert(latest.load().sequence == 5);
+
+    constexpr long count = 100000;
+    std::atomic<bool> is_done{ false };
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r)
+    {
+        readers.emplace_back([&latest, &is_done]()
+            {
+                long last = 0;
+                while (!is_done.load(std::memory_order_acquire))
+                {
+                    Frame frame = latest.load();
+                    assert(is_consistent(frame));
+                    assert(frame.sequence >= last);
+                    last = frame.sequence;
+                }
+            });
+    }
+    for (long i = 6; i <= count; ++i)
+    {
+        latest.store(make_frame(i));
+    }
+    is_done.store(true, std::memory_order_release);
+    for (auto& reader : readers)
+    {
+        reader.join();
+    }
+    assert(latest.load().sequence == count);
+}
+
+static std::string to_string(std::span<const std::byte> record)
+{
+    return std::string(reinterpret_cast<const char*>(record.data()), record.size());
+}
+
+static void test_byte_ring_wrap_around()
+{
+    SpscByteRing ring(100);
+    assert(ring.capacity() == 128);
+    assert(ring.get_max_record_size() == 56);
+    assert(!ring.reserve(57));
+    assert(!ring.read().data());
+
+    // 不同长度的记录反复回绕，读出的内容与顺序不变
+    int next_write = 0;
+    int next_read = 0;
+    for (int round = 0; round < 200; ++round)
+    {
+        std::string text(static_cast<std::size_t>(round % 41), static_cast<char>('a' + round % 26));
+        text += std::to_string(next_write);
+        while (!ring.try_push(text.data(), text.size()))
+        {
+            std::span<const std::byte> record = ring.read();
+            assert(record.data());
+            std::string expected(static_cast<std::size_t>(next_read % 41), static_cast<char>('a' + next_read % 26));
+            expected += std::to_string(next_read);
+            assert(to_string(record) == expected);
+            ring.release();
+            ++next_read;
+        }
+        ++next_write;
+    }
+    std::size_t drained = ring.consume([&](std::span<const std::byte> record)
+        {
+            std::string expected(static_cast<std::size_t>(next_read % 41), static_cast<char>('a' + next_read % 26));
+            expected += std::to_string(next_read);
+            assert(to_string(record) == expected);
+            ++next_read;
+        });
+    assert(drained > 0);
+    assert(next_read == 200);
+    assert(ring.empty());
+
+    // 预留后按实际长度提交；零长度记录
+    std::byte* destination = ring.reserve(32);
+    assert(destination);
+    std::memcpy(destination, "short", 5);
+    ring.commit(5);
+    bool is_pushed = ring.try_push(nullptr, 0);
+    assert(is_pushed);
+    assert(to_string(ring.read()) == "short");
+    ring.release();
+    std::span<const std::byte> empty_record = ring.read();
+    assert(empty_record.data() && empty_record.size() == 0);
+    ring.release();
+    assert(ring.empty());
+}
+
+static void test_byte_ring_threads()
+{
+    constexpr long count = 50000;
+    SpscByteRing spsc(4096);
+    std::thread producer([&spsc]()
+        {
+            for (long i = 0; i < count; ++i)
+            {
+                std::string text = std::to_string(i);
+                while (!spsc.try_push(text.data(), text.size()))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    long expected = 0;
+    while (expected < count)
+    {
+        spsc.consume([&expected](std::span<const std::byte> record)
+            {
+                assert(to_string(record) == std::to_string(expected));
+                ++expected;
+            });
+    }
+    producer.join();
+
+    constexpr int producer_count = 4;
+    constexpr long per_producer = 10000;
+    MpscByteRing mpsc(4096);
+    std::vector<std::thread> producers;
+    for (int p = 0; p < producer_count; ++p)
+    {
+        producers.emplace_back([&mpsc, p]()
+            {
+                for (long i = 0; i < per_producer; ++i)
+                {
+                    long value[2] = { p, i };
+                    std::byte* destination = nullptr;
+                    while (!(destination = mpsc.reserve(sizeof(value))))
+                    {
+                        std::this_thread::yield();
+                    }
+                    std::memcpy(destination, value, sizeof(value));
+                    mpsc.commit();
+                }
+            });
+    }
+    std::vector<long> last(producer_count, -1);
+    long received = 0;
+    while (received < producer_count * per_producer)
+    {
+        received += static_cast<long>(mpsc.consume([&last](std::span<const std::byte> record)
+            {
+                long value[2];
+                assert(record.size() == sizeof(value));
+                std::memcpy(value, record.data(), sizeof(value));
+                assert(value[1] == last[value[0]] + 1);
+                last[value[0]] = value[1];
+            }));
+    }
+    for (auto& thread : producers)
+    {
+        thread.join();
+    }
+    assert(mpsc.empty());
+}
+
+#if !defined(_WIN32)
+struct ShmMessage
+{
+    long sequence;
+    char text[24];
+};
+
+static void test_shm_spsc_ring_across_processes()
+{
+    const std::string name = "/danejoe_shm_demo_" + std::to_string(::getpid());
+    ShmSpscRing<ShmMessage>::unlink(name);
+    ShmSpscRing<ShmMessage> producer = ShmSpscRing<ShmMessage>::create(name, 60, ShmRole::Producer);
+    assert(producer.capacity() == 64);
+
+    bool is_mismatch_rejected = false;
+    try
+    {
+        ShmSpscRing<long>::open(name, ShmRole::Consumer);
+    }
+    catch (const std::runtime_error&)
+    {
+        is_mismatch_rejected = true;
+    }
+    assert(is_mismatch_rejected);
+
+    constexpr long count = 20000;
+    pid_t child = ::fork();
+    assert(child >= 0);
+    if (child == 0)
+    {
+        // 子进程作为消费者，校验顺序与内容后以退出码报告结果
+        ShmSpscRing<ShmMessage> consumer = ShmSpscRing<ShmMessage>::open(name, ShmRole::Consumer);
+        long expected = 0;
+        while (expected < count)
+        {
+            consumer.heartbeat();
+            auto message = consumer.try_pop();
+            if (!message)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            if (message->sequence != expected || std::to_string(expected) != message->text)
+            {
+                ::_exit(1);
+            }
+            ++expected;
+        }
+        while (!consumer.is_closed())
+        {
+            std::this_thread::yield();
+        }
+        ::_exit(consumer.try_pop() ? 2 : 0);
+    }
+    for (long i = 0; i < count; ++i)
+    {
+        ShmMessage message{};
+        message.sequence = i;
+        std::string text = std::to_string(i);
+        std::memcpy(message.text, text.c_str(), text.size() + 1);
+        while (!producer.try_push(message))
+        {
+            std::this_thread::yield();
+        }
+    }
+    producer.close();
+    int status = 0;
+    ::waitpid(child, &status, 0);
+    assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+    // 消费者退出后心跳不再更新
+    assert(producer.is_peer_alive(std::chrono::seconds(60)));
+    assert(!producer.is_peer_alive(std::chrono::nanoseconds(0)));
+    assert(producer.size() == 0);
+    bool is_unlinked = ShmSpscRing<ShmMessage>::unlink(name);
+    assert(is_unlinked);
+}
+#endif
+
+/// 统计存活实例数，检查跳表节点最终都被释放
+struct TrackedValue
+{
+    static inline std::atomic<int> live_count{ 0 };
+    int value = 0;
+    explicit TrackedValue(int v) :value(v) { live_count.fetch_add(1); }
+    TrackedValue(const TrackedValue& other) :value(other.value) { live_count.fetch_add(1); }
+    TrackedValue(TrackedValue&& other)noexcept :value(other.value) { live_count.fetch_add(1); }
+    ~TrackedValue() { live_count.fetch_sub(1); }
+};
+
+static void test_skip_list_single_thread()
+{
+    ConcurrentSkipListMap<int, std::string> map;
+    assert(map.empty());
+    for (int key : { 50, 10, 40, 20, 30 })
+    {
+        bool is_inserted = map.insert(key, std::to_string(key));
+        assert(is_inserted);
+    }
+    assert(!map.insert(30, "dup"));
+    assert(map.size() == 5);
+    assert(map.find(30) == std::string("30"));
+    assert(!map.find(35));
+    assert(map.contains(10) && !map.contains(11));
+
+    std::vector<int> keys;
+    for (const auto& [key, value] : map)
+    {
+        keys.push_back(key);
+    }
+    assert((keys == std::vector<int>{ 10, 20, 30, 40, 50 }));
+
+    auto it = map.lower_bound(25);
+    assert(it != map.end() && it->first == 30);
+    ++it;
+    assert(it->second == "40");
+    assert(map.lower_bound(51) == map.end());
+
+    bool is_erased = map.erase(30);
+    assert(is_erased);
+    assert(!map.erase(30));
+    assert(map.lower_bound(25)->first == 40);
+    assert(map.insert(30, "again"));
+
+    std::vector<int> range;
+    map.for_each_range(20, 50, [&range](int key, const std::string&) { range.push_back(key); });
+    assert((range == std::vector<int>{ 20, 30, 40 }));
+    range.clear();
+    map.for_each_range(0, 100, [&range](int key, const std::string&)
+        {
+            range.push_back(key);
+            return key < 20;
+        });
+    assert((range == std::vector<int>{ 10, 20 }));
+}
+
+static void test_skip_list_concurrent()
+{
+    {
+        ConcurrentSkipListMap<int, TrackedValue> map;
+        constexpr int writer_count = 3;
+        constexpr int per_writer = 2000;
+        std::atomic<bool> is_done{ false };
+        std::atomic<int> unordered{ 0 };
+        std::vector<std::thread> readers;
+        for (int r = 0; r < 2; ++r)
+        {
+            readers.emplace_back([&map, &is_done, &unordered]()
+                {
+                    while (!is_done.load())
+                    {
+                        int previous = -1;
+                        map.for_each_range(0, writer_count * per_writer, [&previous, &unordered](int key, const TrackedValue& value)
+                            {
+                                if (key <= previous || value.value != key)
+                                {
+                                    unordered.fetch_add(1);
+                                }
+                                previous = key;
+                            });
+                        int window_start = per_writer;
+                        for (auto it = map.lower_bound(window_start); it != map.end() && it->first < window_start + 100; ++it)
+                        {
+                            if (it->second.value != it->first)
+                            {
+                                unordered.fetch_add(1);
+                            }
+                        }
+                    }
+                });
+        }
+        std::vector<std::thread> writers;
+        for (int w = 0; w < writer_count; ++w)
+        {
+            writers.emplace_back([&map, w]()
+                {
+                    // 交错的键让各写者在同一区域竞争
+                    for (int i = 0; i < per_writer; ++i)
+                    {
+                        int key = i * writer_count + w;
+                        map.insert(key, TrackedValue(key));
+                    }
+                    for (int i = 0; i < per_writer; i += 2)
+                    {
+                        int key = i * writer_count + w;
+                        bool is_erased = map.erase(key);
+                        assert(is_erased);
+                        (void)is_erased;
+                    }
+                    for (int i = 0; i < per_writer; i += 4)
+                    {
+                        int key = i * writer_count + w;
+                        map.insert(key, TrackedValue(key));
+                    }
+                });
+        }
+        for (auto& writer : writers)
+        {
+            writer.join();
+        }
+        is_done.store(true);
+        for (auto& reader : readers)
+        {
+            reader.join();
+        }
+        assert(unordered.load() == 0);
+
+        int expected_count = writer_count * (per_writer / 2 + per_writer / 4);
+        assert(map.size() == static_cast<std::size_t>(expected_count));
+        int count = 0;
+        int previous = -1;
+        for (const auto& [key, value] : map)
+        {
+            assert(key > previous);
+            int i = key / writer_count;
+            assert(i % 2 == 1 || i % 4 == 0);
+            previous = key;
+            ++count;
+        }
+        assert(count == expected_count);
+    }
+    EpochDomain::get_global().collect();
+    assert(EpochDomain::get_global().get_retired_count() == 0);
+    assert(TrackedValue::live_count.load() == 0);
+}
+
+static void test_slot_map_single_thread()
+{
+    {
+        SlotMap<TrackedValue> map(3);
+        SlotHandle first = map.emplace(1);
+        SlotHandle second = map.emplace(2);
+        SlotHandle third = map.emplace(3);
+        assert(!first.is_null() && !second.is_null() && !third.is_null());
+        assert(map.emplace(4).is_null());
+        assert(map.size() == 3);
+        assert(map.get(second)->value == 2);
+
+        bool is_erased = map.erase(second);
+        assert(is_erased);
+        assert(!map.erase(second));
+        assert(map.get(second) == nullptr);
+        assert(TrackedValue::live_count.load() == 2);
+
+        // 槽位复用后旧句柄的代数不再匹配
+        SlotHandle reused = map.emplace(5);
+        assert(reused.get_index() == second.get_index());
+        assert(reused != second);
+        assert(!map.contains(second) && map.contains(reused));
+        assert(map.get(reused)->value == 5);
+        assert(SlotHandle::from_value(reused.get_value()) == reused);
+        assert(!map.contains(SlotHandle()));
+
+        std::vector<int> values;
+        map.for_each([&values](SlotHandle handle, TrackedValue& value)
+            {
+                (void)handle;
+                values.push_back(value.value);
+            });
+        assert((values == std::vector<int>{ 1, 5, 3 }));
+    }
+    assert(TrackedValue::live_count.load() == 0);
+
+    // 遍历跨越多个位图字，只访问占用的槽位
+    HandleAllocator allocator(200);
+    std::vector<SlotHandle> handles;
+    for (int i = 0; i < 200; ++i)
+    {
+        handles.push_back(allocator.acquire());
+    }
+    for (int i = 0; i < 200; ++i)
+    {
+        if (i != 3 && i != 130 && i != 199)
+        {
+            bool is_released = allocator.release(handles[i]);
+            assert(is_released);
+        }
+    }
+    std::vector<std::uint32_t> live;
+    allocator.for_each([&live](SlotHandle handle)
+        {
+            live.push_back(handle.get_index());
+        });
+    assert((live == std::vector<std::uint32_t>{ 3, 130, 199 }));
+    assert(allocator.size() == 3);
+}
+
+static void test_slot_map_concurrent()
+{
+    constexpr int thread_count = 4;
+    constexpr int round_count = 2000;
+    constexpr std::size_t capacity = 64;
+    HandleAllocator allocator(capacity);
+    // 每个槽位同时只能有一个持有者
+    std::vector<std::atomic<int>> owners(capacity);
+    std::atomic<int> conflict_count{ 0 };
+    std::atomic<int> stale_success_count{ 0 };
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thread_count; ++t)
+    {
+        threads.emplace_back([&, t]()
+            {
+                std::vector<SlotHandle> held;
+                std::vector<SlotHandle> stale;
+                for (int round = 0; round < round_count; ++round)
+                {
+                    SlotHandle handle = allocator.acquire();
+                    if (!handle.is_null())
+                    {
+                        int expected = 0;
+                        if (!owners[handle.get_index()].compare_exchange_strong(expected, t + 1))
+                        {
+                            conflict_count.fetch_add(1);
+                        }
+                        held.push_back(handle);
+                    }
+                    if (held.size() > 8 || (handle.is_null() && !held.empty()))
+                    {
+                        SlotHandle victim = held.front();
+                        held.erase(held.begin());
+                        owners[victim.get_index()].store(0);
+                        bool is_released = allocator.release(victim);
+                        if (!is_released)
+                        {
+                            conflict_count.fetch_add(1);
+                        }
+                        stale.push_back(victim);
+                    }
+                    if (!stale.empty() && round % 7 == 0)
+                    {
+                        // 过期句柄既不有效也不能再次释放
+                        if (allocator.release(stale.back()))
+                        {
+                            stale_success_count.fetch_add(1);
+                        }
+                        stale.pop_back();
+                    }
+                }
+                for (SlotHandle handle : held)
+                {
+                    owners[handle.get_index()].store(0);
+                    allocator.release(handle);
+                }
+            });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    assert(conflict_count.load() == 0);
+    assert(stale_success_count.load() == 0);
+    assert(allocator.size() == 0);
+    std::size_t acquired = 0;
+    while (!allocator.acquire().is_null())
+    {
+        ++acquired;
+    }
+    assert(acquired == capacity);
+}
+
+void run_lock_free_demo()
+{
+    std::cout << "Lock-free demo:\n";
+    test_concurrent_vector_single_thread();
+    test_concurrent_vector_concurrent_append();
+    std::cout << "  concurrent vector ok\n";
+    test_triple_buffer();
+    test_latest_value();
+    std::cout << "  triple buffer and latest value ok\n";
+    test_byte_ring_wrap_around();
+    test_byte_ring_threads();
+    std::cout << "  byte record ring ok\n";
+    test_skip_list_single_thread();
+    test_skip_list_concurrent();
+    std::cout << "  skip list map ok\n";
+    test_slot_map_single_thread();
+    test_slot_map_concurrent();
+    std::cout << "  slot map ok\n";
+#if !defined(_WIN32)
+    test_shm_spsc_ring_across_processes();
+    std::cout << "  shared memory spsc ring ok\n";
+#endif
+}
+
+} // namespace demo
@@ -0,0 +1,91 @@
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "danejoe/concurrent/metrics/sharded_counter.hpp"
+#include "danejoe/concurrent/metrics/sharded_histogram.hpp"
+#include "demo_metrics.hpp"
+
+using DaneJoe::Concurrent::Metrics::HistogramSnapshot;
+using DaneJoe::Concurrent::Metrics::ShardedCounter;
+using DaneJoe::Concurrent::Metrics::ShardedHistogram;
+
+namespace demo {
+
+static void test_sharded_counter()
+{
+    ShardedCounter counter(3);
+    assert(counter.get_shard_count() == 4);
+    assert(ShardedCounter().get_shard_count() >= 1);
+
+    constexpr int thread_count = 8;
+    constexpr int per_thread = 10000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thread_count; ++t)
+    {
+        threads.emplace_back([&counter]()
+            {
+                for (int i = 0; i < per_thread; ++i)
+                {
+                    counter.increment();
+                }
+                counter.add(-5);
+            });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    assert(counter.get() == thread_count * (per_thread - 5));
+    assert(counter.exchange_reset() == thread_count * (per_thread - 5));
+    assert(counter.get() == 0);
+}
+
+static void test_sharded_histogram()
+{
+    ShardedHistogram empty;
+    HistogramSnapshot nothing = empty.get_snapshot();
+    assert(nothing.count == 0 && nothing.min == 0 && nothing.get_percentile(0.5) == 0);
+
+    ShardedHistogram histogram(4);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&histogram]()
+            {
+                for (std::uint64_t value = 1; value <= 1000; ++value)
+                {
+                    histogram.record(value);
+                }
+            });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    histogram.record(0);
+    HistogramSnapshot snapshot = histogram.get_snapshot();
+    assert(snapshot.count == 4001);
+    assert(snapshot.sum == 4 * 500500);
+    assert(snapshot.min == 0 && snapshot.max == 1000);
+    assert(snapshot.buckets[0] == 1);
+    // 512..999 与 1000 落入 [512, 1024) 桶
+    assert(snapshot.buckets[10] == 4 * 489);
+    std::uint64_t median = snapshot.get_percentile(0.5);
+    assert(median >= 500 && median <= 511);
+    assert(snapshot.get_percentile(1.0) == 1000);
+    assert(snapshot.get_percentile(0.0) == 0);
+    assert(snapshot.get_mean() > 499.0 && snapshot.get_mean() < 501.0);
+}
+
+void run_metrics_demo()
+{
+    std::cout << "Metrics demo:\n";
+    test_sharded_counter();
+    test_sharded_histogram();
+    std::cout << "  sharded counter and histogram ok\n";
+}
+
+} // namespace demo
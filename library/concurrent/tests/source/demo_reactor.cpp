@@ -0,0 +1,221 @@
+#include <iostream>
+
+#include "demo_reactor.hpp"
+
+#if defined(__linux__)
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+
+#include "danejoe/concurrent/reactor/event_loop.hpp"
+#include "danejoe/concurrent/blocking/mpmc_bounded_queue.hpp"
+#include "danejoe/concurrent/thread_pool/thread_pool.hpp"
+
+using namespace std::chrono_literals;
+using DaneJoe::Concurrent::Blocking::MpmcBoundedQueue;
+using DaneJoe::Concurrent::Reactor::EVENT_HANGUP;
+using DaneJoe::Concurrent::Reactor::EVENT_READABLE;
+using DaneJoe::Concurrent::Reactor::EventLoop;
+using DaneJoe::Concurrent::Reactor::EventNotifier;
+using DaneJoe::Concurrent::Reactor::TimerId;
+using DaneJoe::Concurrent::ThreadPool::ThreadPool;
+
+namespace demo {
+
+static void set_non_blocking(int fd)
+{
+    ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+}
+
+static void test_pipe_readiness()
+{
+    int fds[2];
+    int result = ::pipe(fds);
+    assert(result == 0);
+    set_non_blocking(fds[0]);
+
+    EventLoop loop;
+    std::string received;
+    bool is_closed = false;
+    loop.add_fd(fds[0], EVENT_READABLE, [&](std::uint32_t events)
+        {
+            char buffer[64];
+            ssize_t size = ::read(fds[0], buffer, sizeof(buffer));
+            if (size > 0)
+            {
+                received.append(buffer, static_cast<std::size_t>(size));
+            }
+            else if (size == 0 || (events & EVENT_HANGUP))
+            {
+                is_closed = true;
+                loop.remove_fd(fds[0]);
+            }
+        });
+    assert(loop.get_fd_count() == 1);
+    assert(loop.poll(0) == 0);
+
+    std::thread writer([&fds]()
+        {
+            [[maybe_unused]] ssize_t written = ::write(fds[1], "hello ", 6);
+            std::this_thread::sleep_for(5ms);
+            written = ::write(fds[1], "pipe", 4);
+            ::close(fds[1]);
+        });
+    while (!is_closed)
+    {
+        loop.poll(1000);
+    }
+    writer.join();
+    assert(received == "hello pipe");
+    assert(loop.get_fd_count() == 0);
+    ::close(fds[0]);
+}
+
+static void test_socketpair_echo_with_pool()
+{
+    int fds[2];
+    int result = ::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0, fds);
+    assert(result == 0);
+
+    ThreadPool pool(2);
+    EventLoop loop(&pool);
+    std::atomic<int> completed{ 0 };
+    loop.add_fd(fds[0], EVENT_READABLE, [&](std::uint32_t)
+        {
+            char buffer[64];
+            ssize_t size = ::read(fds[0], buffer, sizeof(buffer));
+            if (size <= 0)
+            {
+                return;
+            }
+            std::string request(buffer, static_cast<std::size_t>(size));
+            assert(loop.is_in_loop_thread());
+            // 完成处理交给线程池，应答回到循环线程写出
+            loop.post([&, request]()
+                {
+                    assert(pool.is_worker_thread());
+                    std::string response = "echo:" + request;
+                    loop.execute([&, response]()
+                        {
+                            completed.fetch_add(1);
+                            [[maybe_unused]] ssize_t written = ::write(fds[0], response.data(), response.size());
+                        });
+                });
+        });
+    std::thread loop_thread([&loop]() { loop.run(); });
+
+    [[maybe_unused]] ssize_t written = ::write(fds[1], "ping", 4);
+    char buffer[64];
+    ssize_t size = -1;
+    auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (size <= 0 && std::chrono::steady_clock::now() < deadline)
+    {
+        size = ::read(fds[1], buffer, sizeof(buffer));
+        std::this_thread::sleep_for(1ms);
+    }
+    assert(std::string(buffer, static_cast<std::size_t>(size)) == "echo:ping");
+    assert(completed.load() == 1);
+
+    loop.stop();
+    loop_thread.join();
+    pool.shutdown();
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+static void test_timers()
+{
+    EventLoop loop;
+    std::vector<int> order;
+    int periodic_count = 0;
+    loop.add_timer(20ms, [&]() { order.push_back(2); });
+    loop.add_timer(5ms, [&]() { order.push_back(1); });
+    TimerId cancelled = loop.add_timer(10ms, [&]() { order.push_back(-1); });
+    TimerId periodic = loop.add_timer(2ms, [&]() { ++periodic_count; }, 2ms);
+    bool is_cancelled = loop.cancel_timer(cancelled);
+    assert(is_cancelled);
+    assert(loop.get_timer_count() == 3);
+
+    auto deadline = std::chrono::steady_clock::now() + 5s;
+    while ((order.size() < 2 || periodic_count < 3) && std::chrono::steady_clock::now() < deadline)
+    {
+        loop.poll(100);
+    }
+    assert((order == std::vector<int>{ 1, 2 }));
+    assert(periodic_count >= 3);
+    is_cancelled = loop.cancel_timer(periodic);
+    assert(is_cancelled);
+    assert(loop.get_timer_count() == 0);
+    int count_after_cancel = periodic_count;
+    loop.poll(10);
+    assert(periodic_count == count_after_cancel);
+}
+
+static void test_notifier_drains_queue()
+{
+    EventLoop loop;
+    MpmcBoundedQueue<int> queue(1024);
+    long sum = 0;
+    int received = 0;
+    std::unique_ptr<EventNotifier> notifier = loop.create_notifier([&]()
+        {
+            while (auto value = queue.try_pop())
+            {
+                sum += *value;
+                ++received;
+            }
+        });
+    std::thread producer([&]()
+        {
+            for (int i = 1; i <= 500; ++i)
+            {
+                queue.push(i);
+                notifier->notify();
+            }
+        });
+    auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (received < 500 && std::chrono::steady_clock::now() < deadline)
+    {
+        loop.poll(100);
+    }
+    producer.join();
+    assert(received == 500);
+    assert(sum == 500 * 501 / 2);
+    assert(loop.get_fd_count() == 1);
+    notifier.reset();
+    assert(loop.get_fd_count() == 0);
+}
+
+void run_reactor_demo()
+{
+    std::cout << "Reactor demo:\n";
+    test_pipe_readiness();
+    test_socketpair_echo_with_pool();
+    test_timers();
+    test_notifier_drains_queue();
+    std::cout << "  epoll event loop ok\n";
+}
+
+} // namespace demo
+
+#else
+
+namespace demo {
+
+void run_reactor_demo()
+{
+    std::cout << "Reactor demo:\n  skipped (Linux only)\n";
+}
+
+} // namespace demo
+
+#endif
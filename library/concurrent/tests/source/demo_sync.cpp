@@ -0,0 +1,99 @@
+#include <cassert>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "danejoe/concurrent/sync/spin_lock.hpp"
+#include "danejoe/concurrent/sync/ticket_lock.hpp"
+#include "danejoe/concurrent/sync/mcs_lock.hpp"
+#include "demo_sync.hpp"
+
+using DaneJoe::Concurrent::Sync::McsLock;
+using DaneJoe::Concurrent::Sync::SpinLock;
+using DaneJoe::Concurrent::Sync::TicketLock;
+
+namespace demo {
+
+template<class Lock>
+static void test_mutual_exclusion()
+{
+    Lock lock;
+    long counter = 0;
+    constexpr int thread_count = 4;
+    constexpr int per_thread = 20000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thread_count; ++t)
+    {
+        threads.emplace_back([&lock, &counter]()
+            {
+                for (int i = 0; i < per_thread; ++i)
+                {
+                    std::lock_guard<Lock> guard(lock);
+                    ++counter;
+                }
+            });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    assert(counter == thread_count * per_thread);
+}
+
+template<class Lock>
+static void test_try_lock()
+{
+    Lock lock;
+    bool is_locked = lock.try_lock();
+    assert(is_locked);
+    std::thread other([&lock]()
+        {
+            bool is_other_locked = lock.try_lock();
+            assert(!is_other_locked);
+        });
+    other.join();
+    lock.unlock();
+    std::unique_lock<Lock> guard(lock, std::try_to_lock);
+    assert(guard.owns_lock());
+}
+
+static void test_nested_mcs()
+{
+    // 同一线程同时持有多把 MCS 锁
+    McsLock first;
+    McsLock second;
+    long counter = 0;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 3; ++t)
+    {
+        threads.emplace_back([&]()
+            {
+                for (int i = 0; i < 5000; ++i)
+                {
+                    std::scoped_lock guard(first, second);
+                    ++counter;
+                }
+            });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    assert(counter == 15000);
+}
+
+void run_sync_demo()
+{
+    std::cout << "Sync demo:\n";
+    test_mutual_exclusion<SpinLock>();
+    test_mutual_exclusion<TicketLock>();
+    test_mutual_exclusion<McsLock>();
+    test_try_lock<SpinLock>();
+    test_try_lock<TicketLock>();
+    test_try_lock<McsLock>();
+    test_nested_mcs();
+    std::cout << "  spin, ticket and mcs locks ok\n";
+}
+
+} // namespace demo
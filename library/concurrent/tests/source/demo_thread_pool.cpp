@@ -0,0 +1,640 @@
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "danejoe/concurrent/thread_pool/thread_pool.hpp"
+#include "danejoe/concurrent/thread_pool/strand.hpp"
+#include "danejoe/concurrent/thread_pool/keyed_executor.hpp"
+#include "demo_thread_pool.hpp"
+
+using DaneJoe::Concurrent::ThreadPool::DeadlineMiss;
+using DaneJoe::Concurrent::ThreadPool::DeadlineMissPolicy;
+using DaneJoe::Concurrent::ThreadPool::Future;
+using DaneJoe::Concurrent::ThreadPool::IExecutor;
+using DaneJoe::Concurrent::ThreadPool::InlineExecutor;
+using DaneJoe::Concurrent::ThreadPool::KeyedExecutor;
+using DaneJoe::Concurrent::ThreadPool::Promise;
+using DaneJoe::Concurrent::ThreadPool::SchedulingPolicy;
+using DaneJoe::Concurrent::ThreadPool::Strand;
+using DaneJoe::Concurrent::ThreadPool::Task;
+using DaneJoe::Concurrent::ThreadPool::ThreadPool;
+using DaneJoe::Concurrent::ThreadPool::ThreadPoolOptions;
+using DaneJoe::Concurrent::ThreadPool::ThreadPoolStats;
+using DaneJoe::Concurrent::ThreadPool::when_all;
+using DaneJoe::Concurrent::ThreadPool::when_any;
+
+namespace demo {
+
+static void test_submit_and_get()
+{
+    ThreadPool pool(2);
+    auto sum = pool.submit([](int a, int b) { return a + b; }, 2, 3);
+    assert(sum.get() == 5);
+
+    auto failed = pool.submit([]() -> int { throw std::runtime_error("boom"); });
+    bool is_thrown = false;
+    try
+    {
+        failed.get();
+    }
+    catch (const std::runtime_error&)
+    {
+        is_thrown = true;
+    }
+    assert(is_thrown);
+}
+
+static void test_then_chain()
+{
+    ThreadPool pool(2);
+    auto inline_chain = pool.submit([]() { return 20; })
+        .then([](int value) { return value + 1; })
+        .then([](int value) { return std::to_string(value * 2); });
+    assert(inline_chain.get() == "42");
+
+    auto pooled_chain = pool.submit([]() {})
+        .then(pool, []() { return 7; });
+    assert(pooled_chain.get() == 7);
+}
+
+static void test_promise_and_broken_promise()
+{
+    Future<int> future;
+    {
+        Promise<int> promise;
+        future = promise.get_future();
+    }
+    bool is_broken = false;
+    try
+    {
+        future.get();
+    }
+    catch (const std::future_error& error)
+    {
+        is_broken = error.code() == std::future_errc::broken_promise;
+    }
+    assert(is_broken);
+}
+
+static void test_when_all_and_when_any()
+{
+    ThreadPool pool(4);
+    std::vector<Future<int>> futures;
+    for (int i = 0; i < 16; ++i)
+    {
+        futures.push_back(pool.submit([i]() { return i; }));
+    }
+    int total = 0;
+    for (auto& future : when_all(std::move(futures)).get())
+    {
+        total += future.get();
+    }
+    assert(total == 120);
+
+    auto mixed = when_all(pool.submit([]() { return 1; }), pool.submit([]() { return std::string("x"); })).get();
+    assert(std::get<0>(mixed).get() == 1);
+    assert(std::get<1>(mixed).get() == "x");
+
+    Promise<int> never_first;
+    std::vector<Future<int>> racers;
+    racers.push_back(never_first.get_future());
+    racers.push_back(pool.submit([]() { return 9; }));
+    auto first = when_any(std::move(racers)).get();
+    assert(first.index == 1);
+    assert(first.future.get() == 9);
+    never_first.set_value(0);
+}
+
+static void test_shutdown_drains_tasks()
+{
+    std::atomic<int> counter = 0;
+    {
+        ThreadPool pool(3);
+        for (int i = 0; i < 1000; ++i)
+        {
+            pool.post([&counter]() { counter.fetch_add(1); });
+        }
+    }
+    assert(counter.load() == 1000);
+
+    ThreadPool pool(1);
+    pool.shutdown();
+    bool is_rejected = false;
+    try
+    {
+        pool.submit([]() { return 1; }).get();
+    }
+    catch (const std::future_error& error)
+    {
+        is_rejected = error.code() == std::future_errc::broken_promise;
+    }
+    assert(is_rejected);
+
+    // execute() 不丢弃任务：关闭后在调用线程上执行，建立在其上的 Strand 不会停滞
+    bool is_run = false;
+    pool.execute([&is_run]() { is_run = true; });
+    assert(is_run);
+    Strand strand(pool);
+    int strand_count = 0;
+    strand.execute([&strand_count]() { ++strand_count; });
+    strand.execute([&strand_count]() { ++strand_count; });
+    assert(strand_count == 2);
+}
+
+static void test_pending_count_is_consistent()
+{
+    constexpr std::size_t producer_count = 4;
+    constexpr std::size_t per_producer = 20000;
+    // 取走任务的减计数若先于投递的加计数，待执行任务数会下溢为极大值；竞争窗口很短，重复多轮
+    for (int round = 0; round < 5; ++round)
+    {
+        ThreadPool pool(4);
+        std::atomic<bool> is_done = false;
+        std::atomic<std::size_t> max_pending = 0;
+        std::thread sampler([&]()
+            {
+                while (!is_done.load())
+                {
+                    std::size_t pending = pool.get_pending_count();
+                    if (pending > max_pending.load())
+                    {
+                        max_pending.store(pending);
+                    }
+                }
+            });
+        std::vector<std::thread> producers;
+        for (std::size_t i = 0; i < producer_count; ++i)
+        {
+            producers.emplace_back([&pool]()
+                {
+                    for (std::size_t j = 0; j < per_producer; ++j)
+                    {
+                        pool.post([]() {});
+                    }
+                });
+        }
+        for (auto& producer : producers)
+        {
+            producer.join();
+        }
+        pool.shutdown();
+        is_done.store(true);
+        sampler.join();
+        assert(max_pending.load() <= producer_count * per_producer);
+        assert(pool.get_pending_count() == 0);
+    }
+}
+
+static void test_strand_is_serial_and_ordered()
+{
+    ThreadPool pool(4);
+    Strand strand(pool, 64);
+    std::vector<int> order;
+    std::atomic<int> concurrent = 0;
+    std::atomic<bool> is_overlapped = false;
+    for (int i = 0; i < 500; ++i)
+    {
+        strand.execute([&, i]()
+            {
+                if (concurrent.fetch_add(1) != 0)
+                {
+                    is_overlapped.store(true);
+                }
+                order.push_back(i);
+                concurrent.fetch_sub(1);
+            });
+    }
+    strand.execute([]() {});
+    while (strand.size() != 0)
+    {
+        std::this_thread::yield();
+    }
+    pool.shutdown();
+    assert(!is_overlapped.load());
+    assert(order.size() == 500);
+    for (int i = 0; i < 500; ++i)
+    {
+        assert(order[i] == i);
+    }
+}
+
+static void test_strand_rejects_self_post_when_full()
+{
+    ThreadPool pool(2);
+    Strand strand(pool, 1);
+    std::promise<bool> result;
+    std::future<bool> result_future = result.get_future();
+    strand.execute([&strand, &result]()
+        {
+            bool is_posted = strand.try_post([]() {});
+            try
+            {
+                // 积压已满时在本 Strand 的任务中阻塞提交会等待自己，应立即拒绝
+                strand.execute([]() {});
+                result.set_value(false);
+            }
+            catch (const std::system_error& error)
+            {
+                result.set_value(is_posted && error.code() == std::errc::resource_deadlock_would_occur);
+            }
+        });
+    bool is_rejected = result_future.get();
+    assert(is_rejected);
+    pool.shutdown();
+}
+
+static void test_keyed_executor()
+{
+    ThreadPool pool(4);
+    // 容量足以容纳每个键的全部任务，投递不会被拒绝
+    KeyedExecutor<int> executor(pool, 128);
+    std::vector<std::vector<int>> per_key(4);
+    std::vector<Future<void>> futures;
+    for (int i = 0; i < 400; ++i)
+    {
+        int key = i % 4;
+        int sequence = i / 4;
+        bool is_posted = executor.post(key, [&per_key, key, sequence]() { per_key[key].push_back(sequence); });
+        assert(is_posted);
+    }
+    for (int key = 0; key < 4; ++key)
+    {
+        futures.push_back(executor.submit(key, []() {}));
+    }
+    when_all(std::move(futures)).get();
+    for (auto& sequences : per_key)
+    {
+        assert(sequences.size() == 100);
+        for (int i = 0; i < 100; ++i)
+        {
+            assert(sequences[i] == i);
+        }
+    }
+    pool.shutdown();
+    assert(executor.get_active_key_count() == 0);
+}
+
+static void test_keyed_executor_rejects_when_full()
+{
+    ThreadPool pool(2);
+    KeyedExecutor<int> executor(pool, 4);
+    std::promise<void> gate;
+    std::shared_future<void> gate_future = gate.get_future().share();
+    std::atomic<bool> is_started = false;
+    // 首个任务出队执行后阻塞，之后的任务留在队列中
+    bool is_posted = executor.post(0, [&is_started, gate_future]()
+        {
+            is_started.store(true);
+            gate_future.wait();
+        });
+    assert(is_posted);
+    while (!is_started.load())
+    {
+        std::this_thread::yield();
+    }
+    for (int i = 0; i < 4; ++i)
+    {
+        is_posted = executor.post(0, []() {});
+        assert(is_posted);
+    }
+    is_posted = executor.post(0, []() {});
+    assert(!is_posted);
+    bool is_rejected = false;
+    try
+    {
+        executor.submit(0, []() { return 1; }).get();
+    }
+    catch (const std::future_error& error)
+    {
+        is_rejected = error.code() == std::future_errc::broken_promise;
+    }
+    assert(is_rejected);
+    // 其他键不受影响
+    int other_value = executor.submit(1, []() { return 2; }).get();
+    assert(other_value == 2);
+    gate.set_value();
+    pool.shutdown();
+    assert(executor.get_active_key_count() == 0);
+}
+
+static void test_keyed_executor_lifetime()
+{
+    // 就地执行的底层执行器：排空结束时移除键需要获取分片锁，投递期间不得持有
+    KeyedExecutor<int> inline_executor(InlineExecutor::get_instance());
+    int value = 0;
+    bool is_posted = inline_executor.post(1, [&value]() { value = 1; });
+    assert(is_posted);
+    assert(value == 1);
+    assert(inline_executor.get_active_key_count() == 0);
+
+    // 执行器销毁时仍有活跃键：排空任务被丢弃后队列与积压任务应随之释放
+    struct HoldingExecutor : IExecutor
+    {
+        void execute(Task task)override
+        {
+            tasks.push_back(std::move(task));
+        }
+        std::vector<Task> tasks;
+    };
+    HoldingExecutor holding_executor;
+    auto sentinel = std::make_shared<int>(0);
+    std::weak_ptr<int> weak_sentinel = sentinel;
+    {
+        KeyedExecutor<int> executor(holding_executor);
+        is_posted = executor.post(0, [sentinel = std::move(sentinel)]() {});
+        assert(is_posted);
+    }
+    holding_executor.tasks.clear();
+    assert(weak_sentinel.expired());
+}
+
+static void test_elastic_grow_and_shrink()
+{
+    ThreadPoolOptions options;
+    options.min_thread_count = 1;
+    options.max_thread_count = 4;
+    options.grow_queue_depth = 4;
+    options.grow_wait_time = std::chrono::milliseconds(5);
+    options.idle_timeout = std::chrono::milliseconds(50);
+    options.sample_interval = std::chrono::milliseconds(1);
+    options.grow_cooldown = std::chrono::milliseconds(1);
+    ThreadPool pool(options);
+    assert(pool.get_thread_count() == 1);
+
+    std::vector<Future<int>> futures;
+    for (int i = 0; i < 16; ++i)
+    {
+        futures.push_back(pool.submit([i]()
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                return i;
+            }));
+    }
+    for (int i = 0; i < 16; ++i)
+    {
+        assert(futures[i].get() == i);
+    }
+    ThreadPoolStats stats = pool.get_stats();
+    assert(stats.peak_thread_count > 1 && stats.peak_thread_count <= 4);
+    assert(stats.queue_depth_grow_count + stats.wait_time_grow_count > 0);
+
+    // 空闲超时后收缩回最少线程数
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (pool.get_thread_count() > 1 && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    stats = pool.get_stats();
+    assert(stats.thread_count == 1);
+    assert(stats.shrink_count >= stats.peak_thread_count - 1);
+
+    // 收缩后仍能再次扩容并执行任务
+    assert(pool.submit([]() { return 7; }).get() == 7);
+
+    ThreadPool fixed(2);
+    assert(fixed.get_stats().thread_count == 2);
+    assert(fixed.get_stats().peak_thread_count == 2);
+}
+
+static void test_elastic_grow_cooldown()
+{
+    ThreadPoolOptions options;
+    options.min_thread_count = 1;
+    options.max_thread_count = 4;
+    options.grow_queue_depth = 2;
+    options.grow_wait_time = std::chrono::milliseconds(1);
+    options.sample_interval = std::chrono::milliseconds(1);
+    options.grow_cooldown = std::chrono::hours(1);
+    ThreadPool pool(options);
+
+    // 冷却期内积压不再触发扩容
+    std::vector<Future<int>> futures;
+    for (int i = 0; i < 16; ++i)
+    {
+        futures.push_back(pool.submit([i]()
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                return i;
+            }));
+    }
+    for (int i = 0; i < 16; ++i)
+    {
+        assert(futures[i].get() == i);
+    }
+    ThreadPoolStats stats = pool.get_stats();
+    assert(stats.peak_thread_count == 2);
+    assert(stats.queue_depth_grow_count + stats.wait_time_grow_count == 1);
+}
+
+static void test_managed_block_compensates()
+{
+    ThreadPoolOptions options;
+    options.min_thread_count = 1;
+    options.max_thread_count = 2;
+    options.grow_queue_depth = 1000;
+    options.grow_wait_time = std::chrono::hours(1);
+    ThreadPool pool(options);
+
+    // 唯一的工作线程阻塞等待后一个任务，补偿线程使后一个任务得以执行
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    Future<bool> blocked = pool.submit([&pool, released]()
+        {
+            pool.managed_block([&released]() { released.wait(); });
+            return true;
+        });
+    while (pool.get_stats().blocked_count == 0)
+    {
+        std::this_thread::yield();
+    }
+    pool.post([&release]() { release.set_value(); });
+    assert(blocked.get());
+    ThreadPoolStats stats = pool.get_stats();
+    assert(stats.compensation_count == 1);
+    assert(stats.peak_thread_count == 2);
+    assert(stats.blocked_count == 0);
+    assert(pool.managed_block([]() { return 3; }) == 3);
+}
+
+static void test_deadline_order()
+{
+    ThreadPoolOptions options;
+    options.min_thread_count = 1;
+    options.scheduling_policy = SchedulingPolicy::EarliestDeadlineFirst;
+    ThreadPool pool(options);
+
+    // 唯一的工作线程被占住期间投递，释放后按截止时间而非投递顺序执行
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    pool.post([released]() { released.wait(); });
+    std::mutex mutex;
+    std::vector<int> order;
+    auto record = [&mutex, &order](int value)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(value);
+        };
+    auto now = ThreadPool::Clock::now();
+    pool.post([&record]() { record(0); });
+    pool.post([&record]() { record(4); }, now + std::chrono::seconds(40));
+    pool.post([&record]() { record(1); }, now + std::chrono::seconds(10));
+    pool.post([&record]() { record(3); }, now + std::chrono::seconds(30));
+    Future<int> second = pool.submit(now + std::chrono::seconds(20), [&record]()
+        {
+            record(2);
+            return 2;
+        });
+    release.set_value();
+    assert(second.get() == 2);
+    pool.shutdown();
+    // 普通任务排在所有截止时间任务之后
+    assert((order == std::vector<int>{ 1, 2, 3, 4, 0 }));
+    ThreadPoolStats stats = pool.get_stats();
+    assert(stats.deadline_task_count == 4);
+    assert(stats.deadline_miss_count == 0);
+}
+
+static void test_deadline_miss_policies()
+{
+    std::atomic<int> handler_count = 0;
+    ThreadPoolOptions options;
+    options.min_thread_count = 1;
+    options.scheduling_policy = SchedulingPolicy::EarliestDeadlineFirst;
+    options.on_deadline_miss = [&handler_count](const DeadlineMiss& miss)
+        {
+            assert(miss.detected_time > miss.deadline);
+            handler_count.fetch_add(1);
+        };
+    {
+        ThreadPool pool(options);
+        std::atomic<bool> is_fresh_run = false;
+        auto past = ThreadPool::Clock::now() - std::chrono::milliseconds(1);
+        Future<int> expired = pool.submit(past, []() { return 1; });
+        Future<int> fresh = pool.submit(past + std::chrono::seconds(30), [&is_fresh_run]()
+            {
+                is_fresh_run.store(true);
+                return 2;
+            });
+        assert(fresh.get() == 2);
+        bool is_broken = false;
+        try
+        {
+            expired.get();
+        }
+        catch (const std::future_error&)
+        {
+            is_broken = true;
+        }
+        assert(is_broken);
+        pool.shutdown();
+        ThreadPoolStats stats = pool.get_stats();
+        assert(stats.deadline_task_count == 2);
+        assert(stats.deadline_miss_count == 1);
+        assert(stats.deadline_drop_count == 1);
+        assert(handler_count.load() == 1);
+    }
+
+    // 降级：超时任务排到未超时的截止时间任务之后，但仍会执行
+    options.deadline_miss_policy = DeadlineMissPolicy::Deprioritize;
+    {
+        ThreadPool pool(options);
+        std::promise<void> release;
+        std::shared_future<void> released = release.get_future().share();
+        pool.post([released]() { released.wait(); });
+        std::mutex mutex;
+        std::vector<int> order;
+        auto record = [&mutex, &order](int value)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                order.push_back(value);
+            };
+        auto now = ThreadPool::Clock::now();
+        pool.post([&record]() { record(1); }, now - std::chrono::milliseconds(1));
+        pool.post([&record]() { record(2); }, now + std::chrono::seconds(30));
+        release.set_value();
+        pool.shutdown();
+        assert((order == std::vector<int>{ 2, 1 }));
+        ThreadPoolStats stats = pool.get_stats();
+        assert(stats.deadline_miss_count == 1);
+        assert(stats.deadline_deprioritize_count == 1);
+        assert(stats.deadline_drop_count == 0);
+        assert(handler_count.load() == 2);
+    }
+
+    // 先进先出模式下截止时间只用于判断超时
+    options.scheduling_policy = SchedulingPolicy::Fifo;
+    options.deadline_miss_policy = DeadlineMissPolicy::Drop;
+    {
+        ThreadPool pool(options);
+        std::atomic<int> run_count = 0;
+        auto now = ThreadPool::Clock::now();
+        pool.post([&run_count]() { run_count.fetch_add(1); }, now - std::chrono::milliseconds(1));
+        pool.post([&run_count]() { run_count.fetch_add(1); }, now + std::chrono::seconds(30));
+        pool.shutdown();
+        assert(run_count.load() == 1);
+        assert(pool.get_stats().deadline_drop_count == 1);
+        assert(handler_count.load() == 3);
+    }
+}
+
+static void test_deadline_work_stealing()
+{
+    ThreadPoolOptions options;
+    options.min_thread_count = 2;
+    options.scheduling_policy = SchedulingPolicy::EarliestDeadlineFirst;
+    ThreadPool pool(options);
+
+    // 工作线程投递到本地堆后自身一直忙碌，任务只能由另一线程窃取执行
+    std::atomic<int> done_count = 0;
+    Future<int> producer = pool.submit([&pool, &done_count]()
+        {
+            auto now = ThreadPool::Clock::now();
+            for (int i = 0; i < 4; ++i)
+            {
+                pool.post([&done_count]() { done_count.fetch_add(1); }, now + std::chrono::seconds(30 + i));
+            }
+            auto limit = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+            while (done_count.load() < 4 && std::chrono::steady_clock::now() < limit)
+            {
+                std::this_thread::yield();
+            }
+            return done_count.load();
+        });
+    assert(producer.get() == 4);
+}
+
+void run_thread_pool_demo()
+{
+    std::cout << "ThreadPool demo:\n";
+    test_submit_and_get();
+    test_then_chain();
+    test_promise_and_broken_promise();
+    test_when_all_and_when_any();
+    test_shutdown_drains_tasks();
+    test_pending_count_is_consistent();
+    test_strand_is_serial_and_ordered();
+    test_strand_rejects_self_post_when_full();
+    test_keyed_executor();
+    test_keyed_executor_rejects_when_full();
+    test_keyed_executor_lifetime();
+    std::cout << "  futures, continuations, combinators and strands ok\n";
+    test_elastic_grow_and_shrink();
+    test_elastic_grow_cooldown();
+    test_managed_block_compensates();
+    std::cout << "  elastic sizing and managed blocking ok\n";
+    test_deadline_order();
+    test_deadline_miss_policies();
+    test_deadline_work_stealing();
+    std::cout << "  earliest-deadline-first scheduling ok\n";
+}
+
+} // namespace demo
@@ -11,6 +11,17 @@ using namespace std::literals::chrono_literals;
 
 #include "danejoe/concurrent/blocking/mpmc_bounded_queue.hpp"
 #include "demo_concurrent.hpp"
+#include "demo_thread_pool.hpp"
+#include "demo_coroutine.hpp"
+#include "demo_algorithm.hpp"
+#include "demo_lock_free.hpp"
+#include "demo_event_bus.hpp"
+#include "demo_actor.hpp"
+#include "demo_cancellation.hpp"
+#include "demo_sync.hpp"
+#include "demo_metrics.hpp"
+#include "demo_reactor.hpp"
+#include "demo_cache.hpp"
 
 using DaneJoe::Concurrent::Blocking::MpmcBoundedQueue;
 
@@ -471,5 +482,16 @@ static void test_batch_push_large_vector()
 int main()
 {
     demo::run_concurrent_demo();
+    demo::run_thread_pool_demo();
+    demo::run_coroutine_demo();
+    demo::run_algorithm_demo();
+    demo::run_lock_free_demo();
+    demo::run_event_bus_demo();
+    demo::run_actor_demo();
+    demo::run_cancellation_demo();
+    demo::run_sync_demo();
+    demo::run_metrics_demo();
+    demo::run_reactor_demo();
+    demo::run_cache_demo();
     return 0;
 }
\ No newline at end of file
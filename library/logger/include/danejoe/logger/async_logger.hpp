@@ -3,6 +3,10 @@
 /**
  * @file async_logger.hpp
  * @brief DaneJoe异步日志类头文件
+ * @details 异步模式下每个写日志的线程持有一个单生产者单消费者字节环，记录只写入本线程的环，不加锁；
+ *          后台线程一轮取空所有线程的环，按控制台与文件分别积压在缓冲区中，
+ *          按 LoggerConfig 的写出策略（积压字节数、时间间隔、日志级别、关闭）整块写出，而不是逐条刷新。
+ *          启用延迟格式化时 log_deferred() 的记录只含参数原始字节，由后台线程解码并格式化
  * @author DaneJoe001
  * @version 0.1.1
  * @date 2025-10-24
@@ -11,10 +15,17 @@
 #include <fstream>
 #include <thread>
 #include <queue>
+#include <chrono>
 #include <mutex>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstdint>
 #include <condition_variable>
 
 #include "danejoe/logger/i_logger.hpp"
+#include "danejoe/concurrent/lock_free/byte_ring.hpp"
+#include "danejoe/concurrent/sync/backoff.hpp"
 
 /**
  * @namespace DaneJoe
@@ -62,6 +73,62 @@ namespace DaneJoe
             int line_num = -1,
             int process_id = -1,
             const std::string& thread_id = "")override;
+        /**
+         * @brief 为延迟格式化记录预留本线程缓冲区
+         * @param level 日志级别
+         * @param size 记录字节数
+         * @return 预留的区域，context 为本线程的记录环；未启用延迟格式化、异步日志已停止或记录超过单条上限时 data 为空
+         */
+        DeferredSlot reserve_deferred(LogLevel level, std::size_t size)override;
+        /**
+         * @brief 发布预留的延迟格式化记录
+         * @param slot reserve_deferred() 返回的区域
+         */
+        void commit_deferred(const DeferredSlot& slot)override;
+    private:
+        /// @brief 记录输出到控制台
+        static constexpr std::uint32_t CONSOLE_SINK = 1;
+        /// @brief 记录输出到文件
+        static constexpr std::uint32_t FILE_SINK = 2;
+        /// @brief 记录要求立即写出
+        static constexpr std::uint32_t FLUSH_FLAG = 4;
+        /// @brief 记录为延迟格式化记录
+        static constexpr std::uint32_t DEFERRED_FLAG = 8;
+        /// @brief 后台线程无记录时的最长等待时间，兜底漏掉的唤醒
+        static constexpr std::chrono::milliseconds BACKEND_IDLE_WAIT = std::chrono::milliseconds(50);
+        /**
+         * @struct ThreadBuffer
+         * @brief 线程日志缓冲区
+         * @details 所属线程是唯一生产者，后台线程是唯一消费者
+         */
+        struct ThreadBuffer
+        {
+            /**
+             * @brief 构造函数
+             * @param capacity 字节容量
+             */
+            explicit ThreadBuffer(std::size_t capacity) :ring(capacity) {}
+            /// @brief 记录环，记录为输出目标掩码加日志文本
+            Concurrent::LockFree::SpscByteRing ring;
+            /// @brief 所属线程是否已退出，退出后取空即可移除
+            std::atomic<bool> is_retired = false;
+            /// @brief 日志器是否已销毁，线程据此清理缓存
+            std::atomic<bool> is_closed = false;
+        };
+        /**
+         * @struct ThreadBufferCache
+         * @brief 线程持有的各日志器缓冲区
+         */
+        struct ThreadBufferCache
+        {
+            /**
+             * @brief 析构函数
+             * @details 线程退出时标记缓冲区，由后台线程取空后移除
+             */
+            ~ThreadBufferCache();
+            /// @brief 日志器编号与缓冲区
+            std::vector<std::pair<std::uint64_t, std::shared_ptr<ThreadBuffer>>> entries;
+        };
     private:
         /**
          * @brief 启动异步日志
@@ -77,18 +144,90 @@ namespace DaneJoe
          */
         bool open_log_file();
         /**
-         * @brief 异步文件日志处理
+         * @brief 获取本线程的缓冲区，首次调用时创建并登记
+         * @return 缓冲区
+         */
+        ThreadBuffer& get_thread_buffer();
+        /**
+         * @brief 计算日志级别对应的输出目标掩码
+         * @param level 日志级别
+         * @return 输出目标掩码，含立即写出标志
+         */
+        std::uint32_t get_sink_mask(LogLevel level)const;
+        /**
+         * @brief 在本线程的缓冲区中预留记录并写入输出目标掩码
+         * @details 缓冲区满时退避等待，后台线程休眠时才唤醒它，直到预留成功或异步日志停止
+         * @param ring 本线程的记录环
+         * @param sink_mask 输出目标掩码
+         * @param size 掩码之后的负载字节数，不超过单条上限
+         * @return 负载可写区域；异步日志已停止时返回 nullptr
+         */
+        std::byte* reserve_record(Concurrent::LockFree::SpscByteRing& ring, std::uint32_t sink_mask, std::size_t size);
+        /**
+         * @brief 发布预留的记录，后台线程在等待时唤醒它
+         * @param ring 本线程的记录环
+         */
+        void commit_record(Concurrent::LockFree::SpscByteRing& ring);
+        /**
+         * @brief 写入本线程的缓冲区
+         * @param sink_mask 输出目标掩码
+         * @param log_str 日志文本
+         * @return 是否写入；异步日志已停止或文本超过单条上限时返回 false，由调用方同步写出
+         * @note 同步写出的超长记录可能先于本线程尚未被后台线程取走的记录
+         */
+        bool push_record(std::uint32_t sink_mask, const std::string& log_str);
+        /**
+         * @brief 解码延迟格式化记录并生成日志文本
+         * @param data 记录负载（DeferredRecord 及编码后的参数）
+         * @return 日志文本
+         */
+        std::string format_deferred(const std::byte* data);
+        /**
+         * @brief 唤醒等待中的后台线程
+         */
+        void wake_backend();
+        /**
+         * @brief 取空所有线程的缓冲区，追加到待写缓冲区
+         * @return 是否取到记录
+         */
+        bool drain_records();
+        /**
+         * @brief 判断是否有未取出的记录
+         * @return 是否有未取出的记录
+         */
+        bool has_pending_records();
+        /**
+         * @brief 判断是否应写出待写缓冲区
+         * @param now 当前时间
+         * @return 是否应写出
+         */
+        bool should_flush(std::chrono::steady_clock::time_point now)const;
+        /**
+         * @brief 计算后台线程的等待时间
+         * @param now 当前时间
+         * @return 等待时间，有积压时不超过距下次定时写出的时间
+         */
+        std::chrono::steady_clock::duration get_backend_wait_time(std::chrono::steady_clock::time_point now)const;
+        /**
+         * @brief 写出待写缓冲区
+         */
+        void write_batches();
+        /**
+         * @brief 同步写日志后判断是否刷新（需持有对应输出的互斥锁）
+         * @param level 日志级别
+         * @param last_flush_time 该输出上次刷新的时间，刷新时更新
+         * @return 是否刷新
          */
-        void async_file_log_handler();
+        bool should_flush_sync(LogLevel level, std::chrono::steady_clock::time_point& last_flush_time)const;
         /**
-         * @brief 异步控制台日志处理
+         * @brief 异步日志后台线程
          */
-        void async_console_log_handler();
+        void async_log_handler();
     private:
-        /// @brief 异步文件日志标志
-        std::atomic<bool> m_async_file_log_flag = false;
-        /// @brief 异步控制台日志标志
-        std::atomic<bool> m_async_console_log_flag = false;
+        /// @brief 日志器编号，区分线程缓存中的各日志器
+        std::uint64_t m_logger_id = 0;
+        /// @brief 异步日志标志
+        std::atomic<bool> m_async_log_flag = false;
         /// @brief 控制台互斥锁
         std::mutex m_console_mutex;
         /// @brief 文件互斥锁
@@ -97,22 +236,30 @@ namespace DaneJoe
         std::ofstream m_log_file;
         /// @brief 调用栈
         std::queue<std::string> m_call_stack;
-        /// @brief 文件日志队列互斥锁
-        std::mutex m_file_log_queue_mutex;
-        /// @brief 控制台日志队列互斥锁
-        std::mutex m_console_log_queue_mutex;
-        /// @brief 文件日志队列
-        std::queue<std::string> m_file_log_queue;
-        /// @brief 控制台日志队列
-        std::queue<std::string> m_console_log_queue;
-        /// @brief 异步文件日志线程
-        std::thread m_async_file_log_thread;
-        /// @brief 异步控制台日志线程
-        std::thread m_async_console_log_thread;
-        /// @brief 文件日志队列条件变量
-        std::condition_variable m_file_log_queue_cond;
-        /// @brief 控制台日志队列条件变量
-        std::condition_variable m_console_log_queue_cond;
+        /// @brief 线程缓冲区列表互斥锁，只在登记线程与后台取记录时使用
+        std::mutex m_thread_buffers_mutex;
+        /// @brief 各线程缓冲区
+        std::vector<std::shared_ptr<ThreadBuffer>> m_thread_buffers;
+        /// @brief 后台线程是否在等待
+        std::atomic<bool> m_is_backend_waiting = false;
+        /// @brief 后台线程等待互斥锁
+        std::mutex m_backend_mutex;
+        /// @brief 后台线程等待条件变量
+        std::condition_variable m_backend_cond;
+        /// @brief 异步日志后台线程
+        std::thread m_async_log_thread;
+        /// @brief 待写入控制台的文本
+        std::string m_console_batch;
+        /// @brief 待写入文件的文本
+        std::string m_file_batch;
+        /// @brief 待写文本中是否有要求立即写出的记录（后台线程独占）
+        bool m_is_flush_requested = false;
+        /// @brief 上次写出待写缓冲区的时间（后台线程独占）
+        std::chrono::steady_clock::time_point m_last_flush_time = std::chrono::steady_clock::now();
+        /// @brief 同步模式控制台上次刷新的时间，由 m_console_mutex 保护
+        std::chrono::steady_clock::time_point m_console_flush_time = std::chrono::steady_clock::now();
+        /// @brief 同步模式文件上次刷新的时间，由 m_file_mutex 保护
+        std::chrono::steady_clock::time_point m_file_flush_time = std::chrono::steady_clock::now();
 
     };
     /**
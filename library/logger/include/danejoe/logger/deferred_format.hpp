@@ -0,0 +1,182 @@
+#pragma once
+
+/**
+ * @file deferred_format.hpp
+ * @brief 延迟格式化的参数编解码
+ * @details 调用点只把参数的原始字节写入记录：算术类型按值拷贝，字符串写入 4 字节长度加内容；
+ *          后台线程按调用点的参数类型实例化的解码函数还原参数后再格式化
+ * @author DaneJoe001
+ * @version 0.1.1
+ * @date 2026-10-18
+ */
+
+#include <tuple>
+#include <format>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <concepts>
+#include <string_view>
+#include <type_traits>
+
+/**
+ * @namespace DaneJoe
+ * @brief DaneJoe命名空间
+ */
+namespace DaneJoe
+{
+    /**
+     * @namespace Detail
+     * @brief 实现细节命名空间
+     */
+    namespace Detail
+    {
+        /**
+         * @struct LogArgCodec
+         * @brief 日志参数编解码，未特化的类型不支持延迟格式化
+         * @tparam T 参数类型（已退化）
+         */
+        template<class T, class = void>
+        struct LogArgCodec;
+        /**
+         * @struct LogArgCodec
+         * @brief 算术类型按值拷贝
+         * @tparam T 算术类型
+         */
+        template<class T>
+        struct LogArgCodec<T, std::enable_if_t<std::is_arithmetic_v<T>>>
+        {
+            /// @brief 解码后的类型
+            using Decoded = T;
+            /**
+             * @brief 计算编码字节数
+             * @param value 参数
+             * @return std::size_t 字节数
+             */
+            static std::size_t get_size(T value)noexcept
+            {
+                (void)value;
+                return sizeof(T);
+            }
+            /**
+             * @brief 编码
+             * @param cursor 写位置，写入后前移
+             * @param value 参数
+             */
+            static void encode(std::byte*& cursor, T value)noexcept
+            {
+                std::memcpy(cursor, &value, sizeof(T));
+                cursor += sizeof(T);
+            }
+            /**
+             * @brief 解码
+             * @param cursor 读位置，读取后前移
+             * @return Decoded 参数
+             */
+            static Decoded decode(const std::byte*& cursor)noexcept
+            {
+                T value;
+                std::memcpy(&value, cursor, sizeof(T));
+                cursor += sizeof(T);
+                return value;
+            }
+        };
+        /**
+         * @struct StringArgCodec
+         * @brief 字符串写入长度与内容，解码为指向记录内部的 string_view
+         */
+        struct StringArgCodec
+        {
+            /// @brief 解码后的类型
+            using Decoded = std::string_view;
+            /**
+             * @brief 计算编码字节数
+             * @param value 参数
+             * @return std::size_t 字节数
+             */
+            static std::size_t get_size(std::string_view value)noexcept
+            {
+                return sizeof(std::uint32_t) + value.size();
+            }
+            /**
+             * @brief 编码
+             * @param cursor 写位置，写入后前移
+             * @param value 参数
+             */
+            static void encode(std::byte*& cursor, std::string_view value)noexcept
+            {
+                std::uint32_t size = static_cast<std::uint32_t>(value.size());
+                std::memcpy(cursor, &size, sizeof(size));
+                std::memcpy(cursor + sizeof(size), value.data(), value.size());
+                cursor += sizeof(size) + value.size();
+            }
+            /**
+             * @brief 解码
+             * @param cursor 读位置，读取后前移
+             * @return Decoded 参数，在记录归还前有效
+             */
+            static Decoded decode(const std::byte*& cursor)noexcept
+            {
+                std::uint32_t size = 0;
+                std::memcpy(&size, cursor, sizeof(size));
+                Decoded value(reinterpret_cast<const char*>(cursor + sizeof(size)), size);
+                cursor += sizeof(size) + size;
+                return value;
+            }
+        };
+        /**
+         * @struct LogArgCodec
+         * @brief C 字符串
+         */
+        template<>
+        struct LogArgCodec<const char*> :StringArgCodec {};
+        /**
+         * @struct LogArgCodec
+         * @brief C 字符串
+         */
+        template<>
+        struct LogArgCodec<char*> :StringArgCodec {};
+        /**
+         * @struct LogArgCodec
+         * @brief 字符串
+         */
+        template<>
+        struct LogArgCodec<std::string> :StringArgCodec {};
+        /**
+         * @struct LogArgCodec
+         * @brief 字符串视图
+         */
+        template<>
+        struct LogArgCodec<std::string_view> :StringArgCodec {};
+        /**
+         * @brief 判断参数类型是否支持延迟格式化
+         * @tparam T 参数类型
+         */
+        template<class T>
+        concept DeferredLoggable = requires(const std::decay_t<T>&value)
+        {
+            { LogArgCodec<std::decay_t<T>>::get_size(value) } -> std::same_as<std::size_t>;
+        };
+        /// @brief 解码参数并格式化的函数
+        using DeferredDecoder = std::string(*)(std::string_view format, const std::byte* data);
+        /**
+         * @brief 解码参数并格式化
+         * @tparam Ts 参数类型（已退化）
+         * @param format 格式串
+         * @param data 编码后的参数
+         * @return std::string 格式化结果
+         */
+        template<class... Ts>
+        std::string decode_deferred_args(std::string_view format, const std::byte* data)
+        {
+            // 花括号初始化保证按参数顺序解码
+            std::tuple<typename LogArgCodec<Ts>::Decoded...> values{ LogArgCodec<Ts>::decode(data)... };
+            (void)data;
+            return std::apply([format](auto&... value)
+                {
+                    return std::vformat(format, std::make_format_args(value...));
+                }, values);
+        }
+    }
+}
@@ -10,9 +10,14 @@
  */
 
 #include <format>
+#include <chrono>
 #include <string>
 #include <thread>
 #include <memory>
+#include <cstring>
+#include <type_traits>
+
+#include "danejoe/logger/deferred_format.hpp"
 
 /**
  * @namespace DaneJoe
@@ -68,6 +73,18 @@ namespace DaneJoe
             bool enable_file = true;
             /// @brief 是否启用异步日志
             bool enable_async = true;
+            /// @brief 异步日志每个线程的缓冲区字节数，单条日志上限为其一半，更长的日志同步写出
+            std::size_t async_buffer_size = 256 * 1024;
+            /// @brief 待写出的日志达到该字节数时写出
+            std::size_t flush_size_threshold = 64 * 1024;
+            /// @brief 有待写出的日志时至多间隔该时间写出一次
+            std::chrono::milliseconds flush_interval = std::chrono::milliseconds(100);
+            /// @brief 达到该级别的日志立即写出（连同之前积压的日志）
+            LogLevel flush_level = LogLevel::ERROR;
+            /// @brief 关闭时是否写出积压的日志，为 false 时直接丢弃以加快退出
+            bool flush_on_shutdown = true;
+            /// @brief 是否启用延迟格式化：log_deferred() 只拷贝参数，由后台线程格式化（需同时启用异步日志）
+            bool enable_deferred_format = false;
             /// @brief 最大文件大小
             std::size_t max_file_size = 10 * 1024 * 1024;
             /// @brief 最大文件数量
@@ -102,6 +119,57 @@ namespace DaneJoe
             /// @brief 是否启用进程ID
             bool enable_proceed_id = false;
         };
+        /**
+         * @struct LogSite
+         * @brief 日志调用点的静态信息
+         * @details 由 DANEJOE_LOG_DEFERRED 在调用点定义为静态对象，记录只保存其地址
+         * @note 字符串须为静态存储期
+         */
+        struct LogSite
+        {
+            /// @brief 日志级别
+            LogLevel level;
+            /// @brief 模块名称
+            const char* module;
+            /// @brief 文件名称
+            const char* file_name;
+            /// @brief 函数名称
+            const char* function_name;
+            /// @brief 行号
+            int line_num;
+        };
+    protected:
+        /**
+         * @struct DeferredRecord
+         * @brief 延迟格式化记录头，其后紧跟编码后的参数
+         */
+        struct DeferredRecord
+        {
+            /// @brief 调用点
+            const LogSite* site;
+            /// @brief 按调用点参数类型实例化的解码函数
+            Detail::DeferredDecoder decode;
+            /// @brief 格式串，指向静态存储
+            const char* format_data;
+            /// @brief 格式串长度
+            std::size_t format_size;
+            /// @brief 调用时间（system_clock 计数）
+            std::chrono::system_clock::rep timestamp;
+            /// @brief 调用线程
+            std::thread::id thread_id;
+        };
+        static_assert(std::is_trivially_copyable_v<DeferredRecord>, "DeferredRecord must be trivially copyable");
+        /**
+         * @struct DeferredSlot
+         * @brief reserve_deferred() 预留的区域
+         */
+        struct DeferredSlot
+        {
+            /// @brief 可写区域，为空表示未预留
+            std::byte* data = nullptr;
+            /// @brief 实现使用的预留上下文，原样交给 commit_deferred()，避免提交时再次查找本线程缓冲区
+            void* context = nullptr;
+        };
     public:
         /**
          * @brief 构造函数
@@ -280,6 +348,62 @@ namespace DaneJoe
                 get_pid(),
                 to_string(std::this_thread::get_id()));
         }
+        /**
+         * @brief 延迟格式化日志
+         * @details 启用延迟格式化且参数均为算术类型或字符串时，调用点只把调用点地址、格式串、时间与参数原始字节
+         *          写入本线程的记录缓冲区，格式化由后台线程完成；否则立即格式化并按普通日志处理
+         * @note 格式串须为静态存储期（字符串字面量）
+         * @tparam Args 可变参数类型
+         * @param site 调用点
+         * @param fmt 格式化字符串
+         * @param args 可变参数
+         */
+        template<typename... Args>
+        void log_deferred(const LogSite& site, std::format_string<Args...> fmt, Args&&... args)
+        {
+            if (!is_level_enabled(site.level))
+            {
+                return;
+            }
+            if constexpr ((Detail::DeferredLoggable<Args> && ...))
+            {
+                std::size_t args_size = (Detail::LogArgCodec<std::decay_t<Args>>::get_size(args) + ... + std::size_t(0));
+                DeferredSlot slot = reserve_deferred(site.level, sizeof(DeferredRecord) + args_size);
+                if (slot.data)
+                {
+                    std::string_view format = fmt.get();
+                    DeferredRecord record{ &site,
+                        &Detail::decode_deferred_args<std::decay_t<Args>...>,
+                        format.data(),
+                        format.size(),
+                        std::chrono::system_clock::now().time_since_epoch().count(),
+                        std::this_thread::get_id() };
+                    std::memcpy(slot.data, &record, sizeof(record));
+                    std::byte* cursor = slot.data + sizeof(record);
+                    (Detail::LogArgCodec<std::decay_t<Args>>::encode(cursor, args), ...);
+                    commit_deferred(slot);
+                    return;
+                }
+            }
+            log_msg(site.level,
+                site.module,
+                std::format(fmt, std::forward<Args>(args)...),
+                site.file_name,
+                site.function_name,
+                site.line_num,
+                get_pid(),
+                to_string(std::this_thread::get_id()));
+        }
+        /**
+         * @brief 判断该级别的日志是否有输出目标
+         * @param level 日志级别
+         * @return 是否输出
+         */
+        bool is_level_enabled(LogLevel level)const
+        {
+            return (m_config.enable_console && m_config.console_level <= level)
+                || (m_config.enable_file && m_config.file_level <= level);
+        }
         /**
          * @brief 析构函数
          */
@@ -329,7 +453,40 @@ namespace DaneJoe
             int line_num = -1,
             int process_id = -1,
             const std::string& thread_id = "");
+        /**
+         * @brief 以给定时间字符串生成日志头
+         * @param time_str 时间字符串
+         * @param level 日志级别
+         * @param module 模块名称
+         * @param file_name 文件名称
+         * @param function_name 函数名称
+         * @param line_num 行号
+         * @param process_id 进程ID
+         * @param thread_id 线程ID
+         * @return 日志头
+         */
+        std::string format_header(const std::string& time_str,
+            LogLevel level,
+            const std::string& module,
+            const std::string& file_name = "",
+            const std::string& function_name = "",
+            int line_num = -1,
+            int process_id = -1,
+            const std::string& thread_id = "");
     protected:
+        /**
+         * @brief 为延迟格式化记录预留本线程缓冲区
+         * @details 默认不支持延迟格式化，返回空区域使调用方立即格式化
+         * @param level 日志级别
+         * @param size 记录字节数
+         * @return 预留的区域，data 非空时调用方写入后必须以该区域调用 commit_deferred()
+         */
+        virtual DeferredSlot reserve_deferred(LogLevel level, std::size_t size);
+        /**
+         * @brief 发布 reserve_deferred() 预留的记录
+         * @param slot reserve_deferred() 返回的区域
+         */
+        virtual void commit_deferred(const DeferredSlot& slot);
         /**
          * @brief 日志消息
          * @param level 日志级别
@@ -370,4 +527,19 @@ namespace DaneJoe
          */
         virtual std::shared_ptr<ILogger> operator()(const ILogger::LoggerConfig& config) = 0;
     };
-};
\ No newline at end of file
+};
+/**
+ * @brief 延迟格式化日志宏
+ * @details 在调用点定义静态 LogSite，参数编码后由后台线程格式化；日志器由调用方持有，避免按名称查找
+ * @param logger 日志器指针（如 std::shared_ptr<DaneJoe::ILogger>）
+ * @param level 日志级别名称，如 INFO
+ * @param module 模块名称，须为字符串字面量
+ * @param fmt 格式化字符串，须为字符串字面量
+ * @param ... 可变参数
+ */
+#define DANEJOE_LOG_DEFERRED(logger,level,module,fmt,...)\
+do\
+{\
+    static const DaneJoe::ILogger::LogSite danejoe_log_site{ DaneJoe::ILogger::LogLevel::level, module, __FILE__, __FUNCTION__, __LINE__ };\
+    (logger)->log_deferred(danejoe_log_site, fmt, ##__VA_ARGS__);\
+}while (0)
@@ -1,13 +1,30 @@
 #include <iostream>
 #include <format>
 #include <string>
+#include <cstring>
+#include <string_view>
+#include <algorithm>
 #include <filesystem>
 
 #include "danejoe/logger/async_logger.hpp"
+#include "danejoe/common/time_util.hpp"
 
 namespace fs = std::filesystem;
 
-DaneJoe::AsyncLogger::AsyncLogger()
+namespace
+{
+    /**
+     * @brief 分配日志器编号
+     * @return 编号，从 1 开始
+     */
+    std::uint64_t next_logger_id()
+    {
+        static std::atomic<std::uint64_t> counter = 0;
+        return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+}
+
+DaneJoe::AsyncLogger::AsyncLogger() :m_logger_id(next_logger_id())
 {
     if (m_config.enable_async)
     {
@@ -18,9 +35,14 @@ DaneJoe::AsyncLogger::AsyncLogger()
 DaneJoe::AsyncLogger::~AsyncLogger()
 {
     stop_async_log();
+    std::lock_guard<std::mutex> lock(m_thread_buffers_mutex);
+    for (auto& buffer : m_thread_buffers)
+    {
+        buffer->is_closed.store(true, std::memory_order_release);
+    }
 }
 
-DaneJoe::AsyncLogger::AsyncLogger(const LoggerConfig& config) :ILogger(config)
+DaneJoe::AsyncLogger::AsyncLogger(const LoggerConfig& config) :ILogger(config), m_logger_id(next_logger_id())
 {
     if (config.enable_async)
     {
@@ -28,34 +50,32 @@ DaneJoe::AsyncLogger::AsyncLogger(const LoggerConfig& config) :ILogger(config)
     }
 }
 
-void DaneJoe::AsyncLogger::stop_async_log()
+DaneJoe::AsyncLogger::ThreadBufferCache::~ThreadBufferCache()
 {
+    for (auto& entry : entries)
     {
-        std::unique_lock<std::mutex> lock(m_console_log_queue_mutex);
-        m_console_log_queue_cond.wait(lock, [this]()
-            {
-                return m_console_log_queue.empty();
-            });
-        m_async_console_log_flag.store(false);
-        m_console_log_queue_cond.notify_all();
+        entry.second->is_retired.store(true, std::memory_order_release);
     }
+}
+
+void DaneJoe::AsyncLogger::stop_async_log()
+{
+    if (m_async_log_flag.exchange(false))
     {
-        std::unique_lock<std::mutex> lock(m_file_log_queue_mutex);
-        m_file_log_queue_cond.wait(lock, [this]()
-            {
-                return m_file_log_queue.empty();
-            });
-        m_async_file_log_flag.store(false);
-        m_file_log_queue_cond.notify_all();
+        wake_backend();
     }
-    if (m_async_file_log_thread.joinable())
+    if (m_async_log_thread.joinable())
     {
-        m_async_file_log_thread.join();
+        m_async_log_thread.join();
     }
-    if (m_async_console_log_thread.joinable())
+    // 停止前已进入 push_record 的线程可能在后台线程最后一轮之后才提交
+    drain_records();
+    if (m_config.flush_on_shutdown)
     {
-        m_async_console_log_thread.join();
+        write_batches();
     }
+    m_console_batch.clear();
+    m_file_batch.clear();
 }
 
 void DaneJoe::AsyncLogger::log_msg(LogLevel level,
@@ -67,38 +87,36 @@ void DaneJoe::AsyncLogger::log_msg(LogLevel level,
     int process_id,
     const std::string& thread_id)
 {
+    std::uint32_t sink_mask = get_sink_mask(level);
+    if (sink_mask == 0)
+    {
+        return;
+    }
     std::string header = get_header(level, module, log_info, file_name, function_name, line_num, process_id, thread_id);
     std::string log_str = std::format("{}[:] [{}] ", header, log_info);
-    if (m_config.enable_console && m_config.console_level <= level)
+    if (m_async_log_flag.load(std::memory_order_acquire) && push_record(sink_mask, log_str))
     {
-        if (m_async_console_log_flag.load())
-        {
-            std::lock_guard<std::mutex> lock(m_console_log_queue_mutex);
-            m_console_log_queue.push(log_str);
-            std::atomic_thread_fence(std::memory_order_seq_cst);
-            m_console_log_queue_cond.notify_one();
-        }
-        else
-        {
-            std::lock_guard<std::mutex> lock(m_console_mutex);
-            std::cout << log_str << std::endl;
-        }
+        return;
     }
-    if (m_config.enable_file && m_config.file_level <= level)
+    if (sink_mask & CONSOLE_SINK)
     {
-        if (m_async_file_log_flag.load())
+        std::lock_guard<std::mutex> lock(m_console_mutex);
+        std::cout << log_str << '\n';
+        if (should_flush_sync(level, m_console_flush_time))
         {
-            std::lock_guard<std::mutex> lock(m_file_log_queue_mutex);
-            m_file_log_queue.push(log_str);
-            std::atomic_thread_fence(std::memory_order_seq_cst);
-            m_file_log_queue_cond.notify_one();
+            std::cout.flush();
         }
-        else
+    }
+    if (sink_mask & FILE_SINK)
+    {
+        std::lock_guard<std::mutex> lock(m_file_mutex);
+        if (open_log_file())
         {
-            std::lock_guard<std::mutex> lock(m_file_mutex);
-            if (open_log_file())
+            // 文件流自身的缓冲区合并写入，按写出策略刷新
+            m_log_file << log_str << '\n';
+            if (should_flush_sync(level, m_file_flush_time))
             {
-                m_log_file << log_str << std::endl;
+                m_log_file.flush();
             }
         }
     }
@@ -130,72 +148,288 @@ std::shared_ptr<DaneJoe::ILogger> DaneJoe::DaneJoeLoggerCreator::operator()(cons
     return std::make_shared<AsyncLogger>(config);
 }
 
-void DaneJoe::AsyncLogger::async_file_log_handler()
+DaneJoe::AsyncLogger::ThreadBuffer& DaneJoe::AsyncLogger::get_thread_buffer()
 {
-    while (true)
+    thread_local ThreadBufferCache cache;
+    for (auto& entry : cache.entries)
     {
-        if (!m_async_file_log_flag.load())
+        if (entry.first == m_logger_id)
         {
-            return;
+            return *entry.second;
         }
-        std::unique_lock<std::mutex> lock(m_file_log_queue_mutex);
-        m_file_log_queue_cond.wait(
-            lock,
-            [this]
-            {
-                return !m_file_log_queue.empty() || !m_async_file_log_flag.load();
-            });
-        if (!m_file_log_queue.empty())
+    }
+    // 顺带清理已销毁日志器的缓冲区
+    std::erase_if(cache.entries, [](const auto& entry)
         {
-            std::string log_str = m_file_log_queue.front();
-            m_file_log_queue.pop();
-            std::atomic_thread_fence(std::memory_order_seq_cst);
-            if (open_log_file())
-            {
-                m_log_file << log_str << std::endl;
-                std::flush(m_log_file);
-            }
-            m_file_log_queue_cond.notify_all();
+            return entry.second->is_closed.load(std::memory_order_acquire);
+        });
+    auto buffer = std::make_shared<ThreadBuffer>(m_config.async_buffer_size);
+    {
+        std::lock_guard<std::mutex> lock(m_thread_buffers_mutex);
+        m_thread_buffers.push_back(buffer);
+    }
+    cache.entries.emplace_back(m_logger_id, buffer);
+    return *buffer;
+}
+
+std::uint32_t DaneJoe::AsyncLogger::get_sink_mask(LogLevel level)const
+{
+    std::uint32_t sink_mask = 0;
+    if (m_config.enable_console && m_config.console_level <= level)
+    {
+        sink_mask |= CONSOLE_SINK;
+    }
+    if (m_config.enable_file && m_config.file_level <= level)
+    {
+        sink_mask |= FILE_SINK;
+    }
+    if (sink_mask != 0 && m_config.flush_level <= level)
+    {
+        sink_mask |= FLUSH_FLAG;
+    }
+    return sink_mask;
+}
+
+std::byte* DaneJoe::AsyncLogger::reserve_record(Concurrent::LockFree::SpscByteRing& ring, std::uint32_t sink_mask, std::size_t size)
+{
+    std::size_t record_size = sizeof(sink_mask) + size;
+    std::byte* destination = ring.reserve(record_size);
+    Concurrent::Sync::Backoff backoff;
+    while (!destination)
+    {
+        // 缓冲区满，等待后台线程取走
+        if (!m_async_log_flag.load(std::memory_order_acquire))
+        {
+            return nullptr;
+        }
+        // 后台线程正在取记录时不必反复加锁通知；它在休眠前会检查各缓冲区，满的缓冲区不会被漏掉
+        if (m_is_backend_waiting.load(std::memory_order_relaxed))
+        {
+            wake_backend();
         }
+        backoff.pause();
+        destination = ring.reserve(record_size);
+    }
+    std::memcpy(destination, &sink_mask, sizeof(sink_mask));
+    return destination + sizeof(sink_mask);
+}
+
+void DaneJoe::AsyncLogger::commit_record(Concurrent::LockFree::SpscByteRing& ring)
+{
+    ring.commit();
+    // 与后台线程设置等待标志后的检查配对，避免双方都错过对方
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_is_backend_waiting.load(std::memory_order_relaxed))
+    {
+        wake_backend();
+    }
+}
+
+bool DaneJoe::AsyncLogger::push_record(std::uint32_t sink_mask, const std::string& log_str)
+{
+    Concurrent::LockFree::SpscByteRing& ring = get_thread_buffer().ring;
+    if (sizeof(sink_mask) + log_str.size() > ring.get_max_record_size())
+    {
+        // 不截断，交由调用方同步写出
+        return false;
+    }
+    std::byte* destination = reserve_record(ring, sink_mask, log_str.size());
+    if (!destination)
+    {
+        return false;
     }
+    std::memcpy(destination, log_str.data(), log_str.size());
+    commit_record(ring);
+    return true;
 }
 
-void DaneJoe::AsyncLogger::async_console_log_handler()
+DaneJoe::ILogger::DeferredSlot DaneJoe::AsyncLogger::reserve_deferred(LogLevel level, std::size_t size)
+{
+    if (!m_config.enable_deferred_format || !m_async_log_flag.load(std::memory_order_acquire))
+    {
+        return DeferredSlot{};
+    }
+    Concurrent::LockFree::SpscByteRing& ring = get_thread_buffer().ring;
+    if (sizeof(std::uint32_t) + size > ring.get_max_record_size())
+    {
+        return DeferredSlot{};
+    }
+    return DeferredSlot{ reserve_record(ring, get_sink_mask(level) | DEFERRED_FLAG, size), &ring };
+}
+
+void DaneJoe::AsyncLogger::commit_deferred(const DeferredSlot& slot)
+{
+    commit_record(*static_cast<Concurrent::LockFree::SpscByteRing*>(slot.context));
+}
+
+std::string DaneJoe::AsyncLogger::format_deferred(const std::byte* data)
+{
+    DeferredRecord record;
+    std::memcpy(&record, data, sizeof(record));
+    std::string log_info = record.decode(std::string_view(record.format_data, record.format_size), data + sizeof(record));
+    std::chrono::system_clock::time_point time{ std::chrono::system_clock::duration(record.timestamp) };
+    const LogSite& site = *record.site;
+    std::string header = format_header(TimeUtil::get_time_str(time),
+        site.level,
+        site.module,
+        site.file_name,
+        site.function_name,
+        site.line_num,
+        get_pid(),
+        to_string(record.thread_id));
+    return std::format("{}[:] [{}] ", header, log_info);
+}
+
+void DaneJoe::AsyncLogger::wake_backend()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_backend_mutex);
+    }
+    m_backend_cond.notify_one();
+}
+
+bool DaneJoe::AsyncLogger::drain_records()
+{
+    std::size_t count = 0;
+    std::lock_guard<std::mutex> lock(m_thread_buffers_mutex);
+    std::erase_if(m_thread_buffers, [this, &count](const std::shared_ptr<ThreadBuffer>& buffer)
+        {
+            // 先读退出标志再取记录，标志为真时取空后不会再有新记录
+            bool is_retired = buffer->is_retired.load(std::memory_order_acquire);
+            count += buffer->ring.consume([this](std::span<const std::byte> record)
+                {
+                    std::uint32_t sink_mask = 0;
+                    std::memcpy(&sink_mask, record.data(), sizeof(sink_mask));
+                    if (sink_mask & FLUSH_FLAG)
+                    {
+                        m_is_flush_requested = true;
+                    }
+                    std::string deferred_text;
+                    std::string_view text(reinterpret_cast<const char*>(record.data()) + sizeof(sink_mask),
+                        record.size() - sizeof(sink_mask));
+                    if (sink_mask & DEFERRED_FLAG)
+                    {
+                        deferred_text = format_deferred(record.data() + sizeof(sink_mask));
+                        text = deferred_text;
+                    }
+                    if (sink_mask & CONSOLE_SINK)
+                    {
+                        m_console_batch.append(text);
+                        m_console_batch.push_back('\n');
+                    }
+                    if (sink_mask & FILE_SINK)
+                    {
+                        m_file_batch.append(text);
+                        m_file_batch.push_back('\n');
+                    }
+                });
+            return is_retired && buffer->ring.empty();
+        });
+    return count > 0;
+}
+
+bool DaneJoe::AsyncLogger::has_pending_records()
+{
+    std::lock_guard<std::mutex> lock(m_thread_buffers_mutex);
+    return std::any_of(m_thread_buffers.begin(), m_thread_buffers.end(), [](const std::shared_ptr<ThreadBuffer>& buffer)
+        {
+            return !buffer->ring.empty();
+        });
+}
+
+bool DaneJoe::AsyncLogger::should_flush(std::chrono::steady_clock::time_point now)const
+{
+    if (m_console_batch.empty() && m_file_batch.empty())
+    {
+        return false;
+    }
+    return m_is_flush_requested
+        || m_console_batch.size() >= m_config.flush_size_threshold
+        || m_file_batch.size() >= m_config.flush_size_threshold
+        || now - m_last_flush_time >= m_config.flush_interval;
+}
+
+std::chrono::steady_clock::duration DaneJoe::AsyncLogger::get_backend_wait_time(std::chrono::steady_clock::time_point now)const
+{
+    std::chrono::steady_clock::duration wait_time = BACKEND_IDLE_WAIT;
+    if (!m_console_batch.empty() || !m_file_batch.empty())
+    {
+        std::chrono::steady_clock::time_point flush_time = m_last_flush_time + m_config.flush_interval;
+        wait_time = std::min(wait_time, std::max(flush_time - now, std::chrono::steady_clock::duration::zero()));
+    }
+    return wait_time;
+}
+
+bool DaneJoe::AsyncLogger::should_flush_sync(LogLevel level, std::chrono::steady_clock::time_point& last_flush_time)const
+{
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (m_config.flush_level <= level || now - last_flush_time >= m_config.flush_interval)
+    {
+        last_flush_time = now;
+        return true;
+    }
+    return false;
+}
+
+void DaneJoe::AsyncLogger::write_batches()
+{
+    m_is_flush_requested = false;
+    m_last_flush_time = std::chrono::steady_clock::now();
+    if (!m_console_batch.empty())
+    {
+        std::lock_guard<std::mutex> lock(m_console_mutex);
+        std::cout.write(m_console_batch.data(), static_cast<std::streamsize>(m_console_batch.size()));
+        std::cout.flush();
+        m_console_batch.clear();
+    }
+    if (!m_file_batch.empty())
+    {
+        std::lock_guard<std::mutex> lock(m_file_mutex);
+        if (open_log_file())
+        {
+            m_log_file.write(m_file_batch.data(), static_cast<std::streamsize>(m_file_batch.size()));
+            m_log_file.flush();
+        }
+        m_file_batch.clear();
+    }
+}
+
+void DaneJoe::AsyncLogger::async_log_handler()
 {
     while (true)
     {
-        if (!m_async_console_log_flag.load())
+        bool is_running = m_async_log_flag.load(std::memory_order_acquire);
+        bool has_records = drain_records();
+        if (!is_running)
         {
+            // 观察到停止后又取过一轮，积压与之后的记录由 stop_async_log() 处理
             return;
         }
-        std::unique_lock<std::mutex> lock(m_console_log_queue_mutex);
-        m_console_log_queue_cond.wait(lock, [this]()
-            {
-                return !m_console_log_queue.empty() || !m_async_console_log_flag.load();
-            });
-        if (!m_console_log_queue.empty())
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if (should_flush(now))
         {
-            std::string log_str = m_console_log_queue.front();
-            m_console_log_queue.pop();
-            std::atomic_thread_fence(std::memory_order_seq_cst);
-            std::cout << log_str << std::endl;
-            std::flush(std::cout);
-            m_console_log_queue_cond.notify_all();
+            write_batches();
         }
+        if (has_records)
+        {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(m_backend_mutex);
+        m_is_backend_waiting.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!has_pending_records() && m_async_log_flag.load(std::memory_order_acquire))
+        {
+            m_backend_cond.wait_for(lock, get_backend_wait_time(now));
+        }
+        m_is_backend_waiting.store(false, std::memory_order_relaxed);
     }
 }
 
 void DaneJoe::AsyncLogger::start_async_log()
 {
-    if (!m_async_file_log_flag.load())
+    if (!m_async_log_flag.load())
     {
-        m_async_file_log_flag.store(true);
-        m_async_file_log_thread = std::thread(&AsyncLogger::async_file_log_handler, this);
+        m_async_log_flag.store(true);
+        m_async_log_thread = std::thread(&AsyncLogger::async_log_handler, this);
     }
-    if (!m_async_console_log_flag.load())
-    {
-        m_async_console_log_flag.store(true);
-        m_async_console_log_thread = std::thread(&AsyncLogger::async_console_log_handler, this);
-    }
-
-}
\ No newline at end of file
+}
@@ -71,6 +71,18 @@ void DaneJoe::ILogger::set_output_settings(const LogOutputSetting& settings)
     m_output_setting = settings;
 }
 
+DaneJoe::ILogger::DeferredSlot DaneJoe::ILogger::reserve_deferred(LogLevel level, std::size_t size)
+{
+    (void)level;
+    (void)size;
+    return DeferredSlot{};
+}
+
+void DaneJoe::ILogger::commit_deferred(const DeferredSlot& slot)
+{
+    (void)slot;
+}
+
 int DaneJoe::ILogger::get_pid()
 {
     return ProcessUtil::get_pid();
@@ -85,7 +97,19 @@ std::string DaneJoe::ILogger::get_header(LogLevel level,
     int process_id,
     const std::string& thread_id)
 {
-    std::string time_str = DANEJOE_NOW_TIME_STR;
+    (void)log_info;
+    return format_header(DANEJOE_NOW_TIME_STR, level, module, file_name, function_name, line_num, process_id, thread_id);
+}
+
+std::string DaneJoe::ILogger::format_header(const std::string& time_str,
+    LogLevel level,
+    const std::string& module,
+    const std::string& file_name,
+    const std::string& function_name,
+    int line_num,
+    int process_id,
+    const std::string& thread_id)
+{
     std::string header;
     if (m_output_setting.enable_time)
         header += std::format("[{}] ", time_str);
@@ -1,9 +1,175 @@
+#include <cassert>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
 #include "danejoe/logger/logger_manager.hpp"
+#include "danejoe/logger/async_logger.hpp"
 #include "demo_logger.hpp"
 
 namespace demo {
 
+static std::size_t count_lines(const std::string& path)
+{
+    std::ifstream file(path);
+    std::string line;
+    std::size_t count = 0;
+    while (std::getline(file, line))
+    {
+        ++count;
+    }
+    return count;
+}
+
+static void test_async_multi_thread()
+{
+    const std::string path = "./log/demo_async.log";
+    std::filesystem::remove(path);
+    constexpr int thread_count = 4;
+    constexpr int per_thread = 5000;
+    {
+        DaneJoe::ILogger::LoggerConfig config;
+        config.log_path = path;
+        config.enable_console = false;
+        // 缓冲区很小，生产者会反复等待后台线程取走记录
+        config.async_buffer_size = 4096;
+        DaneJoe::AsyncLogger logger(config);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < thread_count; ++t)
+        {
+            threads.emplace_back([&logger, t]()
+                {
+                    for (int i = 0; i < per_thread; ++i)
+                    {
+                        logger.info("demo", "", "", -1, "thread {} record {}", t, i);
+                    }
+                });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+    // 析构时取空所有线程缓冲区，已退出线程的记录也不丢失
+    std::size_t line_count = count_lines(path);
+    assert(line_count == thread_count * per_thread);
+}
+
+static void test_flush_policy()
+{
+    const std::string path = "./log/demo_flush.log";
+    std::filesystem::remove(path);
+    DaneJoe::ILogger::LoggerConfig config;
+    config.log_path = path;
+    config.enable_console = false;
+    config.flush_interval = std::chrono::hours(1);
+    config.flush_size_threshold = 1024 * 1024;
+    {
+        DaneJoe::AsyncLogger logger(config);
+        for (int i = 0; i < 10; ++i)
+        {
+            logger.info("demo", "", "", -1, "buffered {}", i);
+        }
+        // 未达到任何写出条件，记录留在后台线程的缓冲区中
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        assert(count_lines(path) == 0);
+
+        // ERROR 级别立即写出，连同之前积压的记录
+        logger.error("demo", "", "", -1, "flush now");
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (count_lines(path) < 11 && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        assert(count_lines(path) == 11);
+        logger.info("demo", "", "", -1, "written on shutdown");
+    }
+    assert(count_lines(path) == 12);
+
+    // 关闭时不写出积压的日志
+    std::filesystem::remove(path);
+    config.flush_on_shutdown = false;
+    {
+        DaneJoe::AsyncLogger logger(config);
+        logger.info("demo", "", "", -1, "dropped on shutdown");
+    }
+    assert(count_lines(path) == 0);
+}
+
+static std::vector<std::string> read_lines(const std::string& path)
+{
+    std::ifstream file(path);
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+static void test_oversized_record()
+{
+    const std::string path = "./log/demo_oversized.log";
+    std::filesystem::remove(path);
+    const std::string payload(3000, 'x');
+    {
+        DaneJoe::ILogger::LoggerConfig config;
+        config.log_path = path;
+        config.enable_console = false;
+        // 单条上限 2048 字节，超长记录同步写出而不截断
+        config.async_buffer_size = 4096;
+        DaneJoe::AsyncLogger logger(config);
+        logger.info("demo", "", "", -1, "short");
+        logger.info("demo", "", "", -1, "long {}", payload);
+    }
+    std::vector<std::string> lines = read_lines(path);
+    assert(lines.size() == 2);
+    bool has_full_payload = false;
+    for (const auto& line : lines)
+    {
+        has_full_payload = has_full_payload || line.find("[long " + payload + "]") != std::string::npos;
+    }
+    assert(has_full_payload);
+}
+
+static void test_deferred_format()
+{
+    const std::string path = "./log/demo_deferred.log";
+    DaneJoe::ILogger::LoggerConfig config;
+    config.log_path = path;
+    config.enable_console = false;
+    config.file_level = DaneJoe::ILogger::LogLevel::DEBUG;
+    for (bool is_deferred : { true, false })
+    {
+        std::filesystem::remove(path);
+        config.enable_deferred_format = is_deferred;
+        {
+            auto logger = std::make_shared<DaneJoe::AsyncLogger>(config);
+            std::string name = "worker";
+            for (int i = 0; i < 3; ++i)
+            {
+                DANEJOE_LOG_DEFERRED(logger, INFO, "demo", "deferred {} {} {:.1f} {}", i, name, 2.5, "done");
+            }
+            // 指针不支持延迟编码，退回立即格式化
+            DANEJOE_LOG_DEFERRED(logger, INFO, "demo", "fallback {}", static_cast<const void*>(nullptr));
+            // 低于输出级别的记录不编码
+            DANEJOE_LOG_DEFERRED(logger, TRACE, "demo", "filtered {}", 1);
+        }
+        std::vector<std::string> lines = read_lines(path);
+        assert(lines.size() == 4);
+        for (int i = 0; i < 3; ++i)
+        {
+            assert(lines[i].find("[demo]") != std::string::npos);
+            assert(lines[i].find("[deferred " + std::to_string(i) + " worker 2.5 done]") != std::string::npos);
+        }
+        assert(lines[3].find("[fallback 0x0]") != std::string::npos);
+    }
+}
+
 void run_logger_demo()
 {
     std::cout << "Logger demo:\n";
@@ -14,6 +180,15 @@ void run_logger_demo()
     DANEJOE_LOG_WARN ("default", "demo", "warn {}", "pay attention");
     DANEJOE_LOG_ERROR("default", "demo", "error code: {}", -1);
 
+    test_async_multi_thread();
+    std::cout << "  async multi-thread logging ok\n";
+    test_oversized_record();
+    std::cout << "  oversized record ok\n";
+    test_flush_policy();
+    std::cout << "  flush policy ok\n";
+    test_deferred_format();
+    std::cout << "  deferred format ok\n";
+
     std::cout << "Logger demo done." << std::endl;
 }
 